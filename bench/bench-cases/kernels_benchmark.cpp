@@ -0,0 +1,166 @@
+#include "benchmark/benchmark.h"
+#include "common/CpuDispatch.hpp"
+#include "common/Kernels.hpp"
+#include "common/SIMD.hpp"
+#include "extern/RoaringBitmap.hpp"
+// ---------------------------------------------------------------------------------------------------
+#include <random>
+#include <vector>
+// ---------------------------------------------------------------------------------------------------
+
+using namespace btrblocks;
+using namespace std;
+
+namespace btrbench {
+
+// The shared decode kernels on one block of generated data, once per SIMD
+// level. Arg: the SimdLevel to force (and the dictionary size for gathers).
+static constexpr u32 kernel_tuple_count = 64000;
+
+// Forces the level of the benchmark for its lifetime
+class ForcedSimdLevel {
+ public:
+  explicit ForcedSimdLevel(benchmark::State& state) : previous(CpuDispatch::level()) {
+    auto level = static_cast<SimdLevel>(state.range(0));
+    if (CpuDispatch::supported() < level) {
+      state.SkipWithError(("cpu does not support " + CpuDispatch::toString(level)).c_str());
+      skipped = true;
+    }
+    CpuDispatch::force(level);
+  }
+  ~ForcedSimdLevel() { CpuDispatch::force(previous); }
+
+  bool skipped = false;
+
+ private:
+  SimdLevel previous;
+};
+
+template <typename T>
+static void GatherBenchmark(benchmark::State& state) {
+  ForcedSimdLevel forced(state);
+  if (forced.skipped) {
+    return;
+  }
+  std::mt19937 rng(42);
+  vector<T> dictionary(state.range(1));
+  for (auto& value : dictionary) {
+    value = static_cast<T>(rng());
+  }
+  vector<INTEGER> codes(kernel_tuple_count);
+  for (auto& code : codes) {
+    code = rng() % dictionary.size();
+  }
+  vector<T> dest(kernel_tuple_count + SIMD_EXTRA_ELEMENTS(T));
+
+  for (auto _ : state) {
+    Kernels::gather(dest.data(), dictionary.data(), dictionary.size(), codes.data(),
+                    kernel_tuple_count);
+    benchmark::DoNotOptimize(dest.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * kernel_tuple_count);
+  state.SetBytesProcessed(state.iterations() * kernel_tuple_count * sizeof(T));
+}
+
+template <typename T>
+static void ExpandRunsBenchmark(benchmark::State& state) {
+  ForcedSimdLevel forced(state);
+  if (forced.skipped) {
+    return;
+  }
+  // Mostly short runs, as RLE picks them for the cascade
+  std::mt19937 rng(42);
+  vector<T> values;
+  vector<INTEGER> counts;
+  for (u32 tuple_count = 0; tuple_count < kernel_tuple_count;) {
+    auto count = std::min<INTEGER>(1 + rng() % 24, kernel_tuple_count - tuple_count);
+    values.push_back(static_cast<T>(rng()));
+    counts.push_back(count);
+    tuple_count += count;
+  }
+  vector<T> dest(kernel_tuple_count + SIMD_EXTRA_ELEMENTS(T));
+
+  for (auto _ : state) {
+    Kernels::expandRuns(dest.data(), values.data(), counts.data(), values.size());
+    benchmark::DoNotOptimize(dest.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * kernel_tuple_count);
+  state.SetBytesProcessed(state.iterations() * kernel_tuple_count * sizeof(T));
+}
+
+// Nullmap with every tenth row set, like the columns the sparse scheme picks
+static vector<BITMAP> GenerateSparseNullmap() {
+  std::mt19937 rng(42);
+  vector<BITMAP> nullmap(kernel_tuple_count);
+  for (auto& is_set : nullmap) {
+    is_set = rng() % 10 == 0;
+  }
+  return nullmap;
+}
+
+template <typename T>
+static void SelectSetBenchmark(benchmark::State& state) {
+  ForcedSimdLevel forced(state);
+  if (forced.skipped) {
+    return;
+  }
+  auto nullmap = GenerateSparseNullmap();
+  vector<T> src(kernel_tuple_count, 42);
+  vector<T> dest(kernel_tuple_count + SIMD_EXTRA_ELEMENTS(T));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        Kernels::selectSet(dest.data(), src.data(), nullmap.data(), kernel_tuple_count));
+  }
+
+  state.SetItemsProcessed(state.iterations() * kernel_tuple_count);
+}
+
+template <typename T>
+static void ExpandSetBenchmark(benchmark::State& state) {
+  ForcedSimdLevel forced(state);
+  if (forced.skipped) {
+    return;
+  }
+  auto nullmap = GenerateSparseNullmap();
+  vector<VALIDITY> validity(bitmap::PackedBitmap::wordCount(kernel_tuple_count));
+  bitmap::PackedBitmap::pack(validity.data(), nullmap.data(), kernel_tuple_count);
+  vector<T> values(kernel_tuple_count, 42);
+  vector<T> dest(kernel_tuple_count + SIMD_EXTRA_ELEMENTS(T));
+
+  for (auto _ : state) {
+    Kernels::expandSet(dest.data(), values.data(), validity.data(), kernel_tuple_count);
+    benchmark::DoNotOptimize(dest.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * kernel_tuple_count);
+  state.SetBytesProcessed(state.iterations() * kernel_tuple_count * sizeof(T));
+}
+
+void RegisterKernelBenchmarks() {
+  const auto max_level = static_cast<int>(SimdLevel::AVX512);
+  auto gather_32 = benchmark::RegisterBenchmark("KERNELS_gather/32", GatherBenchmark<u32>);
+  auto gather_64 = benchmark::RegisterBenchmark("KERNELS_gather/64", GatherBenchmark<u64>);
+  for (int level = 0; level <= max_level; level++) {
+    // Cache-resident, a wide-domain block dictionary and a dictionary beyond L2
+    for (int dictionary_count : {1000, 60000, 1 << 23}) {
+      gather_32->Args({level, dictionary_count});
+      gather_64->Args({level, dictionary_count});
+    }
+  }
+  benchmark::RegisterBenchmark("KERNELS_expand_runs/32", ExpandRunsBenchmark<u32>)
+      ->DenseRange(0, max_level);
+  benchmark::RegisterBenchmark("KERNELS_expand_runs/64", ExpandRunsBenchmark<u64>)
+      ->DenseRange(0, max_level);
+  benchmark::RegisterBenchmark("KERNELS_select_set/32", SelectSetBenchmark<u32>)
+      ->DenseRange(0, max_level);
+  benchmark::RegisterBenchmark("KERNELS_select_set/64", SelectSetBenchmark<u64>)
+      ->DenseRange(0, max_level);
+  benchmark::RegisterBenchmark("KERNELS_expand_set/32", ExpandSetBenchmark<u32>)
+      ->DenseRange(0, max_level);
+  benchmark::RegisterBenchmark("KERNELS_expand_set/64", ExpandSetBenchmark<u64>)
+      ->DenseRange(0, max_level);
+}
+}  // namespace btrbench
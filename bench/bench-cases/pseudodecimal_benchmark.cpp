@@ -0,0 +1,115 @@
+#include "benchmark/benchmark.h"
+#include "btrblocks.hpp"
+#include "scheme/SchemePool.hpp"
+#include "scheme/double/Pseudodecimal.hpp"
+#include "storage/MMapVector.hpp"
+// ---------------------------------------------------------------------------------------------------
+#include <random>
+// ---------------------------------------------------------------------------------------------------
+
+using namespace btrblocks;
+using namespace std;
+
+namespace btrbench {
+
+// Pseudodecimal encoding and decoding on their own, block by block like the
+// datablock hands them to the scheme. Arg: allowed cascading level.
+struct PseudodecimalInput {
+  vector<DOUBLE> values;
+  vector<DoubleStats> blocks;
+};
+
+static PseudodecimalInput LoadPseudodecimalInput(const string& dataset) {
+  PseudodecimalInput input;
+  if (dataset == "generated") {
+    // Prices with two decimal places and a few values that need patches
+    std::mt19937_64 rng(42);
+    input.values.resize(BtrBlocksConfig::get().block_size * 16);
+    for (auto& value : input.values) {
+      value = rng() % 50 == 0 ? static_cast<DOUBLE>(rng()) / 7.0 : (rng() % 100000) / 100.0;
+    }
+  } else {
+    Vector<DOUBLE> column((BENCHMARK_DATASET() + dataset).c_str());
+    input.values.assign(column.data, column.data + column.size());
+  }
+
+  const u64 block_size = BtrBlocksConfig::get().block_size;
+  for (u64 offset = 0; offset < input.values.size(); offset += block_size) {
+    auto count = static_cast<u32>(std::min(block_size, input.values.size() - offset));
+    input.blocks.push_back(
+        DoubleStats::generateStats(input.values.data() + offset, nullptr, count));
+  }
+  return input;
+}
+
+static void PseudodecimalCompressBenchmark(benchmark::State& state, const string& dataset) {
+  SetupSchemes(DoubleSchemeType::PSEUDODECIMAL);
+  auto input = LoadPseudodecimalInput(dataset);
+  auto cascade = static_cast<u8>(state.range(0));
+  doubles::Decimal scheme;
+  auto dest = makeBytesArray(BtrBlocksConfig::get().block_size * sizeof(DOUBLE) * 2);
+
+  size_t compressed_size = 0;
+  for (auto _ : state) {
+    compressed_size = 0;
+    for (auto& stats : input.blocks) {
+      compressed_size += scheme.compress(stats.src, nullptr, dest.get(), stats, cascade);
+    }
+    benchmark::DoNotOptimize(dest.get());
+  }
+
+  state.SetItemsProcessed(state.iterations() * input.values.size());
+  state.SetBytesProcessed(state.iterations() * input.values.size() * sizeof(DOUBLE));
+  state.counters["comp_ratio"] =
+      static_cast<double>(input.values.size() * sizeof(DOUBLE)) / compressed_size;
+}
+
+static void PseudodecimalDecompressBenchmark(benchmark::State& state, const string& dataset) {
+  SetupSchemes(DoubleSchemeType::PSEUDODECIMAL);
+  auto input = LoadPseudodecimalInput(dataset);
+  auto cascade = static_cast<u8>(state.range(0));
+  doubles::Decimal scheme;
+
+  const u64 block_size = BtrBlocksConfig::get().block_size;
+  vector<vector<u8>> compressed(input.blocks.size());
+  for (u32 block_i = 0; block_i < input.blocks.size(); block_i++) {
+    auto& stats = input.blocks[block_i];
+    compressed[block_i].resize(block_size * sizeof(DOUBLE) * 2);
+    auto size = scheme.compress(stats.src, nullptr, compressed[block_i].data(), stats, cascade);
+    if (size > stats.total_size) {
+      // Too many exceptions, the block would not be stored as pseudodecimal
+      state.SkipWithError("pseudodecimal rejects the dataset");
+      return;
+    }
+    compressed[block_i].resize(size);
+  }
+  vector<DOUBLE> dest(block_size + SIMD_EXTRA_ELEMENTS(DOUBLE));
+
+  for (auto _ : state) {
+    for (u32 block_i = 0; block_i < input.blocks.size(); block_i++) {
+      scheme.decompress(dest.data(), nullptr, compressed[block_i].data(),
+                        input.blocks[block_i].tuple_count, 0);
+    }
+    benchmark::DoNotOptimize(dest.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * input.values.size());
+  state.SetBytesProcessed(state.iterations() * input.values.size() * sizeof(DOUBLE));
+}
+
+void RegisterPseudodecimalBenchmarks() {
+  vector<string> datasets{"generated"};
+  datasets.insert(datasets.end(), double_datasets.begin(), double_datasets.end());
+
+  for (auto& dataset : datasets) {
+    benchmark::RegisterBenchmark(("PSEUDODECIMAL_compress/" + dataset).c_str(),
+                                 PseudodecimalCompressBenchmark, dataset)
+        ->DenseRange(1, 2)
+        ->UseRealTime();
+    benchmark::RegisterBenchmark(("PSEUDODECIMAL_decompress/" + dataset).c_str(),
+                                 PseudodecimalDecompressBenchmark, dataset)
+        ->DenseRange(1, 2)
+        ->UseRealTime();
+  }
+}
+}  // namespace btrbench
@@ -28,11 +28,13 @@ static const vector<vector<IntegerSchemeType> > benchmarkedIntegerSchemes{
     {IntegerSchemeType::DICT, IntegerSchemeType::BP},
     {IntegerSchemeType::RLE},
     {IntegerSchemeType::PFOR},
-    {IntegerSchemeType::BP}};
+    {IntegerSchemeType::BP},
+    // DELTA cascades the deltas, so give it BP as well
+    {IntegerSchemeType::DELTA, IntegerSchemeType::BP}};
 
 static const vector<DoubleSchemeType> benchmarkedDoubleSchemes{
     DoubleSchemeType::DICT, DoubleSchemeType::RLE, DoubleSchemeType::FREQUENCY,
-    DoubleSchemeType::PSEUDODECIMAL};
+    DoubleSchemeType::PSEUDODECIMAL, DoubleSchemeType::ALP, DoubleSchemeType::XOR};
 
 static const vector<StringSchemeType> benchmarkedStringSchemes{StringSchemeType::DICT,
                                                                StringSchemeType::FSST};
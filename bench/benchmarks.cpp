@@ -2,8 +2,11 @@
 // BtrBlocks
 // ---------------------------------------------------------------------------
 #include "benchmark/benchmark.h"
+#include "common/CpuDispatch.hpp"
 #include "scheme/SchemePool.hpp"
 #include "bench-cases/regression_benchmark.cpp"
+#include "bench-cases/pseudodecimal_benchmark.cpp"
+#include "bench-cases/kernels_benchmark.cpp"
 // ---------------------------------------------------------------------------
 using namespace btrblocks;
 // ---------------------------------------------------------------------------
@@ -13,7 +16,12 @@ int main(int argc, char** argv) {
 #else
   std::cout << "\033[0;31mSIMD DISABLED\033[0m" << std::endl;
 #endif
+  // BTR_SIMD_LEVEL=scalar|avx2|avx512 caps the dispatched kernels
+  std::cout << "SIMD LEVEL " << CpuDispatch::toString(CpuDispatch::level()) << " (supported "
+            << CpuDispatch::toString(CpuDispatch::supported()) << ")" << std::endl;
   btrbench::RegisterSingleBenchmarks();
+  btrbench::RegisterPseudodecimalBenchmarks();
+  btrbench::RegisterKernelBenchmarks();
   benchmark::Initialize(&argc, argv);
   benchmark::RunSpecifiedBenchmarks();
 }
@@ -31,12 +31,24 @@ struct BtrBlocksConfig {
     uint8_t max_cascade_depth{3};                      // maximum recursive compression calls
   } integers;
 
+  struct {
+    Integer64SchemeSet schemes{defaultInteger64Schemes()}; // enabled bigint schemes
+    Integer64SchemeType override_scheme{autoScheme()};     // force using this scheme for bigint columns
+    uint8_t max_cascade_depth{3};                          // maximum recursive compression calls
+  } bigints;
+
   struct {
     DoubleSchemeSet schemes{defaultDoubleSchemes()};   // enabled double schemes
     DoubleSchemeType override_scheme{autoScheme()};    // force using this scheme for double columns
     uint8_t max_cascade_depth{3};                      // maximum recursive compression calls
   } doubles;
 
+  struct {
+    FloatSchemeSet schemes{defaultFloatSchemes()};     // enabled float schemes
+    FloatSchemeType override_scheme{autoScheme()};     // force using this scheme for float columns
+    uint8_t max_cascade_depth{3};                      // maximum recursive compression calls
+  } floats;
+
   struct {
     StringSchemeSet schemes{defaultStringSchemes()};   // enabled string schemes
     StringSchemeType override_scheme{autoScheme()};    // force using this scheme for string columns
@@ -0,0 +1,89 @@
+#include "CpuDispatch.hpp"
+// -------------------------------------------------------------------------------------
+#include <unistd.h>
+#include <algorithm>
+#include <cstdlib>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+SimdLevel parseLevel(const string& name, SimdLevel fallback) {
+  if (name == "scalar") {
+    return SimdLevel::SCALAR;
+  } else if (name == "avx2") {
+    return SimdLevel::AVX2;
+  } else if (name == "avx512") {
+    return SimdLevel::AVX512;
+  }
+  return fallback;
+}
+// -------------------------------------------------------------------------------------
+SimdLevel initialLevel() {
+  SimdLevel level = CpuDispatch::supported();
+  if (const char* forced = std::getenv("BTR_SIMD_LEVEL")) {
+    level = std::min(level, parseLevel(forced, level));
+  }
+  return level;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+SimdLevel CpuDispatch::current = initialLevel();
+// -------------------------------------------------------------------------------------
+SimdLevel CpuDispatch::supported() {
+  static const SimdLevel supported_level = detect();
+  return supported_level;
+}
+// -------------------------------------------------------------------------------------
+SimdLevel CpuDispatch::detect() {
+#if defined(BTR_USE_DISPATCH)
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+      __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl")) {
+    return SimdLevel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2") &&
+      __builtin_cpu_supports("fma")) {
+    return SimdLevel::AVX2;
+  }
+  return SimdLevel::SCALAR;
+#elif defined(BTR_USE_SIMD)
+  return SimdLevel::AVX2;
+#else
+  return SimdLevel::SCALAR;
+#endif
+}
+// -------------------------------------------------------------------------------------
+SimdLevel CpuDispatch::force(SimdLevel level) {
+  current = std::min(level, supported());
+  return current;
+}
+// -------------------------------------------------------------------------------------
+u32 CpuDispatch::l2CacheBytes() {
+  static const u32 l2_bytes = [] {
+#ifdef _SC_LEVEL2_CACHE_SIZE
+    const long size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    if (size > 0) {
+      return static_cast<u32>(size);
+    }
+#endif
+    return 256u * 1024;
+  }();
+  return l2_bytes;
+}
+// -------------------------------------------------------------------------------------
+string CpuDispatch::toString(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::SCALAR:
+      return "scalar";
+    case SimdLevel::AVX2:
+      return "avx2";
+    case SimdLevel::AVX512:
+      return "avx512";
+  }
+  UNREACHABLE();
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,50 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+/*
+ * Runtime selection of the instruction set for the hot decode kernels.
+ *
+ * Kernels are compiled once per level (BTR_TARGET_* on x86, regardless of the
+ * -march of the build) and switch on CpuDispatch::level() when called. The
+ * level is detected once at startup. The BTR_SIMD_LEVEL environment variable
+ * (scalar, avx2 or avx512) or force() caps it, e.g. to compare levels in
+ * benchmarks.
+ */
+enum class SimdLevel : u8 { SCALAR = 0, AVX2 = 1, AVX512 = 2 };
+// -------------------------------------------------------------------------------------
+#ifdef BTR_USE_DISPATCH
+#define BTR_TARGET_AVX2 __attribute__((target("avx2,fma,bmi,bmi2,popcnt,lzcnt")))
+#define BTR_TARGET_AVX512 \
+  __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl,avx2,fma,bmi,bmi2,popcnt,lzcnt")))
+#else
+#define BTR_TARGET_AVX2
+#endif
+// AVX2 kernels also exist in SIMD builds without dispatch (simde on aarch64)
+#if defined(BTR_USE_DISPATCH) || defined(BTR_USE_SIMD)
+#define BTR_WITH_AVX2 1
+#endif
+// -------------------------------------------------------------------------------------
+class CpuDispatch {
+ public:
+  // Highest level the CPU and the build support
+  static SimdLevel supported();
+  // Level the kernels use
+  static inline SimdLevel level() { return current; }
+  static inline bool atLeast(SimdLevel minimum) { return current >= minimum; }
+  // Use at most level (clamped to supported()), returns the level in effect
+  static SimdLevel force(SimdLevel level);
+  static string toString(SimdLevel level);
+  // Size of the per-core L2 cache, 256 KiB if the OS does not report it
+  static u32 l2CacheBytes();
+
+ private:
+  static SimdLevel detect();
+  // Zero before the static initialization, so kernels called that early run scalar
+  static SimdLevel current;
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,129 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <string>
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// DECIMAL(precision, scale) values are stored as integers scaled by
+// 10^scale, the scale is part of the schema ("decimal(12,2)") and of every
+// compressed chunk instead of being stored per value.
+class Decimal {
+ public:
+  // Scaled values of 18 digits always fit into s64
+  static constexpr u8 MAX_PRECISION = 18;
+  static constexpr s64 POWERS_OF_TEN[MAX_PRECISION + 1] = {1ll,
+                                                           10ll,
+                                                           100ll,
+                                                           1000ll,
+                                                           10000ll,
+                                                           100000ll,
+                                                           1000000ll,
+                                                           10000000ll,
+                                                           100000000ll,
+                                                           1000000000ll,
+                                                           10000000000ll,
+                                                           100000000000ll,
+                                                           1000000000000ll,
+                                                           10000000000000ll,
+                                                           100000000000000ll,
+                                                           1000000000000000ll,
+                                                           10000000000000000ll,
+                                                           100000000000000000ll,
+                                                           1000000000000000000ll};
+  // -------------------------------------------------------------------------------------
+  // Parses "decimal(p,s)" or "decimal(p)", returns false for all other types
+  static bool parseType(const string& type_str, u8& precision, u8& scale) {
+    if (type_str.rfind("decimal(", 0) != 0) {
+      return false;
+    }
+    u32 p = 0, s = 0;
+    int consumed = 0;
+    if (std::sscanf(type_str.c_str(), "decimal(%u,%u)%n", &p, &s, &consumed) != 2) {
+      s = 0;
+      consumed = 0;
+      std::sscanf(type_str.c_str(), "decimal(%u)%n", &p, &consumed);
+    }
+    if (consumed != static_cast<int>(type_str.size()) || p == 0 || p > MAX_PRECISION || s > p) {
+      throw Generic_Exception("Invalid decimal type: " + type_str);
+    }
+    precision = p;
+    scale = s;
+    return true;
+  }
+  // -------------------------------------------------------------------------------------
+  // Exact conversion of "[-]digits[.digits]", no detour through double
+  static DECIMAL parse(const string& str, u8 precision, u8 scale) {
+    size_t pos = 0;
+    const bool minus = !str.empty() && str[0] == '-';
+    if (!str.empty() && (str[0] == '-' || str[0] == '+')) {
+      pos++;
+    }
+    s64 value = 0;
+    u32 digits = 0, fraction_digits = 0;
+    bool fraction = false;
+    for (; pos < str.size(); pos++) {
+      if (str[pos] == '.' && !fraction) {
+        fraction = true;
+        continue;
+      }
+      if (!std::isdigit(str[pos])) {
+        throw Generic_Exception("Invalid decimal: " + str);
+      }
+      digits++;
+      if (fraction && ++fraction_digits > scale) {
+        // Trailing zeros beyond the scale are fine, everything else would be rounded
+        if (str[pos] != '0') {
+          throw Generic_Exception("Decimal " + str + " exceeds scale " + std::to_string(scale));
+        }
+        continue;
+      }
+      value = value * 10 + (str[pos] - '0');
+      if (value >= POWERS_OF_TEN[precision]) {
+        throw Generic_Exception("Decimal " + str + " exceeds precision " +
+                                std::to_string(precision));
+      }
+    }
+    if (digits == 0) {
+      throw Generic_Exception("Invalid decimal: " + str);
+    }
+    for (u32 i = std::min<u32>(fraction_digits, scale); i < scale; i++) {
+      value *= 10;
+    }
+    if (value >= POWERS_OF_TEN[precision]) {
+      throw Generic_Exception("Decimal " + str + " exceeds precision " +
+                              std::to_string(precision));
+    }
+    return minus ? -value : value;
+  }
+  // -------------------------------------------------------------------------------------
+  static string format(DECIMAL value, u8 scale) {
+    const bool negative = value < 0;
+    // Negating in u64 keeps the minimum value intact
+    u64 magnitude = negative ? 0 - static_cast<u64>(value) : static_cast<u64>(value);
+    string digits = std::to_string(magnitude);
+    if (digits.size() <= scale) {
+      digits.insert(0, scale + 1 - digits.size(), '0');
+    }
+    if (scale > 0) {
+      digits.insert(digits.size() - scale, 1, '.');
+    }
+    return negative ? "-" + digits : digits;
+  }
+  // -------------------------------------------------------------------------------------
+  // Dividing instead of multiplying by 10^-scale gives the correctly rounded
+  // double for every value below 2^53
+  static void toDoubles(DOUBLE* dest, const DECIMAL* src, u32 tuple_count, u8 scale) {
+    const DOUBLE divisor = static_cast<DOUBLE>(POWERS_OF_TEN[scale]);
+    for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+      dest[row_i] = static_cast<DOUBLE>(src[row_i]) / divisor;
+    }
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,98 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+// -------------------------------------------------------------------------------------
+#include "common/Kernels.hpp"
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+/*
+ * 64-bit value hashes for joins and group-by on compressed chunks.
+ *
+ * A value always hashes to the same result, no matter which scheme the chunk
+ * was compressed with. Schemes may therefore hash their distinct values (or
+ * runs) only once and broadcast the result.
+ */
+class Hash {
+ public:
+  static constexpr u64 SEED = 0x9e3779b97f4a7c15ull;
+  // -------------------------------------------------------------------------------------
+  // murmur3 64-bit finalizer
+  static inline u64 hashValue(u64 key) {
+    key += SEED;
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return key;
+  }
+  // Integers are sign extended, so equal values of different widths collide
+  static inline u64 hashValue(s64 key) { return hashValue(static_cast<u64>(key)); }
+  static inline u64 hashValue(s32 key) { return hashValue(static_cast<u64>(static_cast<s64>(key))); }
+  static inline u64 hashValue(DOUBLE key) {
+    // -0.0 == 0.0, make sure both end up in the same bucket
+    if (key == 0.0) {
+      key = 0.0;
+    }
+    u64 bits;
+    std::memcpy(&bits, &key, sizeof(bits));
+    return hashValue(bits);
+  }
+  // Floats are widened, so equal values of both precisions collide
+  static inline u64 hashValue(FLOAT key) { return hashValue(static_cast<DOUBLE>(key)); }
+  static inline u64 hashValue(const char* data, u32 length) {
+    u64 h = SEED ^ (length * 0xc6a4a7935bd1e995ull);
+    u32 i = 0;
+    for (; i + sizeof(u64) <= length; i += sizeof(u64)) {
+      u64 word;
+      std::memcpy(&word, data + i, sizeof(u64));
+      h = (h ^ mixWord(word)) * 0xc6a4a7935bd1e995ull;
+    }
+    if (i < length) {
+      u64 word = 0;
+      std::memcpy(&word, data + i, length - i);
+      h = (h ^ mixWord(word)) * 0xc6a4a7935bd1e995ull;
+    }
+    return hashValue(h);
+  }
+  static inline u64 hashValue(str value) { return hashValue(value.data(), value.length()); }
+  // -------------------------------------------------------------------------------------
+  template <typename T>
+  static inline void hashColumn(u64* dest, const T* src, u32 tuple_count) {
+    for (u32 i = 0; i < tuple_count; i++) {
+      dest[i] = hashValue(src[i]);
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // dest[i] = hashes[codes[i]]
+  static inline void gather(u64* dest,
+                            const u64* hashes,
+                            u32 hashes_count,
+                            const INTEGER* codes,
+                            u32 tuple_count) {
+    Kernels::gather(dest, hashes, hashes_count, codes, tuple_count);
+  }
+  // -------------------------------------------------------------------------------------
+  // Expand one hash per run into one hash per row
+  static inline void expandRuns(u64* dest,
+                                const u64* hashes,
+                                const INTEGER* counts,
+                                u32 runs_count) {
+    for (u32 run_i = 0; run_i < runs_count; run_i++) {
+      dest = std::fill_n(dest, counts[run_i], hashes[run_i]);
+    }
+  }
+
+ private:
+  static inline u64 mixWord(u64 word) {
+    word *= 0x87c37b91114253d5ull;
+    word = (word << 31) | (word >> 33);
+    return word * 0x4cf5ad432745937full;
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,895 @@
+#include "Kernels.hpp"
+#include "common/CpuDispatch.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+// Scalar
+// -------------------------------------------------------------------------------------
+template <typename T>
+void gatherScalar(T* dest, const T* dictionary, const INTEGER* codes, u32 tuple_count) {
+  for (u32 i = 0; i < tuple_count; i++) {
+    dest[i] = dictionary[codes[i]];
+  }
+}
+// -------------------------------------------------------------------------------------
+template <typename T, typename V>
+void expandRunsScalar(T* dest, const V* values, const INTEGER* counts, u32 runs_count) {
+  auto write_ptr = dest;
+  for (u32 run_i = 0; run_i < runs_count; run_i++) {
+    auto val = static_cast<T>(values[run_i]);
+    auto target_ptr = write_ptr + counts[run_i];
+    while (write_ptr != target_ptr) {
+      *write_ptr++ = val;
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
+template <typename T>
+u32 selectSetScalar(T* dest, const T* src, const BITMAP* nullmap, u32 tuple_count) {
+  u32 set_count = 0;
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    dest[set_count] = src[row_i];
+    set_count += nullmap[row_i] ? 1 : 0;
+  }
+  return set_count;
+}
+// -------------------------------------------------------------------------------------
+template <typename T>
+void expandSetScalar(T* dest, const T* values, const VALIDITY* validity, u32 tuple_count) {
+  for (u32 row_i = 0; row_i < tuple_count; row_i += 64) {
+    VALIDITY word = validity[row_i / 64];
+    const u32 rows = std::min(tuple_count - row_i, 64u);
+    // The bits of the last word past tuple_count are not necessarily zero
+    if (rows < 64) {
+      word &= (VALIDITY{1} << rows) - 1;
+    }
+    if (word == ~VALIDITY{0}) {
+      std::memcpy(dest + row_i, values, 64 * sizeof(T));
+      values += 64;
+      continue;
+    }
+    std::fill_n(dest + row_i, rows, T{0});
+    while (word != 0) {
+      dest[row_i + __builtin_ctzll(word)] = *values++;
+      word &= word - 1;
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
+// Out of range values (and NaN) become INTEGER min, like the cvtt instructions
+// make them, and then fail the round trip. 2^31 is exact in both types.
+template <typename T>
+inline INTEGER alpEncodeValue(T value, T exponent_power, T factor_fraction) {
+  const T rounded = std::nearbyint(value * exponent_power * factor_fraction);
+  if (rounded >= T(-2147483648.0) && rounded < T(2147483648.0)) {
+    return static_cast<INTEGER>(rounded);
+  }
+  return std::numeric_limits<INTEGER>::min();
+}
+// -------------------------------------------------------------------------------------
+// Dividing by the exact power of ten rounds correctly, multiplying with the
+// (inexact) fraction would turn many short decimals into exceptions
+template <typename T>
+inline T alpDecodeValue(INTEGER digits, T factor_power, T exponent_power) {
+  return static_cast<T>(digits) * factor_power / exponent_power;
+}
+// -------------------------------------------------------------------------------------
+// Compare bit patterns, so that -0.0 and NaN become exceptions
+template <typename T>
+u32 alpEncodeScalar(INTEGER* digits,
+                    INTEGER* exceptions,
+                    const T* src,
+                    u32 tuple_count,
+                    T exponent_power,
+                    T factor_fraction,
+                    T factor_power,
+                    u32 row_offset = 0) {
+  u32 exceptions_count = 0;
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    digits[row_i] = alpEncodeValue(src[row_i], exponent_power, factor_fraction);
+    const T decoded = alpDecodeValue(digits[row_i], factor_power, exponent_power);
+    exceptions[exceptions_count] = row_offset + row_i;
+    exceptions_count += std::memcmp(&decoded, src + row_i, sizeof(T)) != 0;
+  }
+  return exceptions_count;
+}
+// -------------------------------------------------------------------------------------
+template <typename T>
+void alpDecodeScalar(T* dest,
+                     const INTEGER* digits,
+                     u32 tuple_count,
+                     T factor_power,
+                     T exponent_power) {
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    dest[row_i] = alpDecodeValue(digits[row_i], factor_power, exponent_power);
+  }
+}
+// -------------------------------------------------------------------------------------
+// AVX2
+// -------------------------------------------------------------------------------------
+#ifdef BTR_WITH_AVX2
+BTR_TARGET_AVX2 void gatherAVX2(u32* dest, const u32* dictionary, const INTEGER* codes, u32 n) {
+  auto base = reinterpret_cast<const int*>(dictionary);
+  u32 i = 0;
+  for (; i + 32 <= n; i += 32) {
+    // Load codes.
+    __m256i codes_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i + 0));
+    __m256i codes_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i + 8));
+    __m256i codes_2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i + 16));
+    __m256i codes_3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i + 24));
+
+    // Gather values.
+    __m256i values_0 = _mm256_i32gather_epi32(base, codes_0, 4);
+    __m256i values_1 = _mm256_i32gather_epi32(base, codes_1, 4);
+    __m256i values_2 = _mm256_i32gather_epi32(base, codes_2, 4);
+    __m256i values_3 = _mm256_i32gather_epi32(base, codes_3, 4);
+
+    // store values
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i + 0), values_0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i + 8), values_1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i + 16), values_2);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i + 24), values_3);
+  }
+  gatherScalar(dest + i, dictionary, codes + i, n - i);
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX2 void gatherAVX2(u64* dest, const u64* dictionary, const INTEGER* codes, u32 n) {
+  auto base = reinterpret_cast<const long long*>(dictionary);
+  u32 i = 0;
+  for (; i + 16 <= n; i += 16) {
+    // Load codes
+    __m128i codes_0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes + i + 0));
+    __m128i codes_1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes + i + 4));
+    __m128i codes_2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes + i + 8));
+    __m128i codes_3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(codes + i + 12));
+
+    // gather values
+    __m256i values_0 = _mm256_i32gather_epi64(base, codes_0, 8);
+    __m256i values_1 = _mm256_i32gather_epi64(base, codes_1, 8);
+    __m256i values_2 = _mm256_i32gather_epi64(base, codes_2, 8);
+    __m256i values_3 = _mm256_i32gather_epi64(base, codes_3, 8);
+
+    // store values
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i + 0), values_0);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i + 4), values_1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i + 8), values_2);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i + 12), values_3);
+  }
+  gatherScalar(dest + i, dictionary, codes + i, n - i);
+}
+// -------------------------------------------------------------------------------------
+/*
+ * I tried several variation for vectorizing this. Using AVX2 directly is
+ * the fastest even when there are many very short runs. The penalty of
+ * branching simply outweighs the few instructions saved by not using AVX2
+ * for short runs
+ */
+template <typename T>
+BTR_TARGET_AVX2 void expandRunsAVX2(T* dest, const T* values, const INTEGER* counts, u32 runs) {
+  constexpr u32 per_store = sizeof(__m256i) / sizeof(T);
+  auto write_ptr = dest;
+  for (u32 run_i = 0; run_i < runs; run_i++) {
+    auto target_ptr = write_ptr + counts[run_i];
+    // set is a sequential operation
+    __m256i vec;
+    if constexpr (sizeof(T) == 4) {
+      vec = _mm256_set1_epi32(values[run_i]);
+    } else {
+      vec = _mm256_set1_epi64x(values[run_i]);
+    }
+    while (write_ptr < target_ptr) {
+      // store is performed in a single cycle
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(write_ptr), vec);
+      write_ptr += per_store;
+    }
+    write_ptr = target_ptr;
+  }
+}
+// -------------------------------------------------------------------------------------
+// Same stores as expandRunsAVX2, but the last vector of the output is filled
+// one value at a time, so that nothing is written past the last run
+template <typename T>
+BTR_TARGET_AVX2 void expandRunsNarrowAVX2(T* dest,
+                                          const INTEGER* values,
+                                          const INTEGER* counts,
+                                          u32 runs) {
+  constexpr u32 per_store = sizeof(__m256i) / sizeof(T);
+  u64 tuple_count = 0;
+  for (u32 run_i = 0; run_i < runs; run_i++) {
+    tuple_count += counts[run_i];
+  }
+  const T* end_ptr = dest + tuple_count;
+  auto write_ptr = dest;
+  for (u32 run_i = 0; run_i < runs; run_i++) {
+    auto target_ptr = write_ptr + counts[run_i];
+    const T val = static_cast<T>(values[run_i]);
+    __m256i vec;
+    if constexpr (sizeof(T) == 2) {
+      vec = _mm256_set1_epi16(val);
+    } else {
+      vec = _mm256_set1_epi8(val);
+    }
+    while (write_ptr < target_ptr && write_ptr + per_store <= end_ptr) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(write_ptr), vec);
+      write_ptr += per_store;
+    }
+    while (write_ptr < target_ptr) {
+      *write_ptr++ = val;
+    }
+    write_ptr = target_ptr;
+  }
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX2 u32 alpEncodeAVX2(INTEGER* digits,
+                                  INTEGER* exceptions,
+                                  const DOUBLE* src,
+                                  u32 n,
+                                  DOUBLE exponent_power,
+                                  DOUBLE factor_fraction,
+                                  DOUBLE factor_power) {
+  const __m256d encode_power = _mm256_set1_pd(exponent_power);
+  const __m256d encode_fraction = _mm256_set1_pd(factor_fraction);
+  const __m256d decode_power = _mm256_set1_pd(factor_power);
+  const __m256d decode_divisor = _mm256_set1_pd(exponent_power);
+  u32 exceptions_count = 0;
+  u32 i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d values = _mm256_loadu_pd(src + i);
+    __m256d scaled = _mm256_mul_pd(_mm256_mul_pd(values, encode_power), encode_fraction);
+    __m256d rounded = _mm256_round_pd(scaled, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m128i encoded = _mm256_cvttpd_epi32(rounded);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(digits + i), encoded);
+    // -------------------------------------------------------------------------------------
+    __m256d decoded =
+        _mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(encoded), decode_power), decode_divisor);
+    __m256i equal =
+        _mm256_cmpeq_epi64(_mm256_castpd_si256(decoded), _mm256_castpd_si256(values));
+    u32 failed = ~_mm256_movemask_pd(_mm256_castsi256_pd(equal));
+    // Branch-free append, the row is always written but only kept on failure
+    for (u32 lane_i = 0; lane_i < 4; lane_i++) {
+      exceptions[exceptions_count] = i + lane_i;
+      exceptions_count += (failed >> lane_i) & 1;
+    }
+  }
+  return exceptions_count + alpEncodeScalar(digits + i, exceptions + exceptions_count, src + i,
+                                            n - i, exponent_power, factor_fraction,
+                                            factor_power, i);
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX2 u32 alpEncodeAVX2(INTEGER* digits,
+                                  INTEGER* exceptions,
+                                  const FLOAT* src,
+                                  u32 n,
+                                  FLOAT exponent_power,
+                                  FLOAT factor_fraction,
+                                  FLOAT factor_power) {
+  const __m256 encode_power = _mm256_set1_ps(exponent_power);
+  const __m256 encode_fraction = _mm256_set1_ps(factor_fraction);
+  const __m256 decode_power = _mm256_set1_ps(factor_power);
+  const __m256 decode_divisor = _mm256_set1_ps(exponent_power);
+  u32 exceptions_count = 0;
+  u32 i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 values = _mm256_loadu_ps(src + i);
+    __m256 scaled = _mm256_mul_ps(_mm256_mul_ps(values, encode_power), encode_fraction);
+    __m256 rounded = _mm256_round_ps(scaled, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256i encoded = _mm256_cvttps_epi32(rounded);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(digits + i), encoded);
+    // -------------------------------------------------------------------------------------
+    __m256 decoded =
+        _mm256_div_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(encoded), decode_power), decode_divisor);
+    __m256i equal =
+        _mm256_cmpeq_epi32(_mm256_castps_si256(decoded), _mm256_castps_si256(values));
+    u32 failed = ~_mm256_movemask_ps(_mm256_castsi256_ps(equal));
+    for (u32 lane_i = 0; lane_i < 8; lane_i++) {
+      exceptions[exceptions_count] = i + lane_i;
+      exceptions_count += (failed >> lane_i) & 1;
+    }
+  }
+  return exceptions_count + alpEncodeScalar(digits + i, exceptions + exceptions_count, src + i,
+                                            n - i, exponent_power, factor_fraction,
+                                            factor_power, i);
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX2 void alpDecodeAVX2(DOUBLE* dest,
+                                   const INTEGER* digits,
+                                   u32 n,
+                                   DOUBLE factor_power,
+                                   DOUBLE exponent_power) {
+  const __m256d decode_power = _mm256_set1_pd(factor_power);
+  const __m256d decode_divisor = _mm256_set1_pd(exponent_power);
+  u32 i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i digits_0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits + i));
+    __m128i digits_1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits + i + 4));
+    __m256d values_0 =
+        _mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(digits_0), decode_power), decode_divisor);
+    __m256d values_1 =
+        _mm256_div_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(digits_1), decode_power), decode_divisor);
+    _mm256_storeu_pd(dest + i, values_0);
+    _mm256_storeu_pd(dest + i + 4, values_1);
+  }
+  alpDecodeScalar(dest + i, digits + i, n - i, factor_power, exponent_power);
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX2 void alpDecodeAVX2(FLOAT* dest,
+                                   const INTEGER* digits,
+                                   u32 n,
+                                   FLOAT factor_power,
+                                   FLOAT exponent_power) {
+  const __m256 decode_power = _mm256_set1_ps(factor_power);
+  const __m256 decode_divisor = _mm256_set1_ps(exponent_power);
+  u32 i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i digits_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(digits + i));
+    __m256i digits_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(digits + i + 8));
+    __m256 values_0 =
+        _mm256_div_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(digits_0), decode_power), decode_divisor);
+    __m256 values_1 =
+        _mm256_div_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(digits_1), decode_power), decode_divisor);
+    _mm256_storeu_ps(dest + i, values_0);
+    _mm256_storeu_ps(dest + i + 8, values_1);
+  }
+  alpDecodeScalar(dest + i, digits + i, n - i, factor_power, exponent_power);
+}
+// -------------------------------------------------------------------------------------
+// AVX2 has no vpcompress/vpexpand, instead every mask of 8 (4) rows maps to
+// the vpermd indices that move the 32-bit lanes of the values into place
+template <u32 rows>
+using LaneTable = std::array<std::array<u32, 8>, 1u << rows>;
+// -------------------------------------------------------------------------------------
+// The set rows to the front, in order
+template <u32 rows>
+constexpr LaneTable<rows> makeCompressTable() {
+  constexpr u32 lanes_per_row = 8 / rows;
+  LaneTable<rows> table{};
+  for (u32 mask = 0; mask < (1u << rows); mask++) {
+    u32 set_i = 0;
+    for (u32 row_i = 0; row_i < rows; row_i++) {
+      if ((mask >> row_i) & 1) {
+        for (u32 lane_i = 0; lane_i < lanes_per_row; lane_i++) {
+          table[mask][set_i * lanes_per_row + lane_i] = row_i * lanes_per_row + lane_i;
+        }
+        set_i++;
+      }
+    }
+  }
+  return table;
+}
+// -------------------------------------------------------------------------------------
+// The next value to every set row, the others are zeroed afterwards
+template <u32 rows>
+constexpr LaneTable<rows> makeExpandTable() {
+  constexpr u32 lanes_per_row = 8 / rows;
+  LaneTable<rows> table{};
+  for (u32 mask = 0; mask < (1u << rows); mask++) {
+    u32 set_i = 0;
+    for (u32 row_i = 0; row_i < rows; row_i++) {
+      if ((mask >> row_i) & 1) {
+        for (u32 lane_i = 0; lane_i < lanes_per_row; lane_i++) {
+          table[mask][row_i * lanes_per_row + lane_i] = set_i * lanes_per_row + lane_i;
+        }
+        set_i++;
+      }
+    }
+  }
+  return table;
+}
+// -------------------------------------------------------------------------------------
+constexpr LaneTable<8> compress_lanes_32 = makeCompressTable<8>();
+constexpr LaneTable<4> compress_lanes_64 = makeCompressTable<4>();
+constexpr LaneTable<8> expand_lanes_32 = makeExpandTable<8>();
+constexpr LaneTable<4> expand_lanes_64 = makeExpandTable<4>();
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX2 inline __m256i loadLanes(const std::array<u32, 8>& lanes) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes.data()));
+}
+// -------------------------------------------------------------------------------------
+// Full vectors are stored at the write position, they only overwrite slots
+// that the scalar kernel writes as well
+BTR_TARGET_AVX2 u32 selectSetAVX2(u32* dest, const u32* src, const BITMAP* nullmap, u32 n) {
+  u32 set_count = 0;
+  u32 i = 0;
+  for (; i + 8 <= n; i += 8) {
+    u64 bytes;
+    std::memcpy(&bytes, nullmap + i, sizeof(bytes));
+    const __m128i nulls = _mm_cmpeq_epi8(_mm_cvtsi64_si128(bytes), _mm_setzero_si128());
+    const u32 mask = ~_mm_movemask_epi8(nulls) & 0xFF;
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    values = _mm256_permutevar8x32_epi32(values, loadLanes(compress_lanes_32[mask]));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + set_count), values);
+    set_count += _mm_popcnt_u32(mask);
+  }
+  return set_count + selectSetScalar(dest + set_count, src + i, nullmap + i, n - i);
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX2 u32 selectSetAVX2(u64* dest, const u64* src, const BITMAP* nullmap, u32 n) {
+  u32 set_count = 0;
+  u32 i = 0;
+  for (; i + 4 <= n; i += 4) {
+    u32 bytes;
+    std::memcpy(&bytes, nullmap + i, sizeof(bytes));
+    const __m128i nulls = _mm_cmpeq_epi8(_mm_cvtsi32_si128(bytes), _mm_setzero_si128());
+    const u32 mask = ~_mm_movemask_epi8(nulls) & 0xF;
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    values = _mm256_permutevar8x32_epi32(values, loadLanes(compress_lanes_64[mask]));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + set_count), values);
+    set_count += _mm_popcnt_u32(mask);
+  }
+  return set_count + selectSetScalar(dest + set_count, src + i, nullmap + i, n - i);
+}
+// -------------------------------------------------------------------------------------
+// The masked load only reads the values that are used. The rows of the tail
+// are expanded one at a time, so no bit past n is ever read.
+BTR_TARGET_AVX2 void expandSetAVX2(u32* dest, const u32* values, const VALIDITY* validity, u32 n) {
+  const __m256i lane_ids = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+  u32 i = 0;
+  for (; i + 8 <= n; i += 8) {
+    const u32 mask = (validity[i / 64] >> (i % 64)) & 0xFF;
+    const u32 count = _mm_popcnt_u32(mask);
+    const __m256i used = _mm256_cmpgt_epi32(_mm256_set1_epi32(count), lane_ids);
+    __m256i expanded = _mm256_maskload_epi32(reinterpret_cast<const int*>(values), used);
+    expanded = _mm256_permutevar8x32_epi32(expanded, loadLanes(expand_lanes_32[mask]));
+    const __m256i set =
+        _mm256_cmpeq_epi32(_mm256_and_si256(_mm256_set1_epi32(mask), lane_bits), lane_bits);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_and_si256(expanded, set));
+    values += count;
+  }
+  for (; i < n; i++) {
+    dest[i] = (validity[i / 64] >> (i % 64)) & 1 ? *values++ : 0;
+  }
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX2 void expandSetAVX2(u64* dest, const u64* values, const VALIDITY* validity, u32 n) {
+  const __m256i lane_ids = _mm256_setr_epi64x(0, 1, 2, 3);
+  const __m256i lane_bits = _mm256_setr_epi64x(1, 2, 4, 8);
+  u32 i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const u32 mask = (validity[i / 64] >> (i % 64)) & 0xF;
+    const u32 count = _mm_popcnt_u32(mask);
+    const __m256i used = _mm256_cmpgt_epi64(_mm256_set1_epi64x(count), lane_ids);
+    __m256i expanded = _mm256_maskload_epi64(reinterpret_cast<const long long*>(values), used);
+    expanded = _mm256_permutevar8x32_epi32(expanded, loadLanes(expand_lanes_64[mask]));
+    const __m256i set =
+        _mm256_cmpeq_epi64(_mm256_and_si256(_mm256_set1_epi64x(mask), lane_bits), lane_bits);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_and_si256(expanded, set));
+    values += count;
+  }
+  for (; i < n; i++) {
+    dest[i] = (validity[i / 64] >> (i % 64)) & 1 ? *values++ : 0;
+  }
+}
+#endif  // BTR_WITH_AVX2
+// -------------------------------------------------------------------------------------
+// AVX-512
+// -------------------------------------------------------------------------------------
+#ifdef BTR_USE_DISPATCH
+// The lowest min(count, 64) bits set. bzhi only reads the low byte of the index.
+BTR_TARGET_AVX512 inline u64 lowMask(u32 count) {
+  return _bzhi_u64(~u64{0}, std::min(count, 64u));
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX512 void gatherAVX512(u32* dest, const u32* dictionary, const INTEGER* codes, u32 n) {
+  u32 i = 0;
+  for (; i + 64 <= n; i += 64) {
+    // Load codes.
+    __m512i codes_0 = _mm512_loadu_si512(codes + i + 0);
+    __m512i codes_1 = _mm512_loadu_si512(codes + i + 16);
+    __m512i codes_2 = _mm512_loadu_si512(codes + i + 32);
+    __m512i codes_3 = _mm512_loadu_si512(codes + i + 48);
+
+    // Gather values.
+    __m512i values_0 = _mm512_i32gather_epi32(codes_0, dictionary, 4);
+    __m512i values_1 = _mm512_i32gather_epi32(codes_1, dictionary, 4);
+    __m512i values_2 = _mm512_i32gather_epi32(codes_2, dictionary, 4);
+    __m512i values_3 = _mm512_i32gather_epi32(codes_3, dictionary, 4);
+
+    // store values
+    _mm512_storeu_si512(dest + i + 0, values_0);
+    _mm512_storeu_si512(dest + i + 16, values_1);
+    _mm512_storeu_si512(dest + i + 32, values_2);
+    _mm512_storeu_si512(dest + i + 48, values_3);
+  }
+  // Masked loads, gathers and stores touch neither codes nor dest past n
+  for (; i < n; i += 16) {
+    const __mmask16 mask = lowMask(n - i);
+    __m512i codes_v = _mm512_maskz_loadu_epi32(mask, codes + i);
+    __m512i values_v =
+        _mm512_mask_i32gather_epi32(_mm512_setzero_si512(), mask, codes_v, dictionary, 4);
+    _mm512_mask_storeu_epi32(dest + i, mask, values_v);
+  }
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX512 void gatherAVX512(u64* dest, const u64* dictionary, const INTEGER* codes, u32 n) {
+  u32 i = 0;
+  for (; i + 32 <= n; i += 32) {
+    // Load codes
+    __m256i codes_0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i + 0));
+    __m256i codes_1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i + 8));
+    __m256i codes_2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i + 16));
+    __m256i codes_3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(codes + i + 24));
+
+    // gather values
+    __m512i values_0 = _mm512_i32gather_epi64(codes_0, dictionary, 8);
+    __m512i values_1 = _mm512_i32gather_epi64(codes_1, dictionary, 8);
+    __m512i values_2 = _mm512_i32gather_epi64(codes_2, dictionary, 8);
+    __m512i values_3 = _mm512_i32gather_epi64(codes_3, dictionary, 8);
+
+    // store values
+    _mm512_storeu_si512(dest + i + 0, values_0);
+    _mm512_storeu_si512(dest + i + 8, values_1);
+    _mm512_storeu_si512(dest + i + 16, values_2);
+    _mm512_storeu_si512(dest + i + 24, values_3);
+  }
+  for (; i < n; i += 8) {
+    const __mmask8 mask = lowMask(n - i);
+    __m256i codes_v = _mm256_maskz_loadu_epi32(mask, codes + i);
+    __m512i values_v =
+        _mm512_mask_i32gather_epi64(_mm512_setzero_si512(), mask, codes_v, dictionary, 8);
+    _mm512_mask_storeu_epi64(dest + i, mask, values_v);
+  }
+}
+// -------------------------------------------------------------------------------------
+// Full stores for the long runs, the rest of each run is one masked store. Unlike
+// AVX2, nothing is written past the end of the last run.
+template <typename T>
+BTR_TARGET_AVX512 void expandRunsAVX512(T* dest, const T* values, const INTEGER* counts, u32 runs) {
+  constexpr u32 per_store = sizeof(__m512i) / sizeof(T);
+  auto write_ptr = dest;
+  for (u32 run_i = 0; run_i < runs; run_i++) {
+    u32 count = counts[run_i];
+    __m512i vec;
+    if constexpr (sizeof(T) == 4) {
+      vec = _mm512_set1_epi32(values[run_i]);
+    } else {
+      vec = _mm512_set1_epi64(values[run_i]);
+    }
+    while (count > per_store) {
+      _mm512_storeu_si512(write_ptr, vec);
+      write_ptr += per_store;
+      count -= per_store;
+    }
+    if constexpr (sizeof(T) == 4) {
+      _mm512_mask_storeu_epi32(write_ptr, lowMask(count), vec);
+    } else {
+      _mm512_mask_storeu_epi64(write_ptr, lowMask(count), vec);
+    }
+    write_ptr += count;
+  }
+}
+// -------------------------------------------------------------------------------------
+template <typename T>
+BTR_TARGET_AVX512 void expandRunsNarrowAVX512(T* dest,
+                                              const INTEGER* values,
+                                              const INTEGER* counts,
+                                              u32 runs) {
+  constexpr u32 per_store = sizeof(__m512i) / sizeof(T);
+  auto write_ptr = dest;
+  for (u32 run_i = 0; run_i < runs; run_i++) {
+    u32 count = counts[run_i];
+    __m512i vec;
+    if constexpr (sizeof(T) == 2) {
+      vec = _mm512_set1_epi16(static_cast<T>(values[run_i]));
+    } else {
+      vec = _mm512_set1_epi8(static_cast<T>(values[run_i]));
+    }
+    while (count > per_store) {
+      _mm512_storeu_si512(write_ptr, vec);
+      write_ptr += per_store;
+      count -= per_store;
+    }
+    if constexpr (sizeof(T) == 2) {
+      _mm512_mask_storeu_epi16(write_ptr, static_cast<__mmask32>(lowMask(count)), vec);
+    } else {
+      _mm512_mask_storeu_epi8(write_ptr, lowMask(count), vec);
+    }
+    write_ptr += count;
+  }
+}
+// -------------------------------------------------------------------------------------
+// vpcompress: 16 (8) rows at a time, the set bytes of the nullmap select the values
+BTR_TARGET_AVX512 u32 selectSetAVX512(u32* dest, const u32* src, const BITMAP* nullmap, u32 n) {
+  u32 set_count = 0;
+  for (u32 i = 0; i < n; i += 16) {
+    const __mmask16 rows = lowMask(n - i);
+    __m128i bytes = _mm_maskz_loadu_epi8(rows, nullmap + i);
+    const __mmask16 mask = _mm_test_epi8_mask(bytes, bytes);
+    __m512i values = _mm512_maskz_loadu_epi32(rows, src + i);
+    _mm512_mask_compressstoreu_epi32(dest + set_count, mask, values);
+    set_count += _mm_popcnt_u32(mask);
+  }
+  return set_count;
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX512 u32 selectSetAVX512(u64* dest, const u64* src, const BITMAP* nullmap, u32 n) {
+  u32 set_count = 0;
+  for (u32 i = 0; i < n; i += 8) {
+    const __mmask8 rows = lowMask(n - i);
+    __m128i bytes = _mm_maskz_loadu_epi8(rows, nullmap + i);
+    const __mmask8 mask = _mm_test_epi8_mask(bytes, bytes);
+    __m512i values = _mm512_maskz_loadu_epi64(rows, src + i);
+    _mm512_mask_compressstoreu_epi64(dest + set_count, mask, values);
+    set_count += _mm_popcnt_u32(mask);
+  }
+  return set_count;
+}
+// -------------------------------------------------------------------------------------
+// vpexpand: the bits of a validity word spread the next values to their rows
+BTR_TARGET_AVX512 void expandSetAVX512(u32* dest, const u32* values, const VALIDITY* validity,
+                                       u32 n) {
+  for (u32 i = 0; i < n; i += 16) {
+    const __mmask16 mask = (validity[i / 64] >> (i % 64)) & lowMask(n - i);
+    __m512i expanded = _mm512_maskz_expandloadu_epi32(mask, values);
+    _mm512_mask_storeu_epi32(dest + i, lowMask(n - i), expanded);
+    values += _mm_popcnt_u32(mask);
+  }
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX512 void expandSetAVX512(u64* dest, const u64* values, const VALIDITY* validity,
+                                       u32 n) {
+  for (u32 i = 0; i < n; i += 8) {
+    const __mmask8 mask = (validity[i / 64] >> (i % 64)) & lowMask(n - i);
+    __m512i expanded = _mm512_maskz_expandloadu_epi64(mask, values);
+    _mm512_mask_storeu_epi64(dest + i, lowMask(n - i), expanded);
+    values += _mm_popcnt_u32(mask);
+  }
+}
+#endif  // BTR_USE_DISPATCH
+// -------------------------------------------------------------------------------------
+// Gather dispatch
+// -------------------------------------------------------------------------------------
+template <typename T>
+using GatherFunction = void (*)(T*, const T*, const INTEGER*, u32);
+// -------------------------------------------------------------------------------------
+template <typename T>
+GatherFunction<T> gatherFunction() {
+#ifdef BTR_USE_DISPATCH
+  if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+    return gatherAVX512;
+  }
+#endif
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return gatherAVX2;
+  }
+#endif
+  return gatherScalar<T>;
+}
+// -------------------------------------------------------------------------------------
+// Random lookups into a dictionary that does not fit into L2 stall on the
+// misses. Gather in batches and keep the entries of the next prefetch_distance
+// codes prefetched, the hardware gathers alone do not have enough loads in flight.
+constexpr u32 prefetch_batch = 32;
+constexpr u32 prefetch_distance = 64;
+// -------------------------------------------------------------------------------------
+template <typename T>
+void gatherWith(GatherFunction<T> gather,
+                T* dest,
+                const T* dictionary,
+                u32 dictionary_count,
+                const INTEGER* codes,
+                u32 tuple_count) {
+  if (static_cast<u64>(dictionary_count) * sizeof(T) <= Kernels::largeDictionaryBytes()) {
+    return gather(dest, dictionary, codes, tuple_count);
+  }
+  u32 prefetch_i = 0;
+  for (u32 i = 0; i < tuple_count; i += prefetch_batch) {
+    const u32 prefetch_end = std::min(i + prefetch_batch + prefetch_distance, tuple_count);
+    for (; prefetch_i < prefetch_end; prefetch_i++) {
+      __builtin_prefetch(dictionary + codes[prefetch_i]);
+    }
+    gather(dest + i, dictionary, codes + i, std::min(prefetch_batch, tuple_count - i));
+  }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+u32 Kernels::largeDictionaryBytes() {
+  return CpuDispatch::l2CacheBytes();
+}
+// -------------------------------------------------------------------------------------
+void Kernels::gather32(u32* dest,
+                       const u32* dictionary,
+                       u32 dictionary_count,
+                       const INTEGER* codes,
+                       u32 tuple_count) {
+  gatherWith(gatherFunction<u32>(), dest, dictionary, dictionary_count, codes, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void Kernels::gather64(u64* dest,
+                       const u64* dictionary,
+                       u32 dictionary_count,
+                       const INTEGER* codes,
+                       u32 tuple_count) {
+  gatherWith(gatherFunction<u64>(), dest, dictionary, dictionary_count, codes, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void Kernels::expandRuns32(u32* dest, const u32* values, const INTEGER* counts, u32 runs_count) {
+#ifdef BTR_USE_DISPATCH
+  if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+    return expandRunsAVX512(dest, values, counts, runs_count);
+  }
+#endif
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return expandRunsAVX2(dest, values, counts, runs_count);
+  }
+#endif
+  expandRunsScalar(dest, values, counts, runs_count);
+}
+// -------------------------------------------------------------------------------------
+void Kernels::expandRuns64(u64* dest, const u64* values, const INTEGER* counts, u32 runs_count) {
+#ifdef BTR_USE_DISPATCH
+  if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+    return expandRunsAVX512(dest, values, counts, runs_count);
+  }
+#endif
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return expandRunsAVX2(dest, values, counts, runs_count);
+  }
+#endif
+  expandRunsScalar(dest, values, counts, runs_count);
+}
+// -------------------------------------------------------------------------------------
+void Kernels::expandRuns16(u16* dest, const INTEGER* values, const INTEGER* counts, u32 runs_count) {
+#ifdef BTR_USE_DISPATCH
+  if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+    return expandRunsNarrowAVX512(dest, values, counts, runs_count);
+  }
+#endif
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return expandRunsNarrowAVX2(dest, values, counts, runs_count);
+  }
+#endif
+  expandRunsScalar(dest, values, counts, runs_count);
+}
+// -------------------------------------------------------------------------------------
+void Kernels::expandRuns8(u8* dest, const INTEGER* values, const INTEGER* counts, u32 runs_count) {
+#ifdef BTR_USE_DISPATCH
+  if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+    return expandRunsNarrowAVX512(dest, values, counts, runs_count);
+  }
+#endif
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return expandRunsNarrowAVX2(dest, values, counts, runs_count);
+  }
+#endif
+  expandRunsScalar(dest, values, counts, runs_count);
+}
+// -------------------------------------------------------------------------------------
+u32 Kernels::selectSet32(u32* dest, const u32* src, const BITMAP* nullmap, u32 tuple_count) {
+#ifdef BTR_USE_DISPATCH
+  if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+    return selectSetAVX512(dest, src, nullmap, tuple_count);
+  }
+#endif
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return selectSetAVX2(dest, src, nullmap, tuple_count);
+  }
+#endif
+  return selectSetScalar(dest, src, nullmap, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+u32 Kernels::selectSet64(u64* dest, const u64* src, const BITMAP* nullmap, u32 tuple_count) {
+#ifdef BTR_USE_DISPATCH
+  if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+    return selectSetAVX512(dest, src, nullmap, tuple_count);
+  }
+#endif
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return selectSetAVX2(dest, src, nullmap, tuple_count);
+  }
+#endif
+  return selectSetScalar(dest, src, nullmap, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void Kernels::expandSet32(u32* dest,
+                           const u32* values,
+                           const VALIDITY* validity,
+                           u32 tuple_count) {
+#ifdef BTR_USE_DISPATCH
+  if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+    return expandSetAVX512(dest, values, validity, tuple_count);
+  }
+#endif
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return expandSetAVX2(dest, values, validity, tuple_count);
+  }
+#endif
+  expandSetScalar(dest, values, validity, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void Kernels::expandSet64(u64* dest,
+                           const u64* values,
+                           const VALIDITY* validity,
+                           u32 tuple_count) {
+#ifdef BTR_USE_DISPATCH
+  if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+    return expandSetAVX512(dest, values, validity, tuple_count);
+  }
+#endif
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return expandSetAVX2(dest, values, validity, tuple_count);
+  }
+#endif
+  expandSetScalar(dest, values, validity, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+u32 Kernels::alpEncode(INTEGER* digits,
+                       INTEGER* exceptions,
+                       const DOUBLE* src,
+                       u32 tuple_count,
+                       DOUBLE exponent_power,
+                       DOUBLE factor_fraction,
+                       DOUBLE factor_power) {
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return alpEncodeAVX2(digits, exceptions, src, tuple_count, exponent_power, factor_fraction,
+                         factor_power);
+  }
+#endif
+  return alpEncodeScalar(digits, exceptions, src, tuple_count, exponent_power, factor_fraction,
+                         factor_power);
+}
+// -------------------------------------------------------------------------------------
+u32 Kernels::alpEncode(INTEGER* digits,
+                       INTEGER* exceptions,
+                       const FLOAT* src,
+                       u32 tuple_count,
+                       FLOAT exponent_power,
+                       FLOAT factor_fraction,
+                       FLOAT factor_power) {
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return alpEncodeAVX2(digits, exceptions, src, tuple_count, exponent_power, factor_fraction,
+                         factor_power);
+  }
+#endif
+  return alpEncodeScalar(digits, exceptions, src, tuple_count, exponent_power, factor_fraction,
+                         factor_power);
+}
+// -------------------------------------------------------------------------------------
+void Kernels::alpDecode(DOUBLE* dest,
+                        const INTEGER* digits,
+                        u32 tuple_count,
+                        DOUBLE factor_power,
+                        DOUBLE exponent_power) {
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return alpDecodeAVX2(dest, digits, tuple_count, factor_power, exponent_power);
+  }
+#endif
+  alpDecodeScalar(dest, digits, tuple_count, factor_power, exponent_power);
+}
+// -------------------------------------------------------------------------------------
+void Kernels::alpDecode(FLOAT* dest,
+                        const INTEGER* digits,
+                        u32 tuple_count,
+                        FLOAT factor_power,
+                        FLOAT exponent_power) {
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return alpDecodeAVX2(dest, digits, tuple_count, factor_power, exponent_power);
+  }
+#endif
+  alpDecodeScalar(dest, digits, tuple_count, factor_power, exponent_power);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,141 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Decode loops shared by the schemes of all number types. Each one exists per
+// SimdLevel and dispatches on CpuDispatch::level(), values are handled as
+// 32- or 64-bit words. The ALP kernels do floating-point arithmetic instead.
+// -------------------------------------------------------------------------------------
+class Kernels {
+ public:
+  // dest[i] = dictionary[codes[i]]. Dictionaries beyond the L2 cache are
+  // looked up with software prefetching.
+  template <typename T>
+  static inline void gather(T* dest,
+                            const T* dictionary,
+                            u32 dictionary_count,
+                            const INTEGER* codes,
+                            u32 tuple_count) {
+    if constexpr (sizeof(T) == 4) {
+      gather32(reinterpret_cast<u32*>(dest), reinterpret_cast<const u32*>(dictionary),
+               dictionary_count, codes, tuple_count);
+    } else {
+      static_assert(sizeof(T) == 8);
+      gather64(reinterpret_cast<u64*>(dest), reinterpret_cast<const u64*>(dictionary),
+               dictionary_count, codes, tuple_count);
+    }
+  }
+  // Lookups into dictionaries of more than this many bytes miss the cache
+  static u32 largeDictionaryBytes();
+  // counts[i] times values[i], for all runs. May write up to SIMD_EXTRA_BYTES
+  // past the end of the last run (AVX2 only, the AVX-512 stores are masked).
+  template <typename T>
+  static inline void expandRuns(T* dest, const T* values, const INTEGER* counts, u32 runs_count) {
+    if constexpr (sizeof(T) == 4) {
+      expandRuns32(reinterpret_cast<u32*>(dest), reinterpret_cast<const u32*>(values), counts,
+                   runs_count);
+    } else {
+      static_assert(sizeof(T) == 8);
+      expandRuns64(reinterpret_cast<u64*>(dest), reinterpret_cast<const u64*>(values), counts,
+                   runs_count);
+    }
+  }
+  // expandRuns of INTEGER runs into SMALLINT/TINYINT columns. Unlike the wide
+  // variant, no level writes past the end of the last run.
+  template <typename NarrowType>
+  static inline void expandRunsNarrow(NarrowType* dest,
+                                      const INTEGER* values,
+                                      const INTEGER* counts,
+                                      u32 runs_count) {
+    if constexpr (sizeof(NarrowType) == 2) {
+      expandRuns16(reinterpret_cast<u16*>(dest), values, counts, runs_count);
+    } else {
+      static_assert(sizeof(NarrowType) == 1);
+      expandRuns8(reinterpret_cast<u8*>(dest), values, counts, runs_count);
+    }
+  }
+  // Copies the values of the rows set in nullmap to the front of dest, returns
+  // their count
+  template <typename T>
+  static inline u32 selectSet(T* dest, const T* src, const BITMAP* nullmap, u32 tuple_count) {
+    if constexpr (sizeof(T) == 4) {
+      return selectSet32(reinterpret_cast<u32*>(dest), reinterpret_cast<const u32*>(src), nullmap,
+                         tuple_count);
+    } else {
+      static_assert(sizeof(T) == 8);
+      return selectSet64(reinterpret_cast<u64*>(dest), reinterpret_cast<const u64*>(src), nullmap,
+                         tuple_count);
+    }
+  }
+  // Inverse of selectSet: the set rows of validity get the next value, the
+  // others 0. Writes exactly tuple_count values, the bits of validity past
+  // tuple_count are ignored and need not be zero.
+  template <typename T>
+  static inline void expandSet(T* dest,
+                               const T* values,
+                               const VALIDITY* validity,
+                               u32 tuple_count) {
+    if constexpr (sizeof(T) == 4) {
+      expandSet32(reinterpret_cast<u32*>(dest), reinterpret_cast<const u32*>(values), validity,
+                  tuple_count);
+    } else {
+      static_assert(sizeof(T) == 8);
+      expandSet64(reinterpret_cast<u64*>(dest), reinterpret_cast<const u64*>(values), validity,
+                  tuple_count);
+    }
+  }
+  // ALP (templated/Alp.hpp): digits[i] = round(src[i] * exponent_power *
+  // factor_fraction), INTEGER min if that is out of range. The rows whose digits
+  // do not decode to the same bits are appended to exceptions, which needs room
+  // for tuple_count rows. Returns the number of exceptions.
+  static u32 alpEncode(INTEGER* digits,
+                       INTEGER* exceptions,
+                       const DOUBLE* src,
+                       u32 tuple_count,
+                       DOUBLE exponent_power,
+                       DOUBLE factor_fraction,
+                       DOUBLE factor_power);
+  static u32 alpEncode(INTEGER* digits,
+                       INTEGER* exceptions,
+                       const FLOAT* src,
+                       u32 tuple_count,
+                       FLOAT exponent_power,
+                       FLOAT factor_fraction,
+                       FLOAT factor_power);
+  // dest[i] = digits[i] * factor_power / exponent_power
+  static void alpDecode(DOUBLE* dest,
+                        const INTEGER* digits,
+                        u32 tuple_count,
+                        DOUBLE factor_power,
+                        DOUBLE exponent_power);
+  static void alpDecode(FLOAT* dest,
+                        const INTEGER* digits,
+                        u32 tuple_count,
+                        FLOAT factor_power,
+                        FLOAT exponent_power);
+
+ private:
+  static void gather32(u32* dest,
+                       const u32* dictionary,
+                       u32 dictionary_count,
+                       const INTEGER* codes,
+                       u32 tuple_count);
+  static void gather64(u64* dest,
+                       const u64* dictionary,
+                       u32 dictionary_count,
+                       const INTEGER* codes,
+                       u32 tuple_count);
+  static void expandRuns32(u32* dest, const u32* values, const INTEGER* counts, u32 runs_count);
+  static void expandRuns64(u64* dest, const u64* values, const INTEGER* counts, u32 runs_count);
+  static void expandRuns16(u16* dest, const INTEGER* values, const INTEGER* counts, u32 runs_count);
+  static void expandRuns8(u8* dest, const INTEGER* values, const INTEGER* counts, u32 runs_count);
+  static u32 selectSet32(u32* dest, const u32* src, const BITMAP* nullmap, u32 tuple_count);
+  static u32 selectSet64(u64* dest, const u64* src, const BITMAP* nullmap, u32 tuple_count);
+  static void expandSet32(u32* dest, const u32* values, const VALIDITY* validity, u32 tuple_count);
+  static void expandSet64(u64* dest, const u64* values, const VALIDITY* validity, u32 tuple_count);
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
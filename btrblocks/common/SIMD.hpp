@@ -16,13 +16,28 @@
 
 #if (defined(__x86_64__) || defined(__i386__))
 #include <immintrin.h>
+#if defined(__x86_64__) && defined(__GNUC__)
+// Hot kernels are compiled for every SIMD level and pick one at runtime, see
+// common/CpuDispatch.hpp. The AVX-512 kernels need 64-bit intrinsics and the
+// target attribute of GCC/Clang.
+#define BTR_USE_DISPATCH 1
+#endif
 #elif defined(__aarch64__)
 #include <simde/x86/avx512.h>
 #endif
 
+#if defined(BTR_FLAG_PORTABLE) and BTR_FLAG_PORTABLE and (defined(__x86_64__) || defined(__i386__))
+// Portable x86 builds only target the baseline instruction set: everything but
+// the dispatched kernels takes the scalar paths. simde runs the AVX2 paths on
+// NEON, which every aarch64 CPU has, so they stay enabled there.
+#undef BTR_USE_SIMD
+#define BTR_IFSIMD(x...)
+#define BTR_IFELSESIMD(a, b) b
+#else
 #define BTR_IFSIMD(x...) x
 #define BTR_IFELSESIMD(a, b) a
 #define BTR_USE_SIMD 1
+#endif
 
 // SIMD instruction can become faster when they are allowed to make writes out
 // of bounds. This spares us any out of bound checks and therefore many
@@ -0,0 +1,161 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include <cctype>
+#include <cstdio>
+#include <string>
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Conversion between the textual and the stored form of DATE and TIMESTAMP.
+// Dates are "YYYY-MM-DD", timestamps "YYYY-MM-DD[ T]hh:mm:ss[.ffffff]" in UTC.
+class Temporal {
+ public:
+  static constexpr s64 MICROS_PER_SECOND = 1000000;
+  static constexpr s64 MICROS_PER_DAY = 86400 * MICROS_PER_SECOND;
+  // -------------------------------------------------------------------------------------
+  // Days since 1970-01-01 in the proleptic Gregorian calendar (H. Hinnant's
+  // days_from_civil)
+  static constexpr DATE daysFromCivil(s32 year, u32 month, u32 day) {
+    year -= month <= 2;
+    const s32 era = (year >= 0 ? year : year - 399) / 400;
+    const u32 year_of_era = static_cast<u32>(year - era * 400);
+    const u32 day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const u32 day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + static_cast<s32>(day_of_era) - 719468;
+  }
+  // -------------------------------------------------------------------------------------
+  static constexpr bool isLeapYear(s32 year) {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+  }
+  static constexpr u32 daysInMonth(s32 year, u32 month) {
+    constexpr u32 days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+  }
+  // -------------------------------------------------------------------------------------
+  static constexpr void civilFromDays(DATE days, s32& year, u32& month, u32& day) {
+    days += 719468;
+    const s32 era = (days >= 0 ? days : days - 146096) / 146097;
+    const u32 day_of_era = static_cast<u32>(days - era * 146097);
+    const u32 year_of_era =
+        (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const u32 day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    const u32 mp = (5 * day_of_year + 2) / 153;
+    day = day_of_year - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<s32>(year_of_era) + era * 400 + (month <= 2);
+  }
+  // -------------------------------------------------------------------------------------
+  static DATE parseDate(const string& str) {
+    s32 year;
+    u32 month, day;
+    size_t consumed = parseDatePart(str, year, month, day);
+    if (consumed != str.size()) {
+      throw Generic_Exception("Invalid date: " + str);
+    }
+    return daysFromCivil(year, month, day);
+  }
+  // -------------------------------------------------------------------------------------
+  static TIMESTAMP parseTimestamp(const string& str) {
+    s32 year;
+    u32 month, day;
+    size_t pos = parseDatePart(str, year, month, day);
+    s64 micros = 0;
+    if (pos < str.size()) {
+      u32 hour, minute, second;
+      if ((str[pos] != ' ' && str[pos] != 'T') || !parseDigits(str, ++pos, 2, 2, hour) ||
+          !parseSeparator(str, pos, ':') || !parseDigits(str, pos, 2, 2, minute) ||
+          !parseSeparator(str, pos, ':') || !parseDigits(str, pos, 2, 2, second) || hour > 23 ||
+          minute > 59 || second > 60) {
+        throw Generic_Exception("Invalid timestamp: " + str);
+      }
+      micros = (hour * 3600 + minute * 60 + second) * MICROS_PER_SECOND;
+      // Fractional seconds, everything below microseconds is cut off
+      if (pos < str.size() && str[pos] == '.') {
+        const size_t digits_begin = ++pos;
+        s64 scale = MICROS_PER_SECOND / 10;
+        for (; pos < str.size() && std::isdigit(static_cast<unsigned char>(str[pos])); pos++) {
+          micros += (str[pos] - '0') * scale;
+          scale /= 10;
+        }
+        if (pos == digits_begin) {
+          throw Generic_Exception("Invalid timestamp: " + str);
+        }
+      }
+      if (pos != str.size()) {
+        throw Generic_Exception("Invalid timestamp: " + str);
+      }
+    }
+    return daysFromCivil(year, month, day) * MICROS_PER_DAY + micros;
+  }
+  // -------------------------------------------------------------------------------------
+  static string formatDate(DATE days) {
+    s32 year;
+    u32 month, day;
+    civilFromDays(days, year, month, day);
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), "%04d-%02u-%02u", year, month, day);
+    return buffer;
+  }
+  // -------------------------------------------------------------------------------------
+  static string formatTimestamp(TIMESTAMP timestamp) {
+    // Floor division, timestamps before 1970 are negative
+    s64 days = timestamp / MICROS_PER_DAY;
+    s64 micros = timestamp % MICROS_PER_DAY;
+    if (micros < 0) {
+      days--;
+      micros += MICROS_PER_DAY;
+    }
+    const s64 seconds = micros / MICROS_PER_SECOND;
+    char buffer[32];
+    std::snprintf(buffer, sizeof(buffer), " %02lld:%02lld:%02lld.%06lld",
+                  static_cast<long long>(seconds / 3600),
+                  static_cast<long long>(seconds / 60 % 60), static_cast<long long>(seconds % 60),
+                  static_cast<long long>(micros % MICROS_PER_SECOND));
+    return formatDate(static_cast<DATE>(days)) + buffer;
+  }
+
+ private:
+  // Reads min_digits to max_digits decimal digits at pos and moves pos behind them
+  static bool parseDigits(const string& str,
+                          size_t& pos,
+                          u32 min_digits,
+                          u32 max_digits,
+                          u32& value) {
+    const size_t begin = pos;
+    value = 0;
+    while (pos < str.size() && pos - begin < max_digits &&
+           std::isdigit(static_cast<unsigned char>(str[pos]))) {
+      value = value * 10 + (str[pos++] - '0');
+    }
+    return pos - begin >= min_digits;
+  }
+  static bool parseSeparator(const string& str, size_t& pos, char separator) {
+    if (pos < str.size() && str[pos] == separator) {
+      pos++;
+      return true;
+    }
+    return false;
+  }
+  // Parses [-]Y-M-D with up to 6 year and 2 month and day digits, returns the
+  // number of characters consumed
+  static size_t parseDatePart(const string& str, s32& year, u32& month, u32& day) {
+    size_t pos = 0;
+    const bool negative = parseSeparator(str, pos, '-');
+    u32 year_digits;
+    if (!parseDigits(str, pos, 1, 6, year_digits) || !parseSeparator(str, pos, '-') ||
+        !parseDigits(str, pos, 1, 2, month) || !parseSeparator(str, pos, '-') ||
+        !parseDigits(str, pos, 1, 2, day)) {
+      throw Generic_Exception("Invalid date: " + str);
+    }
+    year = negative ? -static_cast<s32>(year_digits) : static_cast<s32>(year_digits);
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+      throw Generic_Exception("Invalid date: " + str);
+    }
+    return pos;
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
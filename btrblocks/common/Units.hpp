@@ -49,10 +49,13 @@ enum class ColumnType : u8 {
   DOUBLE = 1,
   STRING = 2,
   SKIP,  // SKIP THIS COLUMN
-  // The next types are out of scope
   FLOAT,
   BIGINT,
   SMALLINT,
+  TINYINT,
+  TIMESTAMP,
+  DATE,
+  DECIMAL,
   UNDEFINED
 };
 using TINYINT = s8;
@@ -60,9 +63,15 @@ using SMALLINT = s16;
 using INTEGER = s32;  // we use FOR always at the beginning so negative integers
                       // will be handled out
 using UINTEGER = u32;
+using BIGINT = s64;
+using FLOAT = float;
 using DOUBLE = double;
+using TIMESTAMP = s64;  // microseconds since 1970-01-01 00:00:00 UTC, see common/Temporal.hpp
+using DATE = s32;       // days since 1970-01-01
+using DECIMAL = s64;    // scaled by 10^scale, see common/Decimal.hpp
 using STRING = string;
 using BITMAP = u8;
+using VALIDITY = u64;  // bit-packed BITMAP of 64 tuples, see bitmap::PackedBitmap
 // -------------------------------------------------------------------------------------
 using str = std::string_view;
 // -------------------------------------------------------------------------------------
@@ -73,6 +82,20 @@ inline ColumnType ConvertStringToType(const string& type_str) {
     return ColumnType::DOUBLE;
   } else if (type_str == "string") {
     return ColumnType::STRING;
+  } else if (type_str == "float") {
+    return ColumnType::FLOAT;
+  } else if (type_str == "bigint") {
+    return ColumnType::BIGINT;
+  } else if (type_str == "smallint") {
+    return ColumnType::SMALLINT;
+  } else if (type_str == "tinyint") {
+    return ColumnType::TINYINT;
+  } else if (type_str == "timestamp") {
+    return ColumnType::TIMESTAMP;
+  } else if (type_str == "date") {
+    return ColumnType::DATE;
+  } else if (type_str == "decimal") {
+    return ColumnType::DECIMAL;
   } else {
     return ColumnType::SKIP;
   }
@@ -85,6 +108,20 @@ inline string ConvertTypeToString(const ColumnType type_str) {
     return "double";
   } else if (type_str == ColumnType::STRING) {
     return "string";
+  } else if (type_str == ColumnType::FLOAT) {
+    return "float";
+  } else if (type_str == ColumnType::BIGINT) {
+    return "bigint";
+  } else if (type_str == ColumnType::SMALLINT) {
+    return "smallint";
+  } else if (type_str == ColumnType::TINYINT) {
+    return "tinyint";
+  } else if (type_str == ColumnType::TIMESTAMP) {
+    return "timestamp";
+  } else if (type_str == ColumnType::DATE) {
+    return "date";
+  } else if (type_str == ColumnType::DECIMAL) {
+    return "decimal";
   } else {
     UNREACHABLE();
     return "";
@@ -117,6 +117,48 @@ class Utils {
 #endif
   }
 
+  // Truncates 32-bit integers to SMALLINT/TINYINT. Truncation instead of
+  // saturation keeps wrapping arithmetic (e.g. FOR bias) exact in the narrow type.
+  static void narrowIntegers(SMALLINT* dest, const INTEGER* src, u32 n) {
+    u32 i = 0;
+#ifdef BTR_USE_SIMD
+    const __m256i mask = _mm256_set1_epi32(0xFFFF);
+    for (; i + 16 <= n; i += 16) {
+      __m256i a = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)), mask);
+      __m256i b =
+          _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 8)), mask);
+      // packus works per 128-bit lane, restore the order of the 64-bit blocks
+      __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), packed);
+    }
+#endif
+    for (; i < n; i++) {
+      dest[i] = static_cast<SMALLINT>(src[i]);
+    }
+  }
+
+  static void narrowIntegers(TINYINT* dest, const INTEGER* src, u32 n) {
+    u32 i = 0;
+#ifdef BTR_USE_SIMD
+    const __m256i mask = _mm256_set1_epi32(0xFF);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    for (; i + 32 <= n; i += 32) {
+      auto in = reinterpret_cast<const __m256i*>(src + i);
+      __m256i a = _mm256_and_si256(_mm256_loadu_si256(in + 0), mask);
+      __m256i b = _mm256_and_si256(_mm256_loadu_si256(in + 1), mask);
+      __m256i c = _mm256_and_si256(_mm256_loadu_si256(in + 2), mask);
+      __m256i d = _mm256_and_si256(_mm256_loadu_si256(in + 3), mask);
+      __m256i packed =
+          _mm256_packus_epi16(_mm256_packus_epi32(a, b), _mm256_packus_epi32(c, d));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                          _mm256_permutevar8x32_epi32(packed, order));
+    }
+#endif
+    for (; i < n; i++) {
+      dest[i] = static_cast<TINYINT>(src[i]);
+    }
+  }
+
   static void readFileToMemory(const std::string& path, std::vector<char>& target) {
     std::ifstream file(path, std::ios::binary | std::ios::ate);
     if (!file.good()) {
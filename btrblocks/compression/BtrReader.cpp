@@ -3,12 +3,84 @@
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <cassert>
+#include "common/Decimal.hpp"
 #include "common/Exceptions.hpp"
 #include "compression/SchemePicker.hpp"
 #include "extern/RoaringBitmap.hpp"
+#include "scheme/bigint/DynamicDictionary.hpp"
+#include "scheme/bigint/RLE.hpp"
+#include "scheme/double/DynamicDictionary.hpp"
+#include "scheme/double/RLE.hpp"
+#include "scheme/float/DynamicDictionary.hpp"
+#include "scheme/float/RLE.hpp"
+#include "scheme/integer/DynamicDictionary.hpp"
+#include "scheme/integer/RLE.hpp"
+#include "scheme/string/DynamicDictionary.hpp"
+#include "scheme/string/FrontCodedDictionary.hpp"
+#include "storage/StringPointerArrayViewer.hpp"
 
 namespace btrblocks {
 
+namespace {
+template <typename T, typename DictionaryScheme>
+void readDictionary(EncodedColumn& output,
+                    DictionaryScheme& scheme,
+                    BitmapWrapper* bitmap,
+                    const u8* src,
+                    u32 tuple_count,
+                    const PartData& part) {
+  output.encoding = ColumnEncoding::DICTIONARY;
+  output.global_codes = scheme.usesGlobalDictionary(src);
+  output.value_count = scheme.getDictionarySize(src, part);
+  auto dictionary = reinterpret_cast<T*>(
+      get_data(output.values, output.value_count * sizeof(T) + SIMD_EXTRA_BYTES));
+  auto codes = get_data(output.codes, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+  scheme.decompressCodes(dictionary, codes, bitmap, src, tuple_count, 0, part);
+}
+
+// The dictionary has already been decompressed into output.values
+template <typename DictionaryScheme>
+void readStringDictionary(EncodedColumn& output,
+                          DictionaryScheme& scheme,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 dictionary_size) {
+  output.encoding = ColumnEncoding::DICTIONARY;
+  output.requires_copy = true;
+  output.value_count = dictionary_size;
+  auto codes = get_data(output.codes, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+  scheme.decompressCodes(codes, src, tuple_count, 0);
+}
+
+template <typename T, typename RLEScheme>
+void readRuns(EncodedColumn& output,
+              RLEScheme& scheme,
+              BitmapWrapper* bitmap,
+              const u8* src,
+              u32 tuple_count) {
+  output.encoding = ColumnEncoding::RUNS;
+  output.value_count = scheme.getRunsCount(src);
+  auto values = reinterpret_cast<T*>(
+      get_data(output.values, output.value_count * sizeof(T) + SIMD_EXTRA_BYTES));
+  auto run_lengths =
+      get_data(output.run_lengths, output.value_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+  scheme.decompressRuns(values, run_lengths, bitmap, src, tuple_count, 0);
+}
+
+template <typename T, typename RLEScheme>
+void readRuns(RunEncodedColumn<T>& output,
+              RLEScheme& scheme,
+              BitmapWrapper* bitmap,
+              const u8* src,
+              u32 tuple_count) {
+  output.tuple_count = tuple_count;
+  output.runs_count = scheme.getRunsCount(src);
+  auto values = get_data(output.values, output.runs_count + SIMD_EXTRA_ELEMENTS(T));
+  auto run_lengths = get_data(output.run_lengths, output.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+  scheme.decompressRuns(values, run_lengths, bitmap, src, tuple_count, 0);
+}
+}  // namespace
+
 BtrReader::BtrReader(void* data) : data(data) {
   this->m_bitmap_wrappers = std::vector<BitmapWrapper*>(this->getChunkCount(), nullptr);
   this->m_bitsets = std::vector<boost::dynamic_bitset<>*>(this->getChunkCount(), nullptr);
@@ -33,11 +105,12 @@ bool BtrReader::readColumn(std::vector<u8>& output_chunk_v, u32 index) {
   auto meta = this->getChunkMetadata(index);
 
   // Get a pointer to the beginning of the memory area with the data
-  auto input_data = static_cast<const u8*>(meta->data);
+  auto input_data = meta->columnData();
 
   // Decompress bitmap
   u32 tuple_count = meta->tuple_count;
   BitmapWrapper* bitmap = this->getBitmap(index);
+  auto part = this->getPart();
 
   auto output_chunk = get_data(output_chunk_v, this->getDecompressedSize(index) + SIMD_EXTRA_BYTES);
   bool requires_copy = false;
@@ -49,7 +122,7 @@ bool BtrReader::readColumn(std::vector<u8>& output_chunk_v, u32 index) {
 
       // Fetch the scheme from metadata
       auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
-      scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0);
+      scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0, part);
       break;
     }
     case ColumnType::DOUBLE: {
@@ -57,12 +130,69 @@ bool BtrReader::readColumn(std::vector<u8>& output_chunk_v, u32 index) {
       auto destination_array = reinterpret_cast<DOUBLE*>(output_chunk);
 
       auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
-      scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0);
+      scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    case ColumnType::BIGINT: {
+      // Prepare destination array
+      auto destination_array = reinterpret_cast<BIGINT*>(output_chunk);
+
+      auto& scheme = Integer64SchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    case ColumnType::TIMESTAMP: {
+      // Prepare destination array
+      auto destination_array = reinterpret_cast<TIMESTAMP*>(output_chunk);
+
+      auto& scheme = Integer64SchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    case ColumnType::DECIMAL: {
+      // Prepare destination array, scaled integers
+      auto destination_array = reinterpret_cast<DECIMAL*>(output_chunk);
+
+      auto& scheme = Integer64SchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    case ColumnType::DATE: {
+      // Prepare destination array
+      auto destination_array = reinterpret_cast<DATE*>(output_chunk);
+
+      auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    case ColumnType::SMALLINT: {
+      // Prepare destination array
+      auto destination_array = reinterpret_cast<SMALLINT*>(output_chunk);
+
+      auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompressNarrow(destination_array, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    case ColumnType::TINYINT: {
+      // Prepare destination array
+      auto destination_array = reinterpret_cast<TINYINT*>(output_chunk);
+
+      auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompressNarrow(destination_array, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    case ColumnType::FLOAT: {
+      // Prepare destination array
+      auto destination_array = reinterpret_cast<FLOAT*>(output_chunk);
+
+      auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.decompress(destination_array, bitmap, input_data, tuple_count, 0, part);
       break;
     }
     case ColumnType::STRING: {
       auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
-      requires_copy = scheme.decompressNoCopy(output_chunk, bitmap, input_data, tuple_count, 0);
+      requires_copy =
+          scheme.decompressNoCopy(output_chunk, bitmap, input_data, tuple_count, 0, part);
       break;
     }
     default: {
@@ -73,13 +203,309 @@ bool BtrReader::readColumn(std::vector<u8>& output_chunk_v, u32 index) {
   return requires_copy;
 }
 
+void BtrReader::hashColumn(std::vector<u64>& output_hashes_v, u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  auto input_data = meta->columnData();
+  u32 tuple_count = meta->tuple_count;
+  BitmapWrapper* bitmap = this->getBitmap(index);
+  auto part = this->getPart();
+
+  auto output_hashes = get_data(output_hashes_v, tuple_count + SIMD_EXTRA_ELEMENTS(u64));
+  switch (meta->type) {
+    case ColumnType::INTEGER:
+    case ColumnType::SMALLINT:
+    case ColumnType::TINYINT:
+    case ColumnType::DATE: {
+      auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.hash(output_hashes, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    case ColumnType::DOUBLE: {
+      auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.hash(output_hashes, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    case ColumnType::BIGINT:
+    case ColumnType::TIMESTAMP:
+    case ColumnType::DECIMAL: {
+      auto& scheme = Integer64SchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.hash(output_hashes, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    case ColumnType::FLOAT: {
+      auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.hash(output_hashes, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    case ColumnType::STRING: {
+      auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      scheme.hash(output_hashes, bitmap, input_data, tuple_count, 0, part);
+      break;
+    }
+    default: {
+      throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+    }
+  }
+}
+
+void BtrReader::readColumnEncoded(EncodedColumn& output, u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  auto input_data = meta->columnData();
+  u32 tuple_count = meta->tuple_count;
+  BitmapWrapper* bitmap = this->getBitmap(index);
+  auto part = this->getPart();
+
+  output.tuple_count = tuple_count;
+  output.requires_copy = false;
+  output.global_codes = false;
+  switch (meta->type) {
+    case ColumnType::INTEGER:
+    case ColumnType::DATE: {
+      auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      if (scheme.schemeType() == IntegerSchemeType::DICT) {
+        auto& dict = dynamic_cast<integers::DynamicDictionary&>(scheme);
+        readDictionary<INTEGER>(output, dict, bitmap, input_data, tuple_count, part);
+        return;
+      } else if (scheme.schemeType() == IntegerSchemeType::RLE) {
+        auto& rle = dynamic_cast<integers::RLE&>(scheme);
+        readRuns<INTEGER>(output, rle, bitmap, input_data, tuple_count);
+        return;
+      }
+      break;
+    }
+    case ColumnType::DOUBLE: {
+      auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      if (scheme.schemeType() == DoubleSchemeType::DICT) {
+        auto& dict = dynamic_cast<doubles::DynamicDictionary&>(scheme);
+        readDictionary<DOUBLE>(output, dict, bitmap, input_data, tuple_count, part);
+        return;
+      } else if (scheme.schemeType() == DoubleSchemeType::RLE) {
+        auto& rle = dynamic_cast<doubles::RLE&>(scheme);
+        readRuns<DOUBLE>(output, rle, bitmap, input_data, tuple_count);
+        return;
+      }
+      break;
+    }
+    case ColumnType::BIGINT:
+    case ColumnType::TIMESTAMP:
+    case ColumnType::DECIMAL: {
+      auto& scheme = Integer64SchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      if (scheme.schemeType() == Integer64SchemeType::DICT) {
+        auto& dict = dynamic_cast<bigints::DynamicDictionary&>(scheme);
+        readDictionary<BIGINT>(output, dict, bitmap, input_data, tuple_count, part);
+        return;
+      } else if (scheme.schemeType() == Integer64SchemeType::RLE) {
+        auto& rle = dynamic_cast<bigints::RLE&>(scheme);
+        readRuns<BIGINT>(output, rle, bitmap, input_data, tuple_count);
+        return;
+      }
+      break;
+    }
+    case ColumnType::SMALLINT:
+    case ColumnType::TINYINT: {
+      // Dictionaries and runs are stored as integers, hand out narrow plain values instead
+      break;
+    }
+    case ColumnType::FLOAT: {
+      auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      if (scheme.schemeType() == FloatSchemeType::DICT) {
+        auto& dict = dynamic_cast<floats::DynamicDictionary&>(scheme);
+        readDictionary<FLOAT>(output, dict, bitmap, input_data, tuple_count, part);
+        return;
+      } else if (scheme.schemeType() == FloatSchemeType::RLE) {
+        auto& rle = dynamic_cast<floats::RLE&>(scheme);
+        readRuns<FLOAT>(output, rle, bitmap, input_data, tuple_count);
+        return;
+      }
+      break;
+    }
+    case ColumnType::STRING: {
+      auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+      if (scheme.schemeType() == StringSchemeType::DICT) {
+        auto& dict = dynamic_cast<strings::DynamicDictionary&>(scheme);
+        u32 dictionary_size = dict.decompressDictionary(output.values, input_data, 0, part);
+        readStringDictionary(output, dict, input_data, tuple_count, dictionary_size);
+        output.global_codes = dict.usesGlobalDictionary(input_data);
+        return;
+      } else if (scheme.schemeType() == StringSchemeType::DICT_FRONT_CODED) {
+        auto& dict = dynamic_cast<strings::FrontCodedDictionary&>(scheme);
+        u32 dictionary_size = dict.decompressDictionary(output.values, input_data, 0);
+        readStringDictionary(output, dict, input_data, tuple_count, dictionary_size);
+        return;
+      }
+      break;
+    }
+    default: {
+      throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " not supported");
+    }
+  }
+
+  // No encoding we can hand out, fall back to plain values
+  output.encoding = ColumnEncoding::PLAIN;
+  output.value_count = tuple_count;
+  output.requires_copy = this->readColumn(output.values, index);
+}
+
+void BtrReader::readStrings(std::vector<std::string>& output,
+                            u32 index,
+                            const u32* rows,
+                            u32 count) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::STRING) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " is not string");
+  }
+  auto input_data = meta->columnData();
+  u32 tuple_count = meta->tuple_count;
+  output.resize(count);
+
+  auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  auto type = scheme.schemeType();
+  if (type == StringSchemeType::DICT || type == StringSchemeType::DICT_FRONT_CODED) {
+    if (this->m_entries_chunk != index) {
+      auto codes = get_data(this->m_entries_codes, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+      if (type == StringSchemeType::DICT) {
+        dynamic_cast<strings::DynamicDictionary&>(scheme).decompressCodes(codes, input_data,
+                                                                         tuple_count, 0);
+        this->m_entry_reader =
+            std::make_shared<strings::DictionaryEntryReader>(input_data, this->getPart());
+      } else {
+        dynamic_cast<strings::FrontCodedDictionary&>(scheme).decompressCodes(codes, input_data,
+                                                                            tuple_count, 0);
+        this->m_entry_reader.reset();
+      }
+      this->m_entries_chunk = index;
+    }
+    if (type == StringSchemeType::DICT) {
+      for (u32 i = 0; i < count; i++) {
+        output[i] = (*this->m_entry_reader)(this->m_entries_codes[rows[i]]);
+      }
+    } else {
+      // Front coding decodes single entries from the closest restart point
+      u8 buffer[MAX_STR_LENGTH];
+      for (u32 i = 0; i < count; i++) {
+        u32 length =
+            strings::FrontCodedDictionary::lookup(input_data, this->m_entries_codes[rows[i]], buffer);
+        output[i].assign(reinterpret_cast<const char*>(buffer), length);
+      }
+    }
+    return;
+  }
+
+  // No random access, decompress the whole chunk
+  std::vector<u8> decompressed;
+  if (this->readColumn(decompressed, index)) {
+    StringPointerArrayViewer viewer(decompressed.data());
+    for (u32 i = 0; i < count; i++) {
+      output[i] = viewer(rows[i]);
+    }
+  } else {
+    StringArrayViewer viewer(decompressed.data());
+    for (u32 i = 0; i < count; i++) {
+      output[i] = viewer(rows[i]);
+    }
+  }
+}
+
+void BtrReader::readColumnRuns(RunEncodedColumn<INTEGER>& output, u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::INTEGER && meta->type != ColumnType::DATE) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " is not integer");
+  }
+
+  auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  if (scheme.schemeType() == IntegerSchemeType::RLE) {
+    auto& rle = dynamic_cast<integers::RLE&>(scheme);
+    readRuns(output, rle, this->getBitmap(index), meta->columnData(), meta->tuple_count);
+    return;
+  }
+
+  thread_local std::vector<u8> values_v;
+  this->readColumn(values_v, index);
+  output.assign(reinterpret_cast<const INTEGER*>(values_v.data()), meta->tuple_count);
+}
+
+void BtrReader::readColumnRuns(RunEncodedColumn<BIGINT>& output, u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::BIGINT && meta->type != ColumnType::TIMESTAMP &&
+      meta->type != ColumnType::DECIMAL) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " is not bigint");
+  }
+
+  auto& scheme = Integer64SchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  if (scheme.schemeType() == Integer64SchemeType::RLE) {
+    auto& rle = dynamic_cast<bigints::RLE&>(scheme);
+    readRuns(output, rle, this->getBitmap(index), meta->columnData(), meta->tuple_count);
+    return;
+  }
+
+  thread_local std::vector<u8> values_v;
+  this->readColumn(values_v, index);
+  output.assign(reinterpret_cast<const BIGINT*>(values_v.data()), meta->tuple_count);
+}
+
+void BtrReader::readColumnRuns(RunEncodedColumn<DOUBLE>& output, u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::DOUBLE) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " is not double");
+  }
+
+  auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  if (scheme.schemeType() == DoubleSchemeType::RLE) {
+    auto& rle = dynamic_cast<doubles::RLE&>(scheme);
+    readRuns(output, rle, this->getBitmap(index), meta->columnData(), meta->tuple_count);
+    return;
+  }
+
+  thread_local std::vector<u8> values_v;
+  this->readColumn(values_v, index);
+  output.assign(reinterpret_cast<const DOUBLE*>(values_v.data()), meta->tuple_count);
+}
+
+void BtrReader::readColumnRuns(RunEncodedColumn<FLOAT>& output, u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::FLOAT) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " is not float");
+  }
+
+  auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
+  if (scheme.schemeType() == FloatSchemeType::RLE) {
+    auto& rle = dynamic_cast<floats::RLE&>(scheme);
+    readRuns(output, rle, this->getBitmap(index), meta->columnData(), meta->tuple_count);
+    return;
+  }
+
+  thread_local std::vector<u8> values_v;
+  this->readColumn(values_v, index);
+  output.assign(reinterpret_cast<const FLOAT*>(values_v.data()), meta->tuple_count);
+}
+
+void BtrReader::readColumnAsDoubles(std::vector<DOUBLE>& output_v, u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  if (meta->type != ColumnType::DECIMAL) {
+    throw Generic_Exception("Type " + ConvertTypeToString(meta->type) + " is not decimal");
+  }
+
+  thread_local std::vector<u8> values_v;
+  this->readColumn(values_v, index);
+  auto output = get_data(output_v, meta->tuple_count + SIMD_EXTRA_ELEMENTS(DOUBLE));
+  Decimal::toDoubles(output, reinterpret_cast<const DECIMAL*>(values_v.data()), meta->tuple_count,
+                     meta->decimal_scale);
+}
+
+const ZoneMap* BtrReader::getZoneMap(u32 index) {
+  return this->getChunkMetadata(index)->zoneMap();
+}
+
 string BtrReader::getSchemeDescription(u32 index) {
   auto meta = this->getChunkMetadata(index);
   u8 compression = meta->compression_type;
-  auto src = static_cast<const u8*>(meta->data);
+  auto src = meta->columnData();
 
   switch (meta->type) {
-    case ColumnType::INTEGER: {
+    case ColumnType::INTEGER:
+    case ColumnType::SMALLINT:
+    case ColumnType::TINYINT:
+    case ColumnType::DATE: {
       auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(compression);
       return scheme.fullDescription(src);
     }
@@ -87,6 +513,16 @@ string BtrReader::getSchemeDescription(u32 index) {
       auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(compression);
       return scheme.fullDescription(src);
     }
+    case ColumnType::BIGINT:
+    case ColumnType::TIMESTAMP:
+    case ColumnType::DECIMAL: {
+      auto& scheme = Integer64SchemePicker::MyTypeWrapper::getScheme(compression);
+      return scheme.fullDescription(src);
+    }
+    case ColumnType::FLOAT: {
+      auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(compression);
+      return scheme.fullDescription(src);
+    }
     case ColumnType::STRING: {
       auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(compression);
       return scheme.fullDescription(src);
@@ -100,10 +536,13 @@ string BtrReader::getBasicSchemeDescription(u32 index) {
   // Only print the first level of the scheme description instead of all of them
   auto meta = this->getChunkMetadata(index);
   u8 compression = meta->compression_type;
-  auto src = static_cast<const u8*>(meta->data);
+  auto src = meta->columnData();
 
   switch (meta->type) {
-    case ColumnType::INTEGER: {
+    case ColumnType::INTEGER:
+    case ColumnType::SMALLINT:
+    case ColumnType::TINYINT:
+    case ColumnType::DATE: {
       auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(compression);
       return scheme.selfDescription();
     }
@@ -111,6 +550,16 @@ string BtrReader::getBasicSchemeDescription(u32 index) {
       auto& scheme = DoubleSchemePicker::MyTypeWrapper::getScheme(compression);
       return scheme.selfDescription();
     }
+    case ColumnType::BIGINT:
+    case ColumnType::TIMESTAMP:
+    case ColumnType::DECIMAL: {
+      auto& scheme = Integer64SchemePicker::MyTypeWrapper::getScheme(compression);
+      return scheme.selfDescription();
+    }
+    case ColumnType::FLOAT: {
+      auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(compression);
+      return scheme.selfDescription();
+    }
     case ColumnType::STRING: {
       auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(compression);
       return scheme.selfDescription(src);
@@ -140,6 +589,12 @@ BitmapWrapper* BtrReader::getBitmap(u32 index) {
   return this->m_bitmap_wrappers[index];
 }
 
+void BtrReader::readValidity(VALIDITY* dest, u32 index) {
+  auto meta = this->getChunkMetadata(index);
+  bitmap::RoaringBitmap::decompress(dest, meta->data + meta->nullmap_offset, meta->nullmap_type,
+                                    meta->tuple_count);
+}
+
 void BtrReader::releaseBitmap(u32 index) {
   if (this->m_bitmap_wrappers[index] == nullptr) {
     return;
@@ -166,10 +621,31 @@ u32 BtrReader::getDecompressedSize(u32 index) {
     case ColumnType::DOUBLE: {
       return sizeof(DOUBLE) * meta->tuple_count;
     }
+    case ColumnType::BIGINT: {
+      return sizeof(BIGINT) * meta->tuple_count;
+    }
+    case ColumnType::SMALLINT: {
+      return sizeof(SMALLINT) * meta->tuple_count;
+    }
+    case ColumnType::TINYINT: {
+      return sizeof(TINYINT) * meta->tuple_count;
+    }
+    case ColumnType::TIMESTAMP: {
+      return sizeof(TIMESTAMP) * meta->tuple_count;
+    }
+    case ColumnType::DATE: {
+      return sizeof(DATE) * meta->tuple_count;
+    }
+    case ColumnType::DECIMAL: {
+      return sizeof(DECIMAL) * meta->tuple_count;
+    }
+    case ColumnType::FLOAT: {
+      return sizeof(FLOAT) * meta->tuple_count;
+    }
     case ColumnType::STRING: {
       auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
 
-      auto input_data = static_cast<const u8*>(meta->data);
+      auto input_data = meta->columnData();
       BitmapWrapper* bitmapWrapper = this->getBitmap(index);
       u32 size = scheme.getDecompressedSizeNoCopy(input_data, meta->tuple_count, bitmapWrapper);
       // TODO The 4096 is temporary until I figure out why FSST is returning
@@ -192,10 +668,31 @@ u32 BtrReader::getDecompressedDataSize(u32 index) {
     case ColumnType::DOUBLE: {
       return sizeof(DOUBLE) * meta->tuple_count;
     }
+    case ColumnType::BIGINT: {
+      return sizeof(BIGINT) * meta->tuple_count;
+    }
+    case ColumnType::SMALLINT: {
+      return sizeof(SMALLINT) * meta->tuple_count;
+    }
+    case ColumnType::TINYINT: {
+      return sizeof(TINYINT) * meta->tuple_count;
+    }
+    case ColumnType::TIMESTAMP: {
+      return sizeof(TIMESTAMP) * meta->tuple_count;
+    }
+    case ColumnType::DATE: {
+      return sizeof(DATE) * meta->tuple_count;
+    }
+    case ColumnType::DECIMAL: {
+      return sizeof(DECIMAL) * meta->tuple_count;
+    }
+    case ColumnType::FLOAT: {
+      return sizeof(FLOAT) * meta->tuple_count;
+    }
     case ColumnType::STRING: {
       auto& scheme = StringSchemePicker::MyTypeWrapper::getScheme(meta->compression_type);
 
-      auto input_data = static_cast<const u8*>(meta->data);
+      auto input_data = meta->columnData();
       BitmapWrapper* bitmapWrapper = this->getBitmap(index);
       u32 size = scheme.getTotalLength(input_data, meta->tuple_count, bitmapWrapper);
       return size;
@@ -5,15 +5,73 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
 #include "compression/Datablock.hpp"
+#include "compression/RunEncodedColumn.hpp"
 
 namespace btrblocks {
 
+namespace strings {
+class DictionaryEntryReader;
+}
+
+enum class ColumnEncoding : u8 {
+  PLAIN,       // values: one value per row, same layout as readColumn
+  DICTIONARY,  // values: the dictionary, codes: one index into it per row
+  RUNS         // values: one value per run, run_lengths: the length of every run
+};
+
+// Output of BtrReader::readColumnEncoded. Buffers are reused across calls and
+// may be larger than needed, use tuple_count and value_count.
+struct EncodedColumn {
+  ColumnEncoding encoding = ColumnEncoding::PLAIN;
+  u32 tuple_count = 0;
+  // Number of entries in values (rows, dictionary entries or runs)
+  u32 value_count = 0;
+  // Strings only: values is in StringPointerArrayViewer layout if set,
+  // StringArrayViewer otherwise (see readColumn)
+  bool requires_copy = false;
+  // DICTIONARY only: the codes index the part's global dictionary, so they are
+  // the same in every chunk of the column
+  bool global_codes = false;
+  std::vector<u8> values;
+  std::vector<INTEGER> codes;
+  std::vector<INTEGER> run_lengths;
+
+  template <typename T>
+  [[nodiscard]] inline const T* valuesAs() const {
+    return reinterpret_cast<const T*>(values.data());
+  }
+};
+
 class BtrReader {
  public:
   explicit BtrReader(void* data);
   virtual ~BtrReader();
   bool readColumn(std::vector<u8>& output_chunk, u32 index);
+  // Per-row 64-bit hashes of the chunk (see common/Hash.hpp) without
+  // materializing the values where the scheme allows it. Rows that are NULL
+  // get an unspecified hash; check them against getBitmap(index).
+  void hashColumn(std::vector<u64>& output_hashes, u32 index);
+  // Like readColumn, but keeps DICT chunks as dictionary + codes and RLE
+  // chunks as values + run lengths. Everything else is decompressed as PLAIN.
+  void readColumnEncoded(EncodedColumn& output, u32 index);
+  // STRING chunks only: the strings of the given rows. Dictionary chunks only
+  // decode the entries the rows reference; the codes and decoded entries of the
+  // last chunk are cached, so repeated lookups into one chunk stay cheap. All
+  // other chunks are decompressed as a whole. NULL rows come back empty.
+  void readStrings(std::vector<std::string>& output, u32 index, const u32* rows, u32 count);
+  // The chunk as runs of equal values. RLE chunks are handed out as stored,
+  // all other chunks are decompressed and collapsed into runs.
+  void readColumnRuns(RunEncodedColumn<INTEGER>& output, u32 index);
+  void readColumnRuns(RunEncodedColumn<BIGINT>& output, u32 index);
+  void readColumnRuns(RunEncodedColumn<DOUBLE>& output, u32 index);
+  void readColumnRuns(RunEncodedColumn<FLOAT>& output, u32 index);
+  // DECIMAL chunks only. readColumn returns the scaled integers, this converts
+  // them to doubles using the scale of the chunk.
+  void readColumnAsDoubles(std::vector<DOUBLE>& output, u32 index);
+  // Min/max of TIMESTAMP and DATE chunks, nullptr for all other types
+  [[nodiscard]] const ZoneMap* getZoneMap(u32 index);
   [[nodiscard]] string getSchemeDescription(u32 index);
   [[nodiscard]] string getBasicSchemeDescription(u32 index);
 
@@ -22,6 +80,9 @@ class BtrReader {
   // it.
   [[nodiscard]] u32 getDecompressedDataSize(u32 index);
   [[nodiscard]] BitmapWrapper* getBitmap(u32 index);
+  // Writes the nullmap of the chunk as bit-packed validity, wordCount(tuple count)
+  // words (see bitmap::PackedBitmap). Unlike getBitmap, nothing is allocated per chunk.
+  void readValidity(VALIDITY* dest, u32 index);
   void releaseBitmap(u32 index);
   BitmapWrapper* releaseBitmapOwnership(u32 index);
 
@@ -36,12 +97,35 @@ class BtrReader {
     return this->getChunkMetadata(index)->tuple_count;
   }
   [[nodiscard]] inline ColumnType getColumnType() { return this->getChunkMetadata(0)->type; }
+  [[nodiscard]] inline u8 getDecimalScale() { return this->getChunkMetadata(0)->decimal_scale; }
   [[nodiscard]] inline u32 getChunkCount() { return this->getPartMetadata()->num_chunks; }
+  // What the part stores for all of its chunks, the schemes decode with it
+  [[nodiscard]] inline PartData getPart() {
+    return {this->getPartFsstTable(), this->getPartGlobalDictionary()};
+  }
+  // The FSST table shared by the string chunks of the part, nullptr if there is none
+  [[nodiscard]] inline const u8* getPartFsstTable() {
+    auto extension = this->getPartMetadata()->extension();
+    return extension == nullptr ? nullptr : this->getPartData(extension->fsst_table_offset);
+  }
+  // The GlobalDictionary of the part, nullptr if there is none
+  [[nodiscard]] inline const u8* getPartGlobalDictionary() {
+    auto extension = this->getPartMetadata()->extension();
+    return extension == nullptr ? nullptr : this->getPartData(extension->global_dictionary_offset);
+  }
 
  private:
+  [[nodiscard]] inline const u8* getPartData(u32 offset) {
+    return offset == 0 ? nullptr : reinterpret_cast<const u8*>(this->data) + offset;
+  }
+
   void* data{};
   std::vector<BitmapWrapper*> m_bitmap_wrappers;
   std::vector<boost::dynamic_bitset<>*> m_bitsets;
+  // readStrings state of the last dictionary chunk
+  u32 m_entries_chunk = std::numeric_limits<u32>::max();
+  std::vector<INTEGER> m_entries_codes;
+  std::shared_ptr<strings::DictionaryEntryReader> m_entry_reader;
 };
 
 }  // namespace btrblocks
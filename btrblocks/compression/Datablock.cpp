@@ -23,6 +23,17 @@
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
 // -------------------------------------------------------------------------------------
+namespace {
+// SMALLINT and TINYINT columns are compressed by the integer schemes
+template <typename NarrowType>
+const INTEGER* widenIntegers(const NarrowType* src, u32 tuple_count) {
+  thread_local std::vector<INTEGER> widened;
+  widened.resize(tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+  std::copy(src, src + tuple_count, widened.begin());
+  return widened.data();
+}
+}  // namespace
+// -------------------------------------------------------------------------------------
 Datablock::Datablock(const Relation& relation) : RelationCompressor(relation) {}
 u32 Datablock::writeMetadata(const std::string& path,
                              std::vector<ColumnType> types,
@@ -51,53 +62,119 @@ u32 Datablock::writeMetadata(const std::string& path,
   return bytes_written;
 }
 // -------------------------------------------------------------------------------------
-std::vector<u8> Datablock::compress(const InputChunk& input_chunk) {
+std::vector<u8> Datablock::compress(const InputChunk& input_chunk, const PartEncoding& part) {
   // We do not now the exact output size. Therefore we allocate too much and
   // then simply make the space smaller afterwards
   const u32 size =
       sizeof(ColumnChunkMeta) + 10 * input_chunk.size + sizeof(BITMAP) * input_chunk.tuple_count;
   std::vector<u8> output(size);
-  auto total_size = compress(input_chunk, output.data());
+  auto total_size = compress(input_chunk, output.data(), part);
   // Resize the output vector to the actual used size
   output.resize(total_size);
   return output;
 }
 // -------------------------------------------------------------------------------------
-SIZE Datablock::compress(const InputChunk& input_chunk, u8* output) {
+SIZE Datablock::compress(const InputChunk& input_chunk, u8* output, const PartEncoding& part) {
   auto& cfg = BtrBlocksConfig::get();
   auto meta = reinterpret_cast<ColumnChunkMeta*>(output);
   meta->tuple_count = input_chunk.tuple_count;
   meta->type = input_chunk.type;
+  meta->decimal_scale = input_chunk.decimal_scale;
+  // The schemes take a BITMAP per tuple, bit-packed validity is unpacked for them
+  const BITMAP* nullmap = input_chunk.nullmap.get();
+  thread_local std::vector<BITMAP> unpacked_nullmap;
+  if (nullmap == nullptr) {
+    unpacked_nullmap.resize(input_chunk.tuple_count);
+    bitmap::PackedBitmap::unpack(unpacked_nullmap.data(), input_chunk.validity.get(),
+                                 input_chunk.tuple_count);
+    nullmap = unpacked_nullmap.data();
+  }
 
   auto output_data = meta->data;
+  if (hasZoneMap(input_chunk.type)) {
+    output_data += sizeof(ZoneMap);
+  }
 
   switch (input_chunk.type) {
     case ColumnType::INTEGER: {
-      IntegerSchemePicker::compress(reinterpret_cast<INTEGER*>(input_chunk.data.get()),
-                                    input_chunk.nullmap.get(), output_data, input_chunk.tuple_count,
+      IntegerSchemePicker::compress(reinterpret_cast<INTEGER*>(input_chunk.data.get()), nullmap,
+                                    output_data, input_chunk.tuple_count,
                                     cfg.integers.max_cascade_depth, meta->nullmap_offset,
-                                    meta->compression_type);
+                                    meta->compression_type, autoScheme(), "?", part);
       break;
     }
     case ColumnType::DOUBLE: {
       // -------------------------------------------------------------------------------------
-      DoubleSchemePicker::compress(reinterpret_cast<DOUBLE*>(input_chunk.data.get()),
-                                   input_chunk.nullmap.get(), output_data, input_chunk.tuple_count,
+      DoubleSchemePicker::compress(reinterpret_cast<DOUBLE*>(input_chunk.data.get()), nullmap,
+                                   output_data, input_chunk.tuple_count,
                                    cfg.doubles.max_cascade_depth, meta->nullmap_offset,
-                                   meta->compression_type);
+                                   meta->compression_type, autoScheme(), "?", part);
       // -------------------------------------------------------------------------------------
       break;
     }
+    case ColumnType::BIGINT: {
+      Integer64SchemePicker::compress(reinterpret_cast<BIGINT*>(input_chunk.data.get()), nullmap,
+                                      output_data, input_chunk.tuple_count,
+                                      cfg.bigints.max_cascade_depth, meta->nullmap_offset,
+                                      meta->compression_type, autoScheme(), "?", part);
+      break;
+    }
+    case ColumnType::TIMESTAMP: {
+      auto src = reinterpret_cast<TIMESTAMP*>(input_chunk.data.get());
+      *reinterpret_cast<ZoneMap*>(meta->data) =
+          ZoneMap::compute(src, nullmap, input_chunk.tuple_count);
+      Integer64SchemePicker::compress(src, nullmap, output_data, input_chunk.tuple_count,
+                                      cfg.bigints.max_cascade_depth, meta->nullmap_offset,
+                                      meta->compression_type, autoScheme(), "?", part);
+      break;
+    }
+    case ColumnType::DECIMAL: {
+      Integer64SchemePicker::compress(reinterpret_cast<DECIMAL*>(input_chunk.data.get()), nullmap,
+                                      output_data, input_chunk.tuple_count,
+                                      cfg.bigints.max_cascade_depth, meta->nullmap_offset,
+                                      meta->compression_type, autoScheme(), "?", part);
+      break;
+    }
+    case ColumnType::DATE: {
+      auto src = reinterpret_cast<DATE*>(input_chunk.data.get());
+      *reinterpret_cast<ZoneMap*>(meta->data) =
+          ZoneMap::compute(src, nullmap, input_chunk.tuple_count);
+      IntegerSchemePicker::compress(src, nullmap, output_data, input_chunk.tuple_count,
+                                    cfg.integers.max_cascade_depth, meta->nullmap_offset,
+                                    meta->compression_type, autoScheme(), "?", part);
+      break;
+    }
+    case ColumnType::SMALLINT: {
+      IntegerSchemePicker::compress(
+          widenIntegers(reinterpret_cast<SMALLINT*>(input_chunk.data.get()), input_chunk.tuple_count),
+          nullmap, output_data, input_chunk.tuple_count, cfg.integers.max_cascade_depth,
+          meta->nullmap_offset, meta->compression_type, autoScheme(), "?", part);
+      break;
+    }
+    case ColumnType::TINYINT: {
+      IntegerSchemePicker::compress(
+          widenIntegers(reinterpret_cast<TINYINT*>(input_chunk.data.get()), input_chunk.tuple_count),
+          nullmap, output_data, input_chunk.tuple_count, cfg.integers.max_cascade_depth,
+          meta->nullmap_offset, meta->compression_type, autoScheme(), "?", part);
+      break;
+    }
+    case ColumnType::FLOAT: {
+      FloatSchemePicker::compress(reinterpret_cast<FLOAT*>(input_chunk.data.get()), nullmap,
+                                  output_data, input_chunk.tuple_count,
+                                  cfg.floats.max_cascade_depth, meta->nullmap_offset,
+                                  meta->compression_type, autoScheme(), "?", part);
+      break;
+    }
     case ColumnType::STRING: {
       // -------------------------------------------------------------------------------------
       // Collect stats
       StringStats stats = StringStats::generateStats(StringArrayViewer(input_chunk.data.get()),
-                                                     input_chunk.nullmap.get(),
-                                                     input_chunk.tuple_count, input_chunk.size);
+                                                     nullmap, input_chunk.tuple_count,
+                                                     input_chunk.size);
       // -------------------------------------------------------------------------------------
       // Make decisions
       StringScheme& preferred_scheme =
-          StringSchemePicker::chooseScheme(stats, cfg.strings.max_cascade_depth);
+          StringSchemePicker::chooseScheme(stats, cfg.strings.max_cascade_depth, part);
       // Update meta data
       meta->compression_type = static_cast<u8>(preferred_scheme.schemeType());
       // -------------------------------------------------------------------------------------
@@ -105,7 +182,7 @@ SIZE Datablock::compress(const InputChunk& input_chunk, u8* output) {
       ThreadCache::get().compression_level++;
       const StringArrayViewer str_viewer(input_chunk.data.get());
       u32 after_column_size =
-          preferred_scheme.compress(str_viewer, input_chunk.nullmap.get(), output_data, stats);
+          preferred_scheme.compress(str_viewer, nullmap, output_data, stats, part);
       meta->nullmap_offset = after_column_size;
       // -------------------------------------------------------------------------------------
       for (u8 i = 0; i < 5 - cfg.strings.max_cascade_depth; i++) {
@@ -132,9 +209,16 @@ SIZE Datablock::compress(const InputChunk& input_chunk, u8* output) {
       throw Generic_Exception("Type not supported");
   }
 
-  // Compress bitmap
-  auto [nullmap_size, bitmap_type] = bitmap::RoaringBitmap::compress(
-      input_chunk.nullmap.get(), output_data + meta->nullmap_offset, input_chunk.tuple_count);
+  // Compress bitmap, the offset is relative to the zone map if there is one
+  meta->nullmap_offset += output_data - meta->data;
+  auto [nullmap_size, bitmap_type] =
+      input_chunk.validity
+          ? bitmap::RoaringBitmap::compress(input_chunk.validity.get(),
+                                            meta->data + meta->nullmap_offset,
+                                            input_chunk.tuple_count)
+          : bitmap::RoaringBitmap::compress(input_chunk.nullmap.get(),
+                                            meta->data + meta->nullmap_offset,
+                                            input_chunk.tuple_count);
   meta->nullmap_type = bitmap_type;
   u32 total_size = sizeof(*meta) + meta->nullmap_offset + nullmap_size;
 
@@ -147,7 +231,10 @@ SIZE Datablock::compress(const InputChunk& input_chunk, u8* output) {
   return total_size;
 }
 
-bool Datablock::decompress(const u8* data_in, BitmapWrapper** bitmap_out, u8* data_out) {
+bool Datablock::decompress(const u8* data_in,
+                           BitmapWrapper** bitmap_out,
+                           u8* data_out,
+                           const PartData& part) {
   // TODO this code is unused
   auto meta = reinterpret_cast<const ColumnChunkMeta*>(data_in);
 
@@ -163,7 +250,7 @@ bool Datablock::decompress(const u8* data_in, BitmapWrapper** bitmap_out, u8* da
       auto& scheme = SchemePool::available_schemes
                          ->integer_schemes[static_cast<IntegerSchemeType>(meta->compression_type)];
       scheme->decompress(reinterpret_cast<INTEGER*>(data_out), *bitmap_out, meta->data,
-                         meta->tuple_count, 0);
+                         meta->tuple_count, 0, part);
       requires_copy_out = false;
       break;
     }
@@ -171,7 +258,63 @@ bool Datablock::decompress(const u8* data_in, BitmapWrapper** bitmap_out, u8* da
       auto& scheme = SchemePool::available_schemes
                          ->double_schemes[static_cast<DoubleSchemeType>(meta->compression_type)];
       scheme->decompress(reinterpret_cast<DOUBLE*>(data_out), *bitmap_out, meta->data,
-                         meta->tuple_count, 0);
+                         meta->tuple_count, 0, part);
+      requires_copy_out = false;
+      break;
+    }
+    case ColumnType::BIGINT: {
+      auto& scheme = SchemePool::available_schemes
+                         ->bigint_schemes[static_cast<Integer64SchemeType>(meta->compression_type)];
+      scheme->decompress(reinterpret_cast<BIGINT*>(data_out), *bitmap_out, meta->data,
+                         meta->tuple_count, 0, part);
+      requires_copy_out = false;
+      break;
+    }
+    case ColumnType::TIMESTAMP: {
+      auto& scheme = SchemePool::available_schemes
+                         ->bigint_schemes[static_cast<Integer64SchemeType>(meta->compression_type)];
+      scheme->decompress(reinterpret_cast<TIMESTAMP*>(data_out), *bitmap_out, meta->columnData(),
+                         meta->tuple_count, 0, part);
+      requires_copy_out = false;
+      break;
+    }
+    case ColumnType::DECIMAL: {
+      auto& scheme = SchemePool::available_schemes
+                         ->bigint_schemes[static_cast<Integer64SchemeType>(meta->compression_type)];
+      scheme->decompress(reinterpret_cast<DECIMAL*>(data_out), *bitmap_out, meta->data,
+                         meta->tuple_count, 0, part);
+      requires_copy_out = false;
+      break;
+    }
+    case ColumnType::DATE: {
+      auto& scheme = SchemePool::available_schemes
+                         ->integer_schemes[static_cast<IntegerSchemeType>(meta->compression_type)];
+      scheme->decompress(reinterpret_cast<DATE*>(data_out), *bitmap_out, meta->columnData(),
+                         meta->tuple_count, 0, part);
+      requires_copy_out = false;
+      break;
+    }
+    case ColumnType::SMALLINT: {
+      auto& scheme = SchemePool::available_schemes
+                         ->integer_schemes[static_cast<IntegerSchemeType>(meta->compression_type)];
+      scheme->decompressNarrow(reinterpret_cast<SMALLINT*>(data_out), *bitmap_out, meta->data,
+                               meta->tuple_count, 0, part);
+      requires_copy_out = false;
+      break;
+    }
+    case ColumnType::TINYINT: {
+      auto& scheme = SchemePool::available_schemes
+                         ->integer_schemes[static_cast<IntegerSchemeType>(meta->compression_type)];
+      scheme->decompressNarrow(reinterpret_cast<TINYINT*>(data_out), *bitmap_out, meta->data,
+                               meta->tuple_count, 0, part);
+      requires_copy_out = false;
+      break;
+    }
+    case ColumnType::FLOAT: {
+      auto& scheme = SchemePool::available_schemes
+                         ->float_schemes[static_cast<FloatSchemeType>(meta->compression_type)];
+      scheme->decompress(reinterpret_cast<FLOAT*>(data_out), *bitmap_out, meta->data,
+                         meta->tuple_count, 0, part);
       requires_copy_out = false;
       break;
     }
@@ -179,7 +322,7 @@ bool Datablock::decompress(const u8* data_in, BitmapWrapper** bitmap_out, u8* da
       auto& scheme = SchemePool::available_schemes
                          ->string_schemes[static_cast<StringSchemeType>(meta->compression_type)];
       requires_copy_out =
-          scheme->decompressNoCopy(data_out, *bitmap_out, meta->data, meta->tuple_count, 0);
+          scheme->decompressNoCopy(data_out, *bitmap_out, meta->data, meta->tuple_count, 0, part);
       break;
     }
     default:
@@ -253,6 +396,57 @@ OutputBlockStats Datablock::compress(const Chunk& input_chunk, BytesArray& outpu
         // -------------------------------------------------------------------------------------
         break;
       }
+      case ColumnType::BIGINT: {
+        Integer64SchemePicker::compress(
+            input_chunk.array<BIGINT>(column_i), input_chunk.nullmap(column_i),
+            output_block.get() + db_write_offset, input_chunk.tuple_count,
+            cfg.bigints.max_cascade_depth, after_column_size, column_meta.compression_type);
+        break;
+      }
+      case ColumnType::TIMESTAMP: {
+        Integer64SchemePicker::compress(
+            input_chunk.array<TIMESTAMP>(column_i), input_chunk.nullmap(column_i),
+            output_block.get() + db_write_offset, input_chunk.tuple_count,
+            cfg.bigints.max_cascade_depth, after_column_size, column_meta.compression_type);
+        break;
+      }
+      case ColumnType::DECIMAL: {
+        Integer64SchemePicker::compress(
+            input_chunk.array<DECIMAL>(column_i), input_chunk.nullmap(column_i),
+            output_block.get() + db_write_offset, input_chunk.tuple_count,
+            cfg.bigints.max_cascade_depth, after_column_size, column_meta.compression_type);
+        break;
+      }
+      case ColumnType::DATE: {
+        IntegerSchemePicker::compress(
+            input_chunk.array<DATE>(column_i), input_chunk.nullmap(column_i),
+            output_block.get() + db_write_offset, input_chunk.tuple_count,
+            cfg.integers.max_cascade_depth, after_column_size, column_meta.compression_type);
+        break;
+      }
+      case ColumnType::SMALLINT: {
+        IntegerSchemePicker::compress(
+            widenIntegers(input_chunk.array<SMALLINT>(column_i), input_chunk.tuple_count),
+            input_chunk.nullmap(column_i), output_block.get() + db_write_offset,
+            input_chunk.tuple_count, cfg.integers.max_cascade_depth, after_column_size,
+            column_meta.compression_type);
+        break;
+      }
+      case ColumnType::TINYINT: {
+        IntegerSchemePicker::compress(
+            widenIntegers(input_chunk.array<TINYINT>(column_i), input_chunk.tuple_count),
+            input_chunk.nullmap(column_i), output_block.get() + db_write_offset,
+            input_chunk.tuple_count, cfg.integers.max_cascade_depth, after_column_size,
+            column_meta.compression_type);
+        break;
+      }
+      case ColumnType::FLOAT: {
+        FloatSchemePicker::compress(
+            input_chunk.array<FLOAT>(column_i), input_chunk.nullmap(column_i),
+            output_block.get() + db_write_offset, input_chunk.tuple_count,
+            cfg.floats.max_cascade_depth, after_column_size, column_meta.compression_type);
+        break;
+      }
       case ColumnType::STRING: {
         // -------------------------------------------------------------------------------------
         // Collect stats
@@ -389,6 +583,100 @@ btrblocks::Chunk Datablock::decompress(const BytesArray& input_db) {
         column_requires_copy[column_i] = false;
         break;
       }
+      case ColumnType::BIGINT: {
+        // -------------------------------------------------------------------------------------
+        sizes[column_i] = sizeof(BIGINT) * tuple_count;
+        columns[column_i] = makeBytesArray(sizeof(BIGINT) * tuple_count + SIMD_EXTRA_BYTES);
+        // -------------------------------------------------------------------------------------
+        auto destination_array = reinterpret_cast<BIGINT*>(columns[column_i].get());
+        auto& scheme =
+            Integer64SchemePicker::MyTypeWrapper::getScheme(column_meta.compression_type);
+        // -------------------------------------------------------------------------------------
+        scheme.decompress(destination_array, &bitmap, input_db.get() + column_meta.offset,
+                          tuple_count, 0);
+        column_requires_copy[column_i] = false;
+        break;
+      }
+      case ColumnType::TIMESTAMP: {
+        // -------------------------------------------------------------------------------------
+        sizes[column_i] = sizeof(TIMESTAMP) * tuple_count;
+        columns[column_i] = makeBytesArray(sizeof(TIMESTAMP) * tuple_count + SIMD_EXTRA_BYTES);
+        // -------------------------------------------------------------------------------------
+        auto destination_array = reinterpret_cast<TIMESTAMP*>(columns[column_i].get());
+        auto& scheme =
+            Integer64SchemePicker::MyTypeWrapper::getScheme(column_meta.compression_type);
+        // -------------------------------------------------------------------------------------
+        scheme.decompress(destination_array, &bitmap, input_db.get() + column_meta.offset,
+                          tuple_count, 0);
+        column_requires_copy[column_i] = false;
+        break;
+      }
+      case ColumnType::DECIMAL: {
+        // -------------------------------------------------------------------------------------
+        sizes[column_i] = sizeof(DECIMAL) * tuple_count;
+        columns[column_i] = makeBytesArray(sizeof(DECIMAL) * tuple_count + SIMD_EXTRA_BYTES);
+        // -------------------------------------------------------------------------------------
+        auto destination_array = reinterpret_cast<DECIMAL*>(columns[column_i].get());
+        auto& scheme =
+            Integer64SchemePicker::MyTypeWrapper::getScheme(column_meta.compression_type);
+        // -------------------------------------------------------------------------------------
+        scheme.decompress(destination_array, &bitmap, input_db.get() + column_meta.offset,
+                          tuple_count, 0);
+        column_requires_copy[column_i] = false;
+        break;
+      }
+      case ColumnType::DATE: {
+        // -------------------------------------------------------------------------------------
+        sizes[column_i] = sizeof(DATE) * tuple_count;
+        columns[column_i] = makeBytesArray(sizeof(DATE) * tuple_count + SIMD_EXTRA_BYTES);
+        // -------------------------------------------------------------------------------------
+        auto destination_array = reinterpret_cast<DATE*>(columns[column_i].get());
+        auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(column_meta.compression_type);
+        // -------------------------------------------------------------------------------------
+        scheme.decompress(destination_array, &bitmap, input_db.get() + column_meta.offset,
+                          tuple_count, 0);
+        column_requires_copy[column_i] = false;
+        break;
+      }
+      case ColumnType::SMALLINT: {
+        // -------------------------------------------------------------------------------------
+        sizes[column_i] = sizeof(SMALLINT) * tuple_count;
+        columns[column_i] = makeBytesArray(sizeof(SMALLINT) * tuple_count + SIMD_EXTRA_BYTES);
+        // -------------------------------------------------------------------------------------
+        auto destination_array = reinterpret_cast<SMALLINT*>(columns[column_i].get());
+        auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(column_meta.compression_type);
+        // -------------------------------------------------------------------------------------
+        scheme.decompressNarrow(destination_array, &bitmap, input_db.get() + column_meta.offset,
+                                tuple_count, 0);
+        column_requires_copy[column_i] = false;
+        break;
+      }
+      case ColumnType::TINYINT: {
+        // -------------------------------------------------------------------------------------
+        sizes[column_i] = sizeof(TINYINT) * tuple_count;
+        columns[column_i] = makeBytesArray(sizeof(TINYINT) * tuple_count + SIMD_EXTRA_BYTES);
+        // -------------------------------------------------------------------------------------
+        auto destination_array = reinterpret_cast<TINYINT*>(columns[column_i].get());
+        auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(column_meta.compression_type);
+        // -------------------------------------------------------------------------------------
+        scheme.decompressNarrow(destination_array, &bitmap, input_db.get() + column_meta.offset,
+                                tuple_count, 0);
+        column_requires_copy[column_i] = false;
+        break;
+      }
+      case ColumnType::FLOAT: {
+        // -------------------------------------------------------------------------------------
+        sizes[column_i] = sizeof(FLOAT) * tuple_count;
+        columns[column_i] = makeBytesArray(sizeof(FLOAT) * tuple_count + SIMD_EXTRA_BYTES);
+        // -------------------------------------------------------------------------------------
+        auto destination_array = reinterpret_cast<FLOAT*>(columns[column_i].get());
+        auto& scheme = FloatSchemePicker::MyTypeWrapper::getScheme(column_meta.compression_type);
+        // -------------------------------------------------------------------------------------
+        scheme.decompress(destination_array, &bitmap, input_db.get() + column_meta.offset,
+                          tuple_count, 0);
+        column_requires_copy[column_i] = false;
+        break;
+      }
       case ColumnType::STRING: {
         // -------------------------------------------------------------------------------------
         const auto used_compression_scheme =
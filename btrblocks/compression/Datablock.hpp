@@ -4,19 +4,57 @@
 #include "scheme/CompressionScheme.hpp"
 #include "storage/Chunk.hpp"
 // -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <limits>
 #include <unordered_map>
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
 // -------------------------------------------------------------------------------------
 // Begin new chunking
+// Min/max of the non-null values of a TIMESTAMP or DATE chunk. It precedes the
+// compressed data so range predicates can skip chunks without decompressing
+// them. Chunks without non-null values get min > max.
+// Only the column chunks of Datablock::compress(InputChunk) carry one. The
+// blocks of the RelationCompressor interface have no room for it in ColumnMeta,
+// their TIMESTAMP and DATE columns are stored without.
+struct ZoneMap {
+  s64 min;
+  s64 max;
+
+  template <typename T>
+  static ZoneMap compute(const T* src, const BITMAP* nullmap, u32 tuple_count) {
+    ZoneMap zone_map{std::numeric_limits<s64>::max(), std::numeric_limits<s64>::min()};
+    for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+      if (nullmap == nullptr || nullmap[row_i]) {
+        zone_map.min = std::min<s64>(zone_map.min, src[row_i]);
+        zone_map.max = std::max<s64>(zone_map.max, src[row_i]);
+      }
+    }
+    return zone_map;
+  }
+};
+static_assert(sizeof(ZoneMap) == 16);
+
+inline bool hasZoneMap(ColumnType type) {
+  return type == ColumnType::TIMESTAMP || type == ColumnType::DATE;
+}
+
 struct ColumnChunkMeta {
   u8 compression_type;
   BitmapType nullmap_type;
   ColumnType type;
-  // There is 1 unused Bytes here.
-  u32 nullmap_offset = 0;
+  u8 decimal_scale;  // DECIMAL only, values are scaled by 10^decimal_scale
+  u32 nullmap_offset = 0;  // relative to data
   u32 tuple_count;
   u8 data[];
+
+  // Start of the compressed column, behind the zone map if there is one
+  [[nodiscard]] inline const u8* columnData() const {
+    return data + (hasZoneMap(type) ? sizeof(ZoneMap) : 0);
+  }
+  [[nodiscard]] inline const ZoneMap* zoneMap() const {
+    return hasZoneMap(type) ? reinterpret_cast<const ZoneMap*>(data) : nullptr;
+  }
 };
 static_assert(sizeof(ColumnChunkMeta) == 12);
 
@@ -54,6 +92,8 @@ struct DatablockMeta {
 };
 static_assert(sizeof(DatablockMeta) == 16);
 // -------------------------------------------------------------------------------------
+// As a RelationCompressor, the blocks are self-contained: their chunks never use
+// part data.
 class Datablock : public RelationCompressor {
  public:
   explicit Datablock(const Relation& relation);
@@ -61,14 +101,21 @@ class Datablock : public RelationCompressor {
   Chunk decompress(const BytesArray& input_block) override;
   virtual void getCompressedColumn(const BytesArray& input_db, u32 col_i, u8*& ptr, u32& size);
 
-  static bool decompress(const u8* data_in, BitmapWrapper** bitmap_out, u8* data_out);
-  static vector<u8> compress(const InputChunk& input_chunk);
+  static bool decompress(const u8* data_in,
+                         BitmapWrapper** bitmap_out,
+                         u8* data_out,
+                         const PartData& part = {});
+  // Chunks compressed with a PartEncoding refer to its data and only decode with
+  // the matching PartData (see ColumnPartExtension)
+  static vector<u8> compress(const InputChunk& input_chunk, const PartEncoding& part = {});
   static u32 writeMetadata(const std::string& path,
                            std::vector<ColumnType> types,
                            vector<u32> part_counters,
                            u32 num_chunks);
 
-  static SIZE compress(const InputChunk& input_chunk, u8* output_buffer);
+  static SIZE compress(const InputChunk& input_chunk,
+                       u8* output_buffer,
+                       const PartEncoding& part = {});
 };
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks
@@ -0,0 +1,211 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "extern/RoaringBitmap.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// A chunk as (value, run length) pairs, see BtrReader::readColumnRuns.
+// Buffers are reused across calls and may be larger than runs_count.
+template <typename T>
+struct RunEncodedColumn {
+  std::vector<T> values;
+  std::vector<INTEGER> run_lengths;
+  u32 runs_count = 0;
+  u32 tuple_count = 0;
+
+  // Collapse plain values into runs
+  void assign(const T* src, u32 count) {
+    tuple_count = count;
+    runs_count = 0;
+    values.resize(std::max<size_t>(values.size(), count));
+    run_lengths.resize(std::max<size_t>(run_lengths.size(), count));
+    for (u32 row_i = 0; row_i < count; row_i++) {
+      if (runs_count > 0 && values[runs_count - 1] == src[row_i]) {
+        run_lengths[runs_count - 1]++;
+      } else {
+        values[runs_count] = src[row_i];
+        run_lengths[runs_count] = 1;
+        runs_count++;
+      }
+    }
+  }
+};
+// -------------------------------------------------------------------------------------
+// Filter and aggregate helpers that work on runs instead of rows. They skip
+// NULL rows, which RLE carries inside the runs; pass nullptr as nullmap if
+// there are none.
+// -------------------------------------------------------------------------------------
+namespace runs {
+// -------------------------------------------------------------------------------------
+struct RowRange {
+  u32 begin;
+  u32 end;  // exclusive
+};
+// -------------------------------------------------------------------------------------
+namespace detail {
+// Validity words of the chunk, nullptr if no row is NULL
+inline const VALIDITY* validity(BitmapWrapper* nullmap, u32 tuple_count) {
+  if (nullmap == nullptr || nullmap->type() == BitmapType::ALLONES) {
+    return nullptr;
+  }
+  thread_local std::vector<VALIDITY> words;
+  words.resize(bitmap::PackedBitmap::wordCount(tuple_count));
+  nullmap->writeValidity(words.data());
+  return words.data();
+}
+// -------------------------------------------------------------------------------------
+// First row in [row_i, end) whose validity bit is set (or unset), end if there
+// is none
+inline u32 findRow(const VALIDITY* validity, u32 row_i, u32 end, bool set) {
+  while (row_i < end) {
+    VALIDITY word = set ? validity[row_i / 64] : ~validity[row_i / 64];
+    word >>= row_i % 64;
+    if (word != 0) {
+      return std::min(end, row_i + static_cast<u32>(__builtin_ctzll(word)));
+    }
+    row_i = (row_i / 64 + 1) * 64;
+  }
+  return end;
+}
+// -------------------------------------------------------------------------------------
+inline void appendRange(std::vector<RowRange>& ranges, u32 begin, u32 end) {
+  if (!ranges.empty() && ranges.back().end == begin) {
+    ranges.back().end = end;
+  } else {
+    ranges.push_back({begin, end});
+  }
+}
+// -------------------------------------------------------------------------------------
+// Calls fn(run_i, non_null_rows) for every run with at least one non-null row
+template <typename T, typename Function>
+void forEachRun(const RunEncodedColumn<T>& column, BitmapWrapper* nullmap, Function fn) {
+  if (nullmap != nullptr && nullmap->type() == BitmapType::ALLZEROS) {
+    return;
+  }
+  const VALIDITY* validity = detail::validity(nullmap, column.tuple_count);
+  u32 row_i = 0;
+  for (u32 run_i = 0; run_i < column.runs_count; run_i++) {
+    u32 run_end = row_i + column.run_lengths[run_i];
+    u32 non_null = validity == nullptr
+                       ? run_end - row_i
+                       : bitmap::PackedBitmap::countOnes(validity, row_i, run_end);
+    row_i = run_end;
+    if (non_null > 0) {
+      fn(run_i, non_null);
+    }
+  }
+}
+}  // namespace detail
+// -------------------------------------------------------------------------------------
+// Row ranges of the non-null rows of all runs whose value satisfies pred.
+// Adjacent qualifying rows are merged into one range, NULL rows split a run.
+// Returns the number of ranges written.
+template <typename T, typename Predicate>
+u32 filter(const RunEncodedColumn<T>& column,
+           BitmapWrapper* nullmap,
+           Predicate pred,
+           std::vector<RowRange>& ranges) {
+  ranges.clear();
+  const VALIDITY* validity = detail::validity(nullmap, column.tuple_count);
+  u32 row_i = 0;
+  for (u32 run_i = 0; run_i < column.runs_count; run_i++) {
+    u32 run_end = row_i + column.run_lengths[run_i];
+    if (pred(column.values[run_i])) {
+      if (validity == nullptr) {
+        detail::appendRange(ranges, row_i, run_end);
+      } else {
+        for (u32 begin = detail::findRow(validity, row_i, run_end, true); begin < run_end;) {
+          u32 end = detail::findRow(validity, begin, run_end, false);
+          detail::appendRange(ranges, begin, end);
+          begin = detail::findRow(validity, end, run_end, true);
+        }
+      }
+    }
+    row_i = run_end;
+  }
+  return ranges.size();
+}
+// -------------------------------------------------------------------------------------
+// Same as filter, but writes one BITMAP entry per row. Returns the number of
+// selected rows.
+template <typename T, typename Predicate>
+u32 filter(const RunEncodedColumn<T>& column,
+           BitmapWrapper* nullmap,
+           Predicate pred,
+           BITMAP* result) {
+  const VALIDITY* validity = detail::validity(nullmap, column.tuple_count);
+  u32 selected = 0;
+  u32 row_i = 0;
+  for (u32 run_i = 0; run_i < column.runs_count; run_i++) {
+    u32 run_end = row_i + column.run_lengths[run_i];
+    if (!pred(column.values[run_i])) {
+      std::memset(result + row_i, 0, run_end - row_i);
+    } else if (validity == nullptr) {
+      std::memset(result + row_i, 1, run_end - row_i);
+      selected += run_end - row_i;
+    } else {
+      for (u32 i = row_i; i < run_end; i++) {
+        result[i] = bitmap::PackedBitmap::test(validity, i);
+      }
+      selected += bitmap::PackedBitmap::countOnes(validity, row_i, run_end);
+    }
+    row_i = run_end;
+  }
+  return selected;
+}
+// -------------------------------------------------------------------------------------
+template <typename T>
+u64 count(const RunEncodedColumn<T>& column, BitmapWrapper* nullmap) {
+  u64 result = 0;
+  detail::forEachRun(column, nullmap, [&](u32, u32 rows) { result += rows; });
+  return result;
+}
+// -------------------------------------------------------------------------------------
+template <typename T, typename Predicate>
+u64 count(const RunEncodedColumn<T>& column, BitmapWrapper* nullmap, Predicate pred) {
+  u64 result = 0;
+  detail::forEachRun(column, nullmap, [&](u32 run_i, u32 rows) {
+    if (pred(column.values[run_i])) {
+      result += rows;
+    }
+  });
+  return result;
+}
+// -------------------------------------------------------------------------------------
+// Sum type: s64 for integers, double for doubles
+template <typename T, typename SumType = std::conditional_t<std::is_integral_v<T>, s64, double>>
+SumType sum(const RunEncodedColumn<T>& column, BitmapWrapper* nullmap) {
+  SumType result = 0;
+  detail::forEachRun(column, nullmap, [&](u32 run_i, u32 rows) {
+    result += static_cast<SumType>(column.values[run_i]) * static_cast<SumType>(rows);
+  });
+  return result;
+}
+// -------------------------------------------------------------------------------------
+// min and max return numeric_limits max()/lowest() if every row is NULL
+template <typename T>
+T min(const RunEncodedColumn<T>& column, BitmapWrapper* nullmap) {
+  T result = std::numeric_limits<T>::max();
+  detail::forEachRun(column, nullmap,
+                     [&](u32 run_i, u32) { result = std::min(result, column.values[run_i]); });
+  return result;
+}
+// -------------------------------------------------------------------------------------
+template <typename T>
+T max(const RunEncodedColumn<T>& column, BitmapWrapper* nullmap) {
+  T result = std::numeric_limits<T>::lowest();
+  detail::forEachRun(column, nullmap,
+                     [&](u32 run_i, u32) { result = std::max(result, column.values[run_i]); });
+  return result;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace runs
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -10,18 +10,6 @@
 #include "scheme/CompressionScheme.hpp"
 #include "scheme/SchemePool.hpp"
 // -------------------------------------------------------------------------------------
-#if defined(BTR_FLAG_ENABLE_FOR_SCHEME) && BTR_FLAG_ENABLE_FOR_SCHEME
-#define BTR_ENABLE_FOR_SCHEME 1
-constexpr bool enableFORScheme() {
-  return true;
-}
-#else
-#undef BTR_ENABLE_FOR_SCHEME
-constexpr bool enableFORScheme() {
-  return false;
-}
-#endif
-// -------------------------------------------------------------------------------------
 namespace btrblocks {
 // -------------------------------------------------------------------------------------
 template <typename SchemeType, typename SchemeCodeType>
@@ -31,7 +19,11 @@ template <typename Type, typename SchemeType, typename StatsType, typename Schem
 class CSchemePicker {
  public:
   using MyTypeWrapper = TypeWrapper<SchemeType, SchemeCodeType>;
-  static SchemeType& chooseScheme(StatsType& stats, u8 allowed_cascading_level) {
+  // part: what the column part stores for all of its chunks, only the top level
+  // of a chunk passes it
+  static SchemeType& chooseScheme(StatsType& stats,
+                                  u8 allowed_cascading_level,
+                                  const PartEncoding& part = {}) {
     double max_compression_ratio = 0;
     if (MyTypeWrapper::getOverrideScheme() != autoScheme()) {
       auto scheme_code = MyTypeWrapper::getOverrideScheme();
@@ -51,7 +43,7 @@ class CSchemePicker {
         }
 
         auto compression_ratio =
-            scheme.second->expectedCompressionRatio(stats, allowed_cascading_level);
+            scheme.second->expectedCompressionRatio(stats, allowed_cascading_level, part);
         if (compression_ratio > max_compression_ratio) {
           max_compression_ratio = compression_ratio;
           preferred_scheme = scheme.second.get();
@@ -75,7 +67,8 @@ class CSchemePicker {
                        u32& after_size,
                        u8& scheme_code,
                        u8 force_scheme = autoScheme(),
-                       const string& comment = "?") {
+                       const string& comment = "?",
+                       const PartEncoding& part = {}) {
     Log::debug("Compressing with max level {}", allowed_cascading_level);
     ThreadCache::get().compression_level++;
     StatsType stats = StatsType::generateStats(src, nullmap, tuple_count);
@@ -96,9 +89,9 @@ class CSchemePicker {
       u32 least_after_size = std::numeric_limits<u32>::max();
       // SchemeType *preferred_scheme = nullptr;
       for (auto& scheme : MyTypeWrapper::getSchemes()) {
-        if (scheme.second->expectedCompressionRatio(stats, allowed_cascading_level) > 0) {
-          u32 after_size =
-              scheme.second->compress(src, nullmap, tmp_dest.get(), stats, allowed_cascading_level);
+        if (scheme.second->expectedCompressionRatio(stats, allowed_cascading_level, part) > 0) {
+          u32 after_size = scheme.second->compress(src, nullmap, tmp_dest.get(), stats,
+                                                   allowed_cascading_level, part);
           if (after_size < least_after_size) {
             least_after_size = after_size;
             preferred_scheme = scheme.second.get();
@@ -108,7 +101,8 @@ class CSchemePicker {
       die_if(preferred_scheme != nullptr);
       scheme_code = CB(preferred_scheme->schemeType());
       Log::debug((MyTypeWrapper::getTypeName() + ": {}").c_str(), scheme_code);
-      after_size = preferred_scheme->compress(src, nullmap, dest, stats, allowed_cascading_level);
+      after_size =
+          preferred_scheme->compress(src, nullmap, dest, stats, allowed_cascading_level, part);
     }
     ThreadCache::get().compression_level--;
     return;
@@ -127,15 +121,14 @@ class CSchemePicker {
       after_size = preferred_scheme->compress(src, nullmap, dest, stats, 0);
       scheme_code = CB(preferred_scheme->schemeType());
     }
-#ifdef BTR_ENABLE_FOR_SCHEME
-    else if (MyTypeWrapper::shouldUseFOR(stats.min) && allowed_cascading_level > 1) {
+    // Forced or overridden schemes take precedence over FOR
+    else if (force_scheme == autoScheme() && MyTypeWrapper::getOverrideScheme() == autoScheme() &&
+             MyTypeWrapper::shouldUseFOR(stats) && allowed_cascading_level > 1) {
       Log::debug(MyTypeWrapper::getTypeName() + ": FOR");
       preferred_scheme = &MyTypeWrapper::getFORScheme();
       after_size = preferred_scheme->compress(src, nullmap, dest, stats, allowed_cascading_level);
       scheme_code = CB(preferred_scheme->schemeType());
-    }
-#endif
-    else {
+    } else {
       switch (BtrBlocksConfig::get().scheme_selection) {
         // try all schemes
         case SchemeSelection::TRY_ALL: {
@@ -143,9 +136,10 @@ class CSchemePicker {
           u32 least_after_size = std::numeric_limits<u32>::max();
           // SchemeType *preferred_scheme = nullptr;
           for (auto& scheme : MyTypeWrapper::getSchemes()) {
-            if (scheme.second->expectedCompressionRatio(stats, allowed_cascading_level) > 0) {
+            if (scheme.second->expectedCompressionRatio(stats, allowed_cascading_level, part) >
+                0) {
               u32 after_size = scheme.second->compress(src, nullmap, tmp_dest.get(), stats,
-                                                       allowed_cascading_level);
+                                                       allowed_cascading_level, part);
               if (after_size < least_after_size) {
                 least_after_size = after_size;
                 preferred_scheme = scheme.second.get();
@@ -155,8 +149,8 @@ class CSchemePicker {
           die_if(preferred_scheme != nullptr);
           scheme_code = CB(preferred_scheme->schemeType());
           Log::debug((MyTypeWrapper::getTypeName() + ": {}").c_str(), scheme_code);
-          after_size =
-              preferred_scheme->compress(src, nullmap, dest, stats, allowed_cascading_level);
+          after_size = preferred_scheme->compress(src, nullmap, dest, stats,
+                                                  allowed_cascading_level, part);
           break;
         }
         case SchemeSelection::SAMPLE: {
@@ -166,13 +160,13 @@ class CSchemePicker {
             preferred_scheme = &MyTypeWrapper::getScheme(MyTypeWrapper::getOverrideScheme());
             MyTypeWrapper::getOverrideScheme() = autoScheme();
           } else {
-            preferred_scheme = &chooseScheme(stats, allowed_cascading_level);
+            preferred_scheme = &chooseScheme(stats, allowed_cascading_level, part);
           }
           die_if(preferred_scheme != nullptr);
           scheme_code = CB(preferred_scheme->schemeType());
           Log::debug((MyTypeWrapper::getTypeName() + ": {}").c_str(), scheme_code);
-          after_size =
-              preferred_scheme->compress(src, nullmap, dest, stats, allowed_cascading_level);
+          after_size = preferred_scheme->compress(src, nullmap, dest, stats,
+                                                  allowed_cascading_level, part);
 
           break;
         }
@@ -201,7 +195,7 @@ class CSchemePicker {
                                 '\n';
 #endif
       double estimated_cf =
-          preferred_scheme->expectedCompressionRatio(stats, allowed_cascading_level);
+          preferred_scheme->expectedCompressionRatio(stats, allowed_cascading_level, part);
       ThreadCache::dumpPush(ConvertSchemeTypeToString(static_cast<SchemeCodeType>(scheme_code)),
                             estimated_cf, stats.total_size, after_size, stats.unique_count,
                             comment);
@@ -242,8 +236,11 @@ class TypeWrapper<IntegerScheme, IntegerSchemeType> {
   // -------------------------------------------------------------------------------------
   static inline string getTypeName() { return "INTEGER"; }
   // -------------------------------------------------------------------------------------
-  constexpr static bool shouldUseFOR(INTEGER min) {
-    return enableFORScheme() && (Utils::getBitsNeeded(min) >= 8) &&
+  // Negative or large minimums waste bits in the bit packers. The biased range
+  // has to fit into a non-negative INTEGER.
+  static bool shouldUseFOR(const SInteger32Stats& stats) {
+    return (Utils::getBitsNeeded(stats.min) >= 8) &&
+           static_cast<s64>(stats.max) - stats.min <= std::numeric_limits<INTEGER>::max() &&
            BtrBlocksConfig::get().integers.schemes.isEnabled(IntegerSchemeType::FOR);
   }
   static IntegerScheme& getFORScheme() { return getScheme(IntegerSchemeType::FOR); }
@@ -253,6 +250,36 @@ class TypeWrapper<IntegerScheme, IntegerSchemeType> {
 };
 // -------------------------------------------------------------------------------------
 template <>
+class TypeWrapper<Integer64Scheme, Integer64SchemeType> {
+ public:
+  // -------------------------------------------------------------------------------------
+  static std::unordered_map<Integer64SchemeType, unique_ptr<Integer64Scheme>>& getSchemes() {
+    return SchemePool::available_schemes->bigint_schemes;
+  }
+  // -------------------------------------------------------------------------------------
+  static Integer64Scheme& getScheme(Integer64SchemeType code) { return *getSchemes()[code]; }
+  // -------------------------------------------------------------------------------------
+  static Integer64Scheme& getScheme(u8 code) {
+    return *getSchemes()[static_cast<Integer64SchemeType>(code)];
+  }
+  // -------------------------------------------------------------------------------------
+  static u8& getOverrideScheme() {
+    auto& ref = BtrBlocksConfig::get().bigints.override_scheme;
+    return reinterpret_cast<u8&>(ref);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline string getTypeName() { return "BIGINT"; }
+  // -------------------------------------------------------------------------------------
+  // FOR is picked by sampling like any other scheme, it is also the one that
+  // narrows to the 32-bit schemes
+  static bool shouldUseFOR(const SInteger64Stats&) { return false; }
+  static Integer64Scheme& getFORScheme() { return getScheme(Integer64SchemeType::FOR); }
+  // -------------------------------------------------------------------------------------
+  static u8 maxCascadingLevel() { return BtrBlocksConfig::get().bigints.max_cascade_depth; }
+  // -------------------------------------------------------------------------------------
+};
+// -------------------------------------------------------------------------------------
+template <>
 class TypeWrapper<DoubleScheme, DoubleSchemeType> {
  public:
   // -------------------------------------------------------------------------------------
@@ -273,7 +300,7 @@ class TypeWrapper<DoubleScheme, DoubleSchemeType> {
   // -------------------------------------------------------------------------------------
   static inline string getTypeName() { return "DOUBLE"; }
   // -------------------------------------------------------------------------------------
-  constexpr static bool shouldUseFOR(DOUBLE) { return false; }
+  static bool shouldUseFOR(const DoubleStats&) { return false; }
   static DoubleScheme& getFORScheme() {
     throw std::logic_error("FOR not implemented for doubles.");
   }
@@ -283,6 +310,34 @@ class TypeWrapper<DoubleScheme, DoubleSchemeType> {
 };
 // -------------------------------------------------------------------------------------
 template <>
+class TypeWrapper<FloatScheme, FloatSchemeType> {
+ public:
+  // -------------------------------------------------------------------------------------
+  static std::unordered_map<FloatSchemeType, unique_ptr<FloatScheme>>& getSchemes() {
+    return SchemePool::available_schemes->float_schemes;
+  }
+  // -------------------------------------------------------------------------------------
+  static FloatScheme& getScheme(FloatSchemeType code) { return *getSchemes()[code]; }
+  // -------------------------------------------------------------------------------------
+  static FloatScheme& getScheme(u8 code) {
+    return *getSchemes()[static_cast<FloatSchemeType>(code)];
+  }
+  // -------------------------------------------------------------------------------------
+  static u8& getOverrideScheme() {
+    auto& ref = BtrBlocksConfig::get().floats.override_scheme;
+    return reinterpret_cast<u8&>(ref);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline string getTypeName() { return "FLOAT"; }
+  // -------------------------------------------------------------------------------------
+  static bool shouldUseFOR(const FloatStats&) { return false; }
+  static FloatScheme& getFORScheme() { throw std::logic_error("FOR not implemented for floats."); }
+  // -------------------------------------------------------------------------------------
+  static u8 maxCascadingLevel() { return BtrBlocksConfig::get().floats.max_cascade_depth; }
+  // -------------------------------------------------------------------------------------
+};
+// -------------------------------------------------------------------------------------
+template <>
 class TypeWrapper<StringScheme, StringSchemeType> {
  public:
   // -------------------------------------------------------------------------------------
@@ -303,7 +358,7 @@ class TypeWrapper<StringScheme, StringSchemeType> {
   // -------------------------------------------------------------------------------------
   static inline string getTypeName() { return "STRING"; }
   // -------------------------------------------------------------------------------------
-  constexpr static bool shouldUseFOR(str) { return false; }
+  static bool shouldUseFOR(const StringStats&) { return false; }
   static StringScheme& getFORScheme() {
     throw std::logic_error("FOR not implemented for strings.");
   }
@@ -314,6 +369,9 @@ class TypeWrapper<StringScheme, StringSchemeType> {
 // -------------------------------------------------------------------------------------
 using IntegerSchemePicker =
     CSchemePicker<INTEGER, IntegerScheme, SInteger32Stats, IntegerSchemeType>;
+using Integer64SchemePicker =
+    CSchemePicker<BIGINT, Integer64Scheme, SInteger64Stats, Integer64SchemeType>;
 using DoubleSchemePicker = CSchemePicker<DOUBLE, DoubleScheme, DoubleStats, DoubleSchemeType>;
+using FloatSchemePicker = CSchemePicker<FLOAT, FloatScheme, FloatStats, FloatSchemeType>;
 using StringSchemePicker = CSchemePicker<str, StringScheme, StringStats, StringSchemeType>;
 }  // namespace btrblocks
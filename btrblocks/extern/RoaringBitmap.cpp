@@ -1,15 +1,263 @@
 #include "RoaringBitmap.hpp"
 // -------------------------------------------------------+------------------------------
+#include "common/CpuDispatch.hpp"
 #include "common/Log.hpp"
 // -------------------------------------------------------+------------------------------
 
+#include <algorithm>
+#include <cstring>
 // -------------------------------------------------------------------------------------
 namespace btrblocks::bitmap {
+// -------------------------------------------------------------------------------------
+namespace {
+// Sets all words to ones, except for the bits past tuple_count
+void fillOnes(VALIDITY* dest, u32 tuple_count) {
+  const u32 word_count = PackedBitmap::wordCount(tuple_count);
+  std::fill_n(dest, word_count, ~VALIDITY{0});
+  if (tuple_count % 64 != 0) {
+    dest[word_count - 1] = (VALIDITY{1} << (tuple_count % 64)) - 1;
+  }
+}
+// -------------------------------------------------------------------------------------
+// Sets the bits [begin, end), whole words at a time
+void setRange(VALIDITY* dest, u32 begin, u32 end) {
+  const u32 first_word = begin / 64, last_word = (end - 1) / 64;
+  const VALIDITY first_mask = ~VALIDITY{0} << (begin % 64);
+  const VALIDITY last_mask = ~VALIDITY{0} >> (63 - (end - 1) % 64);
+  if (first_word == last_word) {
+    dest[first_word] |= first_mask & last_mask;
+    return;
+  }
+  dest[first_word] |= first_mask;
+  std::fill(dest + first_word + 1, dest + last_word, ~VALIDITY{0});
+  dest[last_word] |= last_mask;
+}
+// -------------------------------------------------------------------------------------
+// Writes the words of a REGULAR or FLIPPED nullmap straight from the serialized
+// containers: bitset containers are copied, runs and arrays set their ranges
+void writeWords(VALIDITY* dest, const u8* src, BitmapType type, u32 tuple_count) {
+  const u32 word_count = PackedBitmap::wordCount(tuple_count);
+  std::fill_n(dest, word_count, VALIDITY{0});
+  RoaringView(src).decode([&](u32 begin, u32 end) { setRange(dest, begin, end); },
+                          [&](u32 first_word, const u8* words, u32 count) {
+                            if (first_word < word_count) {
+                              count = std::min(count, word_count - first_word);
+                              std::memcpy(dest + first_word, words, count * sizeof(VALIDITY));
+                            }
+                          });
+  // -------------------------------------------------------------------------------------
+  if (type == BitmapType::FLIPPED) {
+    // The positions are the null rows
+    for (u32 word_i = 0; word_i < word_count; word_i++) {
+      dest[word_i] = ~dest[word_i];
+    }
+  }
+  // A bitset container may have bits past tuple_count
+  if (tuple_count % 64 != 0) {
+    dest[word_count - 1] &= (VALIDITY{1} << (tuple_count % 64)) - 1;
+  }
+}
+// -------------------------------------------------------------------------------------
+void decodeValidity(VALIDITY* dest, const u8* src, BitmapType type, u32 tuple_count) {
+  switch (type) {
+    case BitmapType::ALLONES: {
+      fillOnes(dest, tuple_count);
+      break;
+    }
+    case BitmapType::ALLZEROS: {
+      std::fill_n(dest, PackedBitmap::wordCount(tuple_count), VALIDITY{0});
+      break;
+    }
+    case BitmapType::REGULAR:
+    case BitmapType::FLIPPED: {
+      writeWords(dest, src, type, tuple_count);
+      break;
+    }
+    default: {
+      throw Generic_Exception("Unknown BitmapType " + std::to_string(static_cast<int>(type)));
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
+// The vectorized loops handle the full blocks and return the number of rows done
+// -------------------------------------------------------------------------------------
+#ifdef BTR_WITH_AVX2
+BTR_TARGET_AVX2 u32 packAVX2(VALIDITY* dest, const BITMAP* src, u32 tuple_count) {
+  u32 row_i = 0;
+  const __m256i zero = _mm256_setzero_si256();
+  for (; row_i + 64 <= tuple_count; row_i += 64) {
+    // The byte masks of the null rows, inverted
+    auto in = reinterpret_cast<const __m256i*>(src + row_i);
+    const u32 low = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(in), zero));
+    const u32 high = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256(in + 1), zero));
+    *dest++ = ~((static_cast<VALIDITY>(high) << 32) | low);
+  }
+  return row_i;
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX2 u32 unpackAVX2(BITMAP* dest, const VALIDITY* src, u32 tuple_count) {
+  u32 row_i = 0;
+  // Byte j of a block of 32 rows tests bit j % 8 of byte j / 8 of the block's bits
+  const __m256i spread = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,  //
+                                          2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+  const __m256i select = _mm256_set1_epi64x(0x8040201008040201);
+  const __m256i one = _mm256_set1_epi8(1);
+  for (; row_i + 32 <= tuple_count; row_i += 32) {
+    const u32 bits = static_cast<u32>(src[row_i / 64] >> (row_i % 64));
+    __m256i bytes = _mm256_shuffle_epi8(_mm256_set1_epi32(bits), spread);
+    bytes = _mm256_cmpeq_epi8(_mm256_and_si256(bytes, select), select);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + row_i), _mm256_and_si256(bytes, one));
+  }
+  return row_i;
+}
+#endif  // BTR_WITH_AVX2
+// -------------------------------------------------------------------------------------
+#ifdef BTR_USE_DISPATCH
+// A validity word is exactly one AVX-512 byte mask
+BTR_TARGET_AVX512 u32 packAVX512(VALIDITY* dest, const BITMAP* src, u32 tuple_count) {
+  u32 row_i = 0;
+  const __m512i zero = _mm512_setzero_si512();
+  for (; row_i + 64 <= tuple_count; row_i += 64) {
+    *dest++ = _mm512_cmpneq_epi8_mask(_mm512_loadu_si512(src + row_i), zero);
+  }
+  return row_i;
+}
+// -------------------------------------------------------------------------------------
+BTR_TARGET_AVX512 u32 unpackAVX512(BITMAP* dest, const VALIDITY* src, u32 tuple_count) {
+  u32 row_i = 0;
+  for (; row_i + 64 <= tuple_count; row_i += 64) {
+    _mm512_storeu_si512(dest + row_i, _mm512_maskz_set1_epi8(src[row_i / 64], 1));
+  }
+  return row_i;
+}
+#endif  // BTR_USE_DISPATCH
+// -------------------------------------------------------------------------------------
+u32 packVectorized([[maybe_unused]] VALIDITY* dest,
+                   [[maybe_unused]] const BITMAP* src,
+                   [[maybe_unused]] u32 tuple_count) {
+#ifdef BTR_USE_DISPATCH
+  if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+    return packAVX512(dest, src, tuple_count);
+  }
+#endif
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return packAVX2(dest, src, tuple_count);
+  }
+#endif
+  return 0;
+}
+// -------------------------------------------------------------------------------------
+u32 unpackVectorized([[maybe_unused]] BITMAP* dest,
+                     [[maybe_unused]] const VALIDITY* src,
+                     [[maybe_unused]] u32 tuple_count) {
+#ifdef BTR_USE_DISPATCH
+  if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+    return unpackAVX512(dest, src, tuple_count);
+  }
+#endif
+#ifdef BTR_WITH_AVX2
+  if (CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    return unpackAVX2(dest, src, tuple_count);
+  }
+#endif
+  return 0;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+void PackedBitmap::pack(VALIDITY* dest, const BITMAP* src, u32 tuple_count) {
+  u32 row_i = packVectorized(dest, src, tuple_count);
+  for (auto write_ptr = dest + row_i / 64; row_i < tuple_count; row_i += 64) {
+    const u32 end = std::min(tuple_count - row_i, 64u);
+    VALIDITY word = 0;
+    for (u32 bit_i = 0; bit_i < end; bit_i++) {
+      word |= static_cast<VALIDITY>(src[row_i + bit_i] != 0) << bit_i;
+    }
+    *write_ptr++ = word;
+  }
+}
+// -------------------------------------------------------------------------------------
+void PackedBitmap::unpack(BITMAP* dest, const VALIDITY* src, u32 tuple_count) {
+  u32 row_i = unpackVectorized(dest, src, tuple_count);
+  for (; row_i < tuple_count; row_i++) {
+    dest[row_i] = test(src, row_i);
+  }
+}
+// -------------------------------------------------------------------------------------
+u32 PackedBitmap::countOnes(const VALIDITY* src, u32 tuple_count) {
+  u32 count = 0;
+  for (u32 word_i = 0; word_i < tuple_count / 64; word_i++) {
+    count += __builtin_popcountll(src[word_i]);
+  }
+  if (tuple_count % 64 != 0) {
+    const VALIDITY tail_mask = (VALIDITY{1} << (tuple_count % 64)) - 1;
+    count += __builtin_popcountll(src[tuple_count / 64] & tail_mask);
+  }
+  return count;
+}
+// -------------------------------------------------------------------------------------
+u32 PackedBitmap::countOnes(const VALIDITY* src, u32 begin, u32 end) {
+  if (begin >= end) {
+    return 0;
+  }
+  const u32 first_word = begin / 64, last_word = (end - 1) / 64;
+  const VALIDITY first_mask = ~VALIDITY{0} << (begin % 64);
+  const VALIDITY last_mask = ~VALIDITY{0} >> (63 - (end - 1) % 64);
+  if (first_word == last_word) {
+    return __builtin_popcountll(src[first_word] & first_mask & last_mask);
+  }
+  u32 count = __builtin_popcountll(src[first_word] & first_mask);
+  for (u32 word_i = first_word + 1; word_i < last_word; word_i++) {
+    count += __builtin_popcountll(src[word_i]);
+  }
+  return count + __builtin_popcountll(src[last_word] & last_mask);
+}
+// -------------------------------------------------------------------------------------
+RoaringView::RoaringView(const u8* src) {
+  switch (src[0]) {
+    case SERIALIZATION_ARRAY_UINT32: {
+      m_cardinality = load<u32>(src + 1);
+      m_positions = src + 1 + sizeof(u32);
+      break;
+    }
+    case SERIALIZATION_CONTAINER: {
+      auto read_ptr = src + 1;
+      const u32 cookie = load<u32>(read_ptr);
+      read_ptr += sizeof(u32);
+      if ((cookie & 0xFFFF) == SERIAL_COOKIE) {
+        m_containers = (cookie >> 16) + 1;
+        m_run_flags = read_ptr;
+        read_ptr += (m_containers + 7) / 8;
+      } else if (cookie == SERIAL_COOKIE_NO_RUNCONTAINER) {
+        m_containers = load<u32>(read_ptr);
+        read_ptr += sizeof(u32);
+      } else {
+        throw Generic_Exception("Invalid roaring cookie " + std::to_string(cookie));
+      }
+      m_header = read_ptr;
+      read_ptr += m_containers * 2 * sizeof(u16);
+      // The offsets of the containers, they are stored in order anyway
+      if (m_run_flags == nullptr || m_containers >= NO_OFFSET_THRESHOLD) {
+        read_ptr += m_containers * sizeof(u32);
+      }
+      m_data = read_ptr;
+      for (u32 container_i = 0; container_i < m_containers; container_i++) {
+        m_cardinality += load<u16>(m_header + container_i * 4 + 2) + 1u;
+      }
+      break;
+    }
+    default: {
+      throw Generic_Exception("Invalid roaring serialization " + std::to_string(src[0]));
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
 BitmapWrapper::BitmapWrapper(const u8* src,
                              BitmapType type,
                              u32 tuple_count,
                              boost::dynamic_bitset<>* bitset)
-    : m_tuple_count(tuple_count), m_bitset(bitset), m_type(type) {
+    : m_tuple_count(tuple_count), m_src(src), m_bitset(bitset), m_type(type) {
   if (type == BitmapType::ALLONES) {
     this->m_cardinality = tuple_count;
     return;
@@ -18,8 +266,7 @@ BitmapWrapper::BitmapWrapper(const u8* src,
     return;
   }
 
-  this->m_roaring = Roaring::read(reinterpret_cast<const char*>(src), false);
-  this->m_cardinality = this->m_roaring.cardinality();
+  this->m_cardinality = RoaringView(src).cardinality();
   if (type == BitmapType::FLIPPED) {
     this->m_cardinality = this->m_tuple_count - this->m_cardinality;
   }
@@ -32,21 +279,18 @@ BitmapWrapper::~BitmapWrapper() {
 void BitmapWrapper::writeBITMAP(BITMAP* dest) {
   switch (this->m_type) {
     case BitmapType::ALLONES: {
-      for (u32 i = 0; i < this->m_tuple_count; i++) {
-        dest[i] = 1;
-      }
+      std::memset(dest, 1, this->m_tuple_count);
       break;
     }
     case BitmapType::ALLZEROS: {
-      for (u32 i = 0; i < this->m_tuple_count; i++) {
-        dest[i] = 0;
-      }
+      std::memset(dest, 0, this->m_tuple_count);
       break;
     }
     default: {
-      for (u32 i = 0; i < this->m_tuple_count; i++) {
-        dest[i] = this->get_bitset()->test(i) ? 1 : 0;
-      }
+      thread_local std::vector<VALIDITY> validity;
+      validity.resize(PackedBitmap::wordCount(this->m_tuple_count));
+      this->writeValidity(validity.data());
+      PackedBitmap::unpack(dest, validity.data(), this->m_tuple_count);
       break;
     }
   }
@@ -58,6 +302,18 @@ std::vector<BITMAP> BitmapWrapper::writeBITMAP() {
   return result;
 }
 
+void BitmapWrapper::writeValidity(VALIDITY* dest) {
+  decodeValidity(dest, this->m_src, this->m_type, this->m_tuple_count);
+}
+
+Roaring& BitmapWrapper::roaring() {
+  if (!this->m_roaring_initialized) {
+    this->m_roaring = Roaring::read(reinterpret_cast<const char*>(this->m_src), false);
+    this->m_roaring_initialized = true;
+  }
+  return this->m_roaring;
+}
+
 void BitmapWrapper::releaseBitset() {
   this->m_bitset = nullptr;
   this->m_bitset_initialized = false;
@@ -81,26 +337,13 @@ boost::dynamic_bitset<>* BitmapWrapper::get_bitset() {
       this->m_bitset->reset();
       break;
     }
-    case BitmapType::REGULAR: {
-      this->m_bitset->reset();
-      this->m_roaring.iterate(
-          [](uint32_t value, void* param) {
-            auto bitset = reinterpret_cast<boost::dynamic_bitset<>*>(param);
-            bitset->set(value, true);
-            return true;
-          },
-          this->m_bitset);
-      break;
-    }
+    case BitmapType::REGULAR:
     case BitmapType::FLIPPED: {
-      this->m_bitset->set();
-      this->m_roaring.iterate(
-          [](uint32_t value, void* param) {
-            auto bitset = reinterpret_cast<boost::dynamic_bitset<>*>(param);
-            bitset->set(value, false);
-            return true;
-          },
-          this->m_bitset);
+      static_assert(sizeof(boost::dynamic_bitset<>::block_type) == sizeof(VALIDITY));
+      thread_local std::vector<VALIDITY> validity;
+      validity.resize(PackedBitmap::wordCount(this->m_tuple_count));
+      this->writeValidity(validity.data());
+      boost::from_block_range(validity.begin(), validity.end(), *this->m_bitset);
       break;
     }
     default: {
@@ -117,40 +360,48 @@ boost::dynamic_bitset<>* BitmapWrapper::get_bitset() {
 std::pair<u32, BitmapType> RoaringBitmap::compress(const BITMAP* bitmap,
                                                    u8* dest,
                                                    u32 tuple_count) {
+  thread_local std::vector<VALIDITY> validity;
+  validity.resize(PackedBitmap::wordCount(tuple_count));
+  PackedBitmap::pack(validity.data(), bitmap, tuple_count);
+  return compress(validity.data(), dest, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+std::pair<u32, BitmapType> RoaringBitmap::compress(const VALIDITY* validity,
+                                                   u8* dest,
+                                                   u32 tuple_count) {
   // Returns a pair of compressed size and the type of bitmap used
-
-  // Determine the bitmap type by counting 1s
-  u32 ones_count = 0;
-  for (u32 i = 0; i < tuple_count; i++) {
-    ones_count += bitmap[i];
-  }
-
+  const u32 ones_count = PackedBitmap::countOnes(validity, tuple_count);
   if (ones_count == 0) {
     return {0, BitmapType::ALLZEROS};
   } else if (ones_count == tuple_count) {
     return {0, BitmapType::ALLONES};
   }
 
-  BITMAP check_value;
-  BitmapType type;
-  if (ones_count < tuple_count / 2) {
-    type = BitmapType::REGULAR;
-    check_value = 1;
-  } else {
-    // There are more 1s than 0s in the Bitmap. In oder to save space and
-    // computation time during decompression of the roaring bitmap we simply
-    // flip the bits. (Less 1s => Smaller Roaring bitmap)
-    type = BitmapType::FLIPPED;
-    check_value = 0;
+  // If there are more 1s than 0s in the Bitmap, we store the 0s instead. In
+  // order to save space and computation time during decompression of the
+  // roaring bitmap we simply flip the bits. (Less 1s => Smaller Roaring bitmap)
+  const bool flip = ones_count >= tuple_count / 2;
+  const BitmapType type = flip ? BitmapType::FLIPPED : BitmapType::REGULAR;
+
+  // Collect the positions word by word
+  thread_local std::vector<u32> positions;
+  positions.resize(flip ? tuple_count - ones_count : ones_count);
+  u32 position_i = 0;
+  const u32 word_count = PackedBitmap::wordCount(tuple_count);
+  for (u32 word_i = 0; word_i < word_count; word_i++) {
+    VALIDITY word = flip ? ~validity[word_i] : validity[word_i];
+    if (word_i == word_count - 1 && tuple_count % 64 != 0) {
+      word &= (VALIDITY{1} << (tuple_count % 64)) - 1;
+    }
+    while (word != 0) {
+      positions[position_i++] = word_i * 64 + __builtin_ctzll(word);
+      word &= word - 1;
+    }
   }
 
   // Write the actual bitmap
   Roaring r;
-  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
-    if (bitmap[row_i] == check_value) {
-      r.add(row_i);
-    }
-  }
+  r.addMany(position_i, positions.data());
   r.runOptimize();
   r.setCopyOnWrite(true);
   u32 compressed_size = r.write(reinterpret_cast<char*>(dest), false);
@@ -158,4 +409,8 @@ std::pair<u32, BitmapType> RoaringBitmap::compress(const BITMAP* bitmap,
   return {compressed_size, type};
 }
 // -------------------------------------------------------------------------------------
+void RoaringBitmap::decompress(VALIDITY* dest, const u8* src, BitmapType type, u32 tuple_count) {
+  decodeValidity(dest, src, type, tuple_count);
+}
+// -------------------------------------------------------------------------------------
 }  // namespace btrblocks::bitmap
@@ -5,12 +5,131 @@
 #include <boost/dynamic_bitset.hpp>
 #include <roaring/roaring.hh>
 // -------------------------------------------------------------------------------------
+#include <cstring>
+// -------------------------------------------------------------------------------------
 namespace btrblocks::bitmap {
+// -------------------------------------------------------------------------------------
+// Bit-packed validity: bit (row % 64) of word (row / 64) is set if the row is not
+// null, the bits past tuple_count are 0. It takes an eighth of the memory of a
+// BITMAP per tuple.
+class PackedBitmap {
+ public:
+  static constexpr u32 wordCount(u32 tuple_count) { return (tuple_count + 63) / 64; }
+  static inline bool test(const VALIDITY* validity, u32 row) {
+    return (validity[row / 64] >> (row % 64)) & 1;
+  }
+  static void pack(VALIDITY* dest, const BITMAP* src, u32 tuple_count);
+  // Writes 0 or 1 per tuple
+  static void unpack(BITMAP* dest, const VALIDITY* src, u32 tuple_count);
+  static u32 countOnes(const VALIDITY* src, u32 tuple_count);
+  // Set rows in [begin, end)
+  static u32 countOnes(const VALIDITY* src, u32 begin, u32 end);
+};
+// -------------------------------------------------------------------------------------
+// Reads a bitmap serialized with Roaring::write(dest, false) container by
+// container, in place. Nothing is deserialized or allocated and the positions
+// are never materialized one by one. The layout is CRoaring's
+// roaring_bitmap_serialize: either 1, a u32 count and the sorted u32 positions,
+// or 2 and the portable format (RoaringFormatSpec) with array, bitset and run
+// containers. Everything is little-endian.
+class RoaringView {
+ public:
+  explicit RoaringView(const u8* src);
+  [[nodiscard]] inline u32 cardinality() const { return m_cardinality; }
+  // Calls on_range(begin, end) for every maximal run [begin, end) of positions
+  // in the array and run containers and on_words(first_word, words, count) for
+  // the count 64-bit words of a bitset container, whose bit i is position
+  // first_word * 64 + i. The calls come in ascending order of the positions,
+  // words may be unaligned.
+  template <typename OnRange, typename OnWords>
+  void decode(OnRange&& on_range, OnWords&& on_words) const;
+
+ private:
+  static constexpr u8 SERIALIZATION_ARRAY_UINT32 = 1;
+  static constexpr u8 SERIALIZATION_CONTAINER = 2;
+  static constexpr u32 SERIAL_COOKIE_NO_RUNCONTAINER = 12346;
+  static constexpr u32 SERIAL_COOKIE = 12347;
+  static constexpr u32 NO_OFFSET_THRESHOLD = 4;
+  static constexpr u32 MAX_ARRAY_CARDINALITY = 4096;
+  static constexpr u32 BITSET_WORDS = (1u << 16) / 64;
+
+  template <typename T>
+  static inline T load(const u8* src) {
+    T value;
+    std::memcpy(&value, src, sizeof(T));
+    return value;
+  }
+
+  u32 m_cardinality = 0;
+  u32 m_containers = 0;
+  // Positions of the SERIALIZATION_ARRAY_UINT32 layout
+  const u8* m_positions = nullptr;
+  // Run container flags, per container key and cardinality - 1, container data
+  const u8* m_run_flags = nullptr;
+  const u8* m_header = nullptr;
+  const u8* m_data = nullptr;
+};
+// -------------------------------------------------------------------------------------
+template <typename OnRange, typename OnWords>
+void RoaringView::decode(OnRange&& on_range, OnWords&& on_words) const {
+  // Adjacent positions of arrays and runs are merged, also across containers
+  u32 begin = 0, end = 0;
+  auto add = [&](u32 range_begin, u32 range_end) {
+    if (range_begin != end) {
+      if (begin != end) {
+        on_range(begin, end);
+      }
+      begin = range_begin;
+    }
+    end = range_end;
+  };
+  if (m_positions != nullptr) {
+    for (u32 position_i = 0; position_i < m_cardinality; position_i++) {
+      const u32 position = load<u32>(m_positions + position_i * sizeof(u32));
+      add(position, position + 1);
+    }
+  } else {
+    const u8* data = m_data;
+    for (u32 container_i = 0; container_i < m_containers; container_i++) {
+      const u32 base = static_cast<u32>(load<u16>(m_header + container_i * 4)) << 16;
+      const u32 cardinality = load<u16>(m_header + container_i * 4 + 2) + 1u;
+      if (m_run_flags != nullptr && (m_run_flags[container_i / 8] >> (container_i % 8)) & 1) {
+        const u16 runs_count = load<u16>(data);
+        data += sizeof(u16);
+        for (u32 run_i = 0; run_i < runs_count; run_i++, data += 2 * sizeof(u16)) {
+          const u32 start = base + load<u16>(data);
+          add(start, start + load<u16>(data + sizeof(u16)) + 1);
+        }
+      } else if (cardinality > MAX_ARRAY_CARDINALITY) {
+        if (begin != end) {
+          on_range(begin, end);
+          begin = end;
+        }
+        on_words(base / 64, data, BITSET_WORDS);
+        data += BITSET_WORDS * sizeof(u64);
+      } else {
+        for (u32 value_i = 0; value_i < cardinality; value_i++, data += sizeof(u16)) {
+          const u32 position = base + load<u16>(data);
+          add(position, position + 1);
+        }
+      }
+    }
+  }
+  if (begin != end) {
+    on_range(begin, end);
+  }
+}
+// -------------------------------------------------------------------------------------
+// The nullmap of a compressed chunk. It decodes the serialized bitmap in place,
+// so it must not outlive the chunk.
 class BitmapWrapper {
  private:
   u32 m_tuple_count;
   u32 m_cardinality;
+  const u8* m_src;
+  // Only deserialized for roaring(), the rest decodes m_src in place
   Roaring m_roaring;
+  bool m_roaring_initialized = false;
   boost::dynamic_bitset<>* m_bitset = nullptr;
   bool m_bitset_initialized = false;
   BitmapType m_type;
@@ -23,16 +142,22 @@ class BitmapWrapper {
   virtual ~BitmapWrapper();
   void writeBITMAP(BITMAP* dest);
   std::vector<BITMAP> writeBITMAP();
+  // Writes PackedBitmap::wordCount(tuple_count) words
+  void writeValidity(VALIDITY* dest);
   boost::dynamic_bitset<>* get_bitset();
   void releaseBitset();
   [[nodiscard]] inline bool test(u32 idx) { return this->get_bitset()->test(idx); }
   [[nodiscard]] inline u32 cardinality() const { return this->m_cardinality; };
   [[nodiscard]] inline BitmapType type() const { return this->m_type; };
-  [[nodiscard]] inline Roaring& roaring() { return this->m_roaring; };
+  Roaring& roaring();
 };
 class RoaringBitmap {
  public:
   static std::pair<u32, BitmapType> compress(const BITMAP* bitmap, u8* dest, u32 tuple_count);
+  static std::pair<u32, BitmapType> compress(const VALIDITY* validity, u8* dest, u32 tuple_count);
+  // Writes PackedBitmap::wordCount(tuple_count) words of a compressed nullmap,
+  // without a BitmapWrapper or a bitset
+  static void decompress(VALIDITY* dest, const u8* src, BitmapType type, u32 tuple_count);
 };
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks::bitmap
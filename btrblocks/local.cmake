@@ -16,6 +16,11 @@ if (${NO_SIMD})
     add_compile_definitions(BTR_FLAG_NO_SIMD=1)
 endif()
 
+if (${PORTABLE})
+    message("Building portable btrblocks, SIMD kernels are dispatched at runtime")
+    add_compile_definitions(BTR_FLAG_PORTABLE=1)
+endif()
+
 if (${WITH_LOGGING})
     message("Enabling logging for btrblocks")
     add_compile_definitions(BTR_FLAG_LOGGING=1)
@@ -26,11 +31,6 @@ if (${SAMPLING_TEST_MODE})
     add_compile_definitions(BTR_FLAG_SAMPLING_TEST_MODE=1)
 endif()
 
-if (${ENABLE_FOR_SCHEME})
-    message("Enabling FOR scheme for btrblocks")
-    add_compile_definitions(BTR_FLAG_ENABLE_FOR_SCHEME=1)
-endif()
-
 # ---------------------------------------------------------------------------
 # Files
 # ---------------------------------------------------------------------------
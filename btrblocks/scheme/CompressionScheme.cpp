@@ -2,6 +2,9 @@
 #include "CompressionScheme.hpp"
 #include "btrblocks.hpp"
 #include "cache/ThreadCache.hpp"
+#include "common/Hash.hpp"
+#include "common/Utils.hpp"
+#include "storage/StringPointerArrayViewer.hpp"
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
 // -------------------------------------------------------------------------------------
@@ -25,6 +28,26 @@ double DoubleScheme::expectedCompressionRatio(DoubleStats& stats, u8 allowed_cas
   return CD(total_before) / CD(total_after);
 }
 // -------------------------------------------------------------------------------------
+double FloatScheme::expectedCompressionRatio(FloatStats& stats, u8 allowed_cascading_level) {
+  auto& cfg = BtrBlocksConfig::get();
+  auto dest = makeBytesArray(CS(cfg.sample_size) * cfg.sample_count * sizeof(FLOAT) * 100);
+  u32 total_before = 0;
+  u32 total_after = 0;
+  if (ThreadCache::get().estimation_level++ >= 1) {
+    total_before += stats.total_size;
+    total_after += compress(stats.src, stats.bitmap, dest.get(), stats, allowed_cascading_level);
+  } else {
+    auto sample = stats.samples(cfg.sample_count, cfg.sample_size);
+    FloatStats c_stats = FloatStats::generateStats(
+        std::get<0>(sample).data(), std::get<1>(sample).data(), std::get<0>(sample).size());
+    total_before += c_stats.total_size;
+    total_after += compress(std::get<0>(sample).data(), std::get<1>(sample).data(), dest.get(),
+                            c_stats, allowed_cascading_level);
+  }
+  ThreadCache::get().estimation_level--;
+  return CD(total_before) / CD(total_after);
+}
+// -------------------------------------------------------------------------------------
 double IntegerScheme::expectedCompressionRatio(SInteger32Stats& stats, u8 allowed_cascading_level) {
   auto& cfg = BtrBlocksConfig::get();
   auto dest = makeBytesArray(CS(cfg.sample_size) * cfg.sample_count * sizeof(INTEGER) * 100);
@@ -45,6 +68,124 @@ double IntegerScheme::expectedCompressionRatio(SInteger32Stats& stats, u8 allowe
   return CD(total_before) / CD(total_after);
 }
 // -------------------------------------------------------------------------------------
+double Integer64Scheme::expectedCompressionRatio(SInteger64Stats& stats,
+                                                 u8 allowed_cascading_level) {
+  auto& cfg = BtrBlocksConfig::get();
+  auto dest = makeBytesArray(CS(cfg.sample_size) * cfg.sample_count * sizeof(BIGINT) * 100);
+  u32 total_before = 0;
+  u32 total_after = 0;
+  if (ThreadCache::get().estimation_level++ >= 1) {
+    total_before += stats.total_size;
+    total_after += compress(stats.src, stats.bitmap, dest.get(), stats, allowed_cascading_level);
+  } else {
+    auto sample = stats.samples(cfg.sample_count, cfg.sample_size);
+    SInteger64Stats c_stats = SInteger64Stats::generateStats(
+        std::get<0>(sample).data(), std::get<1>(sample).data(), std::get<0>(sample).size());
+    total_before += c_stats.total_size;
+    total_after += compress(std::get<0>(sample).data(), std::get<1>(sample).data(), dest.get(),
+                            c_stats, allowed_cascading_level);
+  }
+  ThreadCache::get().estimation_level--;
+  return CD(total_before) / CD(total_after);
+}
+// -------------------------------------------------------------------------------------
+void IntegerScheme::hash(u64* dest,
+                         BitmapWrapper* nullmap,
+                         const u8* src,
+                         u32 tuple_count,
+                         u32 level) {
+  thread_local std::vector<std::vector<INTEGER>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  this->decompress(values, nullmap, src, tuple_count, level);
+  Hash::hashColumn(dest, values, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void IntegerScheme::decompressNarrow(SMALLINT* dest,
+                                     BitmapWrapper* nullmap,
+                                     const u8* src,
+                                     u32 tuple_count,
+                                     u32 level) {
+  thread_local std::vector<std::vector<INTEGER>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  this->decompress(values, nullmap, src, tuple_count, level);
+  Utils::narrowIntegers(dest, values, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void IntegerScheme::decompressNarrow(TINYINT* dest,
+                                     BitmapWrapper* nullmap,
+                                     const u8* src,
+                                     u32 tuple_count,
+                                     u32 level) {
+  thread_local std::vector<std::vector<INTEGER>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  this->decompress(values, nullmap, src, tuple_count, level);
+  Utils::narrowIntegers(dest, values, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void Integer64Scheme::hash(u64* dest,
+                           BitmapWrapper* nullmap,
+                           const u8* src,
+                           u32 tuple_count,
+                           u32 level) {
+  thread_local std::vector<std::vector<BIGINT>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(BIGINT), level);
+  this->decompress(values, nullmap, src, tuple_count, level);
+  Hash::hashColumn(dest, values, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void DoubleScheme::hash(u64* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) {
+  thread_local std::vector<std::vector<DOUBLE>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(DOUBLE), level);
+  this->decompress(values, nullmap, src, tuple_count, level);
+  Hash::hashColumn(dest, values, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void FloatScheme::hash(u64* dest,
+                       BitmapWrapper* nullmap,
+                       const u8* src,
+                       u32 tuple_count,
+                       u32 level) {
+  thread_local std::vector<std::vector<FLOAT>> values_v;
+  auto values = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(FLOAT), level);
+  this->decompress(values, nullmap, src, tuple_count, level);
+  Hash::hashColumn(dest, values, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void StringScheme::hash(u64* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) {
+  this->hashDecompressed(dest, nullmap, src, tuple_count, level, {});
+}
+// -------------------------------------------------------------------------------------
+void StringScheme::hashDecompressed(u64* dest,
+                                    BitmapWrapper* nullmap,
+                                    const u8* src,
+                                    u32 tuple_count,
+                                    u32 level,
+                                    const PartData& part) {
+  // +8 and +4096 for the same fsst reasons as in BtrReader::getDecompressedSize
+  u32 size = this->getDecompressedSizeNoCopy(src, tuple_count, nullmap) + 8 + 4096;
+  thread_local std::vector<std::vector<u8>> strings_v;
+  auto strings = get_level_data(strings_v, size + SIMD_EXTRA_BYTES, level);
+  if (this->decompressNoCopy(strings, nullmap, src, tuple_count, level, part)) {
+    StringPointerArrayViewer viewer(strings);
+    for (u32 i = 0; i < tuple_count; i++) {
+      dest[i] = Hash::hashValue(viewer(i));
+    }
+  } else {
+    StringArrayViewer viewer(strings);
+    for (u32 i = 0; i < tuple_count; i++) {
+      dest[i] = Hash::hashValue(viewer(i));
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
 string ConvertSchemeTypeToString(IntegerSchemeType type) {
   switch (type) {
     case IntegerSchemeType::PFOR:
@@ -55,6 +196,12 @@ string ConvertSchemeTypeToString(IntegerSchemeType type) {
       return "BP";
     case IntegerSchemeType::RLE:
       return "RLE";
+    case IntegerSchemeType::DELTA:
+      return "DELTA";
+    case IntegerSchemeType::SEQUENCE:
+      return "SEQUENCE";
+    case IntegerSchemeType::SPARSE:
+      return "SPARSE";
     case IntegerSchemeType::DICT:
       return "DICT";
     case IntegerSchemeType::FREQUENCY:
@@ -78,10 +225,41 @@ string ConvertSchemeTypeToString(IntegerSchemeType type) {
   }
 }
 // ------------------------------------------------------------------------------
+string ConvertSchemeTypeToString(Integer64SchemeType type) {
+  switch (type) {
+    case Integer64SchemeType::FOR:
+      return "FOR";
+    case Integer64SchemeType::RLE:
+      return "RLE";
+    case Integer64SchemeType::DELTA:
+      return "DELTA";
+    case Integer64SchemeType::DELTA_OF_DELTA:
+      return "DELTA_OF_DELTA";
+    case Integer64SchemeType::SPARSE:
+      return "SPARSE";
+    case Integer64SchemeType::DICT:
+      return "DICT";
+    case Integer64SchemeType::FREQUENCY:
+      return "FREQUENCY";
+    case Integer64SchemeType::ONE_VALUE:
+      return "ONE_VALUE";
+    case Integer64SchemeType::UNCOMPRESSED:
+      return "UNCOMPRESSED";
+    default:
+      throw Generic_Exception("Unknown Integer64SchemeType");
+  }
+}
+// ------------------------------------------------------------------------------
 string ConvertSchemeTypeToString(DoubleSchemeType type) {
   switch (type) {
     case DoubleSchemeType::PSEUDODECIMAL:
       return "PSEUDODECIMAL";
+    case DoubleSchemeType::ALP:
+      return "ALP";
+    case DoubleSchemeType::XOR:
+      return "XOR";
+    case DoubleSchemeType::SPARSE:
+      return "SPARSE";
     case DoubleSchemeType::RLE:
       return "RLE";
     case DoubleSchemeType::DICT:
@@ -103,6 +281,25 @@ string ConvertSchemeTypeToString(DoubleSchemeType type) {
   }
 }
 // ------------------------------------------------------------------------------
+string ConvertSchemeTypeToString(FloatSchemeType type) {
+  switch (type) {
+    case FloatSchemeType::ALP:
+      return "ALP";
+    case FloatSchemeType::SPARSE:
+      return "SPARSE";
+    case FloatSchemeType::RLE:
+      return "RLE";
+    case FloatSchemeType::DICT:
+      return "DICT";
+    case FloatSchemeType::ONE_VALUE:
+      return "ONE_VALUE";
+    case FloatSchemeType::UNCOMPRESSED:
+      return "UNCOMPRESSED";
+    default:
+      throw Generic_Exception("Unknown FloatSchemeType");
+  }
+}
+// ------------------------------------------------------------------------------
 string ConvertSchemeTypeToString(StringSchemeType type) {
   switch (type) {
     case StringSchemeType::ONE_VALUE:
@@ -117,6 +314,8 @@ string ConvertSchemeTypeToString(StringSchemeType type) {
       return "UNCOMPRESSED";
     case StringSchemeType::FSST:
       return "FSST";
+    case StringSchemeType::DICT_FRONT_CODED:
+      return "S_DICT_FRONT_CODED";
     default:
       throw Generic_Exception("Unknown StringSchemeType");
   }
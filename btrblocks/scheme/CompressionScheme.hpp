@@ -11,15 +11,37 @@
 #include "stats/StringStats.hpp"
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
+namespace strings {
+class SharedFsstTable;
+}
+class GlobalDictionary;
 // -------------------------------------------------------------------------------------
 using UInteger32Stats = NumberStats<u32>;
 using SInteger32Stats = NumberStats<s32>;
+using SInteger64Stats = NumberStats<s64>;
 using DoubleStats = NumberStats<DOUBLE>;
+using FloatStats = NumberStats<FLOAT>;
 // -------------------------------------------------------------------------------------
 struct Predicate {};
 // -------------------------------------------------------------------------------------
+// Data a column part stores once for all of its chunks, see GlobalDictionary.hpp
+// and string/FsstTable.hpp. Only the top level of a chunk gets it, the cascades
+// below never use it.
+// Compression: what the part will store, nullptr (or empty) where it has nothing
+struct PartEncoding {
+  const strings::SharedFsstTable* fsst_table = nullptr;
+  const GlobalDictionary* global_dictionary = nullptr;
+};
+// Decompression: what the part stores (ColumnPartExtension), nullptr where it has nothing
+struct PartData {
+  const u8* fsst_table = nullptr;
+  const u8* global_dictionary = nullptr;
+};
+// -------------------------------------------------------------------------------------
 string ConvertSchemeTypeToString(IntegerSchemeType type);
+string ConvertSchemeTypeToString(Integer64SchemeType type);
 string ConvertSchemeTypeToString(DoubleSchemeType type);
+string ConvertSchemeTypeToString(FloatSchemeType type);
 string ConvertSchemeTypeToString(StringSchemeType type);
 // -------------------------------------------------------------------------------------
 // expectedCompressionRatio should only be called at top level
@@ -40,6 +62,72 @@ class IntegerScheme {
                           u32 tuple_count,
                           u32 level) = 0;
   // -------------------------------------------------------------------------------------
+  // Per-row 64-bit hashes, see common/Hash.hpp. The default decompresses and
+  // hashes every row; schemes that know their distinct values override it.
+  virtual void hash(u64* dest, BitmapWrapper* nullmap, const u8* src, u32 tuple_count, u32 level);
+  // -------------------------------------------------------------------------------------
+  // SMALLINT and TINYINT columns are compressed as integers and decompressed
+  // into the narrow type. The default decompresses into a 32-bit buffer and
+  // truncates; schemes that can write narrow values directly override both.
+  virtual void decompressNarrow(SMALLINT* dest,
+                                BitmapWrapper* nullmap,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level);
+  virtual void decompressNarrow(TINYINT* dest,
+                                BitmapWrapper* nullmap,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level);
+  // -------------------------------------------------------------------------------------
+  // The top level of a chunk passes the data of its part. The defaults ignore it,
+  // the schemes whose chunks refer to part data override these.
+  virtual double expectedCompressionRatio(SInteger32Stats& stats,
+                                          u8 allowed_cascading_level,
+                                          const PartEncoding&) {
+    return this->expectedCompressionRatio(stats, allowed_cascading_level);
+  }
+  virtual u32 compress(const INTEGER* src,
+                       const BITMAP* nullmap,
+                       u8* dest,
+                       SInteger32Stats& stats,
+                       u8 allowed_cascading_level,
+                       const PartEncoding&) {
+    return this->compress(src, nullmap, dest, stats, allowed_cascading_level);
+  }
+  virtual void decompress(INTEGER* dest,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level,
+                          const PartData&) {
+    this->decompress(dest, nullmap, src, tuple_count, level);
+  }
+  virtual void hash(u64* dest,
+                    BitmapWrapper* nullmap,
+                    const u8* src,
+                    u32 tuple_count,
+                    u32 level,
+                    const PartData&) {
+    this->hash(dest, nullmap, src, tuple_count, level);
+  }
+  virtual void decompressNarrow(SMALLINT* dest,
+                                BitmapWrapper* nullmap,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level,
+                                const PartData&) {
+    this->decompressNarrow(dest, nullmap, src, tuple_count, level);
+  }
+  virtual void decompressNarrow(TINYINT* dest,
+                                BitmapWrapper* nullmap,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level,
+                                const PartData&) {
+    this->decompressNarrow(dest, nullmap, src, tuple_count, level);
+  }
+  // -------------------------------------------------------------------------------------
   virtual IntegerSchemeType schemeType() = 0;
   // -------------------------------------------------------------------------------------
   virtual INTEGER lookup(u32 id) = 0;
@@ -54,6 +142,71 @@ class IntegerScheme {
   virtual bool isUsable(SInteger32Stats&) { return true; }
 };
 // -------------------------------------------------------------------------------------
+// Integer64
+// -------------------------------------------------------------------------------------
+class Integer64Scheme {
+ public:
+  // -------------------------------------------------------------------------------------
+  virtual double expectedCompressionRatio(SInteger64Stats& stats, [[maybe_unused]] u8 allowed_cascading_level);
+  // -------------------------------------------------------------------------------------
+  virtual u32 compress(const BIGINT* src,
+                       const BITMAP* nullmap,
+                       u8* dest,
+                       SInteger64Stats& stats,
+                       u8 allowed_cascading_level) = 0;
+  // -------------------------------------------------------------------------------------
+  virtual void decompress(BIGINT* dest,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) = 0;
+  // -------------------------------------------------------------------------------------
+  // Per-row 64-bit hashes, see common/Hash.hpp. The default decompresses and
+  // hashes every row; schemes that know their distinct values override it.
+  virtual void hash(u64* dest, BitmapWrapper* nullmap, const u8* src, u32 tuple_count, u32 level);
+  // -------------------------------------------------------------------------------------
+  // The top level of a chunk passes the data of its part. The defaults ignore it,
+  // the schemes whose chunks refer to part data override these.
+  virtual double expectedCompressionRatio(SInteger64Stats& stats,
+                                          u8 allowed_cascading_level,
+                                          const PartEncoding&) {
+    return this->expectedCompressionRatio(stats, allowed_cascading_level);
+  }
+  virtual u32 compress(const BIGINT* src,
+                       const BITMAP* nullmap,
+                       u8* dest,
+                       SInteger64Stats& stats,
+                       u8 allowed_cascading_level,
+                       const PartEncoding&) {
+    return this->compress(src, nullmap, dest, stats, allowed_cascading_level);
+  }
+  virtual void decompress(BIGINT* dest,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level,
+                          const PartData&) {
+    this->decompress(dest, nullmap, src, tuple_count, level);
+  }
+  virtual void hash(u64* dest,
+                    BitmapWrapper* nullmap,
+                    const u8* src,
+                    u32 tuple_count,
+                    u32 level,
+                    const PartData&) {
+    this->hash(dest, nullmap, src, tuple_count, level);
+  }
+  // -------------------------------------------------------------------------------------
+  virtual Integer64SchemeType schemeType() = 0;
+  // -------------------------------------------------------------------------------------
+  inline string selfDescription() { return ConvertSchemeTypeToString(this->schemeType()); }
+  virtual string fullDescription(const u8*) {
+    // Default implementation for schemes that do not have nested schemes
+    return this->selfDescription();
+  }
+  virtual bool isUsable(SInteger64Stats&) { return true; }
+};
+// -------------------------------------------------------------------------------------
 // Double
 // -------------------------------------------------------------------------------------
 class DoubleScheme {
@@ -73,6 +226,42 @@ class DoubleScheme {
                           u32 tuple_count,
                           u32 level) = 0;
   // -------------------------------------------------------------------------------------
+  // Per-row 64-bit hashes, see common/Hash.hpp. The default decompresses and
+  // hashes every row; schemes that know their distinct values override it.
+  virtual void hash(u64* dest, BitmapWrapper* nullmap, const u8* src, u32 tuple_count, u32 level);
+  // -------------------------------------------------------------------------------------
+  // The top level of a chunk passes the data of its part. The defaults ignore it,
+  // the schemes whose chunks refer to part data override these.
+  virtual double expectedCompressionRatio(DoubleStats& stats,
+                                          u8 allowed_cascading_level,
+                                          const PartEncoding&) {
+    return this->expectedCompressionRatio(stats, allowed_cascading_level);
+  }
+  virtual u32 compress(const DOUBLE* src,
+                       const BITMAP* nullmap,
+                       u8* dest,
+                       DoubleStats& stats,
+                       u8 allowed_cascading_level,
+                       const PartEncoding&) {
+    return this->compress(src, nullmap, dest, stats, allowed_cascading_level);
+  }
+  virtual void decompress(DOUBLE* dest,
+                          BitmapWrapper* bitmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level,
+                          const PartData&) {
+    this->decompress(dest, bitmap, src, tuple_count, level);
+  }
+  virtual void hash(u64* dest,
+                    BitmapWrapper* nullmap,
+                    const u8* src,
+                    u32 tuple_count,
+                    u32 level,
+                    const PartData&) {
+    this->hash(dest, nullmap, src, tuple_count, level);
+  }
+  // -------------------------------------------------------------------------------------
   virtual DoubleSchemeType schemeType() = 0;
   // -------------------------------------------------------------------------------------
   inline string selfDescription() { return ConvertSchemeTypeToString(this->schemeType()); }
@@ -83,6 +272,71 @@ class DoubleScheme {
   virtual bool isUsable(DoubleStats&) { return true; }
 };
 // -------------------------------------------------------------------------------------
+// Float
+// -------------------------------------------------------------------------------------
+class FloatScheme {
+ public:
+  // -------------------------------------------------------------------------------------
+  virtual double expectedCompressionRatio(FloatStats& stats, [[maybe_unused]] u8 allowed_cascading_level);
+  // -------------------------------------------------------------------------------------
+  virtual u32 compress(const FLOAT* src,
+                       const BITMAP* nullmap,
+                       u8* dest,
+                       FloatStats& stats,
+                       u8 allowed_cascading_level) = 0;
+  // -------------------------------------------------------------------------------------
+  virtual void decompress(FLOAT* dest,
+                          BitmapWrapper* bitmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level) = 0;
+  // -------------------------------------------------------------------------------------
+  // Per-row 64-bit hashes, see common/Hash.hpp. The default decompresses and
+  // hashes every row; schemes that know their distinct values override it.
+  virtual void hash(u64* dest, BitmapWrapper* nullmap, const u8* src, u32 tuple_count, u32 level);
+  // -------------------------------------------------------------------------------------
+  // The top level of a chunk passes the data of its part. The defaults ignore it,
+  // the schemes whose chunks refer to part data override these.
+  virtual double expectedCompressionRatio(FloatStats& stats,
+                                          u8 allowed_cascading_level,
+                                          const PartEncoding&) {
+    return this->expectedCompressionRatio(stats, allowed_cascading_level);
+  }
+  virtual u32 compress(const FLOAT* src,
+                       const BITMAP* nullmap,
+                       u8* dest,
+                       FloatStats& stats,
+                       u8 allowed_cascading_level,
+                       const PartEncoding&) {
+    return this->compress(src, nullmap, dest, stats, allowed_cascading_level);
+  }
+  virtual void decompress(FLOAT* dest,
+                          BitmapWrapper* bitmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level,
+                          const PartData&) {
+    this->decompress(dest, bitmap, src, tuple_count, level);
+  }
+  virtual void hash(u64* dest,
+                    BitmapWrapper* nullmap,
+                    const u8* src,
+                    u32 tuple_count,
+                    u32 level,
+                    const PartData&) {
+    this->hash(dest, nullmap, src, tuple_count, level);
+  }
+  // -------------------------------------------------------------------------------------
+  virtual FloatSchemeType schemeType() = 0;
+  // -------------------------------------------------------------------------------------
+  inline string selfDescription() { return ConvertSchemeTypeToString(this->schemeType()); }
+  virtual string fullDescription(const u8*) {
+    // Default implementation for schemes that do not have nested schemes
+    return this->selfDescription();
+  }
+  virtual bool isUsable(FloatStats&) { return true; }
+};
+// -------------------------------------------------------------------------------------
 // String
 // -------------------------------------------------------------------------------------
 class StringScheme {
@@ -127,6 +381,49 @@ class StringScheme {
     return false;
   }
   // -------------------------------------------------------------------------------------
+  // Per-row 64-bit hashes, see common/Hash.hpp. The default decompresses and
+  // hashes every row; schemes that know their distinct values override it.
+  virtual void hash(u64* dest, BitmapWrapper* nullmap, const u8* src, u32 tuple_count, u32 level);
+  // -------------------------------------------------------------------------------------
+  // The top level of a chunk passes the data of its part. The defaults ignore it,
+  // the schemes whose chunks refer to part data override these.
+  virtual double expectedCompressionRatio(StringStats& stats,
+                                          u8 allowed_cascading_level,
+                                          const PartEncoding&) {
+    return this->expectedCompressionRatio(stats, allowed_cascading_level);
+  }
+  virtual u32 compress(StringArrayViewer src,
+                       const BITMAP* nullmap,
+                       u8* dest,
+                       StringStats& stats,
+                       const PartEncoding&) {
+    return this->compress(src, nullmap, dest, stats);
+  }
+  virtual void decompress(u8* dest,
+                          BitmapWrapper* nullmap,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32 level,
+                          const PartData&) {
+    this->decompress(dest, nullmap, src, tuple_count, level);
+  }
+  virtual bool decompressNoCopy(u8* dest,
+                                BitmapWrapper* nullmap,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level,
+                                const PartData&) {
+    return this->decompressNoCopy(dest, nullmap, src, tuple_count, level);
+  }
+  virtual void hash(u64* dest,
+                    BitmapWrapper* nullmap,
+                    const u8* src,
+                    u32 tuple_count,
+                    u32 level,
+                    const PartData&) {
+    this->hash(dest, nullmap, src, tuple_count, level);
+  }
+  // -------------------------------------------------------------------------------------
   virtual StringSchemeType schemeType() = 0;
   // -------------------------------------------------------------------------------------
   inline string selfDescription(const u8* src = nullptr) {
@@ -148,6 +445,15 @@ class StringScheme {
     return this->selfDescription();
   }
   virtual bool isUsable(StringStats&) { return true; }
+
+ protected:
+  // The default hash: decompresses the chunk and hashes every row
+  void hashDecompressed(u64* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level,
+                        const PartData& part);
 };
 // -------------------------------------------------------------------------------------
 }  // namespace btrblocks
@@ -0,0 +1,100 @@
+#include "GlobalDictionary.hpp"
+#include "storage/Column.hpp"
+// -------------------------------------------------------------------------------------
+#include <cstring>
+#include <set>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+// Sorted distinct values of values, false if there are more than max_unique
+template <typename T, typename Values>
+bool collectDistinct(const Values& values, u32 max_unique, std::set<T>& distinct_values) {
+  for (u64 row_i = 0; row_i < values.size(); row_i++) {
+    distinct_values.insert(values[row_i]);
+    if (distinct_values.size() > max_unique) {
+      return false;
+    }
+  }
+  return true;
+}
+// -------------------------------------------------------------------------------------
+template <typename T>
+vector<u8> serialize(const std::set<T>& distinct_values) {
+  vector<u8> data(sizeof(GlobalDictionaryStructure) + distinct_values.size() * sizeof(T));
+  auto& dict_struct = *reinterpret_cast<GlobalDictionaryStructure*>(data.data());
+  dict_struct.type = GlobalDictionary::physicalType<T>();
+  dict_struct.count = distinct_values.size();
+  std::copy(distinct_values.begin(), distinct_values.end(),
+            reinterpret_cast<T*>(dict_struct.data));
+  return data;
+}
+// -------------------------------------------------------------------------------------
+template <>
+vector<u8> serialize(const std::set<str>& distinct_values) {
+  SIZE strings_size = 0;
+  for (const auto& value : distinct_values) {
+    strings_size += value.length();
+  }
+  const u32 slots_size = (distinct_values.size() + 1) * sizeof(StringArrayViewer::Slot);
+  vector<u8> data(sizeof(GlobalDictionaryStructure) + slots_size + strings_size);
+  auto& dict_struct = *reinterpret_cast<GlobalDictionaryStructure*>(data.data());
+  dict_struct.type = ColumnType::STRING;
+  dict_struct.count = distinct_values.size();
+  // Like the local dictionaries, string offsets are relative to the first slot
+  auto slots = reinterpret_cast<StringArrayViewer::Slot*>(dict_struct.data);
+  u32 offset = slots_size;
+  for (const auto& value : distinct_values) {
+    slots++->offset = offset;
+    std::memcpy(dict_struct.data + offset, value.data(), value.length());
+    offset += value.length();
+  }
+  slots->offset = offset;
+  return data;
+}
+// -------------------------------------------------------------------------------------
+template <typename T, typename Values>
+vector<u8> buildDictionary(const Values& values, u32 max_unique) {
+  std::set<T> distinct_values;
+  if (!collectDistinct(values, max_unique, distinct_values)) {
+    return {};
+  }
+  return serialize(distinct_values);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+GlobalDictionary GlobalDictionary::build(const Column& column, u32 max_unique) {
+  GlobalDictionary dictionary;
+  if (max_unique == 0) {
+    return dictionary;
+  }
+  switch (column.type) {
+    case ColumnType::INTEGER:
+    case ColumnType::DATE:
+      dictionary.data = buildDictionary<INTEGER>(column.integers(), max_unique);
+      break;
+    case ColumnType::BIGINT:
+    case ColumnType::TIMESTAMP:
+    case ColumnType::DECIMAL:
+      dictionary.data = buildDictionary<BIGINT>(column.bigints(), max_unique);
+      break;
+    case ColumnType::DOUBLE:
+      dictionary.data = buildDictionary<DOUBLE>(column.doubles(), max_unique);
+      break;
+    case ColumnType::FLOAT:
+      dictionary.data = buildDictionary<FLOAT>(column.floats(), max_unique);
+      break;
+    case ColumnType::STRING:
+      dictionary.data = buildDictionary<str>(column.strings(), max_unique);
+      break;
+    default:
+      // SMALLINT and TINYINT dictionaries would not be smaller than the values
+      break;
+  }
+  return dictionary;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
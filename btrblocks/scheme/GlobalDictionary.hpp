@@ -0,0 +1,128 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Exceptions.hpp"
+#include "common/Units.hpp"
+#include "storage/StringArrayViewer.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <type_traits>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+class Column;
+// -------------------------------------------------------------------------------------
+/*
+ * Dictionary of a whole low-cardinality column, stored once per column part
+ * (ColumnPartExtension::global_dictionary_offset). DICT chunks whose values are
+ * all in it only store codes, so the codes are the same in every chunk and
+ * part of the column and follow the order of the values.
+ *
+ * Layout: GlobalDictionaryStructure, followed by
+ *   numbers: the sorted values
+ *   strings: the sorted strings in StringArrayViewer layout (count + 1 slots)
+ *
+ * Compression: the top-level DICT schemes get the dictionary of the part as
+ * PartEncoding (Datablock::compress) and use it if it covers the chunk.
+ * Decompression: chunks that use it get the exported dictionary of the part as
+ * PartData (Datablock::decompress, BtrReader).
+ */
+struct GlobalDictionaryStructure {
+  ColumnType type;  // INTEGER, BIGINT, DOUBLE, FLOAT or STRING
+  u32 count;
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+class GlobalDictionary {
+ public:
+  // The distinct values of all rows of column (like the chunk stats, NULL rows
+  // included). Empty if there are more than max_unique or the type has none.
+  static GlobalDictionary build(const Column& column, u32 max_unique);
+  [[nodiscard]] inline bool empty() const { return data.empty(); }
+  [[nodiscard]] inline const vector<u8>& exported() const { return data; }
+  [[nodiscard]] inline u32 size() const { return empty() ? 0 : structure(data.data()).count; }
+  // -------------------------------------------------------------------------------------
+  template <typename T>
+  static constexpr ColumnType physicalType() {
+    if constexpr (std::is_same_v<T, INTEGER>) {
+      return ColumnType::INTEGER;
+    } else if constexpr (std::is_same_v<T, BIGINT>) {
+      return ColumnType::BIGINT;
+    } else if constexpr (std::is_same_v<T, DOUBLE>) {
+      return ColumnType::DOUBLE;
+    } else if constexpr (std::is_same_v<T, FLOAT>) {
+      return ColumnType::FLOAT;
+    } else {
+      static_assert(std::is_same_v<T, str>);
+      return ColumnType::STRING;
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // Compression: dictionary (the part's, may be nullptr) if it holds all
+  // distinct_values (the distinct values of the stats), nullptr otherwise
+  template <typename T, typename Distinct>
+  static const GlobalDictionary* covering(const GlobalDictionary* dictionary,
+                                          const Distinct& distinct_values) {
+    if (dictionary == nullptr || dictionary->empty() ||
+        structure(dictionary->data.data()).type != physicalType<T>()) {
+      return nullptr;
+    }
+    for (const auto& entry : distinct_values) {
+      if constexpr (std::is_same_v<T, str>) {
+        if (dictionary->find<T>(entry) < 0) {
+          return nullptr;
+        }
+      } else {
+        if (dictionary->find<T>(entry.first) < 0) {
+          return nullptr;
+        }
+      }
+    }
+    return dictionary;
+  }
+  // Code of value, -1 if it is not in the dictionary
+  template <typename T>
+  [[nodiscard]] s64 find(const T& value) const {
+    auto& dict_struct = structure(data.data());
+    if constexpr (std::is_same_v<T, str>) {
+      StringArrayViewer strings(dict_struct.data);
+      u32 begin = 0, end = dict_struct.count;
+      while (begin < end) {
+        u32 middle = begin + (end - begin) / 2;
+        if (strings(middle) < value) {
+          begin = middle + 1;
+        } else {
+          end = middle;
+        }
+      }
+      return (begin < dict_struct.count && strings(begin) == value) ? begin : -1;
+    } else {
+      auto begin = reinterpret_cast<const T*>(dict_struct.data);
+      auto end = begin + dict_struct.count;
+      auto it = std::lower_bound(begin, end, value);
+      return (it != end && *it == value) ? it - begin : -1;
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // Decompression: dictionary (the part's exported one, may be nullptr), which
+  // has to be of the given type
+  static const GlobalDictionaryStructure& part(const u8* dictionary, ColumnType type) {
+    if (dictionary == nullptr) {
+      throw Generic_Exception("Chunk uses the global dictionary, but its part has none");
+    }
+    auto& dict_struct = structure(dictionary);
+    if (dict_struct.type != type) {
+      throw Generic_Exception("Global dictionary of type " + ConvertTypeToString(dict_struct.type) +
+                              " does not match the chunk type " + ConvertTypeToString(type));
+    }
+    return dict_struct;
+  }
+
+ private:
+  static inline const GlobalDictionaryStructure& structure(const u8* src) {
+    return *reinterpret_cast<const GlobalDictionaryStructure*>(src);
+  }
+  // -------------------------------------------------------------------------------------
+  vector<u8> data;
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
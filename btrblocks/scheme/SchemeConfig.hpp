@@ -24,8 +24,35 @@ struct SchemeConfig {
     // in integer RLE, override the scheme used for run lengths with
     // this scheme instead of using the scheme picking algorithm
     IntegerSchemeType rle_force_counts_scheme{autoScheme()};
+    // maximum percentage of descending values in a block for which
+    // delta compression will be considered (descents are patched)
+    uint32_t delta_exception_threshold_pct{5};
+    // maximum percentage of values off the line base + stride * row for
+    // which sequence compression will be considered (they are patched)
+    uint32_t sequence_exception_threshold_pct{5};
+    // minimum percentage of null rows in a block for which sparse encoding
+    // (compressing only the values of the set rows) will be considered
+    uint32_t sparse_null_threshold_pct{80};
   } integers;
   // ------------------------------------------------------------------------------
+  struct {
+    // maximum percentage of unique elements in a block
+    // for which frequency compression will be enabled
+    uint32_t frequency_threshold_pct{50};
+    // the average run length has to be higher than this for bigint RLE to be
+    // considered
+    uint32_t rle_run_length_threshold{2};
+    // in bigint RLE, override the scheme used for values with
+    // this scheme instead of using the scheme picking algorithm
+    Integer64SchemeType rle_force_values_scheme{autoScheme()};
+    // in bigint RLE, override the scheme used for run lengths with
+    // this scheme instead of using the scheme picking algorithm
+    IntegerSchemeType rle_force_counts_scheme{autoScheme()};
+    // minimum percentage of null rows in a block for which sparse encoding
+    // (compressing only the values of the set rows) will be considered
+    uint32_t sparse_null_threshold_pct{80};
+  } bigints;
+  // ------------------------------------------------------------------------------
   struct {
     // maximum percentage of unique elements in a block
     // for which frequency compression will be enabled
@@ -39,8 +66,32 @@ struct SchemeConfig {
     // in pseudodecimal encoding, treat a value as an outlier and patch
     // it if it requires more than this many significant digit bits
     uint32_t pseudodecimal_significant_digit_bits_limits{31};
+    // minimum percentage of null rows in a block for which sparse encoding
+    // (compressing only the values of the set rows) will be considered
+    uint32_t sparse_null_threshold_pct{80};
   } doubles;
   // ------------------------------------------------------------------------------
+  struct {
+    // in float RLE, override the scheme used for values with
+    // this scheme instead of using the scheme picking algorithm
+    FloatSchemeType rle_force_values_scheme{autoScheme()};
+    // in float RLE, override the scheme used for run lengths with
+    // this scheme instead of using the scheme picking algorithm
+    IntegerSchemeType rle_force_counts_scheme{autoScheme()};
+    // minimum percentage of null rows in a block for which sparse encoding
+    // (compressing only the values of the set rows) will be considered
+    uint32_t sparse_null_threshold_pct{80};
+  } floats;
+  // ------------------------------------------------------------------------------
+  // columns with at most this many distinct values get a dictionary per column
+  // part that their DICT chunks share (see GlobalDictionary.hpp), 0 disables it
+  uint32_t global_dictionary_max_unique{4096};
+  // number dictionaries of more than this many bytes do not stay in the L2
+  // cache while decoding, their expected compression ratio is discounted by
+  // large_dictionary_penalty_pct to favor schemes that decode sequentially
+  uint32_t large_dictionary_bytes{256 * 1024};
+  uint32_t large_dictionary_penalty_pct{10};
+  // ------------------------------------------------------------------------------
   static constexpr size_t FSST_THRESHOLD = 16ul * 1024;
   struct {
     // in fused dictionary + fsst encoding, the dictionary needs
@@ -58,6 +109,12 @@ struct SchemeConfig {
     // in FSST, override the scheme used for the codes with
     // this scheme instead of using the scheme picking algorithm
     IntegerSchemeType fsst_force_codes_scheme{autoScheme()};
+    // in the front-coded dictionary, store every n-th string in full so
+    // that lookups only decode up to n strings
+    uint32_t front_coding_restart_interval{16};
+    // retrain the FSST table for a chunk instead of using the column part's
+    // shared table if it compresses this many percent worse
+    uint32_t fsst_shared_table_drift_pct{10};
   } strings;
   // ------------------------------------------------------------------------------
   static SchemeConfig& get() {
@@ -4,29 +4,53 @@
 // -------------------------------------------------------------------------------------
 #include "common/Utils.hpp"
 // -------------------------------------------------------------------------------------
+#include "scheme/integer/Delta.hpp"
 #include "scheme/integer/DynamicDictionary.hpp"
+#include "scheme/integer/FOR.hpp"
 #include "scheme/integer/Frequency.hpp"
 #include "scheme/integer/OneValue.hpp"
 #include "scheme/integer/PBP.hpp"
 #include "scheme/integer/RLE.hpp"
+#include "scheme/integer/Sequence.hpp"
+#include "scheme/integer/Sparse.hpp"
 #include "scheme/integer/Uncompressed.hpp"
 // legacy schemes
-#include "scheme/integer/FOR.hpp"
 #include "scheme/integer/FixedDictionary.hpp"
 #include "scheme/integer/Truncation.hpp"
 // -------------------------------------------------------------------------------------
+#include "scheme/bigint/Delta.hpp"
+#include "scheme/bigint/DeltaOfDelta.hpp"
+#include "scheme/bigint/DynamicDictionary.hpp"
+#include "scheme/bigint/FOR.hpp"
+#include "scheme/bigint/Frequency.hpp"
+#include "scheme/bigint/OneValue.hpp"
+#include "scheme/bigint/RLE.hpp"
+#include "scheme/bigint/Sparse.hpp"
+#include "scheme/bigint/Uncompressed.hpp"
+// -------------------------------------------------------------------------------------
+#include "scheme/double/Alp.hpp"
 #include "scheme/double/DynamicDictionary.hpp"
 #include "scheme/double/OneValue.hpp"
 #include "scheme/double/Pseudodecimal.hpp"
 #include "scheme/double/RLE.hpp"
+#include "scheme/double/Sparse.hpp"
 #include "scheme/double/Uncompressed.hpp"
+#include "scheme/double/Xor.hpp"
 // legacy schemes
 #include "scheme/double/DoubleBP.hpp"
 #include "scheme/double/FixedDictionary.hpp"
 #include "scheme/double/Frequency.hpp"
 #include "scheme/double/MaxExponent.hpp"
 // -------------------------------------------------------------------------------------
+#include "scheme/float/Alp.hpp"
+#include "scheme/float/DynamicDictionary.hpp"
+#include "scheme/float/OneValue.hpp"
+#include "scheme/float/RLE.hpp"
+#include "scheme/float/Sparse.hpp"
+#include "scheme/float/Uncompressed.hpp"
+// -------------------------------------------------------------------------------------
 #include "scheme/string/DynamicDictionary.hpp"
+#include "scheme/string/FrontCodedDictionary.hpp"
 #include "scheme/string/Fsst.hpp"
 #include "scheme/string/OneValue.hpp"
 #include "scheme/string/Uncompressed.hpp"
@@ -62,6 +86,9 @@ SchemesCollection::SchemesCollection() {
                  OneValue,
                  DynamicDictionary,
                  RLE,
+                 Delta,
+                 Sequence,
+                 Sparse,
                  FBP,
                  PBP,
                  Frequency,
@@ -88,11 +115,49 @@ SchemesCollection::SchemesCollection() {
                  RLE,
                  Frequency,
                  Decimal,
+                 Alp,
+                 Xor,
+                 Sparse,
                  DoubleBP,
                  Dictionary8,
                  Dictionary16>(double_schemes, cfg.doubles.schemes);
     // clang-format on
   }
+  // Bigint Schemes
+  {
+    using namespace bigints;
+    // required schemes
+    die_if(cfg.bigints.schemes.isEnabled(Integer64SchemeType::ONE_VALUE));
+    die_if(cfg.bigints.schemes.isEnabled(Integer64SchemeType::UNCOMPRESSED));
+    // optional bigint schemes
+    // clang-format off
+    addIfEnabled<Uncompressed,
+                 OneValue,
+                 DynamicDictionary,
+                 RLE,
+                 FOR,
+                 Delta,
+                 DeltaOfDelta,
+                 Frequency,
+                 Sparse>(bigint_schemes, cfg.bigints.schemes);
+    // clang-format on
+  }
+  // Float Schemes
+  {
+    using namespace floats;
+    // required schemes
+    die_if(cfg.floats.schemes.isEnabled(FloatSchemeType::ONE_VALUE));
+    die_if(cfg.floats.schemes.isEnabled(FloatSchemeType::UNCOMPRESSED));
+    // optional float schemes
+    // clang-format off
+    addIfEnabled<Uncompressed,
+                 OneValue,
+                 DynamicDictionary,
+                 RLE,
+                 Alp,
+                 Sparse>(float_schemes, cfg.floats.schemes);
+    // clang-format on
+  }
   // String Schemes
   {
     using namespace legacy::strings;
@@ -106,6 +171,7 @@ SchemesCollection::SchemesCollection() {
                  OneValue,
                  DynamicDictionary,
                  Fsst,
+                 FrontCodedDictionary,
                  Dictionary8,
                  Dictionary16>(string_schemes, cfg.strings.schemes);
     // clang-format on
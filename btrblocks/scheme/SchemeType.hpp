@@ -16,9 +16,12 @@ enum class IntegerSchemeType : uint8_t {
   RLE = 3,
   PFOR = 4,
   BP = 5,
+  DELTA = 6,
+  SEQUENCE = 7,
+  SPARSE = 8,
+  FOR = 26,  // keeps the code it had as a legacy scheme
   // legacy schemes
   FREQUENCY = 25,
-  FOR = 26,
   PFOR_DELTA = 27,
   TRUNCATION_8 = 28,
   TRUNCATION_16 = 29,
@@ -29,7 +32,30 @@ enum class IntegerSchemeType : uint8_t {
 using IntegerSchemeSet = SchemeSet<IntegerSchemeType>;
 constexpr IntegerSchemeSet defaultIntegerSchemes() {
   return {IntegerSchemeType::UNCOMPRESSED, IntegerSchemeType::ONE_VALUE, IntegerSchemeType::DICT,
-          IntegerSchemeType::RLE,          IntegerSchemeType::PFOR,      IntegerSchemeType::BP};
+          IntegerSchemeType::RLE,          IntegerSchemeType::PFOR,      IntegerSchemeType::BP,
+          IntegerSchemeType::DELTA,        IntegerSchemeType::SEQUENCE,  IntegerSchemeType::FOR,
+          IntegerSchemeType::SPARSE};
+};
+// ------------------------------------------------------------------------------
+enum class Integer64SchemeType : uint8_t {
+  UNCOMPRESSED = 0,
+  ONE_VALUE = 1,
+  DICT = 2,
+  RLE = 3,
+  FOR = 4,
+  DELTA = 5,
+  FREQUENCY = 6,
+  DELTA_OF_DELTA = 7,
+  SPARSE = 8,
+  SCHEME_MAX = 32
+};
+using Integer64SchemeSet = SchemeSet<Integer64SchemeType>;
+constexpr Integer64SchemeSet defaultInteger64Schemes() {
+  return {Integer64SchemeType::UNCOMPRESSED, Integer64SchemeType::ONE_VALUE,
+          Integer64SchemeType::DICT,         Integer64SchemeType::RLE,
+          Integer64SchemeType::FOR,          Integer64SchemeType::DELTA,
+          Integer64SchemeType::FREQUENCY,    Integer64SchemeType::DELTA_OF_DELTA,
+          Integer64SchemeType::SPARSE};
 };
 // ------------------------------------------------------------------------------
 enum class DoubleSchemeType : uint8_t {
@@ -39,6 +65,9 @@ enum class DoubleSchemeType : uint8_t {
   RLE = 3,
   FREQUENCY = 4,
   PSEUDODECIMAL = 5,
+  ALP = 6,
+  XOR = 7,
+  SPARSE = 8,
   // legacy schemes
   DOUBLE_BP = 28,
   DICTIONARY_8 = 29,
@@ -49,7 +78,24 @@ using DoubleSchemeSet = SchemeSet<DoubleSchemeType>;
 constexpr DoubleSchemeSet defaultDoubleSchemes() {
   return {DoubleSchemeType::UNCOMPRESSED, DoubleSchemeType::ONE_VALUE,
           DoubleSchemeType::DICT,         DoubleSchemeType::RLE,
-          DoubleSchemeType::FREQUENCY,    DoubleSchemeType::PSEUDODECIMAL};
+          DoubleSchemeType::FREQUENCY,    DoubleSchemeType::PSEUDODECIMAL,
+          DoubleSchemeType::ALP,          DoubleSchemeType::XOR,
+          DoubleSchemeType::SPARSE};
+};
+// ------------------------------------------------------------------------------
+enum class FloatSchemeType : uint8_t {
+  UNCOMPRESSED = 0,
+  ONE_VALUE = 1,
+  DICT = 2,
+  RLE = 3,
+  ALP = 4,
+  SPARSE = 5,
+  SCHEME_MAX = 32
+};
+using FloatSchemeSet = SchemeSet<FloatSchemeType>;
+constexpr FloatSchemeSet defaultFloatSchemes() {
+  return {FloatSchemeType::UNCOMPRESSED, FloatSchemeType::ONE_VALUE, FloatSchemeType::DICT,
+          FloatSchemeType::RLE,          FloatSchemeType::ALP,          FloatSchemeType::SPARSE};
 };
 // ------------------------------------------------------------------------------
 enum class StringSchemeType : uint8_t {
@@ -57,6 +103,7 @@ enum class StringSchemeType : uint8_t {
   ONE_VALUE = 1,
   DICT = 2,
   FSST = 3,
+  DICT_FRONT_CODED = 4,
   // legacy schemes
   DICTIONARY_8 = 30,
   DICTIONARY_16 = 31,
@@ -65,7 +112,7 @@ enum class StringSchemeType : uint8_t {
 using StringSchemeSet = SchemeSet<StringSchemeType>;
 constexpr StringSchemeSet defaultStringSchemes() {
   return {StringSchemeType::UNCOMPRESSED, StringSchemeType::ONE_VALUE, StringSchemeType::DICT,
-          StringSchemeType::FSST};
+          StringSchemeType::FSST, StringSchemeType::DICT_FRONT_CODED};
 };
 // ------------------------------------------------------------------------------
 // When overriding schemes, pass this value to use automatic scheme selection.
@@ -0,0 +1,106 @@
+#include "Delta.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Log.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+double Delta::expectedCompressionRatio(SInteger64Stats& stats, u8 allowed_cascading_level) {
+  if (allowed_cascading_level <= 1 || stats.tuple_count == 0) {
+    return 0;
+  }
+  return Integer64Scheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 Delta::compress(const BIGINT* src,
+                    const BITMAP* nullmap,
+                    u8* dest,
+                    SInteger64Stats& stats,
+                    u8 allowed_cascading_level) {
+  auto& col_struct = *reinterpret_cast<DeltaStructure*>(dest);
+  // -------------------------------------------------------------------------------------
+  // Start from the first non-null value, nulls repeat the previous value
+  u32 first_row = 0;
+  while (first_row < stats.tuple_count && nullmap != nullptr && !nullmap[first_row]) {
+    first_row++;
+  }
+  col_struct.base = first_row < stats.tuple_count ? src[first_row] : 0;
+  // -------------------------------------------------------------------------------------
+  vector<BIGINT> deltas(stats.tuple_count, 0);
+  u64 prev = static_cast<u64>(col_struct.base);
+  for (u32 row_i = first_row + 1; row_i < stats.tuple_count; row_i++) {
+    if (nullmap != nullptr && !nullmap[row_i]) {
+      continue;
+    }
+    // Wrapping u64 arithmetic, decompression wraps the same way
+    deltas[row_i] = static_cast<BIGINT>(static_cast<u64>(src[row_i]) - prev);
+    prev = static_cast<u64>(src[row_i]);
+  }
+  // -------------------------------------------------------------------------------------
+  auto write_ptr = col_struct.data;
+  u32 used_space;
+  Integer64SchemePicker::compress(deltas.data(), nullptr, write_ptr, deltas.size(),
+                                  allowed_cascading_level - 1, used_space,
+                                  col_struct.deltas_scheme_code, autoScheme(), "deltas");
+  write_ptr += used_space;
+  Log::debug("BIGINT_DELTA: deltas_c = {} deltas_s = {}", CI(col_struct.deltas_scheme_code),
+             CI(used_space));
+  // -------------------------------------------------------------------------------------
+  return write_ptr - dest;
+}
+// -------------------------------------------------------------------------------------
+void Delta::decompress(BIGINT* dest,
+                       BitmapWrapper*,
+                       const u8* src,
+                       u32 tuple_count,
+                       u32 level) {
+  const auto& col_struct = *reinterpret_cast<const DeltaStructure*>(src);
+  if (tuple_count == 0) {
+    return;
+  }
+  // -------------------------------------------------------------------------------------
+  // Deltas of null rows are 0, so the whole column is decoded without nullmap
+  Integer64SchemePicker::MyTypeWrapper::getScheme(col_struct.deltas_scheme_code)
+      .decompress(dest, nullptr, col_struct.data, tuple_count, level + 1);
+  dest[0] = col_struct.base;
+  prefixSum(dest, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void Delta::prefixSum(BIGINT* dest, u32 tuple_count) {
+  u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+  /*
+   * Same scheme as the 32-bit variant with 4 elements: one shift+add step
+   * inside each 128-bit lane, then the low lane's total is added to the high
+   * lane and the carry of the previous block to everything.
+   */
+  __m256i carry = _mm256_setzero_si256();
+  for (; row_i + 4 <= tuple_count; row_i += 4) {
+    auto ptr = reinterpret_cast<__m256i*>(dest + row_i);
+    __m256i v = _mm256_loadu_si256(ptr);
+    v = _mm256_add_epi64(v, _mm256_slli_si256(v, 8));
+    __m256i low_total = _mm256_permute4x64_epi64(v, 0x55);
+    v = _mm256_add_epi64(v, _mm256_blend_epi32(_mm256_setzero_si256(), low_total, 0xF0));
+    v = _mm256_add_epi64(v, carry);
+    _mm256_storeu_si256(ptr, v);
+    carry = _mm256_permute4x64_epi64(v, 0xFF);
+  }
+#endif
+  auto values = reinterpret_cast<u64*>(dest);
+  for (row_i = std::max(row_i, 1u); row_i < tuple_count; row_i++) {
+    values[row_i] += values[row_i - 1];
+  }
+}
+// -------------------------------------------------------------------------------------
+std::string Delta::fullDescription(const u8* src) {
+  const auto& col_struct = *reinterpret_cast<const DeltaStructure*>(src);
+  auto& deltas_scheme =
+      Integer64SchemePicker::MyTypeWrapper::getScheme(col_struct.deltas_scheme_code);
+  return this->selfDescription() + " -> ([bigint] deltas) " +
+         deltas_scheme.fullDescription(col_struct.data);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,38 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+// Deltas between consecutive values, cascaded into the bigint schemes. Unlike
+// the 32-bit variant descents need no patches, FOR absorbs negative deltas.
+// -------------------------------------------------------------------------------------
+struct DeltaStructure {
+  BIGINT base;
+  u8 deltas_scheme_code;
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+class Delta : public Integer64Scheme {
+ public:
+  double expectedCompressionRatio(SInteger64Stats& stats, u8 allowed_cascading_level) override;
+  u32 compress(const BIGINT* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               SInteger64Stats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(BIGINT* dest,
+                  BitmapWrapper* nullmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  inline Integer64SchemeType schemeType() override { return staticSchemeType(); }
+  inline static Integer64SchemeType staticSchemeType() { return Integer64SchemeType::DELTA; }
+  // -------------------------------------------------------------------------------------
+  // In-place inclusive prefix sum with wrapping u64 arithmetic
+  static void prefixSum(BIGINT* values, u32 count);
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+#include "DeltaOfDelta.hpp"
+#include "Delta.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Log.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+double DeltaOfDelta::expectedCompressionRatio(SInteger64Stats& stats,
+                                              u8 allowed_cascading_level) {
+  if (allowed_cascading_level <= 1 || stats.tuple_count < 2) {
+    return 0;
+  }
+  return Integer64Scheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 DeltaOfDelta::compress(const BIGINT* src,
+                           const BITMAP* nullmap,
+                           u8* dest,
+                           SInteger64Stats& stats,
+                           u8 allowed_cascading_level) {
+  auto& col_struct = *reinterpret_cast<DeltaOfDeltaStructure*>(dest);
+  // -------------------------------------------------------------------------------------
+  // Start from the first non-null value, nulls repeat the previous value
+  u32 first_row = 0;
+  while (first_row < stats.tuple_count && nullmap != nullptr && !nullmap[first_row]) {
+    first_row++;
+  }
+  col_struct.base = first_row < stats.tuple_count ? src[first_row] : 0;
+  col_struct.first_delta = 0;
+  // -------------------------------------------------------------------------------------
+  // Wrapping u64 arithmetic, decompression wraps the same way
+  vector<BIGINT> dods(stats.tuple_count, 0);
+  u64 prev = static_cast<u64>(col_struct.base);
+  u64 prev_delta = 0;
+  for (u32 row_i = 1; row_i < stats.tuple_count; row_i++) {
+    u64 value = (nullmap != nullptr && !nullmap[row_i]) || row_i < first_row
+                    ? prev
+                    : static_cast<u64>(src[row_i]);
+    u64 delta = value - prev;
+    if (row_i == 1) {
+      col_struct.first_delta = static_cast<BIGINT>(delta);
+    } else {
+      dods[row_i] = static_cast<BIGINT>(delta - prev_delta);
+    }
+    prev = value;
+    prev_delta = delta;
+  }
+  // -------------------------------------------------------------------------------------
+  auto write_ptr = col_struct.data;
+  u32 used_space;
+  Integer64SchemePicker::compress(dods.data(), nullptr, write_ptr, dods.size(),
+                                  allowed_cascading_level - 1, used_space,
+                                  col_struct.dods_scheme_code, autoScheme(), "dods");
+  write_ptr += used_space;
+  Log::debug("DELTA_OF_DELTA: dods_c = {} dods_s = {}", CI(col_struct.dods_scheme_code),
+             CI(used_space));
+  // -------------------------------------------------------------------------------------
+  return write_ptr - dest;
+}
+// -------------------------------------------------------------------------------------
+void DeltaOfDelta::decompress(BIGINT* dest,
+                              BitmapWrapper*,
+                              const u8* src,
+                              u32 tuple_count,
+                              u32 level) {
+  const auto& col_struct = *reinterpret_cast<const DeltaOfDeltaStructure*>(src);
+  if (tuple_count == 0) {
+    return;
+  }
+  // -------------------------------------------------------------------------------------
+  Integer64SchemePicker::MyTypeWrapper::getScheme(col_struct.dods_scheme_code)
+      .decompress(dest, nullptr, col_struct.data, tuple_count, level + 1);
+  // -------------------------------------------------------------------------------------
+  // First pass turns the deltas of deltas into deltas, second pass into values
+  dest[0] = 0;
+  if (tuple_count > 1) {
+    dest[1] = col_struct.first_delta;
+  }
+  Delta::prefixSum(dest, tuple_count);
+  dest[0] = col_struct.base;
+  Delta::prefixSum(dest, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+std::string DeltaOfDelta::fullDescription(const u8* src) {
+  const auto& col_struct = *reinterpret_cast<const DeltaOfDeltaStructure*>(src);
+  auto& dods_scheme = Integer64SchemePicker::MyTypeWrapper::getScheme(col_struct.dods_scheme_code);
+  return this->selfDescription() + " -> ([bigint] deltas of deltas) " +
+         dods_scheme.fullDescription(col_struct.data);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
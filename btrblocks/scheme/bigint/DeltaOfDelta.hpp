@@ -0,0 +1,39 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+// Differences between consecutive deltas, for timestamps taken at (nearly)
+// regular intervals. The second-order deltas are mostly zero or tiny and
+// cascade into ONE_VALUE/RLE or FOR -> bit-packing.
+// -------------------------------------------------------------------------------------
+struct DeltaOfDeltaStructure {
+  BIGINT base;
+  BIGINT first_delta;
+  u8 dods_scheme_code;
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+class DeltaOfDelta : public Integer64Scheme {
+ public:
+  double expectedCompressionRatio(SInteger64Stats& stats, u8 allowed_cascading_level) override;
+  u32 compress(const BIGINT* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               SInteger64Stats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(BIGINT* dest,
+                  BitmapWrapper* nullmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  inline Integer64SchemeType schemeType() override { return staticSchemeType(); }
+  inline static Integer64SchemeType staticSchemeType() {
+    return Integer64SchemeType::DELTA_OF_DELTA;
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
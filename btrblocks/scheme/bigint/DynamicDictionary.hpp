@@ -0,0 +1,63 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+class DynamicDictionary : public Integer64Scheme {
+ public:
+  double expectedCompressionRatio(SInteger64Stats& stats, u8 allowed_cascading_level) override;
+  double expectedCompressionRatio(SInteger64Stats& stats,
+                                  u8 allowed_cascading_level,
+                                  const PartEncoding& part) override;
+  u32 compress(const BIGINT* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               SInteger64Stats& stats,
+               u8 allowed_cascading_level) override;
+  u32 compress(const BIGINT* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               SInteger64Stats& stats,
+               u8 allowed_cascading_level,
+               const PartEncoding& part) override;
+  void decompress(BIGINT* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  void decompress(BIGINT* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level,
+                  const PartData& part) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level,
+            const PartData& part) override;
+  u32 getDictionarySize(const u8* src, const PartData& part);
+  // Whether the codes index the part's GlobalDictionary (stable across chunks)
+  bool usesGlobalDictionary(const u8* src);
+  u32 decompressCodes(BIGINT* dictionary,
+                      INTEGER* codes,
+                      BitmapWrapper* nullmap,
+                      const u8* src,
+                      u32 tuple_count,
+                      u32 level,
+                      const PartData& part);
+  std::string fullDescription(const u8* src) override;
+  inline Integer64SchemeType schemeType() override { return staticSchemeType(); }
+  inline static Integer64SchemeType staticSchemeType() { return Integer64SchemeType::DICT; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,104 @@
+#include "FOR.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/integer/PBP.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Log.hpp"
+// -------------------------------------------------------------------------------------
+#include <limits>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+u32 FOR::compress(const BIGINT* src,
+                  const BITMAP* nullmap,
+                  u8* dest,
+                  SInteger64Stats& stats,
+                  u8 allowed_cascading_level) {
+  auto& col_struct = *reinterpret_cast<FORStructure*>(dest);
+  // -------------------------------------------------------------------------------------
+  // stats.min also covers null rows, so every biased value is non-negative
+  col_struct.bias = stats.min;
+  const u64 range = static_cast<u64>(stats.max) - static_cast<u64>(stats.min);
+  col_struct.narrowed = range <= static_cast<u64>(std::numeric_limits<INTEGER>::max());
+  auto write_ptr = col_struct.data;
+  // -------------------------------------------------------------------------------------
+  if (col_struct.narrowed) {
+    vector<INTEGER> narrowed(stats.tuple_count);
+    for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
+      narrowed[row_i] =
+          static_cast<INTEGER>(static_cast<u64>(src[row_i]) - static_cast<u64>(col_struct.bias));
+    }
+    u32 used_space;
+    IntegerSchemePicker::compress(narrowed.data(), nullmap, write_ptr, stats.tuple_count,
+                                  allowed_cascading_level - 1, used_space, col_struct.next_scheme,
+                                  autoScheme(), "for_narrowed");
+    write_ptr += used_space;
+    Log::debug("BIGINT_FOR: narrowed_c = {} narrowed_s = {}", CI(col_struct.next_scheme),
+               CI(used_space));
+  } else {
+    vector<u64> biased(stats.tuple_count);
+    for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
+      biased[row_i] = static_cast<u64>(src[row_i]) - static_cast<u64>(col_struct.bias);
+    }
+    col_struct.next_scheme = CB(IntegerSchemeType::BP);
+    write_ptr += integers::FBP64::compress(biased.data(), write_ptr, stats.tuple_count);
+  }
+  // -------------------------------------------------------------------------------------
+  return write_ptr - dest;
+}
+// -------------------------------------------------------------------------------------
+void FOR::decompress(BIGINT* dest,
+                     BitmapWrapper* nullmap,
+                     const u8* src,
+                     u32 tuple_count,
+                     u32 level) {
+  const auto& col_struct = *reinterpret_cast<const FORStructure*>(src);
+  const u64 bias = static_cast<u64>(col_struct.bias);
+  auto values = reinterpret_cast<u64*>(dest);
+  u32 row_i = 0;
+  // -------------------------------------------------------------------------------------
+  if (col_struct.narrowed) {
+    thread_local std::vector<std::vector<INTEGER>> narrowed_v;
+    auto narrowed = get_level_data(narrowed_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.next_scheme)
+        .decompress(narrowed, nullmap, col_struct.data, tuple_count, level + 1);
+    // Widen and add the bias. The result for null values does not matter
+#ifdef BTR_USE_SIMD
+    const __m256i bias_v = _mm256_set1_epi64x(col_struct.bias);
+    for (; row_i + 4 <= tuple_count; row_i += 4) {
+      __m128i narrow = _mm_loadu_si128(reinterpret_cast<const __m128i*>(narrowed + row_i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + row_i),
+                          _mm256_add_epi64(_mm256_cvtepu32_epi64(narrow), bias_v));
+    }
+#endif
+    for (; row_i < tuple_count; row_i++) {
+      values[row_i] = static_cast<u32>(narrowed[row_i]) + bias;
+    }
+  } else {
+    integers::FBP64::decompress(values, col_struct.data, tuple_count, level);
+#ifdef BTR_USE_SIMD
+    const __m256i bias_v = _mm256_set1_epi64x(col_struct.bias);
+    for (; row_i + 4 <= tuple_count; row_i += 4) {
+      auto ptr = reinterpret_cast<__m256i*>(dest + row_i);
+      _mm256_storeu_si256(ptr, _mm256_add_epi64(_mm256_loadu_si256(ptr), bias_v));
+    }
+#endif
+    for (; row_i < tuple_count; row_i++) {
+      values[row_i] += bias;
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
+std::string FOR::fullDescription(const u8* src) {
+  const auto& col_struct = *reinterpret_cast<const FORStructure*>(src);
+  if (!col_struct.narrowed) {
+    return this->selfDescription() + " -> ([bigint] biased) FBP64";
+  }
+  auto& scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.next_scheme);
+  return this->selfDescription() + " -> ([int] narrowed) " +
+         scheme.fullDescription(col_struct.data);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
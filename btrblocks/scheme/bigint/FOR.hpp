@@ -0,0 +1,36 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+// Frame of reference. When the biased range fits into a non-negative INTEGER
+// the values are narrowed and cascade into the 32-bit schemes, otherwise the
+// biased values are bit-packed with FBP64.
+// -------------------------------------------------------------------------------------
+struct FORStructure {
+  BIGINT bias;
+  u8 narrowed;
+  u8 next_scheme;
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+class FOR : public Integer64Scheme {
+ public:
+  u32 compress(const BIGINT* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               SInteger64Stats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(BIGINT* dest,
+                  BitmapWrapper* nullmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  inline Integer64SchemeType schemeType() override { return staticSchemeType(); }
+  inline static Integer64SchemeType staticSchemeType() { return Integer64SchemeType::FOR; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
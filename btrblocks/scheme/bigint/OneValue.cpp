@@ -0,0 +1,29 @@
+// -------------------------------------------------------------------------------------
+#include "OneValue.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/templated/OneValue.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+using MyOneValue = TOneValue<BIGINT, SInteger64Stats>;
+// -------------------------------------------------------------------------------------
+double OneValue::expectedCompressionRatio(SInteger64Stats& stats, u8) {
+  return MyOneValue::expectedCompressionRatio(stats);
+}
+// -------------------------------------------------------------------------------------
+u32 OneValue::compress(const BIGINT* src, const BITMAP*, u8* dest, SInteger64Stats& stats, u8) {
+  return MyOneValue::compressColumn(src, dest, stats);
+}
+// -------------------------------------------------------------------------------------
+void OneValue::decompress(BIGINT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  MyOneValue::decompressColumn(dest, src, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void OneValue::hash(u64* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  MyOneValue::hashColumn(dest, src, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,39 @@
+#include "Sparse.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "scheme/SchemeConfig.hpp"
+#include "scheme/templated/Sparse.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+using MySparse = TSparse<BIGINT, Integer64Scheme, SInteger64Stats, Integer64SchemeType>;
+// -------------------------------------------------------------------------------------
+double Sparse::expectedCompressionRatio(SInteger64Stats& stats, u8 allowed_cascading_level) {
+  if (!MySparse::isSparse(stats, SchemeConfig::get().bigints.sparse_null_threshold_pct)) {
+    return 0;
+  }
+  return Integer64Scheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 Sparse::compress(const BIGINT* src,
+                     const BITMAP* nullmap,
+                     u8* dest,
+                     SInteger64Stats& stats,
+                     u8 allowed_cascading_level) {
+  return MySparse::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+void Sparse::decompress(BIGINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) {
+  MySparse::decompressColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+string Sparse::fullDescription(const u8* src) {
+  return MySparse::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
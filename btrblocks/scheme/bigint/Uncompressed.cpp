@@ -0,0 +1,26 @@
+// -------------------------------------------------------------------------------------
+#include "Uncompressed.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <cstring>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::bigints {
+// -------------------------------------------------------------------------------------
+double Uncompressed::expectedCompressionRatio(SInteger64Stats&, u8) {
+  return 1.0;
+}
+// -------------------------------------------------------------------------------------
+u32 Uncompressed::compress(const BIGINT* src, const BITMAP*, u8* dest, SInteger64Stats& stats, u8) {
+  std::memcpy(dest, src, stats.total_size);
+  return stats.total_size;
+}
+// -------------------------------------------------------------------------------------
+void Uncompressed::decompress(BIGINT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  std::memcpy(dest, src, tuple_count * sizeof(BIGINT));
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::bigints
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,39 @@
+#include "Alp.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/templated/Alp.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::doubles {
+// -------------------------------------------------------------------------------------
+using MyAlp = TAlp<DOUBLE, DoubleScheme, DoubleStats, DoubleSchemeType>;
+// -------------------------------------------------------------------------------------
+double Alp::expectedCompressionRatio(DoubleStats& stats, u8 allowed_cascading_level) {
+  if (allowed_cascading_level <= 1) {
+    return 0;
+  }
+  return DoubleScheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 Alp::compress(const DOUBLE* src,
+                  const BITMAP* nullmap,
+                  u8* dest,
+                  DoubleStats& stats,
+                  u8 allowed_cascading_level) {
+  return MyAlp::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+void Alp::decompress(DOUBLE* dest,
+                     BitmapWrapper* nullmap,
+                     const u8* src,
+                     u32 tuple_count,
+                     u32 level) {
+  MyAlp::decompressColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+std::string Alp::fullDescription(const u8* src) {
+  return MyAlp::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::doubles
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,27 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::doubles {
+// -------------------------------------------------------------------------------------
+// ALP over doubles, see TAlp in templated/Alp.hpp
+class Alp : public DoubleScheme {
+ public:
+  double expectedCompressionRatio(DoubleStats& stats, u8 allowed_cascading_level) override;
+  u32 compress(const DOUBLE* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               DoubleStats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(DOUBLE* dest,
+                  BitmapWrapper* nullmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
+  inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::ALP; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::doubles
+// -------------------------------------------------------------------------------------
@@ -16,7 +16,12 @@ using MyDynamicDictionary = TDynamicDictionary<DOUBLE, DoubleScheme, DoubleStats
 // -------------------------------------------------------------------------------------
 double DynamicDictionary::expectedCompressionRatio(btrblocks::DoubleStats& stats,
                                                    u8 allowed_cascading_level) {
-  return MyDynamicDictionary::expectedCompressionRatio(stats, allowed_cascading_level);
+  return this->expectedCompressionRatio(stats, allowed_cascading_level, {});
+}
+double DynamicDictionary::expectedCompressionRatio(btrblocks::DoubleStats& stats,
+                                                   u8 allowed_cascading_level,
+                                                   const PartEncoding& part) {
+  return MyDynamicDictionary::expectedCompressionRatio(stats, allowed_cascading_level, part);
 }
 // -------------------------------------------------------------------------------------
 u32 DynamicDictionary::compress(const DOUBLE* src,
@@ -24,7 +29,16 @@ u32 DynamicDictionary::compress(const DOUBLE* src,
                                 u8* dest,
                                 DoubleStats& stats,
                                 u8 allowed_cascading_level) {
-  return MyDynamicDictionary::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+  return this->compress(src, nullmap, dest, stats, allowed_cascading_level, {});
+}
+u32 DynamicDictionary::compress(const DOUBLE* src,
+                                const BITMAP* nullmap,
+                                u8* dest,
+                                DoubleStats& stats,
+                                u8 allowed_cascading_level,
+                                const PartEncoding& part) {
+  return MyDynamicDictionary::compressColumn(src, nullmap, dest, stats, allowed_cascading_level,
+                                             part);
 }
 // -------------------------------------------------------------------------------------
 void DynamicDictionary::decompress(DOUBLE* dest,
@@ -32,7 +46,48 @@ void DynamicDictionary::decompress(DOUBLE* dest,
                                    const u8* src,
                                    u32 tuple_count,
                                    u32 level) {
-  return MyDynamicDictionary::decompressColumn(dest, nullmap, src, tuple_count, level);
+  return this->decompress(dest, nullmap, src, tuple_count, level, {});
+}
+void DynamicDictionary::decompress(DOUBLE* dest,
+                                   BitmapWrapper* nullmap,
+                                   const u8* src,
+                                   u32 tuple_count,
+                                   u32 level,
+                                   const PartData& part) {
+  return MyDynamicDictionary::decompressColumn(dest, nullmap, src, tuple_count, level, part);
+}
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::hash(u64* dest,
+                             BitmapWrapper* nullmap,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level) {
+  return this->hash(dest, nullmap, src, tuple_count, level, {});
+}
+void DynamicDictionary::hash(u64* dest,
+                             BitmapWrapper* nullmap,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level,
+                             const PartData& part) {
+  return MyDynamicDictionary::hashColumn(dest, nullmap, src, tuple_count, level, part);
+}
+// -------------------------------------------------------------------------------------
+u32 DynamicDictionary::getDictionarySize(const u8* src, const PartData& part) {
+  return MyDynamicDictionary::dictionarySize(src, part);
+}
+bool DynamicDictionary::usesGlobalDictionary(const u8* src) {
+  return MyDynamicDictionary::usesGlobalDictionary(src);
+}
+u32 DynamicDictionary::decompressCodes(DOUBLE* dictionary,
+                                       INTEGER* codes,
+                                       BitmapWrapper* nullmap,
+                                       const u8* src,
+                                       u32 tuple_count,
+                                       u32 level,
+                                       const PartData& part) {
+  return MyDynamicDictionary::decompressCodes(dictionary, codes, nullmap, src, tuple_count, level,
+                                              part);
 }
 
 string DynamicDictionary::fullDescription(const u8* src) {
@@ -8,16 +8,52 @@ namespace btrblocks::doubles {
 class DynamicDictionary : public DoubleScheme {
  public:
   double expectedCompressionRatio(DoubleStats& stats, u8 allowed_cascading_level) override;
+  double expectedCompressionRatio(DoubleStats& stats,
+                                  u8 allowed_cascading_level,
+                                  const PartEncoding& part) override;
   u32 compress(const DOUBLE* src,
                const BITMAP* nullmap,
                u8* dest,
                DoubleStats& stats,
                u8 allowed_cascading_level) override;
+  u32 compress(const DOUBLE* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               DoubleStats& stats,
+               u8 allowed_cascading_level,
+               const PartEncoding& part) override;
   void decompress(DOUBLE* dest,
                   BitmapWrapper* bitmap,
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void decompress(DOUBLE* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level,
+                  const PartData& part) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level,
+            const PartData& part) override;
+  u32 getDictionarySize(const u8* src, const PartData& part);
+  // Whether the codes index the part's GlobalDictionary (stable across chunks)
+  bool usesGlobalDictionary(const u8* src);
+  u32 decompressCodes(DOUBLE* dictionary,
+                      INTEGER* codes,
+                      BitmapWrapper* nullmap,
+                      const u8* src,
+                      u32 tuple_count,
+                      u32 level,
+                      const PartData& part);
   std::string fullDescription(const u8* src) override;
   inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
   inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::DICT; }
@@ -5,10 +5,6 @@
 // -------------------------------------------------------------------------------------
 namespace btrblocks::legacy::doubles {
 // -------------------------------------------------------------------------------------
-struct OneValueStructure {
-  DOUBLE one_value;
-};
-// -------------------------------------------------------------------------------------
 class OneValue : public DoubleScheme {
  public:
   double expectedCompressionRatio(DoubleStats& stats, u8 allowed_cascading_level) override;
@@ -22,6 +18,11 @@ class OneValue : public DoubleScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
   inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
   inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::ONE_VALUE; }
 };
@@ -2,8 +2,10 @@
 #include "Pseudodecimal.hpp"
 #include "scheme/CompressionScheme.hpp"
 // ------------------------------------------------------------------------------
+#include "common/CpuDispatch.hpp"
 #include "common/Units.hpp"
 #include "compression/SchemePicker.hpp"
+#include "scheme/templated/Patches.hpp"
 #include "storage/Chunk.hpp"
 // -------------------------------------------------------------------------------------
 #include "common/Log.hpp"
@@ -53,6 +55,63 @@ genau überlegt wie wir es weiter optimieren können) und im Dataset gibt es
 anscheinend Spalten wo die doubles nur in diesem Range liegen.
  */
 // -------------------------------------------------------------------------------------
+// Encoding a value: the smallest exponent for which value == number * 10^-exponent
+// holds exactly for a number below max_number (2^significant digit bits),
+// exponent_exception_code if there is none. Negative values and -0.0 are
+// always exceptions.
+static inline INTEGER encodeValue(DOUBLE value, DOUBLE max_number, INTEGER& number) {
+  number = 0;
+  if (std::signbit(value)) {
+    return exponent_exception_code;
+  }
+  for (u32 exponent = 0; exponent <= max_exponent; exponent++) {
+    DOUBLE cd = std::round(value / exact_fractions_of_ten[exponent]);
+    if (cd < max_number && cd * exact_fractions_of_ten[exponent] == value) {
+      number = static_cast<INTEGER>(cd);
+      return exponent;
+    }
+  }
+  return exponent_exception_code;
+}
+
+#ifdef BTR_WITH_AVX2
+// encodeValue for the block_size values at src, all exponents are tried for
+// the 4 values at once. Returns the mask of the exceptions in the block.
+BTR_TARGET_AVX2 static inline u32 encodeAVXBlock(const DOUBLE* src,
+                                                 DOUBLE max_number,
+                                                 INTEGER* exponents,
+                                                 INTEGER* numbers) {
+  static_assert(block_size == 4);
+  const __m256d values = _mm256_loadu_pd(src);
+  const __m256d max_numbers = _mm256_set1_pd(max_number);
+  // trunc(x + 0.49999999999999994) rounds half away from zero like std::round
+  const __m256d half = _mm256_set1_pd(0.49999999999999994);
+  // Lanes with the sign bit set can never be converted
+  __m256d pending = _mm256_castsi256_pd(
+      _mm256_cmpgt_epi64(_mm256_castpd_si256(values), _mm256_set1_epi64x(-1)));
+  __m256d exponents_d = _mm256_set1_pd(exponent_exception_code);
+  __m256d numbers_d = _mm256_setzero_pd();
+
+  for (u32 exponent = 0; exponent <= max_exponent && _mm256_movemask_pd(pending); exponent++) {
+    const __m256d fraction = _mm256_set1_pd(exact_fractions_of_ten[exponent]);
+    __m256d cd = _mm256_round_pd(_mm256_add_pd(_mm256_div_pd(values, fraction), half),
+                                 _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256d converted =
+        _mm256_and_pd(_mm256_cmp_pd(cd, max_numbers, _CMP_LT_OQ),
+                      _mm256_cmp_pd(_mm256_mul_pd(cd, fraction), values, _CMP_EQ_OQ));
+    converted = _mm256_and_pd(converted, pending);
+    exponents_d = _mm256_blendv_pd(exponents_d, _mm256_set1_pd(exponent), converted);
+    numbers_d = _mm256_blendv_pd(numbers_d, cd, converted);
+    pending = _mm256_andnot_pd(converted, pending);
+  }
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(exponents), _mm256_cvtpd_epi32(exponents_d));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(numbers), _mm256_cvttpd_epi32(numbers_d));
+  return _mm256_movemask_pd(
+      _mm256_cmp_pd(exponents_d, _mm256_set1_pd(exponent_exception_code), _CMP_EQ_OQ));
+}
+#endif  // BTR_WITH_AVX2
+// -------------------------------------------------------------------------------------
 u32 Decimal::compress(const DOUBLE* src,
                       const BITMAP*,
                       u8* dest,
@@ -60,66 +119,56 @@ u32 Decimal::compress(const DOUBLE* src,
                       u8 allowed_cascading_level) {
   auto significant_digits_bits_limit =
       SchemeConfig::get().doubles.pseudodecimal_significant_digit_bits_limits;
+  // The significant digits are stored as INTEGER
+  die_if(significant_digits_bits_limit <= 31);
+  const DOUBLE max_number = std::ldexp(1.0, significant_digits_bits_limit);
   // Layout : Header | numbers_v | exponent_v | patches_v
   // ignore bitmap
   auto& col_struct = *reinterpret_cast<DecimalStructure*>(dest);
   col_struct.variant_selector = 0;
-  vector<INTEGER> numbers_v;
-  vector<INTEGER> exponent_v;
-  vector<DOUBLE> patches_v;  // patches
+  vector<INTEGER> numbers_v(stats.tuple_count);
+  vector<INTEGER> exponent_v(stats.tuple_count);
+  vector<DOUBLE> patches_v(stats.tuple_count);  // patches
 
+  u32 converted_count = 0;
   u32 exception_count = 0;
   u8 run_count = 0;
+  [[maybe_unused]] const bool use_avx2 = CpuDispatch::atLeast(SimdLevel::AVX2);
 
   Roaring exceptions_bitmap;
   const u32 num_blocks = (stats.tuple_count + (block_size - 1)) / block_size;
   for (u32 block_i = 0; block_i < num_blocks; block_i++) {
-    bool block_has_exception = false;
-
     const u32 row_start_i = block_i * block_size;
     const u32 row_end_i = std::min(row_start_i + block_size, stats.tuple_count);
-    for (u32 row_i = row_start_i; row_i < row_end_i; row_i++) {
-      DOUBLE current_double = src[row_i];
-
-      bool convertable = false;
-      u32 exponent;
-      u64 converted_number;
-      if (current_double == -0.0 && std::signbit(current_double)) {
-        // Special case -0.0 is handled as exception
-        exponent = exponent_exception_code;
-      } else {
-        // Attempt conversion
-        for (exponent = 0; exponent <= max_exponent; exponent++) {
-          DOUBLE cd = current_double / exact_fractions_of_ten[exponent];
-          cd = std::round(cd);
-          converted_number = static_cast<u64>(cd);
-          DOUBLE if_converted_back =
-              static_cast<DOUBLE>(converted_number) * exact_fractions_of_ten[exponent];
-          if (if_converted_back == current_double &&
-              ((std::floor(std::log2(converted_number)) + 1) <= significant_digits_bits_limit)) {
-            convertable = true;
-            break;
-          }
-        }
+    INTEGER numbers[block_size];
+    bool block_has_exception = false;
+#ifdef BTR_WITH_AVX2
+    if (use_avx2 && row_end_i - row_start_i == block_size) {
+      block_has_exception = encodeAVXBlock(src + row_start_i, max_number,
+                                           exponent_v.data() + row_start_i, numbers) != 0;
+    } else
+#endif
+    {
+      for (u32 row_i = row_start_i; row_i < row_end_i; row_i++) {
+        exponent_v[row_i] = encodeValue(src[row_i], max_number, numbers[row_i - row_start_i]);
+        block_has_exception |= exponent_v[row_i] == exponent_exception_code;
       }
+    }
 
-      // Write result
-      if (convertable) {
-        die_if((std::floor(std::log2(converted_number)) + 1) <= 31);
-        exponent_v.push_back(static_cast<INTEGER>(exponent));
-        numbers_v.push_back(static_cast<INTEGER>(converted_number));
-      } else {
-        block_has_exception = true;
-        exception_count++;
-        if (exception_count > stats.tuple_count / 2) {
-          // This is a hacky way to avoid using Decimal in columns where there
-          // are many exceptions Return a big number will make the selection
-          // process select uncompressed rather than Decimal
-          return stats.total_size + 1000;
-        }
-        exponent_v.push_back(exponent_exception_code);
-        patches_v.push_back(src[row_i]);
-      }
+    // Collect numbers and patches without branching on the exceptions
+    for (u32 row_i = row_start_i; row_i < row_end_i; row_i++) {
+      const bool is_exception = exponent_v[row_i] == exponent_exception_code;
+      numbers_v[converted_count] = numbers[row_i - row_start_i];
+      patches_v[exception_count] = src[row_i];
+      converted_count += !is_exception;
+      exception_count += is_exception;
+    }
+
+    if (exception_count > stats.tuple_count / 2) {
+      // This is a hacky way to avoid using Decimal in columns where there
+      // are many exceptions Return a big number will make the selection
+      // process select uncompressed rather than Decimal
+      return stats.total_size + 1000;
     }
 
     if (block_has_exception) {
@@ -133,6 +182,8 @@ u32 Decimal::compress(const DOUBLE* src,
       }
     }
   }
+  numbers_v.resize(converted_count);
+  patches_v.resize(exception_count);
 
   col_struct.converted_count = numbers_v.size();
   auto write_ptr = col_struct.data;
@@ -209,8 +260,8 @@ static inline void decompressExceptionBlock(DecimalIterateParam* param) {
   param->next_block_i++;
 }
 
-#ifdef BTR_USE_SIMD
-static inline void decompressAVXBlock4(DecimalIterateParam* param) {
+#ifdef BTR_WITH_AVX2
+BTR_TARGET_AVX2 static inline void decompressAVXBlock4(DecimalIterateParam* param) {
   // Load numbers and convert to double
   __m128i numbers_int_0 = _mm_loadu_si128(reinterpret_cast<__m128i*>(param->numbers_ptr) + 0);
   __m128i numbers_int_1 = _mm_loadu_si128(reinterpret_cast<__m128i*>(param->numbers_ptr) + 1);
@@ -252,7 +303,7 @@ static inline void decompressAVXBlock4(DecimalIterateParam* param) {
   param->next_block_i += 4;
 }
 
-static inline void decompressAVXBlock2(DecimalIterateParam* param) {
+BTR_TARGET_AVX2 static inline void decompressAVXBlock2(DecimalIterateParam* param) {
   // Load numbers and convert to double
   __m128i numbers_int_0 = _mm_loadu_si128(reinterpret_cast<__m128i*>(param->numbers_ptr) + 0);
   __m128i numbers_int_1 = _mm_loadu_si128(reinterpret_cast<__m128i*>(param->numbers_ptr) + 1);
@@ -282,7 +333,7 @@ static inline void decompressAVXBlock2(DecimalIterateParam* param) {
   param->next_block_i += 2;
 }
 
-static inline void decompressAVXBlock1(DecimalIterateParam* param) {
+BTR_TARGET_AVX2 static inline void decompressAVXBlock1(DecimalIterateParam* param) {
   // Load numbers and convert to double
   __m128i numbers_int = _mm_loadu_si128(reinterpret_cast<__m128i*>(param->numbers_ptr));
   __m256d numbers_double = _mm256_cvtepi32_pd(numbers_int);
@@ -314,7 +365,8 @@ static inline void decompressAVXBlock1(DecimalIterateParam* param) {
   param->next_block_i++;
 }
 
-static inline void decompressAVXBlockUnroll(DecimalIterateParam* param, uint32_t limit) {
+BTR_TARGET_AVX2 static inline void decompressAVXBlockUnroll(DecimalIterateParam* param,
+                                                            uint32_t limit) {
 #if 1
   auto unroll_limit = limit < 3 ? 0 : limit - 3;
   while (param->next_block_i < unroll_limit) {
@@ -335,7 +387,7 @@ static inline void decompressAVXBlockUnroll(DecimalIterateParam* param, uint32_t
   decompressExceptionBlock(param);
 }
 
-static inline void decompressAVXBlock(DecimalIterateParam* param, uint32_t limit) {
+BTR_TARGET_AVX2 static inline void decompressAVXBlock(DecimalIterateParam* param, uint32_t limit) {
   while (param->next_block_i < limit) {
     decompressAVXBlock1(param);
   }
@@ -343,7 +395,87 @@ static inline void decompressAVXBlock(DecimalIterateParam* param, uint32_t limit
   // Write block with exception
   decompressExceptionBlock(param);
 }
-#endif  // BTR_USE_SIMD
+
+// Walks the blocks, the exception blocks are decoded by the scalar path
+BTR_TARGET_AVX2 static void decompressAVX(DecimalIterateParam* param,
+                                          const u32* exception_blocks,
+                                          u32 exception_blocks_count,
+                                          bool unroll) {
+  const u32 num_avx_blocks =
+      param->tuple_count / block_size;  // The number of blocks that are complete (have 4 values)
+  if (unroll) {
+    for (u32 exception_i = 0; exception_i < exception_blocks_count; exception_i++) {
+      decompressAVXBlockUnroll(param, exception_blocks[exception_i]);
+    }
+
+    // Write remaining blocks
+    decompressAVXBlockUnroll(param, num_avx_blocks);
+
+  } else {
+    for (u32 exception_i = 0; exception_i < exception_blocks_count; exception_i++) {
+      decompressAVXBlock(param, exception_blocks[exception_i]);
+    }
+
+    // Write remaining blocks
+    decompressAVXBlock(param, num_avx_blocks);
+  }
+}
+#endif  // BTR_WITH_AVX2
+
+#ifdef BTR_USE_DISPATCH
+// decompressAVXBlock4 on 512-bit registers
+BTR_TARGET_AVX512 static inline void decompressAVX512Block4(DecimalIterateParam* param) {
+  __m512d numbers_0 = _mm512_cvtepi32_pd(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(param->numbers_ptr) + 0));
+  __m512d numbers_1 = _mm512_cvtepi32_pd(
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(param->numbers_ptr) + 1));
+
+  __m256i exponents_0 =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(param->exponents_ptr) + 0);
+  __m256i exponents_1 =
+      _mm256_loadu_si256(reinterpret_cast<const __m256i*>(param->exponents_ptr) + 1);
+  __m512d powers_0 = _mm512_i32gather_pd(exponents_0, exact_fractions_of_ten, 8);
+  __m512d powers_1 = _mm512_i32gather_pd(exponents_1, exact_fractions_of_ten, 8);
+
+  _mm512_storeu_pd(param->write_ptr + 0, _mm512_mul_pd(numbers_0, powers_0));
+  _mm512_storeu_pd(param->write_ptr + 8, _mm512_mul_pd(numbers_1, powers_1));
+
+  param->write_ptr += 16;
+  param->exponents_ptr += 16;
+  param->numbers_ptr += 16;
+  param->next_block_i += 4;
+}
+
+BTR_TARGET_AVX512 static inline void decompressAVX512BlockUnroll(DecimalIterateParam* param,
+                                                                 uint32_t limit) {
+  auto unroll_limit = limit < 3 ? 0 : limit - 3;
+  while (param->next_block_i < unroll_limit) {
+    decompressAVX512Block4(param);
+  }
+  while (param->next_block_i < limit) {
+    decompressAVXBlock1(param);
+  }
+
+  // Write block with exception
+  decompressExceptionBlock(param);
+}
+
+BTR_TARGET_AVX512 static void decompressAVX512(DecimalIterateParam* param,
+                                               const u32* exception_blocks,
+                                               u32 exception_blocks_count,
+                                               bool unroll) {
+  if (!unroll) {
+    // Short runs between the exceptions, wider registers would not help
+    return decompressAVX(param, exception_blocks, exception_blocks_count, unroll);
+  }
+  for (u32 exception_i = 0; exception_i < exception_blocks_count; exception_i++) {
+    decompressAVX512BlockUnroll(param, exception_blocks[exception_i]);
+  }
+
+  // Write remaining blocks
+  decompressAVX512BlockUnroll(param, param->tuple_count / block_size);
+}
+#endif  // BTR_USE_DISPATCH
 
 void Decimal::decompress(DOUBLE* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32 level) {
   // idea save exceptions in roaring in blocks of 4.
@@ -361,9 +493,6 @@ void Decimal::decompress(DOUBLE* dest, BitmapWrapper*, const u8* src, u32 tuple_
   thread_local std::vector<std::vector<DOUBLE>> patches_v;
   auto patches_ptr = get_level_data(
       patches_v, tuple_count - col_struct.converted_count + SIMD_EXTRA_ELEMENTS(DOUBLE), level);
-  Roaring exceptions_bitmap = Roaring::read(
-      reinterpret_cast<const char*>(col_struct.data + col_struct.exceptions_map_offset), false);
-
   if (col_struct.converted_count > 0) {
     IntegerScheme& numbers_scheme =
         IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.numbers_scheme);
@@ -382,8 +511,10 @@ void Decimal::decompress(DOUBLE* dest, BitmapWrapper*, const u8* src, u32 tuple_
                             col_struct.data + col_struct.patches_offset,
                             tuple_count - col_struct.converted_count, level + 1);
 
-#ifdef BTR_USE_SIMD
-  if (col_struct.variant_selector & do_iteration) {
+#ifdef BTR_WITH_AVX2
+  if ((col_struct.variant_selector & do_iteration) && CpuDispatch::atLeast(SimdLevel::AVX2)) {
+    const bitmap::RoaringView exceptions_bitmap(col_struct.data +
+                                                col_struct.exceptions_map_offset);
     struct DecimalIterateParam param = {
         .next_block_i = 0,
         .tuple_count = tuple_count,
@@ -392,50 +523,17 @@ void Decimal::decompress(DOUBLE* dest, BitmapWrapper*, const u8* src, u32 tuple_
         .numbers_ptr = numbers_ptr,
         .patches_ptr = patches_ptr,
     };
-    const u32 num_avx_blocks =
-        tuple_count / block_size;  // The number of blocks that are complete (have 4 values)
-
-    // if (col_struct.variant_selector & do_unroll) {
-    if (col_struct.variant_selector & do_unroll) {
-      exceptions_bitmap.iterate(
-          [](uint32_t value, void* param_void) {
-            auto param = reinterpret_cast<struct DecimalIterateParam*>(param_void);
-            decompressAVXBlockUnroll(param, value);
-            return true;
-          },
-          &param);
-
-      // Write remaining blocks
-      decompressAVXBlockUnroll(&param, num_avx_blocks);
-
-    } else {
-      exceptions_bitmap.iterate(
-          [](uint32_t value, void* param_void) {
-            auto param = reinterpret_cast<struct DecimalIterateParam*>(param_void);
-            decompressAVXBlock(param, value);
-            return true;
-          },
-          &param);
-
-      // Write remaining blocks
-      decompressAVXBlock(&param, num_avx_blocks);
-    }
-  } else {
-    auto write_ptr = dest;
-    for (u32 row_i = 0; row_i < tuple_count; row_i++) {
-      INTEGER exponent = *exponents_ptr++;
-      if (exponent == exponent_exception_code) {
-        *write_ptr++ = *patches_ptr++;
-      } else {
-        auto number = *numbers_ptr++;
-        u8 exponent_index = exponent & decimal_index_mask;
-        DOUBLE original_double =
-            static_cast<DOUBLE>(number) * exact_fractions_of_ten[exponent_index];
-        *write_ptr++ = original_double;
-      }
+    const u32 exception_blocks_count = exceptions_bitmap.cardinality();
+    auto exception_blocks = Patches::positions(exceptions_bitmap, level);
+    const bool unroll = col_struct.variant_selector & do_unroll;
+#ifdef BTR_USE_DISPATCH
+    if (CpuDispatch::atLeast(SimdLevel::AVX512)) {
+      return decompressAVX512(&param, exception_blocks, exception_blocks_count, unroll);
     }
+#endif
+    return decompressAVX(&param, exception_blocks, exception_blocks_count, unroll);
   }
-#else  // don't use SIMD
+#endif
   auto write_ptr = dest;
   for (u32 row_i = 0; row_i < tuple_count; row_i++) {
     INTEGER exponent = *exponents_ptr++;
@@ -448,7 +546,6 @@ void Decimal::decompress(DOUBLE* dest, BitmapWrapper*, const u8* src, u32 tuple_
       *write_ptr++ = original_double;
     }
   }
-#endif
 }
 
 string Decimal::fullDescription(const u8* src) {
@@ -38,6 +38,26 @@ void RLE::decompress(DOUBLE* dest,
   return MyRLE::decompressColumn(dest, nullmap, src, tuple_count, level);
 }
 // -------------------------------------------------------------------------------------
+void RLE::hash(u64* dest,
+               BitmapWrapper* nullmap,
+               const u8* src,
+               u32 tuple_count,
+               u32 level) {
+  return MyRLE::hashColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+u32 RLE::getRunsCount(const u8* src) {
+  return MyRLE::runsCount(src);
+}
+u32 RLE::decompressRuns(DOUBLE* values,
+                        INTEGER* counts,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) {
+  return MyRLE::decompressRuns(values, counts, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
 string RLE::fullDescription(const u8* src) {
   return MyRLE::fullDescription(src, this->selfDescription());
 }
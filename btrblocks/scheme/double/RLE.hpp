@@ -18,6 +18,18 @@ class RLE : public DoubleScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  u32 getRunsCount(const u8* src);
+  u32 decompressRuns(DOUBLE* values,
+                     INTEGER* counts,
+                     BitmapWrapper* nullmap,
+                     const u8* src,
+                     u32 tuple_count,
+                     u32 level);
   std::string fullDescription(const u8* src) override;
   inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
   inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::RLE; }
@@ -0,0 +1,39 @@
+#include "Sparse.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "scheme/SchemeConfig.hpp"
+#include "scheme/templated/Sparse.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::doubles {
+// -------------------------------------------------------------------------------------
+using MySparse = TSparse<DOUBLE, DoubleScheme, DoubleStats, DoubleSchemeType>;
+// -------------------------------------------------------------------------------------
+double Sparse::expectedCompressionRatio(DoubleStats& stats, u8 allowed_cascading_level) {
+  if (!MySparse::isSparse(stats, SchemeConfig::get().doubles.sparse_null_threshold_pct)) {
+    return 0;
+  }
+  return DoubleScheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 Sparse::compress(const DOUBLE* src,
+                     const BITMAP* nullmap,
+                     u8* dest,
+                     DoubleStats& stats,
+                     u8 allowed_cascading_level) {
+  return MySparse::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+void Sparse::decompress(DOUBLE* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) {
+  MySparse::decompressColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+string Sparse::fullDescription(const u8* src) {
+  return MySparse::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::doubles
+// -------------------------------------------------------------------------------------
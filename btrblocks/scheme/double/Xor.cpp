@@ -0,0 +1,199 @@
+#include "Xor.hpp"
+#include "common/Units.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <cstring>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::doubles {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+// Leading zeros are stored in 5 bits
+const u32 max_leading_zeros = 31;
+// -------------------------------------------------------------------------------------
+inline u64 lowBits(u64 value, u32 bits) {
+  return bits == 64 ? value : value & ((1ull << bits) - 1);
+}
+// -------------------------------------------------------------------------------------
+// LSB-first bit stream of u64 words. The stream follows the u32 block offsets
+// and the scheme output can start anywhere, so words are copied in and out
+// instead of dereferenced.
+class BitWriter {
+ public:
+  explicit BitWriter(u8* dest) : begin(dest), dest(dest) {}
+  // bits in [1, 64], value must not have bits set above
+  inline void write(u64 value, u32 bits) {
+    buffer |= value << filled;
+    if (filled + bits >= 64) {
+      storeWord();
+      u32 consumed = 64 - filled;
+      buffer = consumed == 64 ? 0 : value >> consumed;
+      filled = filled + bits - 64;
+    } else {
+      filled += bits;
+    }
+  }
+  // Pad to the next word, returns the number of words written so far
+  inline u32 flush() {
+    if (filled > 0) {
+      storeWord();
+      buffer = 0;
+      filled = 0;
+    }
+    return (dest - begin) / sizeof(u64);
+  }
+
+ private:
+  inline void storeWord() {
+    std::memcpy(dest, &buffer, sizeof(u64));
+    dest += sizeof(u64);
+  }
+  u8* begin;
+  u8* dest;
+  u64 buffer = 0;
+  u32 filled = 0;
+};
+// -------------------------------------------------------------------------------------
+class BitReader {
+ public:
+  explicit BitReader(const u8* src) : src(src) {}
+  inline bool readBit() {
+    if (available == 0) {
+      current = loadWord();
+      available = 64;
+    }
+    bool bit = current & 1;
+    current >>= 1;
+    available--;
+    return bit;
+  }
+  // bits in [1, 64]
+  inline u64 read(u32 bits) {
+    if (bits <= available) {
+      u64 result = lowBits(current, bits);
+      current = bits == 64 ? 0 : current >> bits;
+      available -= bits;
+      return result;
+    }
+    u64 low = current;
+    u32 low_bits = available;
+    current = loadWord();
+    u32 rest = bits - low_bits;
+    u64 high = lowBits(current, rest);
+    current = rest == 64 ? 0 : current >> rest;
+    available = 64 - rest;
+    return low | (high << low_bits);
+  }
+
+ private:
+  inline u64 loadWord() {
+    u64 word;
+    std::memcpy(&word, src, sizeof(u64));
+    src += sizeof(u64);
+    return word;
+  }
+  const u8* src;
+  u64 current = 0;
+  u32 available = 0;
+};
+// -------------------------------------------------------------------------------------
+inline u64 toBits(DOUBLE value) {
+  u64 bits;
+  std::memcpy(&bits, &value, sizeof(u64));
+  return bits;
+}
+inline DOUBLE fromBits(u64 bits) {
+  DOUBLE value;
+  std::memcpy(&value, &bits, sizeof(u64));
+  return value;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+u32 Xor::compress(const DOUBLE* src,
+                  const BITMAP* nullmap,
+                  u8* dest,
+                  DoubleStats& stats,
+                  u8) {
+  auto& col_struct = *reinterpret_cast<XorStructure*>(dest);
+  col_struct.blocks_count = (stats.tuple_count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  col_struct.stream_offset = col_struct.blocks_count * sizeof(u32);
+  auto block_offsets = reinterpret_cast<u32*>(col_struct.data);
+  BitWriter writer(col_struct.data + col_struct.stream_offset);
+  // -------------------------------------------------------------------------------------
+  for (u32 block_i = 0; block_i < col_struct.blocks_count; block_i++) {
+    block_offsets[block_i] = writer.flush();
+    const u32 row_begin = block_i * BLOCK_SIZE;
+    const u32 row_end = std::min(row_begin + BLOCK_SIZE, stats.tuple_count);
+    // -------------------------------------------------------------------------------------
+    // Every block starts with a raw value, nulls repeat the previous value
+    u64 prev = toBits(src[row_begin]);
+    writer.write(prev, 64);
+    u32 prev_leading = 65;
+    u32 prev_trailing = 0;
+    for (u32 row_i = row_begin + 1; row_i < row_end; row_i++) {
+      u64 current = (nullmap != nullptr && !nullmap[row_i]) ? prev : toBits(src[row_i]);
+      u64 x = current ^ prev;
+      prev = current;
+      if (x == 0) {
+        writer.write(0, 1);
+        continue;
+      }
+      u32 leading = std::min<u32>(__builtin_clzll(x), max_leading_zeros);
+      u32 trailing = __builtin_ctzll(x);
+      if (leading >= prev_leading && trailing >= prev_trailing) {
+        // 10: reuse the previous window
+        writer.write(0b01, 2);
+        writer.write(x >> prev_trailing, 64 - prev_leading - prev_trailing);
+      } else {
+        // 11: new window, a length of 64 is stored as 0
+        u32 length = 64 - leading - trailing;
+        writer.write(0b11, 2);
+        writer.write(leading, 5);
+        writer.write(length & 63, 6);
+        writer.write(x >> trailing, length);
+        prev_leading = leading;
+        prev_trailing = trailing;
+      }
+    }
+  }
+  u32 words = writer.flush();
+  // -------------------------------------------------------------------------------------
+  return sizeof(XorStructure) + col_struct.stream_offset + words * sizeof(u64);
+}
+// -------------------------------------------------------------------------------------
+void Xor::decompress(DOUBLE* dest,
+                     BitmapWrapper*,
+                     const u8* src,
+                     u32 tuple_count,
+                     u32) {
+  const auto& col_struct = *reinterpret_cast<const XorStructure*>(src);
+  auto block_offsets = reinterpret_cast<const u32*>(col_struct.data);
+  auto stream = col_struct.data + col_struct.stream_offset;
+  // -------------------------------------------------------------------------------------
+  for (u32 block_i = 0; block_i < col_struct.blocks_count; block_i++) {
+    BitReader reader(stream + block_offsets[block_i] * sizeof(u64));
+    const u32 row_begin = block_i * BLOCK_SIZE;
+    const u32 row_end = std::min(row_begin + BLOCK_SIZE, tuple_count);
+    // -------------------------------------------------------------------------------------
+    u64 prev = reader.read(64);
+    dest[row_begin] = fromBits(prev);
+    u32 leading = 0;
+    u32 trailing = 0;
+    for (u32 row_i = row_begin + 1; row_i < row_end; row_i++) {
+      if (reader.readBit()) {
+        if (reader.readBit()) {
+          leading = reader.read(5);
+          u32 length = reader.read(6);
+          length = length == 0 ? 64 : length;
+          trailing = 64 - leading - length;
+        }
+        prev ^= reader.read(64 - leading - trailing) << trailing;
+      }
+      dest[row_i] = fromBits(prev);
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::doubles
+// -------------------------------------------------------------------------------------
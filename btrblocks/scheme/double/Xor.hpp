@@ -0,0 +1,42 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::doubles {
+// -------------------------------------------------------------------------------------
+/*
+ * Gorilla-style XOR encoding for slowly drifting doubles. Each value is XORed
+ * with its predecessor and only the meaningful bits between the leading and
+ * trailing zeros are stored:
+ *   0                             -> same value
+ *   10 <bits>                     -> fits into the previous leading/trailing window
+ *   11 <5 leading> <6 length> <bits> -> new window
+ * Values are split into independent blocks so decoding can start at any block.
+ */
+struct XorStructure {
+  u32 blocks_count;
+  u32 stream_offset;
+  // u32 block_offsets[blocks_count] (in u64 words), followed by the bit stream
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+class Xor : public DoubleScheme {
+ public:
+  static constexpr u32 BLOCK_SIZE = 1024;
+  // -------------------------------------------------------------------------------------
+  u32 compress(const DOUBLE* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               DoubleStats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(DOUBLE* dest,
+                  BitmapWrapper* bitmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  inline DoubleSchemeType schemeType() override { return staticSchemeType(); }
+  inline static DoubleSchemeType staticSchemeType() { return DoubleSchemeType::XOR; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::doubles
+// -------------------------------------------------------------------------------------
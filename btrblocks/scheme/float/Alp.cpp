@@ -0,0 +1,39 @@
+#include "Alp.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/templated/Alp.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+using MyAlp = TAlp<FLOAT, FloatScheme, FloatStats, FloatSchemeType>;
+// -------------------------------------------------------------------------------------
+double Alp::expectedCompressionRatio(FloatStats& stats, u8 allowed_cascading_level) {
+  if (allowed_cascading_level <= 1) {
+    return 0;
+  }
+  return FloatScheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 Alp::compress(const FLOAT* src,
+                  const BITMAP* nullmap,
+                  u8* dest,
+                  FloatStats& stats,
+                  u8 allowed_cascading_level) {
+  return MyAlp::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+void Alp::decompress(FLOAT* dest,
+                     BitmapWrapper* nullmap,
+                     const u8* src,
+                     u32 tuple_count,
+                     u32 level) {
+  MyAlp::decompressColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+std::string Alp::fullDescription(const u8* src) {
+  return MyAlp::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,95 @@
+#include "DynamicDictionary.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/templated/DynamicDictionary.hpp"
+#include "storage/Chunk.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Log.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+using MyDynamicDictionary = TDynamicDictionary<FLOAT, FloatScheme, FloatStats, FloatSchemeType>;
+// -------------------------------------------------------------------------------------
+double DynamicDictionary::expectedCompressionRatio(btrblocks::FloatStats& stats,
+                                                   u8 allowed_cascading_level) {
+  return this->expectedCompressionRatio(stats, allowed_cascading_level, {});
+}
+double DynamicDictionary::expectedCompressionRatio(btrblocks::FloatStats& stats,
+                                                   u8 allowed_cascading_level,
+                                                   const PartEncoding& part) {
+  return MyDynamicDictionary::expectedCompressionRatio(stats, allowed_cascading_level, part);
+}
+// -------------------------------------------------------------------------------------
+u32 DynamicDictionary::compress(const FLOAT* src,
+                                const BITMAP* nullmap,
+                                u8* dest,
+                                FloatStats& stats,
+                                u8 allowed_cascading_level) {
+  return this->compress(src, nullmap, dest, stats, allowed_cascading_level, {});
+}
+u32 DynamicDictionary::compress(const FLOAT* src,
+                                const BITMAP* nullmap,
+                                u8* dest,
+                                FloatStats& stats,
+                                u8 allowed_cascading_level,
+                                const PartEncoding& part) {
+  return MyDynamicDictionary::compressColumn(src, nullmap, dest, stats, allowed_cascading_level,
+                                             part);
+}
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::decompress(FLOAT* dest,
+                                   BitmapWrapper* nullmap,
+                                   const u8* src,
+                                   u32 tuple_count,
+                                   u32 level) {
+  return this->decompress(dest, nullmap, src, tuple_count, level, {});
+}
+void DynamicDictionary::decompress(FLOAT* dest,
+                                   BitmapWrapper* nullmap,
+                                   const u8* src,
+                                   u32 tuple_count,
+                                   u32 level,
+                                   const PartData& part) {
+  return MyDynamicDictionary::decompressColumn(dest, nullmap, src, tuple_count, level, part);
+}
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::hash(u64* dest,
+                             BitmapWrapper* nullmap,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level) {
+  return this->hash(dest, nullmap, src, tuple_count, level, {});
+}
+void DynamicDictionary::hash(u64* dest,
+                             BitmapWrapper* nullmap,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level,
+                             const PartData& part) {
+  return MyDynamicDictionary::hashColumn(dest, nullmap, src, tuple_count, level, part);
+}
+// -------------------------------------------------------------------------------------
+u32 DynamicDictionary::getDictionarySize(const u8* src, const PartData& part) {
+  return MyDynamicDictionary::dictionarySize(src, part);
+}
+bool DynamicDictionary::usesGlobalDictionary(const u8* src) {
+  return MyDynamicDictionary::usesGlobalDictionary(src);
+}
+u32 DynamicDictionary::decompressCodes(FLOAT* dictionary,
+                                       INTEGER* codes,
+                                       BitmapWrapper* nullmap,
+                                       const u8* src,
+                                       u32 tuple_count,
+                                       u32 level,
+                                       const PartData& part) {
+  return MyDynamicDictionary::decompressCodes(dictionary, codes, nullmap, src, tuple_count, level,
+                                              part);
+}
+
+string DynamicDictionary::fullDescription(const u8* src) {
+  return MyDynamicDictionary::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
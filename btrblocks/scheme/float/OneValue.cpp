@@ -0,0 +1,29 @@
+// -------------------------------------------------------------------------------------
+#include "OneValue.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/templated/OneValue.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+using MyOneValue = TOneValue<FLOAT, FloatStats>;
+// -------------------------------------------------------------------------------------
+double OneValue::expectedCompressionRatio(FloatStats& stats, u8) {
+  return MyOneValue::expectedCompressionRatio(stats);
+}
+// -------------------------------------------------------------------------------------
+u32 OneValue::compress(const FLOAT* src, const BITMAP*, u8* dest, FloatStats& stats, u8) {
+  return MyOneValue::compressColumn(src, dest, stats);
+}
+// -------------------------------------------------------------------------------------
+void OneValue::decompress(FLOAT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  MyOneValue::decompressColumn(dest, src, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void OneValue::hash(u64* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  MyOneValue::hashColumn(dest, src, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
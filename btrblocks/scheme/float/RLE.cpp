@@ -0,0 +1,66 @@
+// -------------------------------------------------------------------------------------
+#include "RLE.hpp"
+// -------------------------------------------------------------------------------------
+#include "btrblocks.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/templated/RLE.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+using MyRLE = TRLE<FLOAT, FloatScheme, FloatStats, FloatSchemeType>;
+// -------------------------------------------------------------------------------------
+double RLE::expectedCompressionRatio(FloatStats& stats, u8 allowed_cascading_level) {
+  if (stats.average_run_length < 2) {
+    return 0;
+  }
+  return FloatScheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 RLE::compress(const FLOAT* src,
+                  const BITMAP* nullmap,
+                  u8* dest,
+                  FloatStats& stats,
+                  u8 allowed_cascading_level) {
+  auto& cfg = SchemeConfig::get();
+  return MyRLE::compressColumn(src, nullmap, dest, stats, allowed_cascading_level,
+                               CB(cfg.floats.rle_force_values_scheme),
+                               CB(cfg.floats.rle_force_counts_scheme));
+}
+// -------------------------------------------------------------------------------------
+void RLE::decompress(FLOAT* dest,
+                     BitmapWrapper* nullmap,
+                     const u8* src,
+                     u32 tuple_count,
+                     u32 level) {
+  return MyRLE::decompressColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void RLE::hash(u64* dest,
+               BitmapWrapper* nullmap,
+               const u8* src,
+               u32 tuple_count,
+               u32 level) {
+  return MyRLE::hashColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+u32 RLE::getRunsCount(const u8* src) {
+  return MyRLE::runsCount(src);
+}
+u32 RLE::decompressRuns(FLOAT* values,
+                        INTEGER* counts,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) {
+  return MyRLE::decompressRuns(values, counts, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+string RLE::fullDescription(const u8* src) {
+  return MyRLE::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,26 @@
+// -------------------------------------------------------------------------------------
+#include "Uncompressed.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+#include <cstring>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::floats {
+// -------------------------------------------------------------------------------------
+double Uncompressed::expectedCompressionRatio(FloatStats&, u8) {
+  return 1.0;
+}
+// -------------------------------------------------------------------------------------
+u32 Uncompressed::compress(const FLOAT* src, const BITMAP*, u8* dest, FloatStats& stats, u8) {
+  std::memcpy(dest, src, stats.total_size);
+  return stats.total_size;
+}
+// -------------------------------------------------------------------------------------
+void Uncompressed::decompress(FLOAT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  std::memcpy(dest, src, tuple_count * sizeof(FLOAT));
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::floats
+// -------------------------------------------------------------------------------------
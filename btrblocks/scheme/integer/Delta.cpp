@@ -0,0 +1,198 @@
+#include "Delta.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/SchemeConfig.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Log.hpp"
+// -------------------------------------------------------------------------------------
+#include <limits>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::integers {
+// -------------------------------------------------------------------------------------
+double Delta::expectedCompressionRatio(SInteger32Stats& stats, u8 allowed_cascading_level) {
+  if (allowed_cascading_level <= 1 || stats.tuple_count == 0) {
+    return 0;
+  }
+  // Every descent becomes a patch, give up early on unsorted data
+  u32 descents = 0;
+  bool has_prev = false;
+  INTEGER prev = 0;
+  for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
+    if (stats.bitmap != nullptr && !stats.bitmap[row_i]) {
+      continue;
+    }
+    descents += has_prev && stats.src[row_i] < prev;
+    prev = stats.src[row_i];
+    has_prev = true;
+  }
+  if (CD(descents) * 100.0 / CD(stats.tuple_count) >
+      SchemeConfig::get().integers.delta_exception_threshold_pct) {
+    return 0;
+  }
+  return IntegerScheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 Delta::compress(const INTEGER* src,
+                    const BITMAP* nullmap,
+                    u8* dest,
+                    SInteger32Stats& stats,
+                    u8 allowed_cascading_level) {
+  auto& col_struct = *reinterpret_cast<DeltaStructure*>(dest);
+  // -------------------------------------------------------------------------------------
+  // Start from the first non-null value, nulls repeat the previous value
+  u32 first_row = 0;
+  while (first_row < stats.tuple_count && nullmap != nullptr && !nullmap[first_row]) {
+    first_row++;
+  }
+  col_struct.base = first_row < stats.tuple_count ? src[first_row] : 0;
+  // -------------------------------------------------------------------------------------
+  vector<INTEGER> deltas(stats.tuple_count, 0);
+  vector<INTEGER> exceptions_positions;
+  vector<INTEGER> exceptions_values;
+  u32 prev = static_cast<u32>(col_struct.base);
+  for (u32 row_i = first_row + 1; row_i < stats.tuple_count; row_i++) {
+    if (nullmap != nullptr && !nullmap[row_i]) {
+      continue;
+    }
+    // Wrapping u32 arithmetic, decompression wraps the same way
+    u32 delta = static_cast<u32>(src[row_i]) - prev;
+    if (delta <= static_cast<u32>(std::numeric_limits<INTEGER>::max())) {
+      deltas[row_i] = static_cast<INTEGER>(delta);
+    } else {
+      exceptions_positions.push_back(row_i);
+      exceptions_values.push_back(static_cast<INTEGER>(delta));
+    }
+    prev = static_cast<u32>(src[row_i]);
+  }
+  col_struct.exceptions_count = exceptions_positions.size();
+  // -------------------------------------------------------------------------------------
+  auto write_ptr = col_struct.data;
+  // Compress deltas
+  {
+    u32 used_space;
+    IntegerSchemePicker::compress(deltas.data(), nullptr, write_ptr, deltas.size(),
+                                  allowed_cascading_level - 1, used_space,
+                                  col_struct.deltas_scheme_code, autoScheme(), "deltas");
+    write_ptr += used_space;
+    Log::debug("DELTA: deltas_c = {} deltas_s = {}", CI(col_struct.deltas_scheme_code),
+               CI(used_space));
+  }
+  // -------------------------------------------------------------------------------------
+  // Compress exceptions
+  col_struct.exceptions_positions_offset = write_ptr - col_struct.data;
+  if (col_struct.exceptions_count > 0) {
+    u32 used_space;
+    IntegerSchemePicker::compress(exceptions_positions.data(), nullptr, write_ptr,
+                                  exceptions_positions.size(), allowed_cascading_level - 1,
+                                  used_space, col_struct.positions_scheme_code, autoScheme(),
+                                  "exceptions_positions");
+    write_ptr += used_space;
+    // -------------------------------------------------------------------------------------
+    col_struct.exceptions_values_offset = write_ptr - col_struct.data;
+    IntegerSchemePicker::compress(exceptions_values.data(), nullptr, write_ptr,
+                                  exceptions_values.size(), allowed_cascading_level - 1,
+                                  used_space, col_struct.values_scheme_code, autoScheme(),
+                                  "exceptions_values");
+    write_ptr += used_space;
+  } else {
+    col_struct.exceptions_values_offset = col_struct.exceptions_positions_offset;
+    col_struct.positions_scheme_code = CB(IntegerSchemeType::UNCOMPRESSED);
+    col_struct.values_scheme_code = CB(IntegerSchemeType::UNCOMPRESSED);
+  }
+  // -------------------------------------------------------------------------------------
+  return write_ptr - dest;
+}
+// -------------------------------------------------------------------------------------
+void Delta::decompress(INTEGER* dest,
+                       BitmapWrapper*,
+                       const u8* src,
+                       u32 tuple_count,
+                       u32 level) {
+  const auto& col_struct = *reinterpret_cast<const DeltaStructure*>(src);
+  if (tuple_count == 0) {
+    return;
+  }
+  // -------------------------------------------------------------------------------------
+  // Deltas of null rows are 0, so the whole column is decoded without nullmap
+  IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.deltas_scheme_code)
+      .decompress(dest, nullptr, col_struct.data, tuple_count, level + 1);
+  // -------------------------------------------------------------------------------------
+  // Patch the descents
+  if (col_struct.exceptions_count > 0) {
+    thread_local std::vector<std::vector<INTEGER>> positions_v;
+    auto positions = get_level_data(
+        positions_v, col_struct.exceptions_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.positions_scheme_code)
+        .decompress(positions, nullptr, col_struct.data + col_struct.exceptions_positions_offset,
+                    col_struct.exceptions_count, level + 1);
+    thread_local std::vector<std::vector<INTEGER>> values_v;
+    auto values = get_level_data(
+        values_v, col_struct.exceptions_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.values_scheme_code)
+        .decompress(values, nullptr, col_struct.data + col_struct.exceptions_values_offset,
+                    col_struct.exceptions_count, level + 1);
+    for (u32 exception_i = 0; exception_i < col_struct.exceptions_count; exception_i++) {
+      dest[positions[exception_i]] = values[exception_i];
+    }
+  }
+  dest[0] = col_struct.base;
+  // -------------------------------------------------------------------------------------
+  // Inclusive prefix sum, wrapping like the u32 deltas in compress
+  u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+  /*
+   * Two shift+add steps give the prefix sums inside each 128-bit lane, then the
+   * low lane's total is added to the high lane. The carry is the last element
+   * of the previous block broadcast to all elements.
+   */
+  __m256i carry = _mm256_setzero_si256();
+  const __m256i low_lane_last = _mm256_set1_epi32(3);
+  const __m256i high_lane_last = _mm256_set1_epi32(7);
+  for (; row_i + 8 <= tuple_count; row_i += 8) {
+    auto ptr = reinterpret_cast<__m256i*>(dest + row_i);
+    __m256i v = _mm256_loadu_si256(ptr);
+    v = _mm256_add_epi32(v, _mm256_slli_si256(v, 4));
+    v = _mm256_add_epi32(v, _mm256_slli_si256(v, 8));
+    __m256i low_total = _mm256_permutevar8x32_epi32(v, low_lane_last);
+    v = _mm256_add_epi32(v, _mm256_blend_epi32(_mm256_setzero_si256(), low_total, 0xF0));
+    v = _mm256_add_epi32(v, carry);
+    _mm256_storeu_si256(ptr, v);
+    carry = _mm256_permutevar8x32_epi32(v, high_lane_last);
+  }
+#endif
+  auto values = reinterpret_cast<u32*>(dest);
+  for (row_i = std::max(row_i, 1u); row_i < tuple_count; row_i++) {
+    values[row_i] += values[row_i - 1];
+  }
+}
+// -------------------------------------------------------------------------------------
+INTEGER Delta::lookup(u32) {
+  UNREACHABLE();
+}
+void Delta::scan(Predicate, BITMAP*, const u8*, u32) {
+  UNREACHABLE();
+}
+// -------------------------------------------------------------------------------------
+std::string Delta::fullDescription(const u8* src) {
+  const auto& col_struct = *reinterpret_cast<const DeltaStructure*>(src);
+  auto& deltas_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.deltas_scheme_code);
+  string result = this->selfDescription();
+  result += "\n\t-> ([int] deltas) " + deltas_scheme.fullDescription(col_struct.data);
+  if (col_struct.exceptions_count > 0) {
+    auto& positions_scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.positions_scheme_code);
+    result += "\n\t-> ([int] exceptions positions) " +
+              positions_scheme.fullDescription(col_struct.data +
+                                               col_struct.exceptions_positions_offset);
+    auto& values_scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.values_scheme_code);
+    result += "\n\t-> ([int] exceptions values) " +
+              values_scheme.fullDescription(col_struct.data + col_struct.exceptions_values_offset);
+  }
+  return result;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::integers
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,42 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::integers {
+// -------------------------------------------------------------------------------------
+// Deltas between consecutive values. Descents (negative deltas) are stored as
+// patches so that the cascaded deltas stay small and non-negative.
+// -------------------------------------------------------------------------------------
+struct DeltaStructure {
+  INTEGER base;
+  u32 exceptions_count;
+  u32 exceptions_positions_offset;
+  u32 exceptions_values_offset;
+  u8 deltas_scheme_code;
+  u8 positions_scheme_code;
+  u8 values_scheme_code;
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+class Delta : public IntegerScheme {
+ public:
+  double expectedCompressionRatio(SInteger32Stats& stats, u8 allowed_cascading_level) override;
+  u32 compress(const INTEGER* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               SInteger32Stats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(INTEGER* dest,
+                  BitmapWrapper* nullmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
+  inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::DELTA; }
+  INTEGER lookup(u32) override;
+  void scan(Predicate, BITMAP*, const u8*, u32) override;
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::integers
+// -------------------------------------------------------------------------------------
@@ -17,7 +17,12 @@ using MyDynamicDictionary =
 // -------------------------------------------------------------------------------------
 double DynamicDictionary::expectedCompressionRatio(SInteger32Stats& stats,
                                                    u8 allowed_cascading_level) {
-  return MyDynamicDictionary::expectedCompressionRatio(stats, allowed_cascading_level);
+  return this->expectedCompressionRatio(stats, allowed_cascading_level, {});
+}
+double DynamicDictionary::expectedCompressionRatio(SInteger32Stats& stats,
+                                                   u8 allowed_cascading_level,
+                                                   const PartEncoding& part) {
+  return MyDynamicDictionary::expectedCompressionRatio(stats, allowed_cascading_level, part);
 }
 // -------------------------------------------------------------------------------------
 u32 DynamicDictionary::compress(const INTEGER* src,
@@ -25,7 +30,16 @@ u32 DynamicDictionary::compress(const INTEGER* src,
                                 u8* dest,
                                 SInteger32Stats& stats,
                                 u8 allowed_cascading_level) {
-  return MyDynamicDictionary::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+  return this->compress(src, nullmap, dest, stats, allowed_cascading_level, {});
+}
+u32 DynamicDictionary::compress(const INTEGER* src,
+                                const BITMAP* nullmap,
+                                u8* dest,
+                                SInteger32Stats& stats,
+                                u8 allowed_cascading_level,
+                                const PartEncoding& part) {
+  return MyDynamicDictionary::compressColumn(src, nullmap, dest, stats, allowed_cascading_level,
+                                             part);
 }
 // -------------------------------------------------------------------------------------
 void DynamicDictionary::decompress(INTEGER* dest,
@@ -33,7 +47,79 @@ void DynamicDictionary::decompress(INTEGER* dest,
                                    const u8* src,
                                    u32 tuple_count,
                                    u32 level) {
-  return MyDynamicDictionary::decompressColumn(dest, nullmap, src, tuple_count, level);
+  return this->decompress(dest, nullmap, src, tuple_count, level, {});
+}
+void DynamicDictionary::decompress(INTEGER* dest,
+                                   BitmapWrapper* nullmap,
+                                   const u8* src,
+                                   u32 tuple_count,
+                                   u32 level,
+                                   const PartData& part) {
+  return MyDynamicDictionary::decompressColumn(dest, nullmap, src, tuple_count, level, part);
+}
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::decompressNarrow(SMALLINT* dest,
+                                         BitmapWrapper* nullmap,
+                                         const u8* src,
+                                         u32 tuple_count,
+                                         u32 level) {
+  return this->decompressNarrow(dest, nullmap, src, tuple_count, level, {});
+}
+void DynamicDictionary::decompressNarrow(SMALLINT* dest,
+                                         BitmapWrapper* nullmap,
+                                         const u8* src,
+                                         u32 tuple_count,
+                                         u32 level,
+                                         const PartData& part) {
+  return MyDynamicDictionary::decompressColumnNarrow(dest, nullmap, src, tuple_count, level, part);
+}
+void DynamicDictionary::decompressNarrow(TINYINT* dest,
+                                         BitmapWrapper* nullmap,
+                                         const u8* src,
+                                         u32 tuple_count,
+                                         u32 level) {
+  return this->decompressNarrow(dest, nullmap, src, tuple_count, level, {});
+}
+void DynamicDictionary::decompressNarrow(TINYINT* dest,
+                                         BitmapWrapper* nullmap,
+                                         const u8* src,
+                                         u32 tuple_count,
+                                         u32 level,
+                                         const PartData& part) {
+  return MyDynamicDictionary::decompressColumnNarrow(dest, nullmap, src, tuple_count, level, part);
+}
+// -------------------------------------------------------------------------------------
+void DynamicDictionary::hash(u64* dest,
+                             BitmapWrapper* nullmap,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level) {
+  return this->hash(dest, nullmap, src, tuple_count, level, {});
+}
+void DynamicDictionary::hash(u64* dest,
+                             BitmapWrapper* nullmap,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level,
+                             const PartData& part) {
+  return MyDynamicDictionary::hashColumn(dest, nullmap, src, tuple_count, level, part);
+}
+// -------------------------------------------------------------------------------------
+u32 DynamicDictionary::getDictionarySize(const u8* src, const PartData& part) {
+  return MyDynamicDictionary::dictionarySize(src, part);
+}
+bool DynamicDictionary::usesGlobalDictionary(const u8* src) {
+  return MyDynamicDictionary::usesGlobalDictionary(src);
+}
+u32 DynamicDictionary::decompressCodes(INTEGER* dictionary,
+                                       INTEGER* codes,
+                                       BitmapWrapper* nullmap,
+                                       const u8* src,
+                                       u32 tuple_count,
+                                       u32 level,
+                                       const PartData& part) {
+  return MyDynamicDictionary::decompressCodes(dictionary, codes, nullmap, src, tuple_count, level,
+                                              part);
 }
 // -------------------------------------------------------------------------------------
 INTEGER DynamicDictionary::lookup(u32) {
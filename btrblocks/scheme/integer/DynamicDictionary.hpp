@@ -13,16 +13,74 @@ struct DynamicDictionaryStructure {
 class DynamicDictionary : public IntegerScheme {
  public:
   double expectedCompressionRatio(SInteger32Stats& stats, u8 allowed_cascading_level) override;
+  double expectedCompressionRatio(SInteger32Stats& stats,
+                                  u8 allowed_cascading_level,
+                                  const PartEncoding& part) override;
   u32 compress(const INTEGER* src,
                const BITMAP* nullmap,
                u8* dest,
                SInteger32Stats& stats,
                u8 allowed_cascading_level) override;
+  u32 compress(const INTEGER* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               SInteger32Stats& stats,
+               u8 allowed_cascading_level,
+               const PartEncoding& part) override;
   void decompress(INTEGER* dest,
                   BitmapWrapper* nullmap,
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void decompress(INTEGER* dest,
+                  BitmapWrapper* nullmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level,
+                  const PartData& part) override;
+  void decompressNarrow(SMALLINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
+  void decompressNarrow(SMALLINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level,
+                        const PartData& part) override;
+  void decompressNarrow(TINYINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
+  void decompressNarrow(TINYINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level,
+                        const PartData& part) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level,
+            const PartData& part) override;
+  u32 getDictionarySize(const u8* src, const PartData& part);
+  // Whether the codes index the part's GlobalDictionary (stable across chunks)
+  bool usesGlobalDictionary(const u8* src);
+  u32 decompressCodes(INTEGER* dictionary,
+                      INTEGER* codes,
+                      BitmapWrapper* nullmap,
+                      const u8* src,
+                      u32 tuple_count,
+                      u32 level,
+                      const PartData& part);
   std::string fullDescription(const u8* src) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::DICT; }
@@ -9,9 +9,11 @@
 // -------------------------------------------------------------------------------------
 #include <cmath>
 // -------------------------------------------------------------------------------------
-namespace btrblocks::legacy::integers {
+namespace btrblocks::integers {
 // -------------------------------------------------------------------------------------
 double FOR::expectedCompressionRatio(SInteger32Stats& stats, u8 allowed_cascading_level) {
+  // Not picked by sampling, SchemePicker puts it in front of the other schemes
+  // when the minimum is negative or large (see shouldUseFOR)
   return 0;
 }
 // -------------------------------------------------------------------------------------
@@ -21,21 +23,27 @@ u32 FOR::compress(const INTEGER* src,
                   SInteger32Stats& stats,
                   u8 allowed_cascading_level) {
   auto& col_struct = *reinterpret_cast<FORStructure*>(dest);
-  vector<INTEGER> biased_output;
+  vector<INTEGER> biased_output(stats.tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
   // -------------------------------------------------------------------------------------
+  // stats.min also covers null rows, so every biased value is non-negative
   col_struct.bias = stats.min;
-  for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
-    if (nullmap == nullptr || nullmap[row_i]) {
-      biased_output.push_back(src[row_i] - col_struct.bias);
-    } else {
-      biased_output.push_back(src[row_i]);
-    }
+  u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+  const __m256i bias = _mm256_set1_epi32(col_struct.bias);
+  for (; row_i + 8 <= stats.tuple_count; row_i += 8) {
+    __m256i values = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + row_i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(biased_output.data() + row_i),
+                        _mm256_sub_epi32(values, bias));
+  }
+#endif
+  for (; row_i < stats.tuple_count; row_i++) {
+    biased_output[row_i] = static_cast<u32>(src[row_i]) - static_cast<u32>(col_struct.bias);
   }
   // -------------------------------------------------------------------------------------
   // Next Level compression
   auto write_ptr = col_struct.data;
   u32 used_space;
-  IntegerSchemePicker::compress(biased_output.data(), nullmap, write_ptr, biased_output.size(),
+  IntegerSchemePicker::compress(biased_output.data(), nullmap, write_ptr, stats.tuple_count,
                                 allowed_cascading_level - 1, used_space, col_struct.next_scheme,
                                 autoScheme(), "for_next_level");
   write_ptr += used_space;
@@ -59,9 +67,71 @@ void FOR::decompress(INTEGER* dest,
   }
 
   // In any case we add the bias. The result for null values does not matter
-  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
-    dest[row_i] += col_struct.bias;
+  u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+  const __m256i bias = _mm256_set1_epi32(col_struct.bias);
+  for (; row_i + 8 <= tuple_count; row_i += 8) {
+    auto ptr = reinterpret_cast<__m256i*>(dest + row_i);
+    _mm256_storeu_si256(ptr, _mm256_add_epi32(_mm256_loadu_si256(ptr), bias));
   }
+#endif
+  for (; row_i < tuple_count; row_i++) {
+    dest[row_i] = static_cast<u32>(dest[row_i]) + static_cast<u32>(col_struct.bias);
+  }
+}
+// -------------------------------------------------------------------------------------
+namespace {
+// The bias is added with wrapping arithmetic, which the truncated values of
+// the next level survive unchanged
+template <typename NarrowType>
+void decompressNarrowColumn(NarrowType* dest,
+                            BitmapWrapper* nullmap,
+                            const u8* src,
+                            u32 tuple_count,
+                            u32 level) {
+  const auto& col_struct = *reinterpret_cast<const FORStructure*>(src);
+  // -------------------------------------------------------------------------------------
+  IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.next_scheme)
+      .decompressNarrow(dest, nullmap, col_struct.data, tuple_count, level + 1);
+  // -------------------------------------------------------------------------------------
+  if (nullmap != nullptr && nullmap->type() == BitmapType::ALLZEROS) {
+    return;
+  }
+  const auto bias = static_cast<NarrowType>(col_struct.bias);
+  u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+  constexpr u32 per_vector = sizeof(__m256i) / sizeof(NarrowType);
+  for (; row_i + per_vector <= tuple_count; row_i += per_vector) {
+    auto ptr = reinterpret_cast<__m256i*>(dest + row_i);
+    __m256i values = _mm256_loadu_si256(ptr);
+    if constexpr (sizeof(NarrowType) == 2) {
+      values = _mm256_add_epi16(values, _mm256_set1_epi16(bias));
+    } else {
+      values = _mm256_add_epi8(values, _mm256_set1_epi8(bias));
+    }
+    _mm256_storeu_si256(ptr, values);
+  }
+#endif
+  for (; row_i < tuple_count; row_i++) {
+    dest[row_i] = static_cast<NarrowType>(dest[row_i] + bias);
+  }
+}
+}  // namespace
+// -------------------------------------------------------------------------------------
+void FOR::decompressNarrow(SMALLINT* dest,
+                           BitmapWrapper* nullmap,
+                           const u8* src,
+                           u32 tuple_count,
+                           u32 level) {
+  decompressNarrowColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+void FOR::decompressNarrow(TINYINT* dest,
+                           BitmapWrapper* nullmap,
+                           const u8* src,
+                           u32 tuple_count,
+                           u32 level) {
+  decompressNarrowColumn(dest, nullmap, src, tuple_count, level);
 }
 // -------------------------------------------------------------------------------------
 INTEGER FOR::lookup(u32) {
@@ -77,5 +147,5 @@ std::string FOR::fullDescription(const u8* src) {
   return this->selfDescription() + " -> ([int] biased) " + scheme.fullDescription(col_struct.data);
 }
 // -------------------------------------------------------------------------------------
-}  // namespace btrblocks::legacy::integers
+}  // namespace btrblocks::integers
 // -------------------------------------------------------------------------------------
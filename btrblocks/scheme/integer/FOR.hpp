@@ -3,7 +3,7 @@
 #include "scheme/CompressionScheme.hpp"
 // -------------------------------------------------------------------------------------
 // -------------------------------------------------------------------------------------
-namespace btrblocks::legacy::integers {
+namespace btrblocks::integers {
 // -------------------------------------------------------------------------------------
 struct FORStructure {
   INTEGER bias;
@@ -24,6 +24,16 @@ class FOR : public IntegerScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void decompressNarrow(SMALLINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
+  void decompressNarrow(TINYINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
   std::string fullDescription(const u8* src) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::FOR; }
@@ -31,5 +41,5 @@ class FOR : public IntegerScheme {
   void scan(Predicate, BITMAP*, const u8*, u32) override;
 };
 // -------------------------------------------------------------------------------------
-}  // namespace btrblocks::legacy::integers
+}  // namespace btrblocks::integers
 // -------------------------------------------------------------------------------------
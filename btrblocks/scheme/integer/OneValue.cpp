@@ -1,4 +1,5 @@
 #include "OneValue.hpp"
+#include "common/Hash.hpp"
 #include "common/Units.hpp"
 #include "scheme/CompressionScheme.hpp"
 #include "storage/Chunk.hpp"
@@ -38,6 +39,21 @@ void OneValue::decompress(INTEGER* dest,
   }
 }
 // -------------------------------------------------------------------------------------
+void OneValue::decompressNarrow(SMALLINT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  std::fill_n(dest, tuple_count, static_cast<SMALLINT>(col_struct.one_value));
+}
+// -------------------------------------------------------------------------------------
+void OneValue::decompressNarrow(TINYINT* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  std::fill_n(dest, tuple_count, static_cast<TINYINT>(col_struct.one_value));
+}
+// -------------------------------------------------------------------------------------
+void OneValue::hash(u64* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  const auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  std::fill_n(dest, tuple_count, Hash::hashValue(static_cast<INTEGER>(col_struct.one_value)));
+}
+// -------------------------------------------------------------------------------------
 INTEGER OneValue::lookup(u32) {
   UNREACHABLE();
 }
@@ -21,6 +21,21 @@ class OneValue : public IntegerScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void decompressNarrow(SMALLINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
+  void decompressNarrow(TINYINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::ONE_VALUE; }
   INTEGER lookup(u32) override;
@@ -189,11 +189,13 @@ INTEGER EXP_FBP::lookup(u32) {
   UNREACHABLE();
 }
 // -------------------------------------------------------------------------------------
-u32 FBP64::compress(u64* src, u8* dest, u32 tuple_count) {
+namespace {
+// -------------------------------------------------------------------------------------
+u32 compressHalf(const u32* src, u8* dest, u32 tuple_count) {
   auto& col_struct = *reinterpret_cast<XPBPStructure*>(dest);
   // -------------------------------------------------------------------------------------
-  FPFor fast_pfor;
-  size_t compressed_codes_size = tuple_count * 2 + 1024;  // not really used
+  FBPImpl codec;
+  size_t compressed_codes_size = tuple_count + 1024;  // not really used
   // -------------------------------------------------------------------------------------
   auto dest_integer = reinterpret_cast<u64>(col_struct.data);
   u64 padding = dest_integer;
@@ -201,23 +203,76 @@ u32 FBP64::compress(u64* src, u8* dest, u32 tuple_count) {
   col_struct.padding = dest_integer - padding;
   auto dest_4_aligned = reinterpret_cast<u32*>(dest_integer);
   // -------------------------------------------------------------------------------------
-  fast_pfor.compress(reinterpret_cast<const u32*>(src), tuple_count, dest_4_aligned,
-                     compressed_codes_size);
+  codec.compress(src, tuple_count, dest_4_aligned, compressed_codes_size);
   col_struct.u32_count = compressed_codes_size;
   // -------------------------------------------------------------------------------------
   return sizeof(XPBPStructure) + compressed_codes_size * sizeof(u32);
 }
-void FBP64::decompress(u8* dest, const u8* src, u32 tuple_count, u32 level) {
+// -------------------------------------------------------------------------------------
+void decompressHalf(u32* dest, const u8* src, u32 tuple_count) {
   auto& col_struct = *reinterpret_cast<const XPBPStructure*>(src);
   // -------------------------------------------------------------------------------------
-  FPFor codec;
-
+  FBPImpl codec;
   SIZE decompressed_codes_size = tuple_count;
   auto encoded_array =
       const_cast<u32*>(reinterpret_cast<const u32*>(col_struct.data + col_struct.padding));
-  if (codec.decompress(encoded_array, col_struct.u32_count, reinterpret_cast<u32*>(dest),
-                       decompressed_codes_size) != encoded_array + col_struct.u32_count) {
-    throw Generic_Exception("Decompressing XPBP failed");
+  if (codec.decompress(encoded_array, col_struct.u32_count, dest, decompressed_codes_size) !=
+      encoded_array + col_struct.u32_count) {
+    throw Generic_Exception("Decompressing FBP64 failed");
+  }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+u32 FBP64::compress(const u64* src, u8* dest, u32 tuple_count) {
+  auto& col_struct = *reinterpret_cast<FBP64Structure*>(dest);
+  // -------------------------------------------------------------------------------------
+  // Split into low and high words, values below 2^32 leave the high words all
+  // zero and they pack into almost nothing
+  vector<u32> low(tuple_count);
+  vector<u32> high(tuple_count);
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    low[row_i] = static_cast<u32>(src[row_i]);
+    high[row_i] = static_cast<u32>(src[row_i] >> 32);
+  }
+  // -------------------------------------------------------------------------------------
+  auto write_ptr = col_struct.data;
+  write_ptr += compressHalf(low.data(), write_ptr, tuple_count);
+  // Keep the header of the high words 4 byte aligned
+  u64 padding;
+  col_struct.high_offset = Utils::alignBy(write_ptr - col_struct.data, 4, padding);
+  write_ptr = col_struct.data + col_struct.high_offset;
+  write_ptr += compressHalf(high.data(), write_ptr, tuple_count);
+  // -------------------------------------------------------------------------------------
+  return write_ptr - dest;
+}
+// -------------------------------------------------------------------------------------
+void FBP64::decompress(u64* dest, const u8* src, u32 tuple_count, u32 level) {
+  auto& col_struct = *reinterpret_cast<const FBP64Structure*>(src);
+  // -------------------------------------------------------------------------------------
+  thread_local std::vector<std::vector<u32>> low_v;
+  auto low = get_level_data(low_v, tuple_count + SIMD_EXTRA_ELEMENTS(u32), level);
+  thread_local std::vector<std::vector<u32>> high_v;
+  auto high = get_level_data(high_v, tuple_count + SIMD_EXTRA_ELEMENTS(u32), level);
+  decompressHalf(low, col_struct.data, tuple_count);
+  decompressHalf(high, col_struct.data + col_struct.high_offset, tuple_count);
+  // -------------------------------------------------------------------------------------
+  u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+  for (; row_i + 8 <= tuple_count; row_i += 8) {
+    __m256i low_words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(low + row_i));
+    __m256i high_words = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(high + row_i));
+    // unpack interleaves within 128-bit lanes, fix the lane order afterwards
+    __m256i first = _mm256_unpacklo_epi32(low_words, high_words);
+    __m256i second = _mm256_unpackhi_epi32(low_words, high_words);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + row_i),
+                        _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + row_i + 4),
+                        _mm256_permute2x128_si256(first, second, 0x31));
+  }
+#endif
+  for (; row_i < tuple_count; row_i++) {
+    dest[row_i] = (static_cast<u64>(high[row_i]) << 32) | low[row_i];
   }
 }
 // -------------------------------------------------------------------------------------
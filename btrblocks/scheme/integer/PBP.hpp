@@ -86,10 +86,17 @@ class EXP_FBP : public IntegerScheme {
   void scan(Predicate, BITMAP*, const u8*, u32) override;
 };
 // -------------------------------------------------------------------------------------
+// Bit packing for 64-bit values, used by the bigint schemes
+struct FBP64Structure {
+  u32 high_offset;
+  // low words XPBPStructure, followed by the high words XPBPStructure
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
 class FBP64 {
  public:
-  static u32 compress(u64* src, u8* dest, u32 tuple_count);
-  static void decompress(u8* dest, const u8* src, u32 tuple_count, u32 level);
+  static u32 compress(const u64* src, u8* dest, u32 tuple_count);
+  static void decompress(u64* dest, const u8* src, u32 tuple_count, u32 level);
 };
 }  // namespace btrblocks::integers
 // -------------------------------------------------------------------------------------
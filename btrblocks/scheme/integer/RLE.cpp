@@ -32,6 +32,25 @@ void RLE::decompress(INTEGER* dest,
                      u32 level) {
   return MyRLE::decompressColumn(dest, nullmap, src, tuple_count, level);
 }
+// -------------------------------------------------------------------------------------
+void RLE::decompressNarrow(SMALLINT* dest,
+                           BitmapWrapper* nullmap,
+                           const u8* src,
+                           u32 tuple_count,
+                           u32 level) {
+  return MyRLE::decompressColumnNarrow(dest, nullmap, src, tuple_count, level);
+}
+void RLE::decompressNarrow(TINYINT* dest,
+                           BitmapWrapper* nullmap,
+                           const u8* src,
+                           u32 tuple_count,
+                           u32 level) {
+  return MyRLE::decompressColumnNarrow(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+u32 RLE::getRunsCount(const u8* src) {
+  return MyRLE::runsCount(src);
+}
 u32 RLE::decompressRuns(INTEGER* values,
                         INTEGER* counts,
                         BitmapWrapper* nullmap,
@@ -41,6 +60,14 @@ u32 RLE::decompressRuns(INTEGER* values,
   return MyRLE::decompressRuns(values, counts, nullmap, src, tuple_count, level);
 }
 // -------------------------------------------------------------------------------------
+void RLE::hash(u64* dest,
+               BitmapWrapper* nullmap,
+               const u8* src,
+               u32 tuple_count,
+               u32 level) {
+  return MyRLE::hashColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
 INTEGER RLE::lookup(u32) {
   UNREACHABLE();
 }
@@ -20,6 +20,7 @@ class RLE : public IntegerScheme {
                u8* dest,
                SInteger32Stats& stats,
                u8 allowed_cascading_level) override;
+  u32 getRunsCount(const u8* src);
   u32 decompressRuns(INTEGER* values,
                      INTEGER* counts,
                      BitmapWrapper* nullmap,
@@ -31,6 +32,21 @@ class RLE : public IntegerScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void decompressNarrow(SMALLINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
+  void decompressNarrow(TINYINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
   std::string fullDescription(const u8* src) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::RLE; }
@@ -0,0 +1,186 @@
+#include "Sequence.hpp"
+#include "common/Units.hpp"
+#include "scheme/CompressionScheme.hpp"
+#include "scheme/SchemeConfig.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstring>
+#include <limits>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::integers {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+inline s64 floorDiv(s64 a, s64 b) {
+  s64 q = a / b;
+  return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+inline s64 ceilDiv(s64 a, s64 b) {
+  s64 q = a / b;
+  return (a % b != 0 && ((a < 0) == (b < 0))) ? q + 1 : q;
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+double Sequence::expectedCompressionRatio(SInteger32Stats& stats, u8) {
+  if (stats.tuple_count == 0 || stats.sequence_count == 0) {
+    return 0;
+  }
+  // Null rows are free, they are decoded as part of the line
+  const u32 exceptions_count = stats.set_count - stats.sequence_count;
+  if (CD(exceptions_count) * 100.0 / CD(stats.tuple_count) >
+      SchemeConfig::get().integers.sequence_exception_threshold_pct) {
+    return 0;
+  }
+  return CD(stats.total_size) /
+         CD(sizeof(SequenceStructure) + exceptions_count * (sizeof(u32) + sizeof(INTEGER)));
+}
+// -------------------------------------------------------------------------------------
+u32 Sequence::compress(const INTEGER* src,
+                       const BITMAP* nullmap,
+                       u8* dest,
+                       SInteger32Stats& stats,
+                       u8) {
+  auto& col_struct = *reinterpret_cast<SequenceStructure*>(dest);
+  col_struct.base = stats.sequence_base;
+  col_struct.stride = stats.sequence_stride;
+  // -------------------------------------------------------------------------------------
+  vector<u32> exceptions_positions;
+  vector<INTEGER> exceptions_values;
+  // Wrapping u32 arithmetic, decompression wraps the same way
+  const u32 stride = static_cast<u32>(col_struct.stride);
+  u32 expected = static_cast<u32>(col_struct.base);
+  for (u32 row_i = 0; row_i < stats.tuple_count; row_i++, expected += stride) {
+    if (nullmap != nullptr && !nullmap[row_i]) {
+      continue;
+    }
+    if (static_cast<u32>(src[row_i]) != expected) {
+      exceptions_positions.push_back(row_i);
+      exceptions_values.push_back(src[row_i]);
+    }
+  }
+  col_struct.exceptions_count = exceptions_positions.size();
+  // -------------------------------------------------------------------------------------
+  auto write_ptr = col_struct.data;
+  std::memcpy(write_ptr, exceptions_positions.data(), exceptions_positions.size() * sizeof(u32));
+  write_ptr += exceptions_positions.size() * sizeof(u32);
+  std::memcpy(write_ptr, exceptions_values.data(), exceptions_values.size() * sizeof(INTEGER));
+  write_ptr += exceptions_values.size() * sizeof(INTEGER);
+  // -------------------------------------------------------------------------------------
+  return write_ptr - dest;
+}
+// -------------------------------------------------------------------------------------
+void Sequence::decompress(INTEGER* dest,
+                          BitmapWrapper*,
+                          const u8* src,
+                          u32 tuple_count,
+                          u32) {
+  const auto& col_struct = *reinterpret_cast<const SequenceStructure*>(src);
+  const u32 stride = static_cast<u32>(col_struct.stride);
+  // -------------------------------------------------------------------------------------
+  u32 row_i = 0;
+#ifdef BTR_USE_SIMD
+  if (tuple_count >= 8) {
+    const __m256i steps = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i current = _mm256_add_epi32(_mm256_set1_epi32(col_struct.base),
+                                       _mm256_mullo_epi32(_mm256_set1_epi32(stride), steps));
+    const __m256i step = _mm256_set1_epi32(stride * 8);
+    for (; row_i + 8 <= tuple_count; row_i += 8) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + row_i), current);
+      current = _mm256_add_epi32(current, step);
+    }
+  }
+#endif
+  auto values = reinterpret_cast<u32*>(dest);
+  for (; row_i < tuple_count; row_i++) {
+    values[row_i] = static_cast<u32>(col_struct.base) + stride * row_i;
+  }
+  // -------------------------------------------------------------------------------------
+  auto positions = reinterpret_cast<const u32*>(col_struct.data);
+  auto exceptions = reinterpret_cast<const INTEGER*>(positions + col_struct.exceptions_count);
+  for (u32 exception_i = 0; exception_i < col_struct.exceptions_count; exception_i++) {
+    dest[positions[exception_i]] = exceptions[exception_i];
+  }
+}
+// -------------------------------------------------------------------------------------
+INTEGER Sequence::valueAt(const u8* src, u32 row) {
+  const auto& col_struct = *reinterpret_cast<const SequenceStructure*>(src);
+  auto positions = reinterpret_cast<const u32*>(col_struct.data);
+  auto positions_end = positions + col_struct.exceptions_count;
+  auto it = std::lower_bound(positions, positions_end, row);
+  if (it != positions_end && *it == row) {
+    return reinterpret_cast<const INTEGER*>(positions_end)[it - positions];
+  }
+  return static_cast<INTEGER>(static_cast<u32>(col_struct.base) +
+                              static_cast<u32>(col_struct.stride) * row);
+}
+// -------------------------------------------------------------------------------------
+u32 Sequence::filterRange(const u8* src,
+                          u32 tuple_count,
+                          INTEGER min,
+                          INTEGER max,
+                          BITMAP* result) {
+  const auto& col_struct = *reinterpret_cast<const SequenceStructure*>(src);
+  if (tuple_count == 0) {
+    return 0;
+  }
+  auto positions = reinterpret_cast<const u32*>(col_struct.data);
+  auto exceptions = reinterpret_cast<const INTEGER*>(positions + col_struct.exceptions_count);
+  const s64 base = col_struct.base;
+  const s64 stride = col_struct.stride;
+  const s64 last = base + stride * (tuple_count - 1);
+  // -------------------------------------------------------------------------------------
+  u32 matches = 0;
+  if (last < std::numeric_limits<INTEGER>::min() || last > std::numeric_limits<INTEGER>::max()) {
+    // The line wraps around, evaluate it row by row
+    u32 value = static_cast<u32>(base);
+    for (u32 row_i = 0; row_i < tuple_count; row_i++, value += static_cast<u32>(stride)) {
+      result[row_i] = static_cast<INTEGER>(value) >= min && static_cast<INTEGER>(value) <= max;
+      matches += result[row_i];
+    }
+  } else {
+    // The rows on the line matching the predicate form one interval [begin, end)
+    s64 begin = 0;
+    s64 end = 0;
+    if (stride == 0) {
+      end = (base >= min && base <= max) ? tuple_count : 0;
+    } else if (stride > 0) {
+      begin = ceilDiv(s64(min) - base, stride);
+      end = floorDiv(s64(max) - base, stride) + 1;
+    } else {
+      begin = ceilDiv(s64(max) - base, stride);
+      end = floorDiv(s64(min) - base, stride) + 1;
+    }
+    begin = std::clamp<s64>(begin, 0, tuple_count);
+    end = std::clamp<s64>(end, begin, tuple_count);
+    std::memset(result, 0, begin);
+    std::memset(result + begin, 1, end - begin);
+    std::memset(result + end, 0, tuple_count - end);
+    matches = end - begin;
+  }
+  // -------------------------------------------------------------------------------------
+  for (u32 exception_i = 0; exception_i < col_struct.exceptions_count; exception_i++) {
+    const u32 row = positions[exception_i];
+    const bool match = exceptions[exception_i] >= min && exceptions[exception_i] <= max;
+    matches += CI(match) - CI(result[row]);
+    result[row] = match;
+  }
+  return matches;
+}
+// -------------------------------------------------------------------------------------
+INTEGER Sequence::lookup(u32) {
+  UNREACHABLE();
+}
+void Sequence::scan(Predicate, BITMAP*, const u8*, u32) {
+  UNREACHABLE();
+}
+// -------------------------------------------------------------------------------------
+std::string Sequence::fullDescription(const u8* src) {
+  const auto& col_struct = *reinterpret_cast<const SequenceStructure*>(src);
+  return this->selfDescription() + " (base = " + std::to_string(col_struct.base) +
+         ", stride = " + std::to_string(col_struct.stride) +
+         ", exceptions = " + std::to_string(col_struct.exceptions_count) + ")";
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::integers
+// -------------------------------------------------------------------------------------
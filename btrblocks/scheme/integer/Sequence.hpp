@@ -0,0 +1,46 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::integers {
+// -------------------------------------------------------------------------------------
+// Values on the line base + stride * row (row ids, auto increments, regular
+// timestamps). Only the rows off the line are stored, uncompressed and sorted by
+// position, so that single values can be looked up without decoding the block.
+// -------------------------------------------------------------------------------------
+struct SequenceStructure {
+  INTEGER base;
+  INTEGER stride;
+  u32 exceptions_count;
+  // u32 positions[exceptions_count], followed by INTEGER values[exceptions_count]
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+class Sequence : public IntegerScheme {
+ public:
+  double expectedCompressionRatio(SInteger32Stats& stats, u8 allowed_cascading_level) override;
+  u32 compress(const INTEGER* src,
+               const BITMAP* nullmap,
+               u8* dest,
+               SInteger32Stats& stats,
+               u8 allowed_cascading_level) override;
+  void decompress(INTEGER* dest,
+                  BitmapWrapper* nullmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  std::string fullDescription(const u8* src) override;
+  inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
+  inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::SEQUENCE; }
+  INTEGER lookup(u32) override;
+  void scan(Predicate, BITMAP*, const u8*, u32) override;
+  // -------------------------------------------------------------------------------------
+  // O(log exceptions) access to a single row
+  static INTEGER valueAt(const u8* src, u32 row);
+  // Sets result[row] to whether min <= value <= max and returns the number of
+  // matches. Null rows are not masked, the caller has to combine with the nullmap.
+  static u32 filterRange(const u8* src, u32 tuple_count, INTEGER min, INTEGER max, BITMAP* result);
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::integers
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,46 @@
+#include "Sparse.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+#include "scheme/SchemeConfig.hpp"
+#include "scheme/templated/Sparse.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::integers {
+// -------------------------------------------------------------------------------------
+using MySparse = TSparse<INTEGER, IntegerScheme, SInteger32Stats, IntegerSchemeType>;
+// -------------------------------------------------------------------------------------
+double Sparse::expectedCompressionRatio(SInteger32Stats& stats, u8 allowed_cascading_level) {
+  if (!MySparse::isSparse(stats, SchemeConfig::get().integers.sparse_null_threshold_pct)) {
+    return 0;
+  }
+  return IntegerScheme::expectedCompressionRatio(stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+u32 Sparse::compress(const INTEGER* src,
+                     const BITMAP* nullmap,
+                     u8* dest,
+                     SInteger32Stats& stats,
+                     u8 allowed_cascading_level) {
+  return MySparse::compressColumn(src, nullmap, dest, stats, allowed_cascading_level);
+}
+// -------------------------------------------------------------------------------------
+void Sparse::decompress(INTEGER* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) {
+  MySparse::decompressColumn(dest, nullmap, src, tuple_count, level);
+}
+// -------------------------------------------------------------------------------------
+string Sparse::fullDescription(const u8* src) {
+  return MySparse::fullDescription(src, this->selfDescription());
+}
+// -------------------------------------------------------------------------------------
+INTEGER Sparse::lookup(u32) {
+  UNREACHABLE();
+}
+void Sparse::scan(Predicate, BITMAP*, const u8*, u32) {
+  UNREACHABLE();
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::integers
+// -------------------------------------------------------------------------------------
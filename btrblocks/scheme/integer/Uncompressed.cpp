@@ -1,5 +1,6 @@
 #include "Uncompressed.hpp"
 #include "common/Units.hpp"
+#include "common/Utils.hpp"
 #include "scheme/CompressionScheme.hpp"
 #include "storage/Chunk.hpp"
 // -------------------------------------------------------------------------------------
@@ -32,6 +33,22 @@ void Uncompressed::decompress(INTEGER* dest,
   std::memcpy(dest, src, column_size);
 }
 // -------------------------------------------------------------------------------------
+void Uncompressed::decompressNarrow(SMALLINT* dest,
+                                    BitmapWrapper*,
+                                    const u8* src,
+                                    u32 tuple_count,
+                                    u32) {
+  Utils::narrowIntegers(dest, reinterpret_cast<const INTEGER*>(src), tuple_count);
+}
+// -------------------------------------------------------------------------------------
+void Uncompressed::decompressNarrow(TINYINT* dest,
+                                    BitmapWrapper*,
+                                    const u8* src,
+                                    u32 tuple_count,
+                                    u32) {
+  Utils::narrowIntegers(dest, reinterpret_cast<const INTEGER*>(src), tuple_count);
+}
+// -------------------------------------------------------------------------------------
 INTEGER Uncompressed::lookup(u32) {
   UNREACHABLE();
 }
@@ -17,6 +17,16 @@ class Uncompressed : public IntegerScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void decompressNarrow(SMALLINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
+  void decompressNarrow(TINYINT* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
   inline IntegerSchemeType schemeType() override { return staticSchemeType(); }
   inline static IntegerSchemeType staticSchemeType() { return IntegerSchemeType::UNCOMPRESSED; }
   // -------------------------------------------------------------------------------------
@@ -1,29 +1,97 @@
 #include "DynamicDictionary.hpp"
+#include "common/Hash.hpp"
 #include "common/Units.hpp"
 #include "compression/SchemePicker.hpp"
+#include "scheme/GlobalDictionary.hpp"
 #include "scheme/integer/PBP.hpp"
 #include "scheme/integer/RLE.hpp"
 #include "storage/Chunk.hpp"
 // -------------------------------------------------------------------------------------
 #include "common/Log.hpp"
 #include "fsst.h"
+#include "scheme/string/FsstTable.hpp"
 #include "storage/StringPointerArrayViewer.hpp"
 // -------------------------------------------------------------------------------------
 #include <cmath>
 // -------------------------------------------------------------------------------------
 namespace btrblocks::strings {
 // -------------------------------------------------------------------------------------
+// The chunk's own FSST table precedes the compressed strings, unless it uses the
+// table of its part
+static inline u32 fsstTableSize(const DynamicDictionaryStructure& col_struct) {
+  return col_struct.sharedFsstTable() ? 0 : FSST_MAXHEADER;
+}
+// The uncompressed dictionary in StringArrayViewer layout: the chunk's own or
+// the global one of its part
+static inline const u8* dictionaryData(const DynamicDictionaryStructure& col_struct,
+                                       const PartData& part) {
+  if (col_struct.globalDictionary()) {
+    return GlobalDictionary::part(part.global_dictionary, ColumnType::STRING).data;
+  }
+  return col_struct.data;
+}
+// -------------------------------------------------------------------------------------
+// An FSST dictionary decoded as a whole: the entries back to back, lengths[c]
+// bytes for code c
+struct DecodedFsstDictionary {
+  const u8* strings;
+  const INTEGER* lengths;
+  u32 total_length;
+};
+// Decodes the entry lengths, then all entries in one go into the buffer that
+// reserve(total_length) returns, which needs room for total_length + 4096 bytes
+template <typename Reserve>
+static DecodedFsstDictionary decodeFsstDictionary(const DynamicDictionaryStructure& col_struct,
+                                                  const PartData& part,
+                                                  u32 level,
+                                                  Reserve&& reserve) {
+  thread_local std::vector<std::vector<INTEGER>> lengths_v;
+  auto lengths =
+      get_level_data(lengths_v, col_struct.num_codes + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  IntegerScheme& lengths_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.lengths_scheme);
+  lengths_scheme.decompress(lengths, nullptr, col_struct.data + col_struct.lengths_offset,
+                            col_struct.num_codes, level + 1);
+  u32 total_length = 0;
+  for (u32 c = 0; c < col_struct.num_codes; c++) {
+    total_length += lengths[c];
+  }
+
+  u8* strings = reserve(total_length);
+  fsst_decoder_t decoder;
+  const u32 fsst_dict_size = fsstTableSize(col_struct);
+  importFsstTable(decoder, col_struct.data, col_struct.sharedFsstTable(), part.fsst_table);
+  auto fsst_compressed_buf = col_struct.data + fsst_dict_size;
+  u32 total_compressed_length = col_struct.fsst_offsets_offset - fsst_dict_size;
+  fsst_decompress(&decoder, total_compressed_length, const_cast<u8*>(fsst_compressed_buf),
+                  total_length + 4096, strings);
+  return {strings, lengths, total_length};
+}
+// -------------------------------------------------------------------------------------
 /*
  * Plan:
  * Output only 32-bits codes, hence no need for templates
  * compress distinct strings with fsst
  */
 // -------------------------------------------------------------------------------------
-double DynamicDictionary::expectedCompressionRatio(StringStats& stats, u8) {
+double DynamicDictionary::expectedCompressionRatio(StringStats& stats,
+                                                   u8 allowed_cascading_level) {
+  return this->expectedCompressionRatio(stats, allowed_cascading_level, {});
+}
+double DynamicDictionary::expectedCompressionRatio(StringStats& stats,
+                                                   u8,
+                                                   const PartEncoding& part) {
   auto& cfg = SchemeConfig::get().strings;
-  u32 bits_per_code = std::floor(std::log2(stats.distinct_values.size())) + 1;
   u32 after_size = sizeof(DynamicDictionaryStructure);
-  after_size += FSST_MAXHEADER;
+  auto global = GlobalDictionary::covering<str>(part.global_dictionary, stats.distinct_values);
+  if (global != nullptr) {
+    // The dictionary is stored once per part, only the codes count
+    after_size += stats.tuple_count * (CD(Utils::getBitsNeeded(global->size())) / 8.0);
+    return CD(stats.total_size) / CD(after_size);
+  }
+  u32 bits_per_code = std::floor(std::log2(stats.distinct_values.size())) + 1;
+  // The FSST table is only stored in the chunk if the part has none
+  after_size += (part.fsst_table != nullptr && part.fsst_table->trained()) ? 0 : FSST_MAXHEADER;
   after_size += stats.tuple_count * (CD(bits_per_code) / 8.0);
   after_size += sizeof(StringArrayViewer::Slot) * (1 + stats.distinct_values.size());
   if (stats.total_unique_length >= cfg.dict_fsst_input_size_threshold) {  // Threshold
@@ -36,13 +104,25 @@ double DynamicDictionary::expectedCompressionRatio(StringStats& stats, u8) {
 // -------------------------------------------------------------------------------------
 bool DynamicDictionary::usesFsst(const u8* src) {
   const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
-  return col_struct.use_fsst;
+  return col_struct.useFsst();
+}
+// -------------------------------------------------------------------------------------
+bool DynamicDictionary::usesGlobalDictionary(const u8* src) {
+  const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+  return col_struct.globalDictionary();
 }
 // -------------------------------------------------------------------------------------
 u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
-                                const BITMAP*,
+                                const BITMAP* nullmap,
                                 u8* dest,
                                 btrblocks::StringStats& stats) {
+  return this->compress(src, nullmap, dest, stats, {});
+}
+u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
+                                const BITMAP*,
+                                u8* dest,
+                                btrblocks::StringStats& stats,
+                                const PartEncoding& part) {
   // Layout: FSST_DICT | FSST_STRINGS | FSST_OFFSETS@from FSST_STRINGS
   // BEGINNING@ | Compressed(Codes) OR :    DICT | OFFSETS | Compressed(Codes)
   // -------------------------------------------------------------------------------------
@@ -51,11 +131,18 @@ u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
   die_if(stats.unique_count <= std::numeric_limits<u32>::max());
   // -------------------------------------------------------------------------------------
   auto& col_struct = *reinterpret_cast<DynamicDictionaryStructure*>(dest);
-  col_struct.use_fsst =
-      (cfg.dict_allow_fsst && (stats.total_unique_length >= cfg.dict_fsst_input_size_threshold)) ||
-      cfg.dict_force_fsst;
+  auto global = GlobalDictionary::covering<str>(part.global_dictionary, stats.distinct_values);
+  const bool use_fsst =
+      global == nullptr &&
+      ((cfg.dict_allow_fsst && (stats.total_unique_length >= cfg.dict_fsst_input_size_threshold)) ||
+       cfg.dict_force_fsst);
+  col_struct.flags = use_fsst ? DynamicDictionaryStructure::USE_FSST : 0;
   col_struct.total_decompressed_size = stats.total_size;
   col_struct.num_codes = stats.distinct_values.size();
+  if (global != nullptr) {
+    col_struct.flags |= DynamicDictionaryStructure::GLOBAL_DICTIONARY;
+    col_struct.num_codes = global->size();
+  }
   auto write_ptr = col_struct.data;
   // IDEA: sort distinct_values ascending by number of occurences to reduce the
   // numbers of bits required for codes
@@ -63,10 +150,10 @@ u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
   // -------------------------------------------------------------------------------------
   // FSST Compression
   // -------------------------------------------------------------------------------------
-  Log::debug("FSST: using_fsst = {}", static_cast<s64>(col_struct.use_fsst));
+  Log::debug("FSST: using_fsst = {}", static_cast<s64>(use_fsst));
   // -------------------------------------------------------------------------------------
   u64 fsst_strings_used_space;
-  if (col_struct.use_fsst) {
+  if (use_fsst) {
     ThreadCache::setFsst();
     // -------------------------------------------------------------------------------------
     const auto fsst_n = stats.unique_count;
@@ -83,13 +170,13 @@ u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
       str_i++;
     }
     // -------------------------------------------------------------------------------------
-    // Encoder
-    // TODO: use memcpy instead of export/import (Note: I still use
-    // FSST_MAXHEADER ~2KiB )
-    fsst_encoder_t* encoder =
-        fsst_create(fsst_n, (unsigned long*) input_string_lengths.get(), input_string_buffers.get(), 0);
-    die_if(fsst_export(encoder, write_ptr) > 0);
-    auto fsst_table_used_space = FSST_MAXHEADER;
+    // Encoder, the table is only written if the chunk does not use the part's table
+    FsstEncoder encoder(part.fsst_table, fsst_n, input_string_lengths.get(),
+                        input_string_buffers.get());
+    if (encoder.isShared()) {
+      col_struct.flags |= DynamicDictionaryStructure::SHARED_FSST_TABLE;
+    }
+    auto fsst_table_used_space = encoder.exportTable(write_ptr);
     // -------------------------------------------------------------------------------------
     Log::debug("FSST: dict_s = {}", static_cast<s64>(fsst_table_used_space));
     // -------------------------------------------------------------------------------------
@@ -97,7 +184,7 @@ u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
     // -------------------------------------------------------------------------------------
     // Compress
     const u64 output_buffer_size = 7 + 4 * stats.total_unique_length;  // fake
-    if (fsst_compress(encoder, fsst_n, (unsigned long*) input_string_lengths.get(), input_string_buffers.get(),
+    if (fsst_compress(encoder.get(), fsst_n, (unsigned long*) input_string_lengths.get(), input_string_buffers.get(),
                       output_buffer_size, write_ptr, (unsigned long*) output_string_lengths.get(),
                       output_string_buffers.get()) != fsst_n) {
       throw Generic_Exception("FSST Compression failed !");
@@ -150,7 +237,7 @@ u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
                                   used_space, col_struct.lengths_scheme,
                                   static_cast<u8>(autoScheme()));
     write_ptr += used_space;
-  } else {
+  } else if (!col_struct.globalDictionary()) {
     auto dest_slot_ptr = reinterpret_cast<StringArrayViewer::Slot*>(col_struct.data);
     u8* str_write_ptr =
         col_struct.data + ((distinct_values.size() + 1) * sizeof(StringArrayViewer::Slot));
@@ -171,9 +258,14 @@ u32 DynamicDictionary::compress(const btrblocks::StringArrayViewer src,
     vector<INTEGER> codes;
     for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
       const str& current_value = src(row_i);
-      auto it = std::lower_bound(distinct_values.begin(), distinct_values.end(), current_value);
-      assert(it != distinct_values.end());
-      auto new_code = static_cast<INTEGER>(std::distance(distinct_values.begin(), it));
+      INTEGER new_code;
+      if (global != nullptr) {
+        new_code = static_cast<INTEGER>(global->find(current_value));
+      } else {
+        auto it = std::lower_bound(distinct_values.begin(), distinct_values.end(), current_value);
+        assert(it != distinct_values.end());
+        new_code = static_cast<INTEGER>(std::distance(distinct_values.begin(), it));
+      }
       codes.push_back(new_code);
       if (new_code != current_code) {
         run_count++;
@@ -224,10 +316,18 @@ u32 DynamicDictionary::getDecompressedSizeNoCopy(const u8* src,
 }
 // -------------------------------------------------------------------------------------
 void DynamicDictionary::decompress(u8* dest,
-                                   BitmapWrapper*,
+                                   BitmapWrapper* nullmap,
                                    const u8* src,
                                    u32 tuple_count,
                                    u32 level) {
+  this->decompress(dest, nullmap, src, tuple_count, level, {});
+}
+void DynamicDictionary::decompress(u8* dest,
+                                   BitmapWrapper*,
+                                   const u8* src,
+                                   u32 tuple_count,
+                                   u32 level,
+                                   const PartData& part) {
   // -------------------------------------------------------------------------------------
   const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
   const u8* compressed_codes_ptr = col_struct.data + col_struct.codes_offset;
@@ -266,8 +366,8 @@ void DynamicDictionary::decompress(u8* dest,
     thread_local std::vector<std::vector<u32>> cached_str_lengths_v;
     auto cached_str_lengths_ptr = get_level_data(cached_str_lengths_v, col_struct.num_codes, level);
 
-    if (!col_struct.use_fsst) {
-      StringArrayViewer dict_array(col_struct.data);
+    if (!col_struct.useFsst()) {
+      StringArrayViewer dict_array(dictionaryData(col_struct, part));
 
       // Fill str_length cache
       for (u32 idx = 0; idx < col_struct.num_codes; idx++) {
@@ -312,8 +412,8 @@ void DynamicDictionary::decompress(u8* dest,
       }
     } else {
       fsst_decoder_t decoder;
-      const u32 fsst_dict_size = FSST_MAXHEADER;
-      die_if(fsst_import(&decoder, const_cast<u8*>(col_struct.data)) > 0);
+      const u32 fsst_dict_size = fsstTableSize(col_struct);
+      importFsstTable(decoder, col_struct.data, col_struct.sharedFsstTable(), part.fsst_table);
       auto fsst_offsets =
           reinterpret_cast<const u32*>(col_struct.data + col_struct.fsst_offsets_offset);
       auto fsst_compressed_buf = col_struct.data + fsst_dict_size;
@@ -386,10 +486,10 @@ void DynamicDictionary::decompress(u8* dest,
     codes_scheme.decompress(decompressed_codes, nullptr, compressed_codes_ptr, tuple_count,
                             level + 1);
     // -------------------------------------------------------------------------------------
-    if (col_struct.use_fsst) {
+    if (col_struct.useFsst()) {
       fsst_decoder_t decoder;
-      const u32 fsst_dict_size = FSST_MAXHEADER;
-      die_if(fsst_import(&decoder, const_cast<u8*>(col_struct.data)) > 0);
+      const u32 fsst_dict_size = fsstTableSize(col_struct);
+      importFsstTable(decoder, col_struct.data, col_struct.sharedFsstTable(), part.fsst_table);
       auto fsst_offsets =
           reinterpret_cast<const u32*>(col_struct.data + col_struct.fsst_offsets_offset);
       auto fsst_compressed_buf = col_struct.data + fsst_dict_size;
@@ -403,7 +503,7 @@ void DynamicDictionary::decompress(u8* dest,
                             MAX_STR_LENGTH, dest_write_ptr);
       }
     } else {
-      StringArrayViewer dict_array(col_struct.data);
+      StringArrayViewer dict_array(dictionaryData(col_struct, part));
       for (u32 row_i = 0; row_i < tuple_count; row_i++) {
         dest_slots[row_i].offset = dest_write_ptr - dest;
         auto current_code = decompressed_codes[row_i];
@@ -419,10 +519,18 @@ void DynamicDictionary::decompress(u8* dest,
 }
 
 bool DynamicDictionary::decompressNoCopy(u8* dest,
-                                         BitmapWrapper*,
+                                         BitmapWrapper* nullmap,
                                          const u8* src,
                                          u32 tuple_count,
                                          u32 level) {
+  return this->decompressNoCopy(dest, nullmap, src, tuple_count, level, {});
+}
+bool DynamicDictionary::decompressNoCopy(u8* dest,
+                                         BitmapWrapper*,
+                                         const u8* src,
+                                         u32 tuple_count,
+                                         u32 level,
+                                         const PartData& part) {
   const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
 
   // Build views
@@ -439,37 +547,18 @@ bool DynamicDictionary::decompressNoCopy(u8* dest,
   // vectorization
 
   // Copy strings to destination
-  if (col_struct.use_fsst) {
-    // Decompress lengths
-    thread_local std::vector<std::vector<INTEGER>> uncompressed_lengths_v;
-    auto uncompressed_lengths_ptr = get_level_data(
-        uncompressed_lengths_v, col_struct.num_codes + SIMD_EXTRA_ELEMENTS(INTEGER), level);
-    IntegerScheme& lengths_scheme =
-        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.lengths_scheme);
-    lengths_scheme.decompress(uncompressed_lengths_ptr, nullptr,
-                              col_struct.data + col_struct.lengths_offset, col_struct.num_codes,
-                              level + 1);
-
-    // Fill lengths and offsets
-    u32 start_offset = current_offset;
+  if (col_struct.useFsst()) {
+    auto start_offset = current_offset;
+    auto dict =
+        decodeFsstDictionary(col_struct, part, level, [&](u32) { return dest + start_offset; });
     for (u32 c = 0; c < col_struct.num_codes; c++) {
       views_ptr[c].offset = current_offset;
-      views_ptr[c].length = uncompressed_lengths_ptr[c];
-      current_offset += uncompressed_lengths_ptr[c];
+      views_ptr[c].length = dict.lengths[c];
+      current_offset += dict.lengths[c];
     }
-    u32 total_length = current_offset - start_offset;
-
-    // Decompress all strings in one go
-    fsst_decoder_t decoder;
-    const u32 fsst_dict_size = FSST_MAXHEADER;
-    die_if(fsst_import(&decoder, const_cast<u8*>(col_struct.data)) > 0);
-    auto fsst_compressed_buf = col_struct.data + fsst_dict_size;
-    u32 total_compressed_length = col_struct.fsst_offsets_offset - fsst_dict_size;
-    fsst_decompress(&decoder, total_compressed_length, const_cast<u8*>(fsst_compressed_buf),
-                    total_length + 4096, reinterpret_cast<unsigned char*>(dest) + start_offset);
   } else {
     auto start_offset = current_offset;
-    StringArrayViewer dict_array(col_struct.data);
+    StringArrayViewer dict_array(dictionaryData(col_struct, part));
     for (u32 c = 0; c < col_struct.num_codes; c++) {
       views_ptr[c].length = dict_array.size(c);
       views_ptr[c].offset = current_offset;
@@ -575,6 +664,114 @@ bool DynamicDictionary::decompressNoCopy(u8* dest,
   return true;
 }
 
+void DynamicDictionary::hash(u64* dest,
+                             BitmapWrapper* nullmap,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level) {
+  this->hash(dest, nullmap, src, tuple_count, level, {});
+}
+void DynamicDictionary::hash(u64* dest,
+                             BitmapWrapper*,
+                             const u8* src,
+                             u32 tuple_count,
+                             u32 level,
+                             const PartData& part) {
+  const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+
+  // Hash every distinct string exactly once
+  thread_local std::vector<std::vector<u64>> dict_hashes_v;
+  auto dict_hashes = get_level_data(dict_hashes_v, col_struct.num_codes, level);
+  if (col_struct.useFsst()) {
+    thread_local std::vector<std::vector<u8>> strings_v;
+    auto dict = decodeFsstDictionary(col_struct, part, level, [&](u32 total_length) {
+      return get_level_data(strings_v, total_length + 4096 + 8, level);
+    });
+    auto str_ptr = reinterpret_cast<const char*>(dict.strings);
+    for (u32 c = 0; c < col_struct.num_codes; c++) {
+      dict_hashes[c] = Hash::hashValue(str_ptr, dict.lengths[c]);
+      str_ptr += dict.lengths[c];
+    }
+  } else {
+    StringArrayViewer dict_array(dictionaryData(col_struct, part));
+    for (u32 c = 0; c < col_struct.num_codes; c++) {
+      dict_hashes[c] = Hash::hashValue(dict_array.get_pointer(c), dict_array.size(c));
+    }
+  }
+
+  const u8* compressed_codes_ptr = col_struct.data + col_struct.codes_offset;
+  IntegerScheme& codes_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme);
+  if (col_struct.use_rle_optimized_path) {
+    auto& rle = dynamic_cast<btrblocks::integers::RLE&>(codes_scheme);
+
+    thread_local std::vector<std::vector<INTEGER>> values_v;
+    auto values_ptr = get_level_data(values_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+
+    thread_local std::vector<std::vector<INTEGER>> counts_v;
+    auto counts_ptr = get_level_data(counts_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+
+    u32 runs_count = rle.decompressRuns(values_ptr, counts_ptr, nullptr, compressed_codes_ptr,
+                                        tuple_count, level + 1);
+    for (u32 run = 0; run < runs_count; run++) {
+      dest = std::fill_n(dest, counts_ptr[run], dict_hashes[values_ptr[run]]);
+    }
+  } else {
+    thread_local std::vector<std::vector<INTEGER>> decompressed_codes_v;
+    auto decompressed_codes =
+        get_level_data(decompressed_codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    codes_scheme.decompress(decompressed_codes, nullptr, compressed_codes_ptr, tuple_count,
+                            level + 1);
+    Hash::gather(dest, dict_hashes, col_struct.num_codes, decompressed_codes, tuple_count);
+  }
+}
+
+u32 DynamicDictionary::decompressDictionary(std::vector<u8>& dest_v,
+                                            const u8* src,
+                                            u32 level,
+                                            const PartData& part) {
+  const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+  auto views_size = col_struct.num_codes * sizeof(StringPointerArrayViewer::View);
+
+  if (col_struct.useFsst()) {
+    u8* dest = nullptr;
+    auto dict = decodeFsstDictionary(col_struct, part, level, [&](u32 total_length) {
+      dest = get_data(dest_v, views_size + total_length + 4096 + 8);
+      return dest + views_size;
+    });
+    auto views = reinterpret_cast<StringPointerArrayViewer::View*>(dest);
+    u32 current_offset = views_size;
+    for (u32 c = 0; c < col_struct.num_codes; c++) {
+      views[c].offset = current_offset;
+      views[c].length = dict.lengths[c];
+      current_offset += dict.lengths[c];
+    }
+  } else {
+    StringArrayViewer dict_array(dictionaryData(col_struct, part));
+    u32 total_length = dict_array.get_pointer(col_struct.num_codes) - dict_array.get_pointer(0);
+
+    auto dest = get_data(dest_v, views_size + total_length + SIMD_EXTRA_BYTES);
+    auto views = reinterpret_cast<StringPointerArrayViewer::View*>(dest);
+    u32 current_offset = views_size;
+    for (u32 c = 0; c < col_struct.num_codes; c++) {
+      views[c].offset = current_offset;
+      views[c].length = dict_array.size(c);
+      current_offset += views[c].length;
+    }
+    std::memcpy(dest + views_size, dict_array.get_pointer(0), total_length);
+  }
+
+  return col_struct.num_codes;
+}
+
+void DynamicDictionary::decompressCodes(INTEGER* dest, const u8* src, u32 tuple_count, u32 level) {
+  const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+  IntegerScheme& codes_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme);
+  codes_scheme.decompress(dest, nullptr, col_struct.data + col_struct.codes_offset, tuple_count,
+                          level + 1);
+}
+
 std::string DynamicDictionary::fullDescription(const u8* src) {
   const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
   IntegerScheme& codes_scheme =
@@ -604,6 +801,35 @@ bool DynamicDictionary::isUsable(StringStats& stats) {
   return unique_count < non_null_count / 2;
 }
 
+DictionaryEntryReader::DictionaryEntryReader(const u8* src, const PartData& part)
+    : col_struct(*reinterpret_cast<const DynamicDictionaryStructure*>(src)), part(part) {
+  if (col_struct.useFsst()) {
+    importFsstTable(decoder, col_struct.data, col_struct.sharedFsstTable(), part.fsst_table);
+    cache.resize(CACHE_SIZE);
+  }
+}
+
+str DictionaryEntryReader::operator()(u32 code) {
+  if (!col_struct.useFsst()) {
+    StringArrayViewer dict_array(dictionaryData(col_struct, part));
+    return {dict_array.get_pointer(code), dict_array.size(code)};
+  }
+  auto& entry = cache[code % CACHE_SIZE];
+  if (entry.code != code) {
+    auto fsst_offsets =
+        reinterpret_cast<const u32*>(col_struct.data + col_struct.fsst_offsets_offset);
+    auto compressed_str_length = fsst_offsets[code + 1] - fsst_offsets[code];
+    auto compressed_str_ptr = col_struct.data + fsstTableSize(col_struct) + fsst_offsets[code];
+    // Every FSST code expands to at most 8 bytes
+    entry.value.resize(compressed_str_length * 8);
+    entry.value.resize(fsst_decompress(&decoder, compressed_str_length,
+                                       const_cast<u8*>(compressed_str_ptr), entry.value.size(),
+                                       reinterpret_cast<u8*>(entry.value.data())));
+    entry.code = code;
+  }
+  return entry.value;
+}
+
 u32 DynamicDictionary::getTotalLength(const u8* src, u32 tuple_count, BitmapWrapper* nullmap) {
   const auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
   return col_struct.total_decompressed_size - ((tuple_count + 1) * sizeof(StringArrayViewer::Slot));
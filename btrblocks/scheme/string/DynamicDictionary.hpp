@@ -2,11 +2,20 @@
 // -------------------------------------------------------------------------------------
 #include "scheme/CompressionScheme.hpp"
 // -------------------------------------------------------------------------------------
+#include <fsst.h>
+// -------------------------------------------------------------------------------------
 namespace btrblocks::strings {
 // -------------------------------------------------------------------------------------
 struct DynamicDictionaryStructure {
+  // Bits of flags. Chunks written before there were flags have a use_fsst bool
+  // in their place, which reads as USE_FSST.
+  static constexpr u8 USE_FSST = 1;
+  static constexpr u8 SHARED_FSST_TABLE = 2;  // the FSST table is in the part, see FsstTable.hpp
+  // No local dictionary, the codes index the part's GlobalDictionary
+  static constexpr u8 GLOBAL_DICTIONARY = 4;
+  // -------------------------------------------------------------------------------------
   u32 total_decompressed_size;  // i.e original input size
-  bool use_fsst;
+  u8 flags;
   u32 fsst_offsets_offset;
   u32 lengths_offset;
   u32 num_codes;
@@ -15,13 +24,25 @@ struct DynamicDictionaryStructure {
   u8 codes_scheme;
   u8 lengths_scheme;
   u8 data[];
+
+  [[nodiscard]] inline bool useFsst() const { return flags & USE_FSST; }
+  [[nodiscard]] inline bool sharedFsstTable() const { return flags & SHARED_FSST_TABLE; }
+  [[nodiscard]] inline bool globalDictionary() const { return flags & GLOBAL_DICTIONARY; }
 };
 // -------------------------------------------------------------------------------------
 class DynamicDictionary : public StringScheme {
  public:
   double expectedCompressionRatio(StringStats& stats, u8 allowed_cascading_level) override;
+  double expectedCompressionRatio(StringStats& stats,
+                                  u8 allowed_cascading_level,
+                                  const PartEncoding& part) override;
   bool usesFsst(const u8* src) override;
   u32 compress(StringArrayViewer src, const BITMAP* nullmap, u8* dest, StringStats& stats) override;
+  u32 compress(StringArrayViewer src,
+               const BITMAP* nullmap,
+               u8* dest,
+               StringStats& stats,
+               const PartEncoding& part) override;
   std::string fullDescription(const u8* src) override;
   bool isUsable(StringStats& stats) override;
   u32 getDecompressedSize(const u8* src, u32 tuple_count, BitmapWrapper* nullmap) override;
@@ -32,14 +53,65 @@ class DynamicDictionary : public StringScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void decompress(u8* dest,
+                  BitmapWrapper* nullmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level,
+                  const PartData& part) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level,
+            const PartData& part) override;
   bool decompressNoCopy(u8* dest,
                         BitmapWrapper* nullmap,
                         const u8* src,
                         u32 tuple_count,
                         u32 level) override;
+  bool decompressNoCopy(u8* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level,
+                        const PartData& part) override;
+  // Late materialization: the distinct strings in StringPointerArrayViewer
+  // layout (one view per code) and the codes of all rows
+  u32 decompressDictionary(std::vector<u8>& dest, const u8* src, u32 level, const PartData& part);
+  void decompressCodes(INTEGER* dest, const u8* src, u32 tuple_count, u32 level);
+  // Whether the codes index the part's GlobalDictionary (stable across chunks)
+  bool usesGlobalDictionary(const u8* src);
   inline StringSchemeType schemeType() override { return staticSchemeType(); }
   inline static StringSchemeType staticSchemeType() { return StringSchemeType::DICT; }
 };
 // -------------------------------------------------------------------------------------
+// Decodes single entries of a DynamicDictionary block on demand. FSST
+// dictionaries are not decoded as a whole, every entry is decoded from its own
+// FSST offsets and kept in a small direct-mapped cache.
+class DictionaryEntryReader {
+ public:
+  static constexpr u32 CACHE_SIZE = 256;
+  DictionaryEntryReader(const u8* src, const PartData& part);
+  // The view stays valid until the next call
+  str operator()(u32 code);
+  [[nodiscard]] inline u32 getNumCodes() const { return col_struct.num_codes; }
+
+ private:
+  struct CacheEntry {
+    s64 code = -1;
+    std::string value;
+  };
+  const DynamicDictionaryStructure& col_struct;
+  const PartData part;
+  fsst_decoder_t decoder;
+  std::vector<CacheEntry> cache;
+};
+// -------------------------------------------------------------------------------------
 }  // namespace btrblocks::strings
 // -------------------------------------------------------------------------------------
@@ -0,0 +1,370 @@
+#include "FrontCodedDictionary.hpp"
+#include "common/Hash.hpp"
+#include "common/Units.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/SchemeConfig.hpp"
+// -------------------------------------------------------------------------------------
+#include "common/Log.hpp"
+#include "storage/StringPointerArrayViewer.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::strings {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+// LEB128, strings are shorter than MAX_STR_LENGTH so lengths take 1-2 bytes
+inline u32 varintSize(u32 value) {
+  u32 size = 1;
+  while (value >= 0x80) {
+    value >>= 7;
+    size++;
+  }
+  return size;
+}
+inline u8* writeVarint(u8* dest, u32 value) {
+  while (value >= 0x80) {
+    *dest++ = static_cast<u8>(value) | 0x80;
+    value >>= 7;
+  }
+  *dest++ = static_cast<u8>(value);
+  return dest;
+}
+inline const u8* readVarint(const u8* src, u32& value) {
+  value = 0;
+  for (u32 shift = 0;; shift += 7) {
+    u8 byte = *src++;
+    value |= static_cast<u32>(byte & 0x7F) << shift;
+    if (byte < 0x80) {
+      return src;
+    }
+  }
+}
+// -------------------------------------------------------------------------------------
+inline u32 commonPrefix(const str& a, const str& b) {
+  auto max_length = std::min(a.length(), b.length());
+  u32 length = 0;
+  while (length < max_length && a[length] == b[length]) {
+    length++;
+  }
+  return length;
+}
+// -------------------------------------------------------------------------------------
+inline const u32* restartOffsets(const FrontCodedDictionaryStructure& col_struct) {
+  return reinterpret_cast<const u32*>(col_struct.data + col_struct.restarts_offset);
+}
+// -------------------------------------------------------------------------------------
+// Decodes all entries back to back into strings. An entry's prefix is the tail of
+// the previous string, which has just been written, so no scratch buffer is needed.
+void decodeEntries(const FrontCodedDictionaryStructure& col_struct,
+                   u8* strings,
+                   StringPointerArrayViewer::View* views,
+                   u32 first_offset) {
+  const u8* read_ptr = col_struct.data;
+  u8* write_ptr = strings;
+  u8* prev = strings;
+  for (u32 code = 0; code < col_struct.num_codes; code++) {
+    u32 prefix_length = 0;
+    u32 suffix_length;
+    if (code % col_struct.restart_interval != 0) {
+      read_ptr = readVarint(read_ptr, prefix_length);
+    }
+    read_ptr = readVarint(read_ptr, suffix_length);
+    std::memcpy(write_ptr, prev, prefix_length);
+    std::memcpy(write_ptr + prefix_length, read_ptr, suffix_length);
+    read_ptr += suffix_length;
+    views[code].offset = first_offset + (write_ptr - strings);
+    views[code].length = prefix_length + suffix_length;
+    prev = write_ptr;
+    write_ptr += views[code].length;
+  }
+}
+// -------------------------------------------------------------------------------------
+void decodeCodes(const FrontCodedDictionaryStructure& col_struct,
+                 INTEGER* dest,
+                 u32 tuple_count,
+                 u32 level) {
+  IntegerScheme& codes_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme);
+  codes_scheme.decompress(dest, nullptr, col_struct.data + col_struct.codes_offset, tuple_count,
+                          level + 1);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+double FrontCodedDictionary::expectedCompressionRatio(StringStats& stats, u8) {
+  if (stats.distinct_values.empty()) {
+    return 0;
+  }
+  const u32 restart_interval = SchemeConfig::get().strings.front_coding_restart_interval;
+  // The distinct values are sorted already, so the entry sizes are exact
+  u32 entries_size = 0;
+  u32 code = 0;
+  const str* prev = nullptr;
+  for (const auto& value : stats.distinct_values) {
+    u32 prefix_length = 0;
+    if (code++ % restart_interval != 0) {
+      prefix_length = commonPrefix(*prev, value);
+      entries_size += varintSize(prefix_length);
+    }
+    entries_size += varintSize(value.length() - prefix_length) + value.length() - prefix_length;
+    prev = &value;
+  }
+  u32 bits_per_code = std::floor(std::log2(stats.distinct_values.size())) + 1;
+  double after_size = sizeof(FrontCodedDictionaryStructure) + entries_size;
+  after_size += sizeof(u32) * ((stats.distinct_values.size() + restart_interval - 1) / restart_interval);
+  after_size += stats.tuple_count * (CD(bits_per_code) / 8.0);
+  return CD(stats.total_size) / after_size;
+}
+// -------------------------------------------------------------------------------------
+u32 FrontCodedDictionary::compress(StringArrayViewer src,
+                                   const BITMAP*,
+                                   u8* dest,
+                                   StringStats& stats) {
+  // Layout: ENTRIES | RESTART OFFSETS | Compressed(Codes)
+  auto& cfg = SchemeConfig::get().strings;
+  auto& col_struct = *reinterpret_cast<FrontCodedDictionaryStructure*>(dest);
+  col_struct.total_decompressed_size = stats.total_size;
+  col_struct.num_codes = stats.distinct_values.size();
+  col_struct.dictionary_length = stats.total_unique_length;
+  col_struct.restart_interval = cfg.front_coding_restart_interval;
+  vector<str> distinct_values(stats.distinct_values.begin(), stats.distinct_values.end());
+  // -------------------------------------------------------------------------------------
+  // Entries
+  vector<u32> restart_offsets;
+  auto write_ptr = col_struct.data;
+  for (u32 code = 0; code < distinct_values.size(); code++) {
+    const str& value = distinct_values[code];
+    u32 prefix_length = 0;
+    if (code % col_struct.restart_interval == 0) {
+      restart_offsets.push_back(write_ptr - col_struct.data);
+    } else {
+      prefix_length = commonPrefix(distinct_values[code - 1], value);
+      write_ptr = writeVarint(write_ptr, prefix_length);
+    }
+    const u32 suffix_length = value.length() - prefix_length;
+    write_ptr = writeVarint(write_ptr, suffix_length);
+    std::memcpy(write_ptr, value.data() + prefix_length, suffix_length);
+    write_ptr += suffix_length;
+  }
+  // -------------------------------------------------------------------------------------
+  col_struct.restarts_offset = write_ptr - col_struct.data;
+  std::memcpy(write_ptr, restart_offsets.data(), restart_offsets.size() * sizeof(u32));
+  write_ptr += restart_offsets.size() * sizeof(u32);
+  Log::debug("FRONT_CODED: string_pool_size : before = {} after = {}",
+             static_cast<s64>(stats.total_unique_length),
+             static_cast<s64>(write_ptr - col_struct.data));
+  // -------------------------------------------------------------------------------------
+  // Codes
+  {
+    vector<INTEGER> codes(stats.tuple_count);
+    for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
+      auto it = std::lower_bound(distinct_values.begin(), distinct_values.end(), src(row_i));
+      die_if(it != distinct_values.end());
+      codes[row_i] = static_cast<INTEGER>(std::distance(distinct_values.begin(), it));
+    }
+    col_struct.codes_offset = write_ptr - col_struct.data;
+    u32 used_space;
+    IntegerSchemePicker::compress(codes.data(), nullptr, write_ptr, codes.size(),
+                                  cfg.fsst_codes_max_cascade_depth, used_space,
+                                  col_struct.codes_scheme, static_cast<u8>(autoScheme()), "codes");
+    write_ptr += used_space;
+  }
+  // -------------------------------------------------------------------------------------
+  return write_ptr - dest;
+}
+// -------------------------------------------------------------------------------------
+u32 FrontCodedDictionary::getDecompressedSize(const u8* src, u32, BitmapWrapper*) {
+  return reinterpret_cast<const FrontCodedDictionaryStructure*>(src)->total_decompressed_size;
+}
+// -------------------------------------------------------------------------------------
+u32 FrontCodedDictionary::getDecompressedSizeNoCopy(const u8* src,
+                                                    u32 tuple_count,
+                                                    BitmapWrapper*) {
+  const auto& col_struct = *reinterpret_cast<const FrontCodedDictionaryStructure*>(src);
+  auto strings_size =
+      col_struct.total_decompressed_size - ((tuple_count + 1) * sizeof(StringArrayViewer::Slot));
+  auto views_size = (tuple_count + 4) * sizeof(StringPointerArrayViewer::View);
+  return strings_size + views_size;
+}
+// -------------------------------------------------------------------------------------
+u32 FrontCodedDictionary::getTotalLength(const u8* src, u32 tuple_count, BitmapWrapper*) {
+  const auto& col_struct = *reinterpret_cast<const FrontCodedDictionaryStructure*>(src);
+  return col_struct.total_decompressed_size - ((tuple_count + 1) * sizeof(StringArrayViewer::Slot));
+}
+// -------------------------------------------------------------------------------------
+void FrontCodedDictionary::decompress(u8* dest,
+                                      BitmapWrapper*,
+                                      const u8* src,
+                                      u32 tuple_count,
+                                      u32 level) {
+  const auto& col_struct = *reinterpret_cast<const FrontCodedDictionaryStructure*>(src);
+  // -------------------------------------------------------------------------------------
+  thread_local std::vector<std::vector<u8>> strings_v;
+  auto strings = get_level_data(strings_v, col_struct.dictionary_length + SIMD_EXTRA_BYTES, level);
+  thread_local std::vector<std::vector<StringPointerArrayViewer::View>> views_v;
+  auto views = get_level_data(views_v, col_struct.num_codes, level);
+  decodeEntries(col_struct, strings, views, 0);
+  // -------------------------------------------------------------------------------------
+  thread_local std::vector<std::vector<INTEGER>> codes_v;
+  auto codes = get_level_data(codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  decodeCodes(col_struct, codes, tuple_count, level);
+  // -------------------------------------------------------------------------------------
+  auto dest_slots = reinterpret_cast<StringArrayViewer::Slot*>(dest);
+  auto dest_write_ptr = dest + (sizeof(StringArrayViewer::Slot) * (tuple_count + 1)) + SIMD_EXTRA_BYTES;
+  for (u32 row_i = 0; row_i < tuple_count; row_i++) {
+    dest_slots[row_i].offset = dest_write_ptr - dest;
+    const auto& view = views[codes[row_i]];
+    std::memcpy(dest_write_ptr, strings + view.offset, view.length);
+    dest_write_ptr += view.length;
+  }
+  dest_slots[tuple_count].offset = dest_write_ptr - dest;
+  die_if(dest_write_ptr - dest - SIMD_EXTRA_BYTES == col_struct.total_decompressed_size);
+}
+// -------------------------------------------------------------------------------------
+bool FrontCodedDictionary::decompressNoCopy(u8* dest,
+                                            BitmapWrapper*,
+                                            const u8* src,
+                                            u32 tuple_count,
+                                            u32 level) {
+  const auto& col_struct = *reinterpret_cast<const FrontCodedDictionaryStructure*>(src);
+  // -------------------------------------------------------------------------------------
+  // The distinct strings go right behind the row views
+  thread_local std::vector<std::vector<StringPointerArrayViewer::View>> views_v;
+  auto views = get_level_data(views_v, col_struct.num_codes, level);
+  const u32 strings_offset = (tuple_count + 4) * sizeof(StringPointerArrayViewer::View);
+  decodeEntries(col_struct, dest + strings_offset, views, strings_offset);
+  // -------------------------------------------------------------------------------------
+  thread_local std::vector<std::vector<INTEGER>> codes_v;
+  auto codes = get_level_data(codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  decodeCodes(col_struct, codes, tuple_count, level);
+  // Views are 8 bytes like hashes, so they can be gathered the same way
+  static_assert(sizeof(StringPointerArrayViewer::View) == sizeof(u64));
+  Hash::gather(reinterpret_cast<u64*>(dest), reinterpret_cast<const u64*>(views),
+               col_struct.num_codes, codes, tuple_count);
+  return true;
+}
+// -------------------------------------------------------------------------------------
+void FrontCodedDictionary::hash(u64* dest,
+                                BitmapWrapper*,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level) {
+  const auto& col_struct = *reinterpret_cast<const FrontCodedDictionaryStructure*>(src);
+  // -------------------------------------------------------------------------------------
+  // Hash every distinct string exactly once
+  thread_local std::vector<std::vector<u8>> strings_v;
+  auto strings = get_level_data(strings_v, col_struct.dictionary_length + SIMD_EXTRA_BYTES, level);
+  thread_local std::vector<std::vector<StringPointerArrayViewer::View>> views_v;
+  auto views = get_level_data(views_v, col_struct.num_codes, level);
+  decodeEntries(col_struct, strings, views, 0);
+  thread_local std::vector<std::vector<u64>> dict_hashes_v;
+  auto dict_hashes = get_level_data(dict_hashes_v, col_struct.num_codes, level);
+  for (u32 c = 0; c < col_struct.num_codes; c++) {
+    dict_hashes[c] =
+        Hash::hashValue(reinterpret_cast<const char*>(strings) + views[c].offset, views[c].length);
+  }
+  // -------------------------------------------------------------------------------------
+  thread_local std::vector<std::vector<INTEGER>> codes_v;
+  auto codes = get_level_data(codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+  decodeCodes(col_struct, codes, tuple_count, level);
+  Hash::gather(dest, dict_hashes, col_struct.num_codes, codes, tuple_count);
+}
+// -------------------------------------------------------------------------------------
+u32 FrontCodedDictionary::decompressDictionary(std::vector<u8>& dest_v, const u8* src, u32) {
+  const auto& col_struct = *reinterpret_cast<const FrontCodedDictionaryStructure*>(src);
+  const u32 views_size = col_struct.num_codes * sizeof(StringPointerArrayViewer::View);
+  auto dest = get_data(dest_v, views_size + col_struct.dictionary_length + SIMD_EXTRA_BYTES);
+  decodeEntries(col_struct, dest + views_size,
+                reinterpret_cast<StringPointerArrayViewer::View*>(dest), views_size);
+  return col_struct.num_codes;
+}
+// -------------------------------------------------------------------------------------
+void FrontCodedDictionary::decompressCodes(INTEGER* dest,
+                                           const u8* src,
+                                           u32 tuple_count,
+                                           u32 level) {
+  decodeCodes(*reinterpret_cast<const FrontCodedDictionaryStructure*>(src), dest, tuple_count,
+              level);
+}
+// -------------------------------------------------------------------------------------
+u32 FrontCodedDictionary::lookup(const u8* src, u32 code, u8* dest) {
+  const auto& col_struct = *reinterpret_cast<const FrontCodedDictionaryStructure*>(src);
+  die_if(code < col_struct.num_codes);
+  // -------------------------------------------------------------------------------------
+  const u8* read_ptr = col_struct.data + restartOffsets(col_struct)[code / col_struct.restart_interval];
+  u32 length;
+  read_ptr = readVarint(read_ptr, length);
+  std::memcpy(dest, read_ptr, length);
+  read_ptr += length;
+  for (u32 entry_i = 0; entry_i < code % col_struct.restart_interval; entry_i++) {
+    u32 suffix_length;
+    read_ptr = readVarint(read_ptr, length);
+    read_ptr = readVarint(read_ptr, suffix_length);
+    std::memcpy(dest + length, read_ptr, suffix_length);
+    read_ptr += suffix_length;
+    length += suffix_length;
+  }
+  return length;
+}
+// -------------------------------------------------------------------------------------
+u32 FrontCodedDictionary::lowerBound(const u8* src, str value) {
+  const auto& col_struct = *reinterpret_cast<const FrontCodedDictionaryStructure*>(src);
+  const u32 restarts_count =
+      (col_struct.num_codes + col_struct.restart_interval - 1) / col_struct.restart_interval;
+  auto restarts = restartOffsets(col_struct);
+  auto restartValue = [&](u32 restart_i) {
+    u32 length;
+    auto ptr = readVarint(col_struct.data + restarts[restart_i], length);
+    return str(reinterpret_cast<const char*>(ptr), length);
+  };
+  // -------------------------------------------------------------------------------------
+  // The restart points are stored in full, find the last one that is <= value
+  u32 low = 0;
+  u32 high = restarts_count;
+  while (low < high) {
+    u32 mid = low + (high - low) / 2;
+    if (restartValue(mid) <= value) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  if (low == 0) {
+    return 0;
+  }
+  // -------------------------------------------------------------------------------------
+  // Scan the block behind it
+  u8 buffer[MAX_STR_LENGTH];
+  const u32 block_begin = (low - 1) * col_struct.restart_interval;
+  const u32 block_end = std::min(block_begin + col_struct.restart_interval, col_struct.num_codes);
+  const u8* read_ptr = col_struct.data + restarts[low - 1];
+  u32 length = 0;
+  for (u32 code = block_begin; code < block_end; code++) {
+    u32 suffix_length;
+    if (code != block_begin) {
+      read_ptr = readVarint(read_ptr, length);
+    }
+    read_ptr = readVarint(read_ptr, suffix_length);
+    std::memcpy(buffer + length, read_ptr, suffix_length);
+    read_ptr += suffix_length;
+    length += suffix_length;
+    if (str(reinterpret_cast<const char*>(buffer), length) >= value) {
+      return code;
+    }
+  }
+  return block_end;
+}
+// -------------------------------------------------------------------------------------
+std::string FrontCodedDictionary::fullDescription(const u8* src) {
+  const auto& col_struct = *reinterpret_cast<const FrontCodedDictionaryStructure*>(src);
+  IntegerScheme& codes_scheme =
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme);
+  return this->selfDescription(src) + " -> ([int] codes) " +
+         codes_scheme.fullDescription(col_struct.data + col_struct.codes_offset);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::strings
+// -------------------------------------------------------------------------------------
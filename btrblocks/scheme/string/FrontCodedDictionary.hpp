@@ -0,0 +1,63 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks::strings {
+// -------------------------------------------------------------------------------------
+/*
+ * Dictionary of the sorted distinct strings with front coding: every entry
+ * only stores the suffix that differs from its predecessor,
+ *   varint(prefix_length) varint(suffix_length) suffix
+ * Every restart_interval-th entry (a restart point) is stored in full without
+ * the prefix length, so single codes can be decoded from the closest restart
+ * point and the restart points can be binary searched without decoding.
+ */
+struct FrontCodedDictionaryStructure {
+  u32 total_decompressed_size;  // i.e original input size
+  u32 num_codes;
+  u32 dictionary_length;  // total length of the distinct strings
+  u32 restart_interval;
+  u32 restarts_offset;  // u32 entry offsets of the restart points
+  u32 codes_offset;
+  u8 codes_scheme;
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+class FrontCodedDictionary : public StringScheme {
+ public:
+  double expectedCompressionRatio(StringStats& stats, u8 allowed_cascading_level) override;
+  u32 compress(StringArrayViewer src, const BITMAP* nullmap, u8* dest, StringStats& stats) override;
+  std::string fullDescription(const u8* src) override;
+  u32 getDecompressedSize(const u8* src, u32 tuple_count, BitmapWrapper* nullmap) override;
+  u32 getDecompressedSizeNoCopy(const u8* src, u32 tuple_count, BitmapWrapper* nullmap) override;
+  u32 getTotalLength(const u8* src, u32 tuple_count, BitmapWrapper* nullmap) override;
+  void decompress(u8* dest,
+                  BitmapWrapper* nullmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level) override;
+  bool decompressNoCopy(u8* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
+  // Late materialization, same layout as DynamicDictionary
+  u32 decompressDictionary(std::vector<u8>& dest, const u8* src, u32 level);
+  void decompressCodes(INTEGER* dest, const u8* src, u32 tuple_count, u32 level);
+  // -------------------------------------------------------------------------------------
+  // Decodes a single code into dest (at least MAX_STR_LENGTH bytes), returns its length
+  static u32 lookup(const u8* src, u32 code, u8* dest);
+  // The first code whose string is not less than value, num_codes if there is none
+  static u32 lowerBound(const u8* src, str value);
+  // -------------------------------------------------------------------------------------
+  inline StringSchemeType schemeType() override { return staticSchemeType(); }
+  inline static StringSchemeType staticSchemeType() { return StringSchemeType::DICT_FRONT_CODED; }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::strings
+// -------------------------------------------------------------------------------------
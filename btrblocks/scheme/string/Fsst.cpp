@@ -4,6 +4,7 @@
 // ------------------------------------------------------------------------------
 #include "common/Log.hpp"
 #include "compression/SchemePicker.hpp"
+#include "scheme/string/FsstTable.hpp"
 // ------------------------------------------------------------------------------
 namespace btrblocks::strings {
 // ------------------------------------------------------------------------------
@@ -15,9 +16,17 @@ double Fsst::expectedCompressionRatio(StringStats& stats, u8) {
 }
 
 u32 Fsst::compress(const btrblocks::StringArrayViewer src,
-                   const BITMAP*,
+                   const BITMAP* nullmap,
                    u8* dest,
                    btrblocks::StringStats& stats) {
+  return this->compress(src, nullmap, dest, stats, {});
+}
+
+u32 Fsst::compress(const btrblocks::StringArrayViewer src,
+                   const BITMAP*,
+                   u8* dest,
+                   btrblocks::StringStats& stats,
+                   const PartEncoding& part) {
   // TODO: For now we consider null values to be empty strings. Maybe it would
   // be faster to not compress them and use roaring bitmap iterate to fill the
   // StringArrayView on decompression
@@ -40,18 +49,17 @@ u32 Fsst::compress(const btrblocks::StringArrayViewer src,
     input_string_lengths[str_i] = src.size(str_i);
   }
 
-  // Prepare decoder and write header
-  fsst_encoder_t* encoder =
-      fsst_create(stats.tuple_count, (unsigned long*) input_string_lengths.get(), input_string_buffers.get(), 0);
-  die_if(fsst_export(encoder, write_ptr) > 0);
-  auto fsst_table_used_space = FSST_MAXHEADER;
+  // Prepare encoder and write header, unless the part's table is used
+  FsstEncoder encoder(part.fsst_table, stats.tuple_count, input_string_lengths.get(),
+                      input_string_buffers.get());
+  auto fsst_table_used_space = encoder.exportTable(write_ptr);
   write_ptr += fsst_table_used_space;
   col_struct.strings_offset = write_ptr - col_struct.data;
 
   // Compress strings
   // TODO whyever this is fake(?), fix it.
   const u64 output_buffer_size = 7 + 4 * stats.total_length;  // fake
-  if (fsst_compress(encoder, stats.tuple_count,  (unsigned long*) input_string_lengths.get(),
+  if (fsst_compress(encoder.get(), stats.tuple_count,  (unsigned long*) input_string_lengths.get(),
                      input_string_buffers.get(), output_buffer_size, write_ptr,
                      (unsigned long*)  output_string_lengths.get(),
                      output_string_buffers.get()) != stats.tuple_count) {
@@ -84,7 +92,20 @@ u32 Fsst::getDecompressedSize(const u8* src, u32, BitmapWrapper*) {
   return col_struct.total_decompressed_size;
 }
 
-void Fsst::decompress(u8* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32 level) {
+void Fsst::decompress(u8* dest,
+                      BitmapWrapper* nullmap,
+                      const u8* src,
+                      u32 tuple_count,
+                      u32 level) {
+  this->decompress(dest, nullmap, src, tuple_count, level, {});
+}
+
+void Fsst::decompress(u8* dest,
+                      BitmapWrapper*,
+                      const u8* src,
+                      u32 tuple_count,
+                      u32 level,
+                      const PartData& part) {
   auto& col_struct = *reinterpret_cast<const FsstStructure*>(src);
   auto dest_slots = reinterpret_cast<StringArrayViewer::Slot*>(dest);
   auto dest_write_ptr = dest + sizeof(StringArrayViewer::Slot) * (tuple_count + 1);
@@ -98,8 +119,8 @@ void Fsst::decompress(u8* dest, BitmapWrapper*, const u8* src, u32 tuple_count,
 
   // Decompress strings
   fsst_decoder_t decoder;
-  die_if(fsst_import(&decoder, const_cast<u8*>(col_struct.data)) > 0) auto compressed_strings =
-      const_cast<u8*>(col_struct.data + col_struct.strings_offset);
+  importFsstTable(decoder, col_struct.data, col_struct.sharedTable(), part.fsst_table);
+  auto compressed_strings = const_cast<u8*>(col_struct.data + col_struct.strings_offset);
   auto decompressed_strings_size =
       col_struct.total_decompressed_size - ((tuple_count + 1) * sizeof(INTEGER));
   decompressed_strings_size += 4096;
@@ -108,6 +129,37 @@ void Fsst::decompress(u8* dest, BitmapWrapper*, const u8* src, u32 tuple_count,
   die_if(dest_write_ptr - dest == col_struct.total_decompressed_size)
 }
 
+bool Fsst::decompressNoCopy(u8* dest,
+                            BitmapWrapper* nullmap,
+                            const u8* src,
+                            u32 tuple_count,
+                            u32 level) {
+  return this->decompressNoCopy(dest, nullmap, src, tuple_count, level, {});
+}
+
+bool Fsst::decompressNoCopy(u8* dest,
+                            BitmapWrapper* nullmap,
+                            const u8* src,
+                            u32 tuple_count,
+                            u32 level,
+                            const PartData& part) {
+  this->decompress(dest, nullmap, src, tuple_count, level, part);
+  return false;
+}
+
+void Fsst::hash(u64* dest, BitmapWrapper* nullmap, const u8* src, u32 tuple_count, u32 level) {
+  this->hash(dest, nullmap, src, tuple_count, level, {});
+}
+
+void Fsst::hash(u64* dest,
+                BitmapWrapper* nullmap,
+                const u8* src,
+                u32 tuple_count,
+                u32 level,
+                const PartData& part) {
+  this->hashDecompressed(dest, nullmap, src, tuple_count, level, part);
+}
+
 std::string Fsst::fullDescription(const u8* src) {
   auto& col_struct = *reinterpret_cast<const FsstStructure*>(src);
   IntegerScheme& offsets_scheme =
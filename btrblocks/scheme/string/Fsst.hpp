@@ -15,12 +15,21 @@ struct FsstStructure {
   u32 offsets_offset;
   u8 offsets_scheme;
   u8 data[];
+
+  // Without a table of its own the strings start at data, the table is in the
+  // part (see FsstTable.hpp)
+  [[nodiscard]] inline bool sharedTable() const { return strings_offset == 0; }
 };
 
 class Fsst : public StringScheme {
  public:
   double expectedCompressionRatio(StringStats& stats, u8 allowed_cascading_level) override;
   u32 compress(StringArrayViewer src, const BITMAP* nullmap, u8* dest, StringStats& stats) override;
+  u32 compress(StringArrayViewer src,
+               const BITMAP* nullmap,
+               u8* dest,
+               StringStats& stats,
+               const PartEncoding& part) override;
   u32 getDecompressedSize(const u8* src, u32 tuple_count, BitmapWrapper* nullmap) override;
   u32 getTotalLength(const u8* src, u32 tuple_count, BitmapWrapper* nullmap) override;
   void decompress(u8* dest,
@@ -28,6 +37,30 @@ class Fsst : public StringScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void decompress(u8* dest,
+                  BitmapWrapper* nullmap,
+                  const u8* src,
+                  u32 tuple_count,
+                  u32 level,
+                  const PartData& part) override;
+  bool decompressNoCopy(u8* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level) override;
+  bool decompressNoCopy(u8* dest,
+                        BitmapWrapper* nullmap,
+                        const u8* src,
+                        u32 tuple_count,
+                        u32 level,
+                        const PartData& part) override;
+  void hash(u64* dest, BitmapWrapper* nullmap, const u8* src, u32 tuple_count, u32 level) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level,
+            const PartData& part) override;
   bool isUsable(StringStats& stats) override;
   std::string fullDescription(const u8* src) override;
   inline StringSchemeType schemeType() override { return staticSchemeType(); }
@@ -0,0 +1,128 @@
+#include "FsstTable.hpp"
+#include "common/Exceptions.hpp"
+#include "common/Log.hpp"
+#include "scheme/SchemeConfig.hpp"
+#include "storage/Column.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+// -------------------------------------------------------------------------------------
+namespace btrblocks::strings {
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+// Strings of the sample used to detect drift
+constexpr u64 SAMPLE_SIZE = 256;
+// Strings of the column sample the shared table is trained on, FSST itself
+// only trains on about 16 KiB of it
+constexpr u64 TRAINING_SAMPLE_SIZE = 4096;
+// -------------------------------------------------------------------------------------
+double sampleCompressionRatio(fsst_encoder_t* encoder, u64 n, const u64* lengths, u8** strings) {
+  const u64 step = std::max<u64>(1, n / SAMPLE_SIZE);
+  vector<u64> sample_lengths;
+  vector<u8*> sample_strings;
+  u64 input_size = 0;
+  for (u64 str_i = 0; str_i < n; str_i += step) {
+    sample_lengths.push_back(lengths[str_i]);
+    sample_strings.push_back(strings[str_i]);
+    input_size += lengths[str_i];
+  }
+  if (input_size == 0) {
+    return 1.0;
+  }
+  // -------------------------------------------------------------------------------------
+  const u64 sample_n = sample_lengths.size();
+  vector<u8> output(7 + 2 * input_size);
+  vector<u64> output_lengths(sample_n);
+  vector<u8*> output_strings(sample_n);
+  if (fsst_compress(encoder, sample_n, (unsigned long*)sample_lengths.data(), sample_strings.data(),
+                    output.size(), output.data(), (unsigned long*)output_lengths.data(),
+                    output_strings.data()) != sample_n) {
+    throw Generic_Exception("FSST Compression failed !");
+  }
+  u64 output_size = 0;
+  for (auto length : output_lengths) {
+    output_size += length;
+  }
+  return CD(input_size) / CD(std::max<u64>(output_size, 1));
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+SharedFsstTable::~SharedFsstTable() {
+  if (encoder != nullptr) {
+    fsst_destroy(encoder);
+  }
+}
+// -------------------------------------------------------------------------------------
+void SharedFsstTable::train(const Column& column) {
+  if (column.type != ColumnType::STRING || encoder != nullptr) {
+    return;
+  }
+  // Evenly spaced rows, so every chunk of the column is represented
+  const auto& strings = column.strings();
+  const u64 step = std::max<u64>(1, strings.size() / TRAINING_SAMPLE_SIZE);
+  vector<u64> sample_lengths;
+  vector<u8*> sample_strings;
+  u64 sample_size = 0;
+  for (u64 row_i = 0; row_i < strings.size(); row_i += step) {
+    auto value = strings[row_i];
+    sample_lengths.push_back(value.length());
+    sample_strings.push_back(const_cast<u8*>(reinterpret_cast<const u8*>(value.data())));
+    sample_size += value.length();
+  }
+  if (sample_size == 0) {
+    return;
+  }
+  // -------------------------------------------------------------------------------------
+  const u64 sample_n = sample_lengths.size();
+  encoder = fsst_create(sample_n, (unsigned long*)sample_lengths.data(), sample_strings.data(), 0);
+  trained_ratio =
+      sampleCompressionRatio(encoder, sample_n, sample_lengths.data(), sample_strings.data());
+  table.resize(FSST_MAXHEADER);
+  die_if(fsst_export(encoder, table.data()) > 0);
+}
+// -------------------------------------------------------------------------------------
+FsstEncoder::FsstEncoder(const SharedFsstTable* table, u64 n, u64* lengths, u8** strings) {
+  if (table != nullptr && table->trained()) {
+    // Reuse the shared table unless the strings drifted away from it
+    const double ratio = sampleCompressionRatio(table->encoder, n, lengths, strings);
+    const double drift_pct = SchemeConfig::get().strings.fsst_shared_table_drift_pct;
+    if (ratio >= table->trained_ratio * (1.0 - drift_pct / 100.0)) {
+      encoder = table->encoder;
+      shared = true;
+      return;
+    }
+    Log::debug("FSST: shared table drifted, ratio = {} trained_ratio = {}", ratio,
+               table->trained_ratio);
+  }
+  // -------------------------------------------------------------------------------------
+  encoder = fsst_create(n, (unsigned long*)lengths, strings, 0);
+}
+// -------------------------------------------------------------------------------------
+FsstEncoder::~FsstEncoder() {
+  if (!shared) {
+    fsst_destroy(encoder);
+  }
+}
+// -------------------------------------------------------------------------------------
+u32 FsstEncoder::exportTable(u8* dest) const {
+  if (shared) {
+    return 0;
+  }
+  die_if(fsst_export(encoder, dest) > 0);
+  return FSST_MAXHEADER;
+}
+// -------------------------------------------------------------------------------------
+void importFsstTable(fsst_decoder_t& decoder,
+                     const u8* chunk_table,
+                     bool shared,
+                     const u8* part_table) {
+  const u8* table = shared ? part_table : chunk_table;
+  if (table == nullptr) {
+    throw Generic_Exception("Chunk uses the shared FSST table, but its part has none");
+  }
+  die_if(fsst_import(&decoder, const_cast<u8*>(table)) > 0);
+}
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::strings
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,75 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include "common/Units.hpp"
+// -------------------------------------------------------------------------------------
+#include <fsst.h>
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+class Column;
+}
+namespace btrblocks::strings {
+// -------------------------------------------------------------------------------------
+/*
+ * FSST symbol table shared by the string chunks of a column part. It is stored
+ * once in the part (ColumnPartExtension::fsst_table_offset) instead of
+ * FSST_MAXHEADER bytes in every chunk.
+ *
+ * Compression: train() builds the table from a sample spread over all rows of
+ * the column, before any of its chunks is compressed. Every chunk that uses FSST
+ * and gets the table as PartEncoding (Datablock::compress) reuses it. A chunk
+ * only trains and embeds its own table if the shared one compresses a sample of
+ * it notably worse than the training sample (drift).
+ * Decompression: chunks flagged as using the shared table import it from the
+ * exported table of the part, which they get as PartData (Datablock::decompress,
+ * BtrReader).
+ */
+class SharedFsstTable {
+ public:
+  SharedFsstTable() = default;
+  SharedFsstTable(const SharedFsstTable&) = delete;
+  SharedFsstTable& operator=(const SharedFsstTable&) = delete;
+  ~SharedFsstTable();
+  // Trains the table on a sample of the strings of column. Other column types
+  // and columns without any string bytes leave the table empty.
+  void train(const Column& column);
+  // The exported table, empty until it is trained
+  [[nodiscard]] inline const vector<u8>& exported() const { return table; }
+  // Whether the chunks can use the table, i.e. it is trained
+  [[nodiscard]] inline bool trained() const { return encoder != nullptr; }
+
+ private:
+  friend class FsstEncoder;
+  // -------------------------------------------------------------------------------------
+  fsst_encoder_t* encoder = nullptr;
+  // Compression ratio on the training sample
+  double trained_ratio = 0;
+  vector<u8> table;
+};
+// -------------------------------------------------------------------------------------
+// Encoder for the strings of one chunk: table (the part's, may be nullptr) if it
+// is trained and still fits the strings, a table trained on the strings otherwise
+class FsstEncoder {
+ public:
+  FsstEncoder(const SharedFsstTable* table, u64 n, u64* lengths, u8** strings);
+  FsstEncoder(const FsstEncoder&) = delete;
+  FsstEncoder& operator=(const FsstEncoder&) = delete;
+  ~FsstEncoder();
+  [[nodiscard]] inline fsst_encoder_t* get() const { return encoder; }
+  [[nodiscard]] inline bool isShared() const { return shared; }
+  // Writes the table to dest unless it is shared, returns the bytes written
+  u32 exportTable(u8* dest) const;
+
+ private:
+  fsst_encoder_t* encoder;
+  bool shared = false;
+};
+// -------------------------------------------------------------------------------------
+// chunk_table is the table embedded in the chunk, part_table the exported table
+// of its part (may be nullptr). The chunk uses the latter if shared is set.
+void importFsstTable(fsst_decoder_t& decoder,
+                     const u8* chunk_table,
+                     bool shared,
+                     const u8* part_table);
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks::strings
+// -------------------------------------------------------------------------------------
@@ -1,4 +1,5 @@
 #include "OneValue.hpp"
+#include "common/Hash.hpp"
 #include "common/Units.hpp"
 #include "scheme/CompressionScheme.hpp"
 #include "storage/Chunk.hpp"
@@ -183,6 +184,12 @@ bool OneValue::decompressNoCopy(u8* dest,
   return true;
 }
 
+void OneValue::hash(u64* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32) {
+  auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
+  std::fill_n(dest, tuple_count,
+              Hash::hashValue(reinterpret_cast<const char*>(col_struct.data), col_struct.length));
+}
+
 u32 OneValue::getTotalLength(const u8* src, u32, BitmapWrapper* nullmap) {
   auto& col_struct = *reinterpret_cast<const OneValueStructure*>(src);
   return nullmap->cardinality() * col_struct.length;
@@ -24,6 +24,11 @@ class OneValue : public StringScheme {
                   const u8* src,
                   u32 tuple_count,
                   u32 level) override;
+  void hash(u64* dest,
+            BitmapWrapper* nullmap,
+            const u8* src,
+            u32 tuple_count,
+            u32 level) override;
   bool decompressNoCopy(u8* dest,
                         BitmapWrapper* nullmap,
                         const u8* src,
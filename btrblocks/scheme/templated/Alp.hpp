@@ -0,0 +1,400 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <limits>
+// -------------------------------------------------------------------------------------
+#include "common/Kernels.hpp"
+#include "common/Log.hpp"
+#include "common/Utils.hpp"
+#include "compression/SchemePicker.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+/*
+ * Adaptive lossless floating-point compression (ALP). Every vector of
+ * ALP_VECTOR_SIZE values is encoded with its own (exponent, factor) pair as
+ * digits = round(value * 10^exponent * 10^-factor) and decoded as
+ * digits * 10^factor / 10^exponent. Values that do not survive the round trip
+ * bit-exactly are patched. The pairs are picked in two steps like in the
+ * paper: the best pairs of a few sampled vectors become the candidates and a
+ * small sample of each vector picks one of them.
+ */
+static constexpr u32 ALP_VECTOR_SIZE = 1024;
+// -------------------------------------------------------------------------------------
+struct AlpVectorParameters {
+  u8 exponent;
+  u8 factor;
+};
+// -------------------------------------------------------------------------------------
+struct AlpStructure {
+  u32 exceptions_count;
+  u32 exceptions_positions_offset;
+  u32 exceptions_values_offset;
+  u32 digits_offset;
+  u8 digits_scheme;
+  u8 positions_scheme;
+  u8 values_scheme;
+  // The AlpVectorParameters of all vectors, followed by the digits
+  u8 data[];
+
+  static inline u32 vectorCount(u32 tuple_count) {
+    return (tuple_count + ALP_VECTOR_SIZE - 1) / ALP_VECTOR_SIZE;
+  }
+  inline AlpVectorParameters* parameters() {
+    return reinterpret_cast<AlpVectorParameters*>(data);
+  }
+  inline const AlpVectorParameters* parameters() const {
+    return reinterpret_cast<const AlpVectorParameters*>(data);
+  }
+};
+// -------------------------------------------------------------------------------------
+// The arithmetic runs in the value type, so the exponent is limited to the
+// powers of ten that are exact in it
+template <typename NumberType>
+struct AlpTraits;
+// -------------------------------------------------------------------------------------
+template <>
+struct AlpTraits<DOUBLE> {
+  static constexpr const char* name = "double";
+  static constexpr u8 max_exponent = 18;
+  static constexpr DOUBLE exact_powers_of_ten[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,
+      1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18,
+  };
+  static constexpr DOUBLE fractions_of_ten[] = {
+      1e0,   1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,  1e-8,  1e-9,
+      1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15, 1e-16, 1e-17, 1e-18,
+  };
+};
+// -------------------------------------------------------------------------------------
+template <>
+struct AlpTraits<FLOAT> {
+  static constexpr const char* name = "float";
+  static constexpr u8 max_exponent = 10;
+  static constexpr FLOAT exact_powers_of_ten[] = {
+      1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+  };
+  static constexpr FLOAT fractions_of_ten[] = {
+      1e0f, 1e-1f, 1e-2f, 1e-3f, 1e-4f, 1e-5f, 1e-6f, 1e-7f, 1e-8f, 1e-9f, 1e-10f,
+  };
+};
+// -------------------------------------------------------------------------------------
+template <typename NumberType, typename SchemeType, typename StatsType, typename SchemeCodeType>
+class TAlp {
+  using Traits = AlpTraits<NumberType>;
+  using ValuesPicker = CSchemePicker<NumberType, SchemeType, StatsType, SchemeCodeType>;
+  static_assert(sizeof(Traits::exact_powers_of_ten) ==
+                sizeof(NumberType) * (Traits::max_exponent + 1));
+  static_assert(sizeof(Traits::fractions_of_ten) ==
+                sizeof(NumberType) * (Traits::max_exponent + 1));
+  // Values sampled for the candidates, in vector_sample_size values per vector
+  static constexpr u32 sample_size = 256;
+  static constexpr u32 vector_sample_size = 32;
+  static constexpr u32 max_candidates = 5;
+
+ public:
+  // -------------------------------------------------------------------------------------
+  static inline u32 encode(INTEGER* digits,
+                           INTEGER* exceptions,
+                           const NumberType* src,
+                           u32 tuple_count,
+                           u8 exponent,
+                           u8 factor) {
+    return Kernels::alpEncode(digits, exceptions, src, tuple_count,
+                              Traits::exact_powers_of_ten[exponent],
+                              Traits::fractions_of_ten[factor],
+                              Traits::exact_powers_of_ten[factor]);
+  }
+  // -------------------------------------------------------------------------------------
+  // Up to sample_size non-null values of the rows [0, tuple_count), strided
+  static inline void takeSample(vector<NumberType>& sample,
+                                const NumberType* src,
+                                const BITMAP* nullmap,
+                                u32 tuple_count,
+                                u32 sample_size) {
+    sample.clear();
+    const u32 step = std::max(1u, tuple_count / sample_size);
+    for (u32 row_i = 0; row_i < tuple_count; row_i += step) {
+      if (nullmap == nullptr || nullmap[row_i]) {
+        sample.push_back(src[row_i]);
+      }
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // Estimated size of the bit-packed digits plus the patches of the sample
+  static inline u64 estimateCost(const vector<NumberType>& sample,
+                                 u8 exponent,
+                                 u8 factor,
+                                 vector<INTEGER>& digits,
+                                 vector<INTEGER>& exceptions) {
+    digits.resize(sample.size());
+    exceptions.resize(sample.size());
+    const u32 exceptions_count =
+        encode(digits.data(), exceptions.data(), sample.data(), sample.size(), exponent, factor);
+    s64 min = std::numeric_limits<s64>::max();
+    s64 max = std::numeric_limits<s64>::min();
+    for (u32 sample_i = 0, exception_i = 0; sample_i < sample.size(); sample_i++) {
+      if (exception_i < exceptions_count &&
+          exceptions[exception_i] == static_cast<INTEGER>(sample_i)) {
+        exception_i++;
+        continue;
+      }
+      min = std::min<s64>(min, digits[sample_i]);
+      max = std::max<s64>(max, digits[sample_i]);
+    }
+    u64 bits_per_value = exceptions_count == sample.size()
+                             ? 0
+                             : Utils::getBitsNeeded(static_cast<u64>(max - min));
+    return (sample.size() - exceptions_count) * bits_per_value +
+           exceptions_count * (sizeof(NumberType) + sizeof(INTEGER)) * 8;
+  }
+  // -------------------------------------------------------------------------------------
+  // The cheapest (exponent, factor) pair of all for the sample
+  static inline std::pair<u8, u8> findBestPair(const vector<NumberType>& sample,
+                                               vector<INTEGER>& digits,
+                                               vector<INTEGER>& exceptions) {
+    std::pair<u8, u8> best_pair = {0, 0};
+    u64 best_cost = std::numeric_limits<u64>::max();
+    for (u8 exponent = 0; exponent <= Traits::max_exponent; exponent++) {
+      for (u8 factor = 0; factor <= exponent; factor++) {
+        const u64 cost = estimateCost(sample, exponent, factor, digits, exceptions);
+        if (cost < best_cost) {
+          best_cost = cost;
+          best_pair = {exponent, factor};
+        }
+      }
+    }
+    return best_pair;
+  }
+  // -------------------------------------------------------------------------------------
+  // Try all pairs on a few sampled vectors and keep the max_candidates pairs
+  // that were the best for most of them
+  static inline vector<std::pair<u8, u8>> findCandidates(const NumberType* src,
+                                                         const BITMAP* nullmap,
+                                                         u32 tuple_count) {
+    const u32 vector_count = AlpStructure::vectorCount(tuple_count);
+    const u32 sampled_vectors = sample_size / vector_sample_size;
+    const u32 vector_step = std::max(1u, (vector_count + sampled_vectors - 1) / sampled_vectors);
+    vector<NumberType> sample;
+    vector<INTEGER> digits, exceptions;
+    vector<std::pair<u32, std::pair<u8, u8>>> counts;
+    for (u32 vector_i = 0; vector_i < vector_count; vector_i += vector_step) {
+      const u32 offset = vector_i * ALP_VECTOR_SIZE;
+      takeSample(sample, src + offset, nullmap == nullptr ? nullptr : nullmap + offset,
+                 std::min(ALP_VECTOR_SIZE, tuple_count - offset), vector_sample_size);
+      const auto pair = findBestPair(sample, digits, exceptions);
+      auto it = std::find_if(counts.begin(), counts.end(),
+                             [&](const auto& count) { return count.second == pair; });
+      if (it == counts.end()) {
+        counts.push_back({1, pair});
+      } else {
+        it->first++;
+      }
+    }
+    // Stable, so that ties keep the pair of the earlier vector
+    std::stable_sort(counts.begin(), counts.end(),
+                     [](const auto& a, const auto& b) { return a.first > b.first; });
+    vector<std::pair<u8, u8>> candidates;
+    for (u32 i = 0; i < counts.size() && i < max_candidates; i++) {
+      candidates.push_back(counts[i].second);
+    }
+    return candidates;
+  }
+  // -------------------------------------------------------------------------------------
+  // The pair of every vector, the cheapest candidate on a small sample of it
+  static inline void findParameters(const NumberType* src,
+                                    const BITMAP* nullmap,
+                                    u32 tuple_count,
+                                    AlpVectorParameters* parameters) {
+    const auto candidates = findCandidates(src, nullmap, tuple_count);
+    vector<NumberType> sample;
+    vector<INTEGER> digits, exceptions;
+    for (u32 vector_i = 0; vector_i < AlpStructure::vectorCount(tuple_count); vector_i++) {
+      const u32 offset = vector_i * ALP_VECTOR_SIZE;
+      const u32 vector_tuple_count = std::min(ALP_VECTOR_SIZE, tuple_count - offset);
+      u32 best_i = 0;
+      if (candidates.size() > 1) {
+        takeSample(sample, src + offset, nullmap == nullptr ? nullptr : nullmap + offset,
+                   vector_tuple_count, vector_sample_size);
+        u64 best_cost = std::numeric_limits<u64>::max();
+        for (u32 candidate_i = 0; candidate_i < candidates.size(); candidate_i++) {
+          const u64 cost = estimateCost(sample, candidates[candidate_i].first,
+                                        candidates[candidate_i].second, digits, exceptions);
+          if (cost < best_cost) {
+            best_cost = cost;
+            best_i = candidate_i;
+          }
+        }
+      }
+      parameters[vector_i] = {candidates[best_i].first, candidates[best_i].second};
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  static inline u32 compressColumn(const NumberType* src,
+                                   const BITMAP* nullmap,
+                                   u8* dest,
+                                   StatsType& stats,
+                                   u8 allowed_cascading_level) {
+    auto& col_struct = *reinterpret_cast<AlpStructure*>(dest);
+    const u32 tuple_count = stats.tuple_count;
+    const u32 vector_count = AlpStructure::vectorCount(tuple_count);
+    auto parameters = col_struct.parameters();
+    findParameters(src, nullmap, tuple_count, parameters);
+    // -------------------------------------------------------------------------------------
+    // Encode every vector and collect the positions that fail the round trip
+    vector<INTEGER> digits_v(tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+    vector<INTEGER> positions_v(tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+    INTEGER* digits = digits_v.data();
+    INTEGER* positions = positions_v.data();
+    u32 candidates_count = 0;
+    for (u32 vector_i = 0; vector_i < vector_count; vector_i++) {
+      const u32 offset = vector_i * ALP_VECTOR_SIZE;
+      const u32 vector_candidates_count =
+          encode(digits + offset, positions + candidates_count, src + offset,
+                 std::min(ALP_VECTOR_SIZE, tuple_count - offset), parameters[vector_i].exponent,
+                 parameters[vector_i].factor);
+      for (u32 candidate_i = 0; candidate_i < vector_candidates_count; candidate_i++) {
+        positions[candidates_count++] += offset;
+      }
+    }
+    // -------------------------------------------------------------------------------------
+    // Null rows need no patch. Exceptions and null rows get the digits of an
+    // encodable value, so that they do not widen the bit packing.
+    INTEGER fill_digits = 0;
+    for (u32 i = 0, candidate_i = 0; i < tuple_count; i++) {
+      if (candidate_i < candidates_count && positions[candidate_i] == static_cast<INTEGER>(i)) {
+        candidate_i++;
+      } else if (nullmap == nullptr || nullmap[i]) {
+        fill_digits = digits[i];
+        break;
+      }
+    }
+    if (nullmap != nullptr) {
+      for (u32 i = 0; i < tuple_count; i++) {
+        if (!nullmap[i]) {
+          digits[i] = fill_digits;
+        }
+      }
+    }
+    vector<NumberType> exceptions_values;
+    u32 exceptions_count = 0;
+    for (u32 candidate_i = 0; candidate_i < candidates_count; candidate_i++) {
+      auto position = positions[candidate_i];
+      digits[position] = fill_digits;
+      if (nullmap != nullptr && !nullmap[position]) {
+        continue;
+      }
+      positions[exceptions_count++] = position;
+      exceptions_values.push_back(src[position]);
+    }
+    col_struct.exceptions_count = exceptions_count;
+    // -------------------------------------------------------------------------------------
+    // Keep the digits aligned behind the parameters
+    col_struct.digits_offset =
+        (vector_count * sizeof(AlpVectorParameters) + sizeof(u32) - 1) / sizeof(u32) * sizeof(u32);
+    auto write_ptr = col_struct.data + col_struct.digits_offset;
+    // Compress digits
+    {
+      u32 used_space;
+      IntegerSchemePicker::compress(digits, nullptr, write_ptr, tuple_count,
+                                    allowed_cascading_level - 1, used_space,
+                                    col_struct.digits_scheme, autoScheme(), "digits");
+      write_ptr += used_space;
+      Log::debug("ALP: d_c = {} d_s = {}", CI(col_struct.digits_scheme), CI(used_space));
+    }
+    // -------------------------------------------------------------------------------------
+    // Compress exceptions
+    col_struct.exceptions_positions_offset = write_ptr - col_struct.data;
+    if (exceptions_count > 0) {
+      u32 used_space;
+      IntegerSchemePicker::compress(positions, nullptr, write_ptr, exceptions_count,
+                                    allowed_cascading_level - 1, used_space,
+                                    col_struct.positions_scheme, autoScheme(),
+                                    "exceptions_positions");
+      write_ptr += used_space;
+      // -------------------------------------------------------------------------------------
+      col_struct.exceptions_values_offset = write_ptr - col_struct.data;
+      ValuesPicker::compress(exceptions_values.data(), nullptr, write_ptr, exceptions_count,
+                             allowed_cascading_level - 1, used_space, col_struct.values_scheme,
+                             autoScheme(), "exceptions_values");
+      write_ptr += used_space;
+      Log::debug("ALP: exceptions = {} p_c = {} v_c = {}", exceptions_count,
+                 CI(col_struct.positions_scheme), CI(col_struct.values_scheme));
+    } else {
+      col_struct.exceptions_values_offset = col_struct.exceptions_positions_offset;
+      col_struct.positions_scheme = CB(IntegerSchemeType::UNCOMPRESSED);
+      col_struct.values_scheme = CB(SchemeCodeType::UNCOMPRESSED);
+    }
+    // -------------------------------------------------------------------------------------
+    return write_ptr - dest;
+  }
+  // -------------------------------------------------------------------------------------
+  static inline void decompressColumn(NumberType* dest,
+                                      BitmapWrapper*,
+                                      const u8* src,
+                                      u32 tuple_count,
+                                      u32 level) {
+    const auto& col_struct = *reinterpret_cast<const AlpStructure*>(src);
+    // -------------------------------------------------------------------------------------
+    thread_local std::vector<std::vector<INTEGER>> digits_v;
+    auto digits = get_level_data(digits_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.digits_scheme)
+        .decompress(digits, nullptr, col_struct.data + col_struct.digits_offset, tuple_count,
+                    level + 1);
+    const auto parameters = col_struct.parameters();
+    for (u32 vector_i = 0; vector_i < AlpStructure::vectorCount(tuple_count); vector_i++) {
+      const u32 offset = vector_i * ALP_VECTOR_SIZE;
+      Kernels::alpDecode(dest + offset, digits + offset,
+                         std::min(ALP_VECTOR_SIZE, tuple_count - offset),
+                         Traits::exact_powers_of_ten[parameters[vector_i].factor],
+                         Traits::exact_powers_of_ten[parameters[vector_i].exponent]);
+    }
+    // -------------------------------------------------------------------------------------
+    // Patch the exceptions
+    if (col_struct.exceptions_count > 0) {
+      thread_local std::vector<std::vector<INTEGER>> positions_v;
+      auto positions = get_level_data(
+          positions_v, col_struct.exceptions_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.positions_scheme)
+          .decompress(positions, nullptr,
+                      col_struct.data + col_struct.exceptions_positions_offset,
+                      col_struct.exceptions_count, level + 1);
+      thread_local std::vector<std::vector<NumberType>> values_v;
+      auto values = get_level_data(
+          values_v, col_struct.exceptions_count + SIMD_EXTRA_ELEMENTS(NumberType), level);
+      ValuesPicker::MyTypeWrapper::getScheme(col_struct.values_scheme)
+          .decompress(values, nullptr, col_struct.data + col_struct.exceptions_values_offset,
+                      col_struct.exceptions_count, level + 1);
+      for (u32 exception_i = 0; exception_i < col_struct.exceptions_count; exception_i++) {
+        dest[positions[exception_i]] = values[exception_i];
+      }
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  static inline string fullDescription(const u8* src, const string& selfDescription) {
+    const auto& col_struct = *reinterpret_cast<const AlpStructure*>(src);
+    auto& digits_scheme = IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.digits_scheme);
+    // The pair of the first vector, the tuple count of the others is unknown here
+    const auto& parameters = col_struct.parameters()[0];
+    string result = selfDescription + " (e=" + std::to_string(parameters.exponent) +
+                    ", f=" + std::to_string(parameters.factor) + ", first vector)";
+    result += "\n\t-> ([int] digits) " +
+              digits_scheme.fullDescription(col_struct.data + col_struct.digits_offset);
+    if (col_struct.exceptions_count > 0) {
+      auto& positions_scheme =
+          IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.positions_scheme);
+      result += "\n\t-> ([int] exceptions positions) " +
+                positions_scheme.fullDescription(col_struct.data +
+                                                 col_struct.exceptions_positions_offset);
+      auto& values_scheme = ValuesPicker::MyTypeWrapper::getScheme(col_struct.values_scheme);
+      result += "\n\t-> ([" + string(Traits::name) + "] exceptions values) " +
+                values_scheme.fullDescription(col_struct.data +
+                                              col_struct.exceptions_values_offset);
+    }
+    return result;
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
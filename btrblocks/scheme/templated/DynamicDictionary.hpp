@@ -1,63 +1,106 @@
 #pragma once
+#include "common/Hash.hpp"
+#include "common/Kernels.hpp"
 #include "common/Utils.hpp"
 #include "compression/SchemePicker.hpp"
 #include "scheme/CompressionScheme.hpp"
+#include "scheme/GlobalDictionary.hpp"
+#include "scheme/SchemeConfig.hpp"
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
 struct __attribute__((packed)) DynamicDictionaryStructure {
+  // Bit of codes_offset: no local dictionary in front of the codes, they index
+  // the part's GlobalDictionary. Chunks written before never have it set, their
+  // offsets stay far below it.
+  static constexpr u32 GLOBAL_DICTIONARY = 1u << 31;
   u8 codes_scheme_code;
   u32 codes_offset;
   u8 data[];
+
+  [[nodiscard]] inline bool globalDictionary() const { return codes_offset & GLOBAL_DICTIONARY; }
+  // The local dictionary ends where the codes begin
+  [[nodiscard]] inline u32 codesOffset() const { return codes_offset & ~GLOBAL_DICTIONARY; }
 };
 // -------------------------------------------------------------------------------------
-// Used for integer and doubles
+// Used for integers, bigints, doubles and floats
 template <typename NumberType, typename SchemeType, typename StatsType, typename SchemeCodeType>
 class TDynamicDictionary {
  public:
   // -------------------------------------------------------------------------------------
-  static inline double expectedCompressionRatio(StatsType& stats, u8 allowed_cascading_level) {
+  // The part's dictionary if it holds all values of the chunk. Only the column's
+  // own values at the top level get the part, nested DICTs (e.g. over RLE run
+  // lengths) would only match it by coincidence.
+  static inline const GlobalDictionary* globalDictionary(StatsType& stats,
+                                                         const PartEncoding& part) {
+    return GlobalDictionary::covering<NumberType>(part.global_dictionary, stats.distinct_values);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline double expectedCompressionRatio(StatsType& stats,
+                                                u8 allowed_cascading_level,
+                                                const PartEncoding& part) {
     if (allowed_cascading_level <= 1) {
       return 0;
     }
-    u32 after_size = ((stats.unique_count * sizeof(NumberType)) +
-                      (stats.tuple_count * (Utils::getBitsNeeded(stats.unique_count) / 8.0)));
+    u32 after_size;
+    u32 dictionary_bytes = 0;
+    if (auto global = globalDictionary(stats, part)) {
+      // The dictionary is stored once per part, only the codes count
+      after_size = stats.tuple_count * (Utils::getBitsNeeded(global->size()) / 8.0);
+    } else {
+      dictionary_bytes = stats.unique_count * sizeof(NumberType);
+      after_size = (dictionary_bytes +
+                    (stats.tuple_count * (Utils::getBitsNeeded(stats.unique_count) / 8.0)));
+    }
     after_size += sizeof(DynamicDictionaryStructure) + 5;  // 5 for PBP header
     after_size += (stats.tuple_count) * 2 / 128;  // TODO: find out the overhead of FastPFOR
-    return CD(stats.total_size) / CD(after_size);
+    double ratio = CD(stats.total_size) / CD(after_size);
+    // Wide-domain dictionaries decode with a cache miss per lookup
+    auto& cfg = SchemeConfig::get();
+    if (dictionary_bytes > cfg.large_dictionary_bytes) {
+      ratio *= (100 - std::min(cfg.large_dictionary_penalty_pct, 100u)) / 100.0;
+    }
+    return ratio;
   }
   // -------------------------------------------------------------------------------------
   static inline u32 compressColumn(const NumberType* src,
                                    const BITMAP*,
                                    u8* dest,
                                    StatsType& stats,
-                                   u8 allowed_cascading_level) {
-    // Layout: DICT | CODES
+                                   u8 allowed_cascading_level,
+                                   const PartEncoding& part) {
+    // Layout: DICT | CODES, or only CODES with a global dictionary
     auto& col_struct = *reinterpret_cast<DynamicDictionaryStructure*>(dest);
-    // -------------------------------------------------------------------------------------
-    // Write dictionary
-    auto dict_slots = reinterpret_cast<NumberType*>(col_struct.data);
-    u32 distinct_i = 0;
-    for (const auto& distinct_element : stats.distinct_values) {
-      dict_slots[distinct_i] = distinct_element.first;
-      distinct_i++;
-    }
-    // -------------------------------------------------------------------------------------
     auto dict_begin = reinterpret_cast<NumberType*>(col_struct.data);
-    auto dict_end = reinterpret_cast<NumberType*>(col_struct.data) + distinct_i;
-    // -------------------------------------------------------------------------------------
+    auto dict_end = dict_begin;
     vector<INTEGER> codes;
-    for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
-      auto it = std::lower_bound(dict_begin, dict_end, src[row_i]);
-      if (it == dict_end) {
-        die_if(stats.distinct_values.find(src[row_i]) != stats.distinct_values.end());
+    // -------------------------------------------------------------------------------------
+    auto global = globalDictionary(stats, part);
+    if (global != nullptr) {
+      for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
+        codes.push_back(global->find(src[row_i]));
+      }
+    } else {
+      // Write dictionary
+      for (const auto& distinct_element : stats.distinct_values) {
+        *dict_end++ = distinct_element.first;
+      }
+      // -------------------------------------------------------------------------------------
+      for (u32 row_i = 0; row_i < stats.tuple_count; row_i++) {
+        auto it = std::lower_bound(dict_begin, dict_end, src[row_i]);
+        if (it == dict_end) {
+          die_if(stats.distinct_values.find(src[row_i]) != stats.distinct_values.end());
+        }
+        die_if(it != dict_end);
+        codes.push_back(std::distance(dict_begin, it));
       }
-      die_if(it != dict_end);
-      codes.push_back(std::distance(dict_begin, it));
     }
     // -------------------------------------------------------------------------------------
     // Compress codes
     auto write_ptr = reinterpret_cast<u8*>(dict_end);
     col_struct.codes_offset = write_ptr - col_struct.data;
+    if (global != nullptr) {
+      col_struct.codes_offset |= DynamicDictionaryStructure::GLOBAL_DICTIONARY;
+    }
     u32 used_space;
     // For Number dictionaries, we only need FBP/PBP for coding, if any other
     // schemes was useful beneath, it had to be rather chosen instead of X_DICT
@@ -66,8 +109,8 @@ class TDynamicDictionary {
                                   allowed_cascading_level - 1, used_space,
                                   col_struct.codes_scheme_code, CB(IntegerSchemeType::BP), "codes");
     // -------------------------------------------------------------------------------------
-    Log::debug("X_DICT: codes_c = {} codes_s = {}", CI(col_struct.codes_scheme_code),
-               CI(used_space));
+    Log::debug("X_DICT: global = {} codes_c = {} codes_s = {}", CI(col_struct.globalDictionary()),
+               CI(col_struct.codes_scheme_code), CI(used_space));
     // -------------------------------------------------------------------------------------
     write_ptr += used_space;
     // -------------------------------------------------------------------------------------
@@ -78,7 +121,95 @@ class TDynamicDictionary {
                                       BitmapWrapper*,
                                       const u8* src,
                                       u32 tuple_count,
-                                      u32 level) {
+                                      u32 level,
+                                      const PartData& part) {
+    auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+    // -------------------------------------------------------------------------------------
+    // Decode codes
+    thread_local std::vector<std::vector<INTEGER>> codes_v;
+    auto codes = get_level_data(codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerScheme& scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
+    scheme.decompress(codes, nullptr, col_struct.data + col_struct.codesOffset(), tuple_count,
+                      level + 1);
+    // -------------------------------------------------------------------------------------
+    Kernels::gather(dest, dictionaryValues(col_struct, part), dictionarySize(src, part), codes,
+                    tuple_count);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline const NumberType* dictionaryValues(const DynamicDictionaryStructure& col_struct,
+                                                   const PartData& part) {
+    if (col_struct.globalDictionary()) {
+      auto& dict_struct = GlobalDictionary::part(part.global_dictionary,
+                                                 GlobalDictionary::physicalType<NumberType>());
+      return reinterpret_cast<const NumberType*>(dict_struct.data);
+    }
+    return reinterpret_cast<const NumberType*>(col_struct.data);
+  }
+  static inline u32 dictionarySize(const u8* src, const PartData& part) {
+    auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+    if (col_struct.globalDictionary()) {
+      auto& dict_struct = GlobalDictionary::part(part.global_dictionary,
+                                                 GlobalDictionary::physicalType<NumberType>());
+      return dict_struct.count;
+    }
+    return col_struct.codesOffset() / sizeof(NumberType);
+  }
+  static inline bool usesGlobalDictionary(const u8* src) {
+    return reinterpret_cast<const DynamicDictionaryStructure*>(src)->globalDictionary();
+  }
+  // -------------------------------------------------------------------------------------
+  // Late materialization: output the dictionary and the codes instead of the values
+  static inline u32 decompressCodes(NumberType* dictionary,
+                                    INTEGER* codes,
+                                    BitmapWrapper*,
+                                    const u8* src,
+                                    u32 tuple_count,
+                                    u32 level,
+                                    const PartData& part) {
+    auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+    IntegerScheme& scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
+    scheme.decompress(codes, nullptr, col_struct.data + col_struct.codesOffset(), tuple_count,
+                      level + 1);
+    u32 dict_count = dictionarySize(src, part);
+    std::memcpy(dictionary, dictionaryValues(col_struct, part), dict_count * sizeof(NumberType));
+    return dict_count;
+  }
+  // -------------------------------------------------------------------------------------
+  static inline void hashColumn(u64* dest,
+                                BitmapWrapper*,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level,
+                                const PartData& part) {
+    auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
+    // -------------------------------------------------------------------------------------
+    // Decode codes
+    thread_local std::vector<std::vector<INTEGER>> codes_v;
+    auto codes = get_level_data(codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    IntegerScheme& scheme =
+        IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
+    scheme.decompress(codes, nullptr, col_struct.data + col_struct.codesOffset(), tuple_count,
+                      level + 1);
+    // -------------------------------------------------------------------------------------
+    // Hash every dictionary entry once
+    u32 dict_count = dictionarySize(src, part);
+    thread_local std::vector<std::vector<u64>> dict_hashes_v;
+    auto dict_hashes = get_level_data(dict_hashes_v, dict_count, level);
+    Hash::hashColumn(dict_hashes, dictionaryValues(col_struct, part), dict_count);
+    Hash::gather(dest, dict_hashes, dict_count, codes, tuple_count);
+  }
+  // -------------------------------------------------------------------------------------
+  // Integer dictionaries decoded straight into SMALLINT/TINYINT output
+  template <typename NarrowType>
+  static inline void decompressColumnNarrow(NarrowType* dest,
+                                            BitmapWrapper*,
+                                            const u8* src,
+                                            u32 tuple_count,
+                                            u32 level,
+                                            const PartData& part) {
+    static_assert(std::is_same_v<NumberType, INTEGER>);
     auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
     // -------------------------------------------------------------------------------------
     // Decode codes
@@ -86,10 +217,14 @@ class TDynamicDictionary {
     auto codes = get_level_data(codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
     IntegerScheme& scheme =
         IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
-    scheme.decompress(codes, nullptr, col_struct.data + col_struct.codes_offset, tuple_count,
+    scheme.decompress(codes, nullptr, col_struct.data + col_struct.codesOffset(), tuple_count,
                       level + 1);
     // -------------------------------------------------------------------------------------
-    auto dict = reinterpret_cast<const NumberType*>(col_struct.data);
+    // Narrow the dictionary once, the lookups then hit a 2-4x smaller table
+    u32 dict_count = dictionarySize(src, part);
+    thread_local std::vector<std::vector<NarrowType>> dict_v;
+    auto dict = get_level_data(dict_v, dict_count + SIMD_EXTRA_ELEMENTS(NarrowType), level);
+    Utils::narrowIntegers(dict, dictionaryValues(col_struct, part), dict_count);
     for (u32 i = 0; i < tuple_count; i++) {
       dest[i] = dict[codes[i]];
     }
@@ -100,118 +235,7 @@ class TDynamicDictionary {
     IntegerScheme& scheme =
         IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
     return selfDescription + " -> ([int] codes) " +
-           scheme.fullDescription(col_struct.data + col_struct.codes_offset);
+           scheme.fullDescription(col_struct.data + col_struct.codesOffset());
   }
 };
-
-template <>
-inline void TDynamicDictionary<INTEGER, IntegerScheme, SInteger32Stats, IntegerSchemeType>::
-    decompressColumn(INTEGER* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32 level) {
-  BTR_IFSIMD({
-    static_assert(sizeof(*dest) == 4);
-    static_assert(SIMD_EXTRA_BYTES >= 4 * sizeof(__m256i));
-  })
-
-  auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
-
-  // Decode codes
-  thread_local std::vector<std::vector<INTEGER>> codes_v;
-  auto codes = get_level_data(codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
-  IntegerScheme& scheme =
-      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
-  scheme.decompress(codes, nullptr, col_struct.data + col_struct.codes_offset, tuple_count,
-                    level + 1);
-
-  auto dict = reinterpret_cast<const INTEGER*>(col_struct.data);
-  u32 i = 0;
-#ifdef BTR_USE_SIMD
-  if (tuple_count >= 32) {
-    while (i < tuple_count - 31) {
-      // Load codes.
-      __m256i codes_0 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(codes + 0));
-      __m256i codes_1 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(codes + 8));
-      __m256i codes_2 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(codes + 16));
-      __m256i codes_3 = _mm256_loadu_si256(reinterpret_cast<__m256i*>(codes + 24));
-
-      // Gather values.
-      __m256i values_0 = _mm256_i32gather_epi32(dict, codes_0, 4);
-      __m256i values_1 = _mm256_i32gather_epi32(dict, codes_1, 4);
-      __m256i values_2 = _mm256_i32gather_epi32(dict, codes_2, 4);
-      __m256i values_3 = _mm256_i32gather_epi32(dict, codes_3, 4);
-
-      // store values
-      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + 0), values_0);
-      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + 8), values_1);
-      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + 16), values_2);
-      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + 24), values_3);
-
-      dest += 32;
-      codes += 32;
-      i += 32;
-    }
-  }
-#endif
-
-  while (i < tuple_count) {
-    *dest++ = dict[*codes++];
-    i++;
-  }
-}
-
-template <>
-inline void TDynamicDictionary<DOUBLE, DoubleScheme, DoubleStats, DoubleSchemeType>::
-    decompressColumn(DOUBLE* dest, BitmapWrapper*, const u8* src, u32 tuple_count, u32 level) {
-  BTR_IFSIMD({
-    static_assert(sizeof(*dest) == 8);
-    static_assert(SIMD_EXTRA_BYTES >= 4 * sizeof(__m256d));
-  })
-
-  auto& col_struct = *reinterpret_cast<const DynamicDictionaryStructure*>(src);
-
-  // Decode codes
-  thread_local std::vector<std::vector<INTEGER>> codes_v;
-  auto codes = get_level_data(codes_v, tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
-  IntegerScheme& scheme =
-      IntegerSchemePicker::MyTypeWrapper::getScheme(col_struct.codes_scheme_code);
-  scheme.decompress(codes, nullptr, col_struct.data + col_struct.codes_offset, tuple_count,
-                    level + 1);
-
-  auto dict = reinterpret_cast<const DOUBLE*>(col_struct.data);
-  u32 i = 0;
-#ifdef BTR_USE_SIMD
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wuninitialized"
-  if (tuple_count >= 16) {
-    while (i < tuple_count - 15) {
-      // Load codes
-      __m128i codes_0 = _mm_loadu_si128(reinterpret_cast<__m128i*>(codes + 0));
-      __m128i codes_1 = _mm_loadu_si128(reinterpret_cast<__m128i*>(codes + 4));
-      __m128i codes_2 = _mm_loadu_si128(reinterpret_cast<__m128i*>(codes + 8));
-      __m128i codes_3 = _mm_loadu_si128(reinterpret_cast<__m128i*>(codes + 12));
-
-      // gather values
-      __m256d values_0 = _mm256_i32gather_pd(dict, codes_0, 8);
-      __m256d values_1 = _mm256_i32gather_pd(dict, codes_1, 8);
-      __m256d values_2 = _mm256_i32gather_pd(dict, codes_2, 8);
-      __m256d values_3 = _mm256_i32gather_pd(dict, codes_3, 8);
-
-      // store values
-      _mm256_storeu_pd(dest + 0, values_0);
-      _mm256_storeu_pd(dest + 4, values_1);
-      _mm256_storeu_pd(dest + 8, values_2);
-      _mm256_storeu_pd(dest + 12, values_3);
-
-      dest += 16;
-      codes += 16;
-      i += 16;
-    }
-  }
-#pragma GCC diagnostic pop
-#endif
-
-  while (i < tuple_count) {
-    *dest++ = dict[*codes++];
-    i++;
-  }
-}
 }  // namespace btrblocks
@@ -4,6 +4,7 @@
 // ------------------------------------------------------------------------------
 #include "compression/SchemePicker.hpp"
 #include "scheme/CompressionScheme.hpp"
+#include "scheme/templated/Patches.hpp"
 // -------------------------------------------------------------------------------------
 #include "roaring/roaring.hh"
 // -------------------------------------------------------------------------------------
@@ -103,8 +104,7 @@ class TFrequency {
                                       u32 level) {
     const auto& col_struct = *reinterpret_cast<const FrequencyStructure<NumberType>*>(src);
     // -------------------------------------------------------------------------------------
-    Roaring exceptions_bitmap =
-        Roaring::read(reinterpret_cast<const char*>(col_struct.data), false);
+    const bitmap::RoaringView exceptions_bitmap(col_struct.data);
     thread_local std::vector<std::vector<NumberType>> exceptions_v;
     auto exceptions = get_level_data(
         exceptions_v, exceptions_bitmap.cardinality() + SIMD_EXTRA_ELEMENTS(NumberType), level);
@@ -115,32 +115,15 @@ class TFrequency {
                       exceptions_bitmap.cardinality(), level + 1);
     }
     // -------------------------------------------------------------------------------------
-    // First write the top value to every single entry
-    for (u32 i = 0; i < tuple_count; i++) {
-      dest[i] = col_struct.top_value;
-    }
-
-    // Now fix every single entry that is an exception
-    std::pair<NumberType*, NumberType*> param = {dest, exceptions};
-    exceptions_bitmap.iterate(
-        [](uint32_t value, void* param) {
-          // TODO are the values actually being sorted here??? If not this won't
-          // work.
-          auto p = reinterpret_cast<std::pair<NumberType*, NumberType*>*>(param);
-          // dest[value] = *exceptions_ptr++;
-          p->first[value] = *(p->second);
-          p->second++;
-          return true;
-        },
-        &param);
+    Patches::fill(dest, col_struct.top_value, tuple_count);
+    Patches::apply(dest, exceptions_bitmap, exceptions);
   }
   // -------------------------------------------------------------------------------------
   static inline string fullDescription(const u8* src, const string& selfDescription) {
     const auto& col_struct = *reinterpret_cast<const FrequencyStructure<NumberType>*>(src);
     auto result = selfDescription;
 
-    Roaring exceptions_bitmap =
-        Roaring::read(reinterpret_cast<const char*>(col_struct.data), false);
+    const bitmap::RoaringView exceptions_bitmap(col_struct.data);
     if (exceptions_bitmap.cardinality() > 0) {
       auto& scheme =
           CSchemePicker<NumberType, SchemeType, StatsType,
@@ -0,0 +1,50 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+// -------------------------------------------------------------------------------------
+#include "common/Hash.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Chunks with a single distinct value store just that value. Null rows are
+// decompressed as the value too, an all-null chunk (src == nullptr) stores 0.
+// -------------------------------------------------------------------------------------
+template <typename NumberType, typename StatsType>
+class TOneValue {
+ public:
+  struct Structure {
+    NumberType one_value;
+  };
+  // -------------------------------------------------------------------------------------
+  static inline double expectedCompressionRatio(const StatsType& stats) {
+    if (stats.distinct_values.size() <= 1) {
+      return stats.tuple_count;
+    } else {
+      return 0;
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  static inline u32 compressColumn(const NumberType* src, u8* dest, const StatsType& stats) {
+    auto& col_struct = *reinterpret_cast<Structure*>(dest);
+    if (src != nullptr) {
+      col_struct.one_value = stats.distinct_values.begin()->first;
+    } else {
+      col_struct.one_value = NULL_CODE;
+    }
+    return sizeof(NumberType);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline void decompressColumn(NumberType* dest, const u8* src, u32 tuple_count) {
+    const auto& col_struct = *reinterpret_cast<const Structure*>(src);
+    std::fill_n(dest, tuple_count, col_struct.one_value);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline void hashColumn(u64* dest, const u8* src, u32 tuple_count) {
+    const auto& col_struct = *reinterpret_cast<const Structure*>(src);
+    std::fill_n(dest, tuple_count, Hash::hashValue(col_struct.one_value));
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -0,0 +1,101 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include <cstring>
+#include <numeric>
+// -------------------------------------------------------------------------------------
+#include "common/SIMD.hpp"
+#include "common/Units.hpp"
+#include "extern/RoaringBitmap.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Exception patching for the schemes that keep the positions of their
+// exceptions in a roaring bitmap (Frequency: the rows that are not the top
+// value, Pseudodecimal: the blocks that contain a patch). The serialized
+// bitmap is decoded in place container by container (bitmap::RoaringView),
+// runs of positions are patched with a single copy.
+// -------------------------------------------------------------------------------------
+class Patches {
+ public:
+  // Writes value to dest[0, n)
+  template <typename T>
+  static inline void fill(T* dest, T value, u32 n) {
+    static_assert(sizeof(T) == 4 || sizeof(T) == 8);
+    u32 i = 0;
+#ifdef BTR_USE_SIMD
+    __m256i vec;
+    if constexpr (sizeof(T) == 4) {
+      u32 bits;
+      std::memcpy(&bits, &value, sizeof(T));
+      vec = _mm256_set1_epi32(bits);
+    } else {
+      u64 bits;
+      std::memcpy(&bits, &value, sizeof(T));
+      vec = _mm256_set1_epi64x(bits);
+    }
+    constexpr u32 per_store = sizeof(__m256i) / sizeof(T);
+    for (; i + 4 * per_store <= n; i += 4 * per_store) {
+      auto write_ptr = reinterpret_cast<__m256i*>(dest + i);
+      _mm256_storeu_si256(write_ptr + 0, vec);
+      _mm256_storeu_si256(write_ptr + 1, vec);
+      _mm256_storeu_si256(write_ptr + 2, vec);
+      _mm256_storeu_si256(write_ptr + 3, vec);
+    }
+    for (; i + per_store <= n; i += per_store) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), vec);
+    }
+#endif
+    for (; i < n; i++) {
+      dest[i] = value;
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // Calls fn(position, k) for the k-th set bit of count words from src
+  template <typename Function>
+  static inline void forEachBit(const u8* src, u32 first_word, u32 count, u32& k, Function fn) {
+    for (u32 word_i = 0; word_i < count; word_i++) {
+      u64 word;
+      std::memcpy(&word, src + word_i * sizeof(u64), sizeof(u64));
+      while (word != 0) {
+        fn((first_word + word_i) * 64 + __builtin_ctzll(word), k++);
+        word &= word - 1;
+      }
+    }
+  }
+  // -------------------------------------------------------------------------------------
+  // All positions of bitmap in ascending order. The buffer belongs to the
+  // cascade level and is valid until the next call on that level.
+  static inline const u32* positions(const bitmap::RoaringView& bitmap, u32 level) {
+    thread_local std::vector<std::vector<u32>> positions_v;
+    auto positions = get_level_data(positions_v, bitmap.cardinality(), level);
+    u32 k = 0;
+    bitmap.decode(
+        [&](u32 begin, u32 end) {
+          std::iota(positions + k, positions + k + (end - begin), begin);
+          k += end - begin;
+        },
+        [&](u32 first_word, const u8* words, u32 count) {
+          forEachBit(words, first_word, count, k,
+                     [&](u32 position, u32 i) { positions[i] = position; });
+        });
+    return positions;
+  }
+  // -------------------------------------------------------------------------------------
+  // dest[k-th position of bitmap] = values[k]
+  template <typename T>
+  static inline void apply(T* dest, const bitmap::RoaringView& bitmap, const T* values) {
+    u32 k = 0;
+    bitmap.decode(
+        [&](u32 begin, u32 end) {
+          std::memcpy(dest + begin, values + k, (end - begin) * sizeof(T));
+          k += end - begin;
+        },
+        [&](u32 first_word, const u8* words, u32 count) {
+          forEachBit(words, first_word, count, k,
+                     [&](u32 position, u32 i) { dest[position] = values[i]; });
+        });
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -1,4 +1,6 @@
 #pragma once
+#include "common/Hash.hpp"
+#include "common/Kernels.hpp"
 #include "compression/SchemePicker.hpp"
 #include "scheme/CompressionScheme.hpp"
 // -------------------------------------------------------------------------------------
@@ -101,13 +103,27 @@ class TRLE {
   }
   // -------------------------------------------------------------------------------------
   static inline void decompressColumn(NumberType* dest,
-                                      BitmapWrapper*,
+                                      BitmapWrapper* nullmap,
                                       const u8* src,
                                       u32 tuple_count,
                                       u32 level) {
-    throw Generic_Exception("Unsupported templated specialization");
+    const auto& col_struct = *reinterpret_cast<const RLEStructure*>(src);
+    // -------------------------------------------------------------------------------------
+    thread_local std::vector<std::vector<NumberType>> values_v;
+    auto values =
+        get_level_data(values_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(NumberType), level);
+    thread_local std::vector<std::vector<INTEGER>> counts_v;
+    auto counts =
+        get_level_data(counts_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    u32 runs_count = decompressRuns(values, counts, nullmap, src, tuple_count, level);
+    // -------------------------------------------------------------------------------------
+    Kernels::expandRuns(dest, values, counts, runs_count);
   }
 
+  static inline u32 runsCount(const u8* src) {
+    return reinterpret_cast<const RLEStructure*>(src)->runs_count;
+  }
+  // -------------------------------------------------------------------------------------
   static inline u32 decompressRuns(NumberType* values,
                                    INTEGER* counts,
                                    BitmapWrapper*,
@@ -127,125 +143,49 @@ class TRLE {
     return col_struct.runs_count;
   }
   // -------------------------------------------------------------------------------------
-};
-
-template <>
-inline void TRLE<INTEGER, IntegerScheme, SInteger32Stats, IntegerSchemeType>::decompressColumn(
-    INTEGER* dest,
-    BitmapWrapper*,
-    const u8* src,
-    u32 tuple_count,
-    u32 level) {
-  static_assert(sizeof(*dest) == 4);
-
-  const auto& col_struct = *reinterpret_cast<const RLEStructure*>(src);
-  // -------------------------------------------------------------------------------------
-  // Decompress values
-  thread_local std::vector<std::vector<INTEGER>> values_v;
-  auto values =
-      get_level_data(values_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
-  {
-    IntegerScheme& scheme =
-        TypeWrapper<IntegerScheme, IntegerSchemeType>::getScheme(col_struct.values_scheme_code);
-    scheme.decompress(values, nullptr, col_struct.data, col_struct.runs_count, level + 1);
-  }
-  // -------------------------------------------------------------------------------------
-  // Decompress counts
-  thread_local std::vector<std::vector<INTEGER>> counts_v;
-  auto counts =
-      get_level_data(counts_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
-  {
-    IntegerScheme& scheme =
-        TypeWrapper<IntegerScheme, IntegerSchemeType>::getScheme(col_struct.counts_scheme_code);
-    scheme.decompress(counts, nullptr, col_struct.data + col_struct.runs_count_offset,
-                      col_struct.runs_count, level + 1);
-  }
-  // -------------------------------------------------------------------------------------
-  auto write_ptr = dest;
-#ifdef BTR_USE_SIMD
-  for (u32 run_i = 0; run_i < col_struct.runs_count; run_i++) {
-    auto target_ptr = write_ptr + counts[run_i];
-
-    /*
-     * I tried several variation for vectorizing this. Using AVX2 directly is
-     * the fastest even when there are many very short runs. The penalty of
-     * branching simply outweighs the few instructions saved by not using AVX2
-     * for short runs
-     */
-    // set is a sequential operation
-    __m256i vec = _mm256_set1_epi32(values[run_i]);
-    while (write_ptr < target_ptr) {
-      // store is performed in a single cycle
-      _mm256_storeu_si256(reinterpret_cast<__m256i*>(write_ptr), vec);
-      write_ptr += 8;
-    }
-    write_ptr = target_ptr;
-  }
-#else
-  for (u32 run_i = 0; run_i < col_struct.runs_count; run_i++) {
-    auto val = values[run_i];
-    auto target_ptr = write_ptr + counts[run_i];
-    while (write_ptr != target_ptr) {
-      *write_ptr++ = val;
-    }
-  }
-#endif
-}
-
-template <>
-inline void TRLE<DOUBLE, DoubleScheme, DoubleStats, DoubleSchemeType>::decompressColumn(
-    DOUBLE* dest,
-    BitmapWrapper*,
-    const u8* src,
-    u32 tuple_count,
-    u32 level) {
-  static_assert(sizeof(*dest) == 8);
-
-  const auto& col_struct = *reinterpret_cast<const RLEStructure*>(src);
-  // -------------------------------------------------------------------------------------
-  // Decompress values
-  thread_local std::vector<std::vector<DOUBLE>> values_v;
-  auto values =
-      get_level_data(values_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(DOUBLE), level);
-  {
-    DoubleScheme& scheme =
-        TypeWrapper<DoubleScheme, DoubleSchemeType>::getScheme(col_struct.values_scheme_code);
-    scheme.decompress(values, nullptr, col_struct.data, col_struct.runs_count, level + 1);
+  static inline void hashColumn(u64* dest,
+                                BitmapWrapper* nullmap,
+                                const u8* src,
+                                u32 tuple_count,
+                                u32 level) {
+    const auto& col_struct = *reinterpret_cast<const RLEStructure*>(src);
+    // -------------------------------------------------------------------------------------
+    thread_local std::vector<std::vector<NumberType>> values_v;
+    auto values =
+        get_level_data(values_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(NumberType), level);
+    thread_local std::vector<std::vector<INTEGER>> counts_v;
+    auto counts =
+        get_level_data(counts_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    u32 runs_count = decompressRuns(values, counts, nullmap, src, tuple_count, level);
+    // -------------------------------------------------------------------------------------
+    // One hash per run
+    thread_local std::vector<std::vector<u64>> hashes_v;
+    auto hashes = get_level_data(hashes_v, runs_count, level);
+    Hash::hashColumn(hashes, values, runs_count);
+    Hash::expandRuns(dest, hashes, counts, runs_count);
   }
   // -------------------------------------------------------------------------------------
-  // Decompress counts
-  thread_local std::vector<std::vector<INTEGER>> counts_v;
-  auto counts =
-      get_level_data(counts_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
-  {
-    IntegerScheme& scheme =
-        TypeWrapper<IntegerScheme, IntegerSchemeType>::getScheme(col_struct.counts_scheme_code);
-    scheme.decompress(counts, nullptr, col_struct.data + col_struct.runs_count_offset,
-                      col_struct.runs_count, level + 1);
+  // Expands integer runs straight into SMALLINT/TINYINT output
+  template <typename NarrowType>
+  static inline void decompressColumnNarrow(NarrowType* dest,
+                                            BitmapWrapper* nullmap,
+                                            const u8* src,
+                                            u32 tuple_count,
+                                            u32 level) {
+    static_assert(std::is_same_v<NumberType, INTEGER>);
+    static_assert(sizeof(NarrowType) == 1 || sizeof(NarrowType) == 2);
+    const auto& col_struct = *reinterpret_cast<const RLEStructure*>(src);
+    // -------------------------------------------------------------------------------------
+    thread_local std::vector<std::vector<INTEGER>> values_v;
+    auto values =
+        get_level_data(values_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    thread_local std::vector<std::vector<INTEGER>> counts_v;
+    auto counts =
+        get_level_data(counts_v, col_struct.runs_count + SIMD_EXTRA_ELEMENTS(INTEGER), level);
+    u32 runs_count = decompressRuns(values, counts, nullmap, src, tuple_count, level);
+    // -------------------------------------------------------------------------------------
+    Kernels::expandRunsNarrow(dest, values, counts, runs_count);
   }
   // -------------------------------------------------------------------------------------
-  auto write_ptr = dest;
-#ifdef BTR_USE_SIMD
-  for (u32 run_i = 0; run_i < col_struct.runs_count; run_i++) {
-    auto target_ptr = write_ptr + counts[run_i];
-
-    // set is a sequential operation
-    __m256d vec = _mm256_set1_pd(values[run_i]);
-    while (write_ptr < target_ptr) {
-      // store is performed in a single cycle
-      _mm256_storeu_pd(write_ptr, vec);
-      write_ptr += 4;
-    }
-    write_ptr = target_ptr;
-  }
-#else
-  for (u32 run_i = 0; run_i < col_struct.runs_count; run_i++) {
-    auto val = values[run_i];
-    auto target_ptr = write_ptr + counts[run_i];
-    while (write_ptr != target_ptr) {
-      *write_ptr++ = val;
-    }
-  }
-#endif
-}
+};
 }  // namespace btrblocks
@@ -0,0 +1,102 @@
+#pragma once
+// -------------------------------------------------------------------------------------
+#include <cstring>
+// -------------------------------------------------------------------------------------
+#include "common/Kernels.hpp"
+#include "compression/SchemePicker.hpp"
+#include "extern/RoaringBitmap.hpp"
+#include "scheme/CompressionScheme.hpp"
+// -------------------------------------------------------------------------------------
+namespace btrblocks {
+// -------------------------------------------------------------------------------------
+// Null suppression for mostly-null columns: only the values of the set rows are
+// compressed (by the picked child scheme), decompression puts them back at the
+// set rows of the chunk's nullmap. Null rows are decompressed as 0.
+// -------------------------------------------------------------------------------------
+struct SparseStructure {
+  u32 set_count;
+  u8 values_scheme_code;
+  u8 data[];
+};
+// -------------------------------------------------------------------------------------
+template <typename NumberType, typename SchemeType, typename StatsType, typename SchemeCodeType>
+class TSparse {
+ public:
+  // -------------------------------------------------------------------------------------
+  static inline bool isSparse(const StatsType& stats, u32 null_threshold_pct) {
+    return stats.null_count > 0 &&
+           CD(stats.null_count) * 100.0 >= CD(stats.tuple_count) * CD(null_threshold_pct);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline u32 compressColumn(const NumberType* src,
+                                   const BITMAP* nullmap,
+                                   u8* dest,
+                                   StatsType& stats,
+                                   u8 allowed_cascading_level) {
+    auto& col_struct = *reinterpret_cast<SparseStructure*>(dest);
+    // -------------------------------------------------------------------------------------
+    thread_local std::vector<NumberType> values_v;
+    auto values = get_data(values_v, stats.tuple_count + SIMD_EXTRA_ELEMENTS(NumberType));
+    u32 set_count = stats.tuple_count;
+    if (nullmap == nullptr) {
+      std::memcpy(values, src, stats.tuple_count * sizeof(NumberType));
+    } else {
+      set_count = Kernels::selectSet(values, src, nullmap, stats.tuple_count);
+    }
+    col_struct.set_count = set_count;
+    // -------------------------------------------------------------------------------------
+    u32 used_space;
+    CSchemePicker<NumberType, SchemeType, StatsType, SchemeCodeType>::compress(
+        values, nullptr, col_struct.data, set_count, allowed_cascading_level - 1, used_space,
+        col_struct.values_scheme_code, autoScheme(), "values");
+    // -------------------------------------------------------------------------------------
+    return sizeof(SparseStructure) + used_space;
+  }
+  // -------------------------------------------------------------------------------------
+  static inline void decompressColumn(NumberType* dest,
+                                      BitmapWrapper* nullmap,
+                                      const u8* src,
+                                      u32 tuple_count,
+                                      u32 level) {
+    const auto& col_struct = *reinterpret_cast<const SparseStructure*>(src);
+    const u32 set_count = col_struct.set_count;
+    auto& scheme =
+        CSchemePicker<NumberType, SchemeType, StatsType, SchemeCodeType>::MyTypeWrapper::getScheme(
+            col_struct.values_scheme_code);
+    // -------------------------------------------------------------------------------------
+    if (set_count == tuple_count) {
+      scheme.decompress(dest, nullptr, col_struct.data, tuple_count, level + 1);
+      return;
+    }
+    if (nullmap == nullptr || nullmap->cardinality() != set_count) {
+      throw Generic_Exception("Sparse decompression requires the nullmap of the chunk");
+    }
+    if (set_count == 0) {
+      std::memset(dest, 0, tuple_count * sizeof(NumberType));
+      return;
+    }
+    // -------------------------------------------------------------------------------------
+    thread_local std::vector<std::vector<NumberType>> values_v;
+    auto values = get_level_data(values_v, set_count + SIMD_EXTRA_ELEMENTS(NumberType), level);
+    scheme.decompress(values, nullptr, col_struct.data, set_count, level + 1);
+    // -------------------------------------------------------------------------------------
+    // Spread the values to the set rows, the null rows get 0
+    thread_local std::vector<std::vector<VALIDITY>> validity_v;
+    auto validity =
+        get_level_data(validity_v, bitmap::PackedBitmap::wordCount(tuple_count), level);
+    nullmap->writeValidity(validity);
+    Kernels::expandSet(dest, values, validity, tuple_count);
+  }
+  // -------------------------------------------------------------------------------------
+  static inline string fullDescription(const u8* src, const string& selfDescription) {
+    const auto& col_struct = *reinterpret_cast<const SparseStructure*>(src);
+    auto& scheme =
+        CSchemePicker<NumberType, SchemeType, StatsType, SchemeCodeType>::MyTypeWrapper::getScheme(
+            col_struct.values_scheme_code);
+    return selfDescription + " -> ([" + std::to_string(col_struct.set_count) + "] values) " +
+           scheme.fullDescription(col_struct.data);
+  }
+};
+// -------------------------------------------------------------------------------------
+}  // namespace btrblocks
+// -------------------------------------------------------------------------------------
@@ -7,6 +7,7 @@
 #include <map>
 #include <random>
 #include <set>
+#include <type_traits>
 // -------------------------------------------------------------------------------------
 namespace btrblocks {
 // -------------------------------------------------------------------------------------
@@ -30,6 +31,11 @@ struct NumberStats {
   u32 set_count;
   u32 average_run_length;
   bool is_sorted;
+  // Integers only: the line through the first two adjacent non-null rows and
+  // the number of non-null rows on it (value == sequence_base + sequence_stride * row_i).
+  T sequence_base;
+  T sequence_stride;
+  u32 sequence_count;
   // -------------------------------------------------------------------------------------
   tuple<vector<T>, vector<BITMAP>> samples(u32 n, u32 length) {
     // -------------------------------------------------------------------------------------
@@ -75,6 +81,38 @@ struct NumberStats {
     return std::make_tuple(compiled_values, compiled_bitmap);
   }
   // -------------------------------------------------------------------------------------
+  // Wrapping arithmetic, sequences may overflow. The line is taken from the first
+  // adjacent pair, and from a pair in the middle if the first one is an outlier.
+  void detectSequence() {
+    for (u32 start_row : {0u, tuple_count / 2}) {
+      if (sequence_count * 2 > set_count) {
+        break;
+      }
+      fitSequence(start_row);
+    }
+  }
+  void fitSequence(u32 row_i) {
+    using U = std::make_unsigned_t<T>;
+    while (row_i + 1 < tuple_count && bitmap != nullptr && (!bitmap[row_i] || !bitmap[row_i + 1])) {
+      row_i++;
+    }
+    if (row_i + 1 >= tuple_count) {
+      return;
+    }
+    const U stride = static_cast<U>(src[row_i + 1]) - static_cast<U>(src[row_i]);
+    const U base = static_cast<U>(src[row_i]) - stride * static_cast<U>(row_i);
+    U expected = base;
+    u32 count = 0;
+    for (row_i = 0; row_i < tuple_count; row_i++, expected += stride) {
+      count += (bitmap == nullptr || bitmap[row_i]) && static_cast<U>(src[row_i]) == expected;
+    }
+    if (count > sequence_count) {
+      sequence_base = static_cast<T>(base);
+      sequence_stride = static_cast<T>(stride);
+      sequence_count = count;
+    }
+  }
+  // -------------------------------------------------------------------------------------
   static NumberStats generateStats(const T* src, const BITMAP* nullmap, u32 tuple_count) {
     NumberStats stats(src, nullmap, tuple_count);
     // -------------------------------------------------------------------------------------
@@ -126,6 +164,12 @@ struct NumberStats {
     stats.unique_count = stats.distinct_values.size();
     stats.set_count = stats.tuple_count - stats.null_count;
     // -------------------------------------------------------------------------------------
+    stats.sequence_base = stats.sequence_stride = 0;
+    stats.sequence_count = 0;
+    if constexpr (std::is_integral_v<T>) {
+      stats.detectSequence();
+    }
+    // -------------------------------------------------------------------------------------
     return stats;
   }
 };
@@ -1,6 +1,8 @@
 #include "Chunk.hpp"
 // -------------------------------------------------------------------------------------
+#include "common/Decimal.hpp"
 #include "common/Exceptions.hpp"
+#include "common/Temporal.hpp"
 #include "common/Utils.hpp"
 // -------------------------------------------------------------------------------------
 
@@ -75,6 +77,99 @@ bool Chunk::operator==(const btrblocks::Chunk& other) const {
             }
             break;
           }
+          case ColumnType::BIGINT: {
+            auto me = reinterpret_cast<BIGINT*>(columns[column_i].get())[row_i];
+            auto they = reinterpret_cast<BIGINT*>(other.columns[column_i].get())[row_i];
+            if (me != they) {
+              cerr << "== : BIGINT column (" << relation.columns[column_i].name
+                   << ") data are not identical\t"
+                   << "row_i = " << row_i << endl
+                   << me << endl
+                   << they << endl;
+              return false;
+            }
+            break;
+          }
+          case ColumnType::SMALLINT: {
+            auto me = reinterpret_cast<SMALLINT*>(columns[column_i].get())[row_i];
+            auto they = reinterpret_cast<SMALLINT*>(other.columns[column_i].get())[row_i];
+            if (me != they) {
+              cerr << "== : SMALLINT column (" << relation.columns[column_i].name
+                   << ") data are not identical\t"
+                   << "row_i = " << row_i << endl
+                   << CI(me) << endl
+                   << CI(they) << endl;
+              return false;
+            }
+            break;
+          }
+          case ColumnType::TINYINT: {
+            auto me = reinterpret_cast<TINYINT*>(columns[column_i].get())[row_i];
+            auto they = reinterpret_cast<TINYINT*>(other.columns[column_i].get())[row_i];
+            if (me != they) {
+              cerr << "== : TINYINT column (" << relation.columns[column_i].name
+                   << ") data are not identical\t"
+                   << "row_i = " << row_i << endl
+                   << CI(me) << endl
+                   << CI(they) << endl;
+              return false;
+            }
+            break;
+          }
+          case ColumnType::TIMESTAMP: {
+            auto me = reinterpret_cast<TIMESTAMP*>(columns[column_i].get())[row_i];
+            auto they = reinterpret_cast<TIMESTAMP*>(other.columns[column_i].get())[row_i];
+            if (me != they) {
+              cerr << "== : TIMESTAMP column (" << relation.columns[column_i].name
+                   << ") data are not identical\t"
+                   << "row_i = " << row_i << endl
+                   << Temporal::formatTimestamp(me) << endl
+                   << Temporal::formatTimestamp(they) << endl;
+              return false;
+            }
+            break;
+          }
+          case ColumnType::DATE: {
+            auto me = reinterpret_cast<DATE*>(columns[column_i].get())[row_i];
+            auto they = reinterpret_cast<DATE*>(other.columns[column_i].get())[row_i];
+            if (me != they) {
+              cerr << "== : DATE column (" << relation.columns[column_i].name
+                   << ") data are not identical\t"
+                   << "row_i = " << row_i << endl
+                   << Temporal::formatDate(me) << endl
+                   << Temporal::formatDate(they) << endl;
+              return false;
+            }
+            break;
+          }
+          case ColumnType::DECIMAL: {
+            auto me = reinterpret_cast<DECIMAL*>(columns[column_i].get())[row_i];
+            auto they = reinterpret_cast<DECIMAL*>(other.columns[column_i].get())[row_i];
+            if (me != they) {
+              const u8 scale = relation.columns[column_i].decimal_scale;
+              cerr << "== : DECIMAL column (" << relation.columns[column_i].name
+                   << ") data are not identical\t"
+                   << "row_i = " << row_i << endl
+                   << Decimal::format(me, scale) << endl
+                   << Decimal::format(they, scale) << endl;
+              return false;
+            }
+            break;
+          }
+          case ColumnType::FLOAT: {
+            auto me = reinterpret_cast<FLOAT*>(columns[column_i].get())[row_i];
+            auto they = reinterpret_cast<FLOAT*>(other.columns[column_i].get())[row_i];
+            if (me != they) {
+              cerr << std::setprecision(30) << endl;
+              cerr << "== : FLOAT column (" << relation.columns[column_i].name
+                   << ") data are not identical\t"
+                   << "row_i = " << row_i << endl
+                   << me << endl
+                   << they << endl;
+              return false;
+            }
+            break;
+          }
           case ColumnType::STRING: {
             auto me = this->operator()(column_i, row_i);
             auto they = other.operator()(column_i, row_i);
@@ -140,6 +235,17 @@ InputChunk::InputChunk(unique_ptr<u8[]>&& data,
       size(size),
       tuple_count(tuple_count) {}
 
+InputChunk::InputChunk(unique_ptr<u8[]>&& data,
+                       unique_ptr<VALIDITY[]>&& validity,
+                       ColumnType type,
+                       u64 tuple_count,
+                       SIZE size)
+    : data(std::move(data)),
+      validity(std::move(validity)),
+      type(type),
+      size(size),
+      tuple_count(tuple_count) {}
+
 bool InputChunk::compareContents(u8* their_data,
                                  const std::vector<BITMAP>& their_bitmap,
                                  u64 their_tuple_count,
@@ -151,8 +257,8 @@ bool InputChunk::compareContents(u8* their_data,
   }
 
   for (u64 idx = 0; idx < their_tuple_count; idx++) {
-    if (this->nullmap[idx] != their_bitmap[idx]) {
-      std::cerr << "Bitmaps are not equal at index " << idx << ". Expected: " << this->nullmap[idx]
+    if (this->isSet(idx) != (their_bitmap[idx] != 0)) {
+      std::cerr << "Bitmaps are not equal at index " << idx << ". Expected: " << this->isSet(idx)
                 << " Got: " << their_bitmap[idx] << std::endl;
       return false;
     }
@@ -167,7 +273,7 @@ bool InputChunk::compareContents(u8* their_data,
       auto their_ints = reinterpret_cast<INTEGER*>(their_data);
       auto my_ints = reinterpret_cast<INTEGER*>(this->data.get());
       for (u64 idx = 0; idx < their_tuple_count; idx++) {
-        if (this->nullmap[idx] && my_ints[idx] != their_ints[idx]) {
+        if (this->isSet(idx) && my_ints[idx] != their_ints[idx]) {
           std::cerr << "Integer data is not equal at index " << idx << " Expected: " << my_ints[idx]
                     << " Got: " << their_ints[idx] << std::endl;
           return false;
@@ -183,7 +289,7 @@ bool InputChunk::compareContents(u8* their_data,
       auto their_doubles = reinterpret_cast<DOUBLE*>(their_data);
       auto my_doubles = reinterpret_cast<DOUBLE*>(this->data.get());
       for (u64 idx = 0; idx < their_tuple_count; idx++) {
-        if (this->nullmap[idx] && my_doubles[idx] != their_doubles[idx]) {
+        if (this->isSet(idx) && my_doubles[idx] != their_doubles[idx]) {
           std::cerr << "Double data is not equal at index " << idx << std::setprecision(1000)
                     << " Expected: " << my_doubles[idx] << " Got: " << their_doubles[idx]
                     << std::endl;
@@ -192,10 +298,129 @@ bool InputChunk::compareContents(u8* their_data,
       }
       break;
     }
+    case ColumnType::BIGINT: {
+      if (requires_copy) {
+        throw Generic_Exception("requires_copy not implemented for type BIGINT");
+      }
+
+      auto their_bigints = reinterpret_cast<BIGINT*>(their_data);
+      auto my_bigints = reinterpret_cast<BIGINT*>(this->data.get());
+      for (u64 idx = 0; idx < their_tuple_count; idx++) {
+        if (this->isSet(idx) && my_bigints[idx] != their_bigints[idx]) {
+          std::cerr << "Bigint data is not equal at index " << idx
+                    << " Expected: " << my_bigints[idx] << " Got: " << their_bigints[idx]
+                    << std::endl;
+          return false;
+        }
+      }
+      break;
+    }
+    case ColumnType::SMALLINT: {
+      if (requires_copy) {
+        throw Generic_Exception("requires_copy not implemented for type SMALLINT");
+      }
+
+      auto their_values = reinterpret_cast<SMALLINT*>(their_data);
+      auto my_values = reinterpret_cast<SMALLINT*>(this->data.get());
+      for (u64 idx = 0; idx < their_tuple_count; idx++) {
+        if (this->isSet(idx) && my_values[idx] != their_values[idx]) {
+          std::cerr << "Smallint data is not equal at index " << idx
+                    << " Expected: " << CI(my_values[idx]) << " Got: " << CI(their_values[idx])
+                    << std::endl;
+          return false;
+        }
+      }
+      break;
+    }
+    case ColumnType::TINYINT: {
+      if (requires_copy) {
+        throw Generic_Exception("requires_copy not implemented for type TINYINT");
+      }
+
+      auto their_values = reinterpret_cast<TINYINT*>(their_data);
+      auto my_values = reinterpret_cast<TINYINT*>(this->data.get());
+      for (u64 idx = 0; idx < their_tuple_count; idx++) {
+        if (this->isSet(idx) && my_values[idx] != their_values[idx]) {
+          std::cerr << "Tinyint data is not equal at index " << idx
+                    << " Expected: " << CI(my_values[idx]) << " Got: " << CI(their_values[idx])
+                    << std::endl;
+          return false;
+        }
+      }
+      break;
+    }
+    case ColumnType::TIMESTAMP: {
+      if (requires_copy) {
+        throw Generic_Exception("requires_copy not implemented for type TIMESTAMP");
+      }
+
+      auto their_values = reinterpret_cast<TIMESTAMP*>(their_data);
+      auto my_values = reinterpret_cast<TIMESTAMP*>(this->data.get());
+      for (u64 idx = 0; idx < their_tuple_count; idx++) {
+        if (this->isSet(idx) && my_values[idx] != their_values[idx]) {
+          std::cerr << "Timestamp data is not equal at index " << idx
+                    << " Expected: " << Temporal::formatTimestamp(my_values[idx])
+                    << " Got: " << Temporal::formatTimestamp(their_values[idx]) << std::endl;
+          return false;
+        }
+      }
+      break;
+    }
+    case ColumnType::DATE: {
+      if (requires_copy) {
+        throw Generic_Exception("requires_copy not implemented for type DATE");
+      }
+
+      auto their_values = reinterpret_cast<DATE*>(their_data);
+      auto my_values = reinterpret_cast<DATE*>(this->data.get());
+      for (u64 idx = 0; idx < their_tuple_count; idx++) {
+        if (this->isSet(idx) && my_values[idx] != their_values[idx]) {
+          std::cerr << "Date data is not equal at index " << idx
+                    << " Expected: " << Temporal::formatDate(my_values[idx])
+                    << " Got: " << Temporal::formatDate(their_values[idx]) << std::endl;
+          return false;
+        }
+      }
+      break;
+    }
+    case ColumnType::DECIMAL: {
+      if (requires_copy) {
+        throw Generic_Exception("requires_copy not implemented for type DECIMAL");
+      }
+
+      auto their_values = reinterpret_cast<DECIMAL*>(their_data);
+      auto my_values = reinterpret_cast<DECIMAL*>(this->data.get());
+      for (u64 idx = 0; idx < their_tuple_count; idx++) {
+        if (this->isSet(idx) && my_values[idx] != their_values[idx]) {
+          std::cerr << "Decimal data is not equal at index " << idx
+                    << " Expected: " << Decimal::format(my_values[idx], decimal_scale)
+                    << " Got: " << Decimal::format(their_values[idx], decimal_scale) << std::endl;
+          return false;
+        }
+      }
+      break;
+    }
+    case ColumnType::FLOAT: {
+      if (requires_copy) {
+        throw Generic_Exception("requires_copy not implemented for type FLOAT");
+      }
+
+      auto their_floats = reinterpret_cast<FLOAT*>(their_data);
+      auto my_floats = reinterpret_cast<FLOAT*>(this->data.get());
+      for (u64 idx = 0; idx < their_tuple_count; idx++) {
+        if (this->isSet(idx) && my_floats[idx] != their_floats[idx]) {
+          std::cerr << "Float data is not equal at index " << idx << std::setprecision(1000)
+                    << " Expected: " << my_floats[idx] << " Got: " << their_floats[idx]
+                    << std::endl;
+          return false;
+        }
+      }
+      break;
+    }
     case ColumnType::STRING: {
       auto my_view = btrblocks::StringArrayViewer(this->data.get());
       for (u64 idx = 0; idx < their_tuple_count; idx++) {
-        if (!this->nullmap[idx]) {
+        if (!this->isSet(idx)) {
           continue;
         }
 
@@ -239,7 +464,8 @@ bool ColumnPart::canAdd(SIZE chunk_size) {
         "chunks with compressed size greater than part_size_threshold "
         "unsupported");
   }
-  return (total_size + chunk_size) <= chunk_part_size_threshold;
+  return (total_size + fsst_table.size() + global_dictionary.size() + chunk_size) <=
+         chunk_part_size_threshold;
 }
 
 void ColumnPart::addCompressedChunk(vector<u8>&& chunk) {
@@ -254,19 +480,32 @@ u32 ColumnPart::writeToDisk(const std::string& outputfile) {
     throw Generic_Exception("Opening btr output file failed");
   }
 
+  // The extension is only written if there is part data
+  const bool has_extension = !this->fsst_table.empty() || !this->global_dictionary.empty();
   struct ColumnPartMetadata metadata {
-    .num_chunks = static_cast<u32>(this->chunks.size())
+    .num_chunks = static_cast<u32>(this->chunks.size()), .has_extension = has_extension
+  };
+  struct ColumnPartExtension extension {
+    .fsst_table_offset = 0, .global_dictionary_offset = 0
   };
+  const u32 extension_size = has_extension ? sizeof(extension) : 0;
 
+  // Layout: metadata | offsets | [extension | shared FSST table | global dictionary] | chunks
   // We need to align the offsets by 16. Otherwise, PBP decompression breaks.
-  u32 current_offset = sizeof(metadata) + this->chunks.size() * sizeof(u32);
+  u32 current_offset = sizeof(metadata) + this->chunks.size() * sizeof(u32) + extension_size;
   u64 diff;
   current_offset = Utils::alignBy(current_offset, 16, diff);
+  if (!this->fsst_table.empty()) {
+    extension.fsst_table_offset = current_offset;
+    current_offset = Utils::alignBy(current_offset + this->fsst_table.size(), 16, diff);
+  }
+  if (!this->global_dictionary.empty()) {
+    extension.global_dictionary_offset = current_offset;
+    current_offset = Utils::alignBy(current_offset + this->global_dictionary.size(), 16, diff);
+  }
   std::vector<u32> offsets;
-  std::vector<u64> diffs;
   for (const auto& chunk : this->chunks) {
     offsets.push_back(current_offset);
-    diffs.push_back(diff);
     current_offset += chunk.size();
     current_offset = Utils::alignBy(current_offset, 16, diff);
   }
@@ -275,14 +514,29 @@ u32 ColumnPart::writeToDisk(const std::string& outputfile) {
   btr_file.write(reinterpret_cast<const char*>(&metadata), sizeof(metadata));
   // Write offsets
   btr_file.write(reinterpret_cast<const char*>(offsets.data()), offsets.size() * sizeof(u32));
+  // Write the extension
+  btr_file.write(reinterpret_cast<const char*>(&extension), extension_size);
+  // Write the shared FSST table
+  if (!this->fsst_table.empty()) {
+    btr_file.seekp(extension.fsst_table_offset, std::ios::beg);
+    btr_file.write(reinterpret_cast<const char*>(this->fsst_table.data()), this->fsst_table.size());
+  }
+  // Write the global dictionary
+  if (!this->global_dictionary.empty()) {
+    btr_file.seekp(extension.global_dictionary_offset, std::ios::beg);
+    btr_file.write(reinterpret_cast<const char*>(this->global_dictionary.data()),
+                   this->global_dictionary.size());
+  }
   // Write chunks
   for (std::size_t chunk_i = 0; chunk_i < chunks.size(); chunk_i++) {
     auto& chunk = this->chunks[chunk_i];
-    btr_file.seekp(diffs[chunk_i], std::ios::cur);
+    btr_file.seekp(offsets[chunk_i], std::ios::beg);
     btr_file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
   }
 
-  u32 bytes_written = this->total_size + sizeof(metadata) + offsets.size() * sizeof(u32);
+  u32 bytes_written = this->total_size + this->fsst_table.size() +
+                      this->global_dictionary.size() + sizeof(metadata) +
+                      offsets.size() * sizeof(u32) + extension_size;
   btr_file.flush();
   btr_file.close();
   if (btr_file.fail()) {
@@ -297,6 +551,8 @@ u32 ColumnPart::writeToDisk(const std::string& outputfile) {
 void ColumnPart::reset() {
   this->total_size = 0;
   this->chunks.clear();
+  this->fsst_table.clear();
+  this->global_dictionary.clear();
 }
 }  // namespace btrblocks
 // -------------------------------------------------------------------------------------
@@ -75,16 +75,29 @@ class InputChunk {
    */
  public:
   unique_ptr<u8[]> data;
+  // Exactly one of them is set: a BITMAP per tuple, or the bit-packed validity
+  // (bitmap::PackedBitmap) that takes an eighth of the memory
   unique_ptr<BITMAP[]> nullmap;
+  unique_ptr<VALIDITY[]> validity;
   ColumnType type;
   SIZE size;
   const u64 tuple_count;
+  u8 decimal_scale = 0;  // DECIMAL only
 
   InputChunk(unique_ptr<u8[]>&& data,
              unique_ptr<BITMAP[]>&& bitmap,
              ColumnType type,
              u64 tuple_count,
              SIZE size);
+  InputChunk(unique_ptr<u8[]>&& data,
+             unique_ptr<VALIDITY[]>&& validity,
+             ColumnType type,
+             u64 tuple_count,
+             SIZE size);
+
+  [[nodiscard]] inline bool isSet(u64 row) const {
+    return nullmap ? nullmap[row] != 0 : (validity[row / 64] >> (row % 64)) & 1;
+  }
 
   bool compareContents(u8* their_data,
                        const std::vector<BITMAP>& their_bitmap,
@@ -92,10 +105,28 @@ class InputChunk {
                        bool requires_copy) const;
 };
 
+// Part-level data of the chunks, follows ColumnPartMetadata::offsets if the
+// part has any. Parts without keep the layout of readers that do not know it.
+struct ColumnPartExtension {
+  u32 fsst_table_offset;  // shared FSST table of the string chunks, 0 if there is none
+  u32 global_dictionary_offset;  // GlobalDictionary of the DICT chunks, 0 if there is none
+};
+
 struct ColumnPartMetadata {
-  u32 num_chunks;
+  u32 num_chunks : 31;
+  // Set if a ColumnPartExtension follows the offsets, always 0 in older parts
+  u32 has_extension : 1;
   u32 offsets[];
+
+  // nullptr for parts written without an extension
+  [[nodiscard]] inline const ColumnPartExtension* extension() const {
+    if (!has_extension) {
+      return nullptr;
+    }
+    return reinterpret_cast<const ColumnPartExtension*>(offsets + num_chunks);
+  }
 };
+static_assert(sizeof(ColumnPartMetadata) == 4);
 
 class ColumnPart {
   /*
@@ -105,6 +136,10 @@ class ColumnPart {
  public:
   SIZE total_size = 0;
   vector<vector<u8>> chunks;
+  // Exported strings::SharedFsstTable the chunks were compressed with, if any
+  vector<u8> fsst_table;
+  // Exported GlobalDictionary the chunks were compressed with, if any
+  vector<u8> global_dictionary;
 
   [[nodiscard]] bool canAdd(SIZE chunk_size);
   void addCompressedChunk(vector<u8>&& chunk);
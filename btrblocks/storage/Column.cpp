@@ -8,8 +8,9 @@ namespace btrblocks {
 Column::Column(const ColumnType type,
                string name,
                const string& data_path,
-               const string& bitmap_path)
-    : type(type), name(std::move(name)) {
+               const string& bitmap_path,
+               u8 decimal_scale)
+    : type(type), name(std::move(name)), decimal_scale(decimal_scale) {
   switch (type) {
     case ColumnType::INTEGER:
       data.emplace<0>(data_path.c_str());
@@ -20,6 +21,27 @@ Column::Column(const ColumnType type,
     case ColumnType::STRING:
       data.emplace<2>(data_path.c_str());
       break;
+    case ColumnType::FLOAT:
+      data.emplace<3>(data_path.c_str());
+      break;
+    case ColumnType::BIGINT:
+      data.emplace<4>(data_path.c_str());
+      break;
+    case ColumnType::SMALLINT:
+      data.emplace<5>(data_path.c_str());
+      break;
+    case ColumnType::TINYINT:
+      data.emplace<6>(data_path.c_str());
+      break;
+    case ColumnType::TIMESTAMP:
+      data.emplace<4>(data_path.c_str());
+      break;
+    case ColumnType::DATE:
+      data.emplace<0>(data_path.c_str());
+      break;
+    case ColumnType::DECIMAL:
+      data.emplace<4>(data_path.c_str());
+      break;
     default:
       UNREACHABLE();
       break;
@@ -35,6 +57,14 @@ Column::Column(string name, Data&& data, Vector<BITMAP>&& bitmap)
           return ColumnType::DOUBLE;
         } else if (std::holds_alternative<Vector<str>>(d)) {
           return ColumnType::STRING;
+        } else if (std::holds_alternative<Vector<FLOAT>>(d)) {
+          return ColumnType::FLOAT;
+        } else if (std::holds_alternative<Vector<BIGINT>>(d)) {
+          return ColumnType::BIGINT;
+        } else if (std::holds_alternative<Vector<SMALLINT>>(d)) {
+          return ColumnType::SMALLINT;
+        } else if (std::holds_alternative<Vector<TINYINT>>(d)) {
+          return ColumnType::TINYINT;
         } else {
           UNREACHABLE();
         }
@@ -60,6 +90,34 @@ const Vector<str>& Column::strings() const {
   return std::get<2>(data);
 }
 // -------------------------------------------------------------------------------------
+const Vector<FLOAT>& Column::floats() const {
+  return std::get<3>(data);
+}
+// -------------------------------------------------------------------------------------
+const Vector<BIGINT>& Column::bigints() const {
+  return std::get<4>(data);
+}
+// -------------------------------------------------------------------------------------
+const Vector<SMALLINT>& Column::smallints() const {
+  return std::get<5>(data);
+}
+// -------------------------------------------------------------------------------------
+const Vector<TINYINT>& Column::tinyints() const {
+  return std::get<6>(data);
+}
+// -------------------------------------------------------------------------------------
+const Vector<TIMESTAMP>& Column::timestamps() const {
+  return std::get<4>(data);
+}
+// -------------------------------------------------------------------------------------
+const Vector<DATE>& Column::dates() const {
+  return std::get<0>(data);
+}
+// -------------------------------------------------------------------------------------
+const Vector<DECIMAL>& Column::decimals() const {
+  return std::get<4>(data);
+}
+// -------------------------------------------------------------------------------------
 const Vector<BITMAP>& Column::bitmaps() const {
   return bitmap;
 }
@@ -79,6 +137,27 @@ SIZE Column::sizeInBytes() const {
     case ColumnType::STRING:
       return strings().fileSize;
       break;
+    case ColumnType::FLOAT:
+      return floats().size() * sizeof(FLOAT);
+      break;
+    case ColumnType::BIGINT:
+      return bigints().size() * sizeof(BIGINT);
+      break;
+    case ColumnType::SMALLINT:
+      return smallints().size() * sizeof(SMALLINT);
+      break;
+    case ColumnType::TINYINT:
+      return tinyints().size() * sizeof(TINYINT);
+      break;
+    case ColumnType::TIMESTAMP:
+      return timestamps().size() * sizeof(TIMESTAMP);
+      break;
+    case ColumnType::DATE:
+      return dates().size() * sizeof(DATE);
+      break;
+    case ColumnType::DECIMAL:
+      return decimals().size() * sizeof(DECIMAL);
+      break;
     default:
       UNREACHABLE();
       break;
@@ -8,14 +8,20 @@ namespace btrblocks {
 // -------------------------------------------------------------------------------------
 class Column {
  public:
-  using Data = std::variant<Vector<INTEGER>, Vector<DOUBLE>, Vector<str>>;
+  using Data = std::variant<Vector<INTEGER>, Vector<DOUBLE>, Vector<str>, Vector<FLOAT>,
+                            Vector<BIGINT>, Vector<SMALLINT>, Vector<TINYINT>>;
   const ColumnType type;
   const string name;
+  const u8 decimal_scale = 0;  // DECIMAL only
   Data data;
   Vector<BITMAP> bitmap;
 
   // read from file system
-  Column(const ColumnType type, string name, const string& data_path, const string& bitmap_path);
+  Column(const ColumnType type,
+         string name,
+         const string& data_path,
+         const string& bitmap_path,
+         u8 decimal_scale = 0);
   // read from existing in-memory data
   Column(string name, Data&& data, Vector<BITMAP>&& bitmap);
   // from existing in-memory data, assuming full bitmap (no nulls)
@@ -24,6 +30,15 @@ class Column {
   [[nodiscard]] const Vector<INTEGER>& integers() const;
   [[nodiscard]] const Vector<DOUBLE>& doubles() const;
   [[nodiscard]] const Vector<str>& strings() const;
+  [[nodiscard]] const Vector<FLOAT>& floats() const;
+  [[nodiscard]] const Vector<BIGINT>& bigints() const;
+  [[nodiscard]] const Vector<SMALLINT>& smallints() const;
+  [[nodiscard]] const Vector<TINYINT>& tinyints() const;
+  // TIMESTAMP and DATE share the storage of BIGINT and INTEGER
+  [[nodiscard]] const Vector<TIMESTAMP>& timestamps() const;
+  [[nodiscard]] const Vector<DATE>& dates() const;
+  // Scaled by 10^decimal_scale
+  [[nodiscard]] const Vector<DECIMAL>& decimals() const;
   [[nodiscard]] const Vector<BITMAP>& bitmaps() const;
   [[nodiscard]] SIZE size() const;
   [[nodiscard]] SIZE sizeInBytes() const;
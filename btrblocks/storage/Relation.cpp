@@ -19,7 +19,7 @@ void Relation::addColumn(Column&& column) {
   fixTupleCount();
 }
 // -------------------------------------------------------------------------------------
-void Relation::addColumn(const string& column_file_path) {
+void Relation::addColumn(const string& column_file_path, u8 decimal_scale) {
   std::string column_name, column_type_str;
   std::regex re(R"(.*\/(.*)\.(\w*))");
   std::smatch match;
@@ -31,7 +31,8 @@ void Relation::addColumn(const string& column_file_path) {
     string bitmap_file_path = column_file_path;
     bitmap_file_path = bitmap_file_path.replace(bitmap_file_path.end() - column_type_str.length(),
                                                 bitmap_file_path.end(), "bitmap");
-    columns.emplace_back(column_type, column_name, column_file_path, bitmap_file_path);
+    columns.emplace_back(column_type, column_name, column_file_path, bitmap_file_path,
+                         decimal_scale);
   } else {
     UNREACHABLE();
   }
@@ -100,6 +101,55 @@ Chunk Relation::getChunk(const vector<btrblocks::Range>& ranges, SIZE chunk_i) c
                     chunk_tuple_count * sizeof(DOUBLE));
         break;
       }
+      case ColumnType::BIGINT: {
+        c_sizes[i] = chunk_tuple_count * sizeof(BIGINT);
+        c_columns[i] = std::unique_ptr<u8[]>(new u8[c_sizes[i]]);
+        std::memcpy(reinterpret_cast<void*>(c_columns[i].get()),
+                    columns[i].bigints().data + offset, chunk_tuple_count * sizeof(BIGINT));
+        break;
+      }
+      case ColumnType::SMALLINT: {
+        c_sizes[i] = chunk_tuple_count * sizeof(SMALLINT);
+        c_columns[i] = std::unique_ptr<u8[]>(new u8[c_sizes[i]]);
+        std::memcpy(reinterpret_cast<void*>(c_columns[i].get()),
+                    columns[i].smallints().data + offset, chunk_tuple_count * sizeof(SMALLINT));
+        break;
+      }
+      case ColumnType::TINYINT: {
+        c_sizes[i] = chunk_tuple_count * sizeof(TINYINT);
+        c_columns[i] = std::unique_ptr<u8[]>(new u8[c_sizes[i]]);
+        std::memcpy(reinterpret_cast<void*>(c_columns[i].get()),
+                    columns[i].tinyints().data + offset, chunk_tuple_count * sizeof(TINYINT));
+        break;
+      }
+      case ColumnType::TIMESTAMP: {
+        c_sizes[i] = chunk_tuple_count * sizeof(TIMESTAMP);
+        c_columns[i] = std::unique_ptr<u8[]>(new u8[c_sizes[i]]);
+        std::memcpy(reinterpret_cast<void*>(c_columns[i].get()),
+                    columns[i].timestamps().data + offset, chunk_tuple_count * sizeof(TIMESTAMP));
+        break;
+      }
+      case ColumnType::DATE: {
+        c_sizes[i] = chunk_tuple_count * sizeof(DATE);
+        c_columns[i] = std::unique_ptr<u8[]>(new u8[c_sizes[i]]);
+        std::memcpy(reinterpret_cast<void*>(c_columns[i].get()), columns[i].dates().data + offset,
+                    chunk_tuple_count * sizeof(DATE));
+        break;
+      }
+      case ColumnType::DECIMAL: {
+        c_sizes[i] = chunk_tuple_count * sizeof(DECIMAL);
+        c_columns[i] = std::unique_ptr<u8[]>(new u8[c_sizes[i]]);
+        std::memcpy(reinterpret_cast<void*>(c_columns[i].get()),
+                    columns[i].decimals().data + offset, chunk_tuple_count * sizeof(DECIMAL));
+        break;
+      }
+      case ColumnType::FLOAT: {
+        c_sizes[i] = chunk_tuple_count * sizeof(FLOAT);
+        c_columns[i] = std::unique_ptr<u8[]>(new u8[c_sizes[i]]);
+        std::memcpy(reinterpret_cast<void*>(c_columns[i].get()), columns[i].floats().data + offset,
+                    chunk_tuple_count * sizeof(FLOAT));
+        break;
+      }
       case ColumnType::STRING: {
         const u64 slots_size = sizeof(StringArrayViewer::Slot) * (chunk_tuple_count + 1);
         // -------------------------------------------------------------------------------------
@@ -163,6 +213,55 @@ InputChunk Relation::getInputChunk(const Range& range,
                   chunk_tuple_count * sizeof(DOUBLE));
       break;
     }
+    case ColumnType::BIGINT: {
+      size = chunk_tuple_count * sizeof(BIGINT);
+      data = std::unique_ptr<u8[]>(new u8[size]);
+      std::memcpy(reinterpret_cast<void*>(data.get()), columns[column].bigints().data + offset,
+                  chunk_tuple_count * sizeof(BIGINT));
+      break;
+    }
+    case ColumnType::SMALLINT: {
+      size = chunk_tuple_count * sizeof(SMALLINT);
+      data = std::unique_ptr<u8[]>(new u8[size]);
+      std::memcpy(reinterpret_cast<void*>(data.get()), columns[column].smallints().data + offset,
+                  chunk_tuple_count * sizeof(SMALLINT));
+      break;
+    }
+    case ColumnType::TINYINT: {
+      size = chunk_tuple_count * sizeof(TINYINT);
+      data = std::unique_ptr<u8[]>(new u8[size]);
+      std::memcpy(reinterpret_cast<void*>(data.get()), columns[column].tinyints().data + offset,
+                  chunk_tuple_count * sizeof(TINYINT));
+      break;
+    }
+    case ColumnType::TIMESTAMP: {
+      size = chunk_tuple_count * sizeof(TIMESTAMP);
+      data = std::unique_ptr<u8[]>(new u8[size]);
+      std::memcpy(reinterpret_cast<void*>(data.get()), columns[column].timestamps().data + offset,
+                  chunk_tuple_count * sizeof(TIMESTAMP));
+      break;
+    }
+    case ColumnType::DATE: {
+      size = chunk_tuple_count * sizeof(DATE);
+      data = std::unique_ptr<u8[]>(new u8[size]);
+      std::memcpy(reinterpret_cast<void*>(data.get()), columns[column].dates().data + offset,
+                  chunk_tuple_count * sizeof(DATE));
+      break;
+    }
+    case ColumnType::DECIMAL: {
+      size = chunk_tuple_count * sizeof(DECIMAL);
+      data = std::unique_ptr<u8[]>(new u8[size]);
+      std::memcpy(reinterpret_cast<void*>(data.get()), columns[column].decimals().data + offset,
+                  chunk_tuple_count * sizeof(DECIMAL));
+      break;
+    }
+    case ColumnType::FLOAT: {
+      size = chunk_tuple_count * sizeof(FLOAT);
+      data = std::unique_ptr<u8[]>(new u8[size]);
+      std::memcpy(reinterpret_cast<void*>(data.get()), columns[column].floats().data + offset,
+                  chunk_tuple_count * sizeof(FLOAT));
+      break;
+    }
     case ColumnType::STRING: {
       const u64 slots_size = sizeof(StringArrayViewer::Slot) * (chunk_tuple_count + 1);
       // -------------------------------------------------------------------------------------
@@ -193,7 +292,10 @@ InputChunk Relation::getInputChunk(const Range& range,
       throw Generic_Exception("Type not implemented");
   }
 
-  return {std::move(data), std::move(bitmap), columns[column].type, chunk_tuple_count, size};
+  InputChunk input_chunk{std::move(data), std::move(bitmap), columns[column].type,
+                         chunk_tuple_count, size};
+  input_chunk.decimal_scale = columns[column].decimal_scale;
+  return input_chunk;
 }
 // -------------------------------------------------------------------------------------
 void Relation::fixTupleCount() {
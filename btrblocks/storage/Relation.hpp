@@ -26,7 +26,8 @@ class Relation {
                                          u32 column) const;
 
   void addColumn(Column&& column);
-  void addColumn(const string& column_file_path);
+  // The scale of DECIMAL columns is not part of the file name
+  void addColumn(const string& column_file_path, u8 decimal_scale = 0);
 
  private:
   void fixTupleCount();
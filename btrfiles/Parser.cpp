@@ -1,10 +1,13 @@
 #include "btrfiles.hpp"
 // ------------------------------------------------------------------------------
 #include "Trim.hpp"
+#include "common/Decimal.hpp"
 #include "common/Exceptions.hpp"
+#include "common/Temporal.hpp"
 #include "storage/MMapVector.hpp"
 // -------------------------------------------------------------------------------------
 #include <sys/stat.h>
+#include <limits>
 #include <csv-parser/parser.hpp>
 // -------------------------------------------------------------------------------------
 namespace btrblocks::files {
@@ -14,6 +17,8 @@ struct ColumnDescriptor {
   ColumnType column_type;
   u32 vector_offset;
   vector<BITMAP> set_bitmap;
+  u8 decimal_precision = 0;
+  u8 decimal_scale = 0;
   u32 null_count = 0;   // when 'null' comes in the input
   u32 empty_count = 0;  // 0 by double and integers, '' by strings
 };
@@ -24,7 +29,14 @@ void convertCSV(const string csv_path, const YAML::Node &schema, const string &o
 
    // vector of vector for each type
    vector<vector<s32>> integer_vectors;
+   vector<vector<s64>> bigint_vectors;
+   vector<vector<s16>> smallint_vectors;
+   vector<vector<s8>> tinyint_vectors;
+   vector<vector<TIMESTAMP>> timestamp_vectors;
+   vector<vector<DATE>> date_vectors;
+   vector<vector<DECIMAL>> decimal_vectors;
    vector<vector<double>> double_vectors;
+   vector<vector<float>> float_vectors;
    vector<vector<string>> string_vectors;
 
    if ( mkdir(out_dir.c_str(), S_IRWXU | S_IRWXG) && errno != EEXIST ) {
@@ -39,16 +51,45 @@ void convertCSV(const string csv_path, const YAML::Node &schema, const string &o
          cout << "column name = " << column_name << " , type = " << column_type << endl;
          ColumnType type = ColumnType::UNDEFINED;
          u32 vector_offset = 0;
+         u8 decimal_precision = 0, decimal_scale = 0;
 
          // ugly code
-         if ( column_type == "integer" || column_type == "smallint") {
+         if ( column_type == "integer" ) {
             type = ColumnType::INTEGER;
             integer_vectors.push_back({});
             vector_offset = integer_vectors.size() - 1;
-         } else if ( column_type == "double" || column_type == "float") {
+         } else if ( column_type == "bigint" ) {
+            type = ColumnType::BIGINT;
+            bigint_vectors.push_back({});
+            vector_offset = bigint_vectors.size() - 1;
+         } else if ( column_type == "smallint" ) {
+            type = ColumnType::SMALLINT;
+            smallint_vectors.push_back({});
+            vector_offset = smallint_vectors.size() - 1;
+         } else if ( column_type == "tinyint" ) {
+            type = ColumnType::TINYINT;
+            tinyint_vectors.push_back({});
+            vector_offset = tinyint_vectors.size() - 1;
+         } else if ( column_type == "timestamp" ) {
+            type = ColumnType::TIMESTAMP;
+            timestamp_vectors.push_back({});
+            vector_offset = timestamp_vectors.size() - 1;
+         } else if ( column_type == "date" ) {
+            type = ColumnType::DATE;
+            date_vectors.push_back({});
+            vector_offset = date_vectors.size() - 1;
+         } else if ( Decimal::parseType(column_type, decimal_precision, decimal_scale) ) {
+            type = ColumnType::DECIMAL;
+            decimal_vectors.push_back({});
+            vector_offset = decimal_vectors.size() - 1;
+         } else if ( column_type == "double" ) {
             type = ColumnType::DOUBLE;
             double_vectors.push_back({});
             vector_offset = double_vectors.size() - 1;
+         } else if ( column_type == "float" ) {
+            type = ColumnType::FLOAT;
+            float_vectors.push_back({});
+            vector_offset = float_vectors.size() - 1;
          } else if ( column_type == "string" ) {
             type = ColumnType::STRING;
             string_vectors.push_back({});
@@ -56,7 +97,7 @@ void convertCSV(const string csv_path, const YAML::Node &schema, const string &o
          } else {
             type = ColumnType::SKIP;
          }
-         columns.push_back({column_name, type, vector_offset, {}});
+         columns.push_back({column_name, type, vector_offset, {}, decimal_precision, decimal_scale});
       }
    }
    // read csv data and fill the columns
@@ -108,6 +149,87 @@ void convertCSV(const string csv_path, const YAML::Node &schema, const string &o
                      column_descriptor.empty_count += (value == 0) ? 1 : 0;
                      break;
                   }
+                  case ColumnType::BIGINT: {
+                     const bool is_set = (column_str.size() == 0 || column_str == "null") ? 0 : 1;
+                     column_descriptor.set_bitmap.push_back(is_set);
+                     // -------------------------------------------------------------------------------------
+                     const BIGINT value = (is_set ? std::stoll(column_str) : NULL_CODE);
+                     bigint_vectors[column_descriptor.vector_offset].push_back(value);
+                     // -------------------------------------------------------------------------------------
+                     // Update stats
+                     column_descriptor.null_count += !is_set;
+                     column_descriptor.empty_count += (value == 0) ? 1 : 0;
+                     break;
+                  }
+                  case ColumnType::SMALLINT: {
+                     const bool is_set = (column_str.size() == 0 || column_str == "null") ? 0 : 1;
+                     column_descriptor.set_bitmap.push_back(is_set);
+                     // -------------------------------------------------------------------------------------
+                     const INTEGER parsed = (is_set ? std::stoi(column_str) : NULL_CODE);
+                     if ( parsed < std::numeric_limits<SMALLINT>::min() || parsed > std::numeric_limits<SMALLINT>::max() ) {
+                        throw std::out_of_range("value does not fit into smallint");
+                     }
+                     const SMALLINT value = static_cast<SMALLINT>(parsed);
+                     smallint_vectors[column_descriptor.vector_offset].push_back(value);
+                     // -------------------------------------------------------------------------------------
+                     // Update stats
+                     column_descriptor.null_count += !is_set;
+                     column_descriptor.empty_count += (value == 0) ? 1 : 0;
+                     break;
+                  }
+                  case ColumnType::TINYINT: {
+                     const bool is_set = (column_str.size() == 0 || column_str == "null") ? 0 : 1;
+                     column_descriptor.set_bitmap.push_back(is_set);
+                     // -------------------------------------------------------------------------------------
+                     const INTEGER parsed = (is_set ? std::stoi(column_str) : NULL_CODE);
+                     if ( parsed < std::numeric_limits<TINYINT>::min() || parsed > std::numeric_limits<TINYINT>::max() ) {
+                        throw std::out_of_range("value does not fit into tinyint");
+                     }
+                     const TINYINT value = static_cast<TINYINT>(parsed);
+                     tinyint_vectors[column_descriptor.vector_offset].push_back(value);
+                     // -------------------------------------------------------------------------------------
+                     // Update stats
+                     column_descriptor.null_count += !is_set;
+                     column_descriptor.empty_count += (value == 0) ? 1 : 0;
+                     break;
+                  }
+                  case ColumnType::TIMESTAMP: {
+                     const bool is_set = (column_str.size() == 0 || column_str == "null") ? 0 : 1;
+                     column_descriptor.set_bitmap.push_back(is_set);
+                     // -------------------------------------------------------------------------------------
+                     // Nulls repeat the previous timestamp to keep the deltas small
+                     auto &values = timestamp_vectors[column_descriptor.vector_offset];
+                     const TIMESTAMP value = is_set ? Temporal::parseTimestamp(column_str) : (values.empty() ? 0 : values.back());
+                     values.push_back(value);
+                     // -------------------------------------------------------------------------------------
+                     // Update stats
+                     column_descriptor.null_count += !is_set;
+                     break;
+                  }
+                  case ColumnType::DATE: {
+                     const bool is_set = (column_str.size() == 0 || column_str == "null") ? 0 : 1;
+                     column_descriptor.set_bitmap.push_back(is_set);
+                     // -------------------------------------------------------------------------------------
+                     auto &values = date_vectors[column_descriptor.vector_offset];
+                     const DATE value = is_set ? Temporal::parseDate(column_str) : (values.empty() ? 0 : values.back());
+                     values.push_back(value);
+                     // -------------------------------------------------------------------------------------
+                     // Update stats
+                     column_descriptor.null_count += !is_set;
+                     break;
+                  }
+                  case ColumnType::DECIMAL: {
+                     const bool is_set = (column_str.size() == 0 || column_str == "null") ? 0 : 1;
+                     column_descriptor.set_bitmap.push_back(is_set);
+                     // -------------------------------------------------------------------------------------
+                     const DECIMAL value = (is_set ? Decimal::parse(column_str, column_descriptor.decimal_precision, column_descriptor.decimal_scale) : 0);
+                     decimal_vectors[column_descriptor.vector_offset].push_back(value);
+                     // -------------------------------------------------------------------------------------
+                     // Update stats
+                     column_descriptor.null_count += !is_set;
+                     column_descriptor.empty_count += (value == 0) ? 1 : 0;
+                     break;
+                  }
                   case ColumnType::DOUBLE: {
                      const bool is_set = (column_str.size() == 0 || column_str == "null") ? 0 : 1;
                      column_descriptor.set_bitmap.push_back(is_set);
@@ -120,6 +242,18 @@ void convertCSV(const string csv_path, const YAML::Node &schema, const string &o
                      column_descriptor.empty_count += (value == 0) ? 1 : 0;
                      break;
                   }
+                  case ColumnType::FLOAT: {
+                     const bool is_set = (column_str.size() == 0 || column_str == "null") ? 0 : 1;
+                     column_descriptor.set_bitmap.push_back(is_set);
+                     // -------------------------------------------------------------------------------------
+                     FLOAT value = (is_set ? std::stof(column_str) : static_cast<FLOAT>(NULL_CODE));
+                     float_vectors[column_descriptor.vector_offset].push_back(value);
+                     // -------------------------------------------------------------------------------------
+                     // Update stats
+                     column_descriptor.null_count += !is_set;
+                     column_descriptor.empty_count += (value == 0) ? 1 : 0;
+                     break;
+                  }
                   case ColumnType::STRING: {
                      const bool is_set = (column_str == "null") ? 0 : 1;
                      column_descriptor.set_bitmap.push_back(is_set);
@@ -172,6 +306,42 @@ void convertCSV(const string csv_path, const YAML::Node &schema, const string &o
                writeBinary(output_column_file.c_str(), double_vectors[column_descriptor.vector_offset]);
                break;
             }
+            case ColumnType::BIGINT: {
+               output_column_file += ".bigint";
+               writeBinary(output_column_file.c_str(), bigint_vectors[column_descriptor.vector_offset]);
+               break;
+            }
+            case ColumnType::SMALLINT: {
+               output_column_file += ".smallint";
+               writeBinary(output_column_file.c_str(), smallint_vectors[column_descriptor.vector_offset]);
+               break;
+            }
+            case ColumnType::TINYINT: {
+               output_column_file += ".tinyint";
+               writeBinary(output_column_file.c_str(), tinyint_vectors[column_descriptor.vector_offset]);
+               break;
+            }
+            case ColumnType::TIMESTAMP: {
+               output_column_file += ".timestamp";
+               writeBinary(output_column_file.c_str(), timestamp_vectors[column_descriptor.vector_offset]);
+               break;
+            }
+            case ColumnType::DATE: {
+               output_column_file += ".date";
+               writeBinary(output_column_file.c_str(), date_vectors[column_descriptor.vector_offset]);
+               break;
+            }
+            case ColumnType::DECIMAL: {
+               // The scale stays in the schema
+               output_column_file += ".decimal";
+               writeBinary(output_column_file.c_str(), decimal_vectors[column_descriptor.vector_offset]);
+               break;
+            }
+            case ColumnType::FLOAT: {
+               output_column_file += ".float";
+               writeBinary(output_column_file.c_str(), float_vectors[column_descriptor.vector_offset]);
+               break;
+            }
             case ColumnType::STRING: {
                output_column_file += ".string";
                writeBinary(output_column_file.c_str(), string_vectors[column_descriptor.vector_offset]);
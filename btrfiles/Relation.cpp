@@ -1,5 +1,6 @@
 // ------------------------------------------------------------------------------
 #include "btrfiles.hpp"
+#include "common/Decimal.hpp"
 #include "storage/Relation.hpp"
 // ------------------------------------------------------------------------------
 #include <yaml-cpp/yaml.h>
@@ -14,10 +15,10 @@ Relation readDirectory(const YAML::Node& schema, const string& columns_dir, cons
     const auto& column = columns[column_i];
     const auto column_name = column["name"].as<string>();
     auto column_type = column["type"].as<string>();
-    if (column_type == "smallint") {
-      column_type = "integer";
-    } else if (column_type == "float") {
-      column_type = "double";
+    // "decimal(p,s)" columns are stored in ".decimal" files
+    u8 decimal_precision = 0, decimal_scale = 0;
+    if (Decimal::parseType(column_type, decimal_precision, decimal_scale)) {
+      column_type = "decimal";
     }
     // -------------------------------------------------------------------------------------
     if (only_type != "" && column_type != only_type) { continue; }
@@ -25,7 +26,11 @@ Relation readDirectory(const YAML::Node& schema, const string& columns_dir, cons
     const string column_file_prefix =
         columns_dir + std::to_string(column_i + 1) + "_" + column_name;
     const string column_file_path = column_file_prefix + "." + column_type;
-    if (column_type == "integer" || column_type == "double" || column_type == "string") {
+    if (column_type == "decimal") {
+      result.addColumn(column_file_path, decimal_scale);
+    } else if (column_type == "integer" || column_type == "bigint" || column_type == "smallint" ||
+        column_type == "tinyint" || column_type == "timestamp" || column_type == "date" ||
+        column_type == "double" || column_type == "float" || column_type == "string") {
       result.addColumn(column_file_path);
     }
   }
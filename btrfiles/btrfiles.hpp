@@ -18,9 +18,9 @@
 //   - name: F2
 //     type: string
 //   - name: F3
-//     type: skip     # skip unsupported date column
+//     type: date     # YYYY-MM-DD, timestamps use type: timestamp
 //   - name: F4
-//     type: double
+//     type: double   # or decimal(p,s) for fixed-point values
 //   - name: F5
 //     type: double
 //   - name: F6
@@ -13,3 +13,7 @@ endif (CYGWIN)
 if (CMAKE_SYSTEM_PROCESSOR MATCHES "arm" OR CMAKE_SYSTEM_PROCESSOR MATCHES "aarch64")
     set(IS_AARCH64 ON)
 endif ()
+
+if (CMAKE_SYSTEM_PROCESSOR MATCHES "x86_64|AMD64|amd64|i.86")
+    set(IS_X86 ON)
+endif ()
@@ -191,6 +191,289 @@ int main(int argc, char **argv)
       // TODO:
    }
    // -------------------------------------------------------------------------------------
+   // BIGINT
+   {
+      vector<BIGINT> bigints;
+      if ( mkdir(TEST_DATASET("bigint"), S_IRWXU | S_IRWXG) && errno != EEXIST ) {
+         cerr << "creating output directory failed, status = " << errno << endl;
+      }
+      // FOR: ids far above 2^32 in a narrow range, narrowed to 32 bits
+      {
+         constexpr BIGINT base = 1ll << 40;
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            bigints.push_back(base + (std::rand() % 100000));
+         }
+         writeBinary(TEST_DATASET("bigint/FOR.bigint"), bigints);
+         writeBinary(TEST_DATASET("bigint/FOR.bitmap"), bitmap);
+         bigints.clear();
+      }
+      // FOR wide: the range does not fit into 32 bits
+      {
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            bigints.push_back((static_cast<BIGINT>(std::rand() % 1000) << 32) - std::rand());
+         }
+         writeBinary(TEST_DATASET("bigint/FOR_WIDE.bigint"), bigints);
+         writeBinary(TEST_DATASET("bigint/FOR_WIDE.bitmap"), bitmap);
+         bigints.clear();
+      }
+      // Delta: epoch nanosecond timestamps with jitter
+      {
+         BIGINT timestamp = 1700000000000000000ll;
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            timestamp += 1000000 + (std::rand() % 1000);
+            bigints.push_back(timestamp);
+         }
+         writeBinary(TEST_DATASET("bigint/DELTA.bigint"), bigints);
+         writeBinary(TEST_DATASET("bigint/DELTA.bitmap"), bitmap);
+         bigints.clear();
+      }
+      // RLE
+      {
+         BIGINT value = std::numeric_limits<BIGINT>::min();
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            if ( std::rand() % 20 == 0 ) {
+               value = (static_cast<BIGINT>(std::rand()) << 32) | std::rand();
+            }
+            bigints.push_back(value);
+         }
+         writeBinary(TEST_DATASET("bigint/RLE.bigint"), bigints);
+         writeBinary(TEST_DATASET("bigint/RLE.bitmap"), bitmap);
+         bigints.clear();
+      }
+      // Dictionary
+      {
+         vector<BIGINT> distinct_values;
+         for ( u32 i = 0; i < 1000; i++ ) {
+            distinct_values.push_back((static_cast<BIGINT>(std::rand()) << 32) | std::rand());
+         }
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            bigints.push_back(distinct_values[std::rand() % distinct_values.size()]);
+         }
+         writeBinary(TEST_DATASET("bigint/DICTIONARY.bigint"), bigints);
+         writeBinary(TEST_DATASET("bigint/DICTIONARY.bitmap"), bitmap);
+         bigints.clear();
+      }
+      // Sparse: 85% null rows, whose slots hold garbage
+      {
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            if ( std::rand() % 20 < 17 ) {
+               bigints.push_back((static_cast<BIGINT>(std::rand()) << 32) | std::rand());
+               bitmap[i] = 0;
+            } else {
+               bigints.push_back((static_cast<BIGINT>(std::rand() % 1000) << 32) + std::rand() % 1000);
+            }
+         }
+         writeBinary(TEST_DATASET("bigint/SPARSE.bigint"), bigints);
+         writeBinary(TEST_DATASET("bigint/SPARSE.bitmap"), bitmap);
+         bigints.clear();
+         bitmap = vector<BITMAP>(FLAGS_tuple_count, 1);
+      }
+   }
+   // -------------------------------------------------------------------------------------
+   // SMALLINT
+   {
+      vector<SMALLINT> smallints;
+      if ( mkdir(TEST_DATASET("smallint"), S_IRWXU | S_IRWXG) && errno != EEXIST ) {
+         cerr << "creating output directory failed, status = " << errno << endl;
+      }
+      // FOR: negative values over the whole range
+      {
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            smallints.push_back(std::numeric_limits<SMALLINT>::min() + (std::rand() % 65536));
+         }
+         writeBinary(TEST_DATASET("smallint/FOR.smallint"), smallints);
+         writeBinary(TEST_DATASET("smallint/FOR.bitmap"), bitmap);
+         smallints.clear();
+      }
+      // RLE
+      {
+         SMALLINT value = 0;
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            if ( std::rand() % 20 == 0 ) {
+               value = std::rand() % std::numeric_limits<SMALLINT>::max();
+            }
+            smallints.push_back(value);
+         }
+         writeBinary(TEST_DATASET("smallint/RLE.smallint"), smallints);
+         writeBinary(TEST_DATASET("smallint/RLE.bitmap"), bitmap);
+         smallints.clear();
+      }
+      // Dictionary with NULLs: a few hundred distinct values, 20% of the rows null
+      {
+         vector<SMALLINT> distinct_values;
+         for ( u32 i = 0; i < 300; i++ ) {
+            distinct_values.push_back(std::numeric_limits<SMALLINT>::min() + (std::rand() % 65536));
+         }
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            smallints.push_back(distinct_values[std::rand() % distinct_values.size()]);
+            if ( std::rand() % 5 == 0 ) {
+               bitmap[i] = 0;
+            }
+         }
+         writeBinary(TEST_DATASET("smallint/DICTIONARY_NULLS.smallint"), smallints);
+         writeBinary(TEST_DATASET("smallint/DICTIONARY_NULLS.bitmap"), bitmap);
+         smallints.clear();
+         bitmap = vector<BITMAP>(FLAGS_tuple_count, 1);
+      }
+   }
+   // -------------------------------------------------------------------------------------
+   // TINYINT
+   {
+      vector<TINYINT> tinyints;
+      if ( mkdir(TEST_DATASET("tinyint"), S_IRWXU | S_IRWXG) && errno != EEXIST ) {
+         cerr << "creating output directory failed, status = " << errno << endl;
+      }
+      // Dictionary: a handful of enum values
+      {
+         const vector<TINYINT> distinct_values = {-100, -3, 0, 7, 42, 127};
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            tinyints.push_back(distinct_values[std::rand() % distinct_values.size()]);
+         }
+         writeBinary(TEST_DATASET("tinyint/DICTIONARY.tinyint"), tinyints);
+         writeBinary(TEST_DATASET("tinyint/DICTIONARY.bitmap"), bitmap);
+         tinyints.clear();
+      }
+      // RLE with NULLs: short and long runs, some of them all null
+      {
+         TINYINT value = 0;
+         bool null_run = false;
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            if ( std::rand() % (std::rand() % 2 ? 4 : 100) == 0 ) {
+               value = std::rand() % 256 - 128;
+               null_run = std::rand() % 8 == 0;
+            }
+            tinyints.push_back(value);
+            if ( null_run || std::rand() % 5 == 0 ) {
+               bitmap[i] = 0;
+            }
+         }
+         writeBinary(TEST_DATASET("tinyint/RLE_NULLS.tinyint"), tinyints);
+         writeBinary(TEST_DATASET("tinyint/RLE_NULLS.bitmap"), bitmap);
+         tinyints.clear();
+         bitmap = vector<BITMAP>(FLAGS_tuple_count, 1);
+      }
+   }
+   // -------------------------------------------------------------------------------------
+   // TIMESTAMP
+   {
+      vector<TIMESTAMP> timestamps;
+      if ( mkdir(TEST_DATASET("timestamp"), S_IRWXU | S_IRWXG) && errno != EEXIST ) {
+         cerr << "creating output directory failed, status = " << errno << endl;
+      }
+      // Delta of delta: one reading per second with rare jitter and gaps
+      {
+         TIMESTAMP timestamp = 1700000000ll * 1000000;
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            timestamp += 1000000;
+            if ( std::rand() % 100 == 0 ) {
+               timestamp += std::rand() % 1000;
+            }
+            if ( std::rand() % 5000 == 0 ) {
+               timestamp += 3600ll * 1000000;
+            }
+            timestamps.push_back(timestamp);
+         }
+         writeBinary(TEST_DATASET("timestamp/DELTA_OF_DELTA.timestamp"), timestamps);
+         writeBinary(TEST_DATASET("timestamp/DELTA_OF_DELTA.bitmap"), bitmap);
+         timestamps.clear();
+      }
+   }
+   // -------------------------------------------------------------------------------------
+   // DATE
+   {
+      vector<DATE> dates;
+      if ( mkdir(TEST_DATASET("date"), S_IRWXU | S_IRWXG) && errno != EEXIST ) {
+         cerr << "creating output directory failed, status = " << errno << endl;
+      }
+      // Delta: order dates, a few hundred rows per day
+      {
+         DATE date = 19000;
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            if ( std::rand() % 300 == 0 ) {
+               date++;
+            }
+            dates.push_back(date);
+         }
+         writeBinary(TEST_DATASET("date/DELTA.date"), dates);
+         writeBinary(TEST_DATASET("date/DELTA.bitmap"), bitmap);
+         dates.clear();
+      }
+   }
+   // -------------------------------------------------------------------------------------
+   // DECIMAL
+   {
+      vector<DECIMAL> decimals;
+      if ( mkdir(TEST_DATASET("decimal"), S_IRWXU | S_IRWXG) && errno != EEXIST ) {
+         cerr << "creating output directory failed, status = " << errno << endl;
+      }
+      // FOR: decimal(12,2) prices in cents
+      {
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            decimals.push_back(100000 + (std::rand() % 10000000));
+         }
+         writeBinary(TEST_DATASET("decimal/FOR.decimal"), decimals);
+         writeBinary(TEST_DATASET("decimal/FOR.bitmap"), bitmap);
+         decimals.clear();
+      }
+   }
+   // -------------------------------------------------------------------------------------
+   // FLOAT
+   {
+      vector<FLOAT> floats;
+      if ( mkdir(TEST_DATASET("float"), S_IRWXU | S_IRWXG) && errno != EEXIST ) {
+         cerr << "creating output directory failed, status = " << errno << endl;
+      }
+      // ALP: prices with two decimals and a few values that need patches
+      {
+         floats = vector<FLOAT>(FLAGS_tuple_count);
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            if ( rand() % 100 > 98 ) {
+               floats[i] = static_cast<FLOAT>(rand()) / RAND_MAX;
+            } else {
+               floats[i] = (rand() % 100000) / 100.0f;
+            }
+         }
+         writeBinary(TEST_DATASET("float/ALP.float"), floats);
+         writeBinary(TEST_DATASET("float/ALP.bitmap"), bitmap);
+         floats.clear();
+      }
+      // RLE
+      {
+         floats = vector<FLOAT>(FLAGS_tuple_count);
+         FLOAT value = 0.5f;
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            if ( rand() % 20 == 0 ) {
+               value = (rand() % 1000) / 8.0f;
+            }
+            floats[i] = value;
+         }
+         writeBinary(TEST_DATASET("float/RLE.float"), floats);
+         writeBinary(TEST_DATASET("float/RLE.bitmap"), bitmap);
+         floats.clear();
+      }
+      // One Value
+      {
+         floats = vector<FLOAT>(FLAGS_tuple_count, 100.25f);
+         writeBinary(TEST_DATASET("float/ONE_VALUE.float"), floats);
+         writeBinary(TEST_DATASET("float/ONE_VALUE.bitmap"), bitmap);
+         floats.clear();
+      }
+      // Dictionary: 200 distinct values in random order
+      {
+         vector<FLOAT> distinct_values;
+         for ( u32 i = 0; i < 200; i++ ) {
+            distinct_values.push_back((rand() % 2000000 - 1000000) / 16.0f);
+         }
+         floats = vector<FLOAT>(FLAGS_tuple_count);
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            floats[i] = distinct_values[rand() % distinct_values.size()];
+         }
+         writeBinary(TEST_DATASET("float/DICTIONARY.float"), floats);
+         writeBinary(TEST_DATASET("float/DICTIONARY.bitmap"), bitmap);
+         floats.clear();
+      }
+   }
+   // -------------------------------------------------------------------------------------
    // STRING
    {
       vector<STRING> strings;
@@ -304,6 +587,96 @@ int main(int argc, char **argv)
             integers.clear();
          }
       }
+      // DELTA
+      {
+         vector<INTEGER> integers;
+         {
+            // ascending with a few descents that end up as patches
+            integers = vector<INTEGER>(FLAGS_tuple_count);
+            INTEGER value = rand() % 100000;
+            for ( uint32_t i = 0; i < FLAGS_tuple_count; i++ ) {
+               if ( rand() % 1000 == 0 ) {
+                  value -= rand() % 1000;
+               } else {
+                  value += rand() % 16;
+               }
+               integers[i] = value;
+            }
+            writeBinary(TEST_DATASET("integer/DELTA.integer"), integers);
+            writeBinary(TEST_DATASET("integer/DELTA.bitmap"), bitmap);
+            integers.clear();
+         }
+      }
+      // FOR
+      {
+         vector<INTEGER> integers;
+         {
+            // small negative and positive values
+            integers = vector<INTEGER>(FLAGS_tuple_count);
+            for ( uint32_t i = 0; i < FLAGS_tuple_count; i++ ) {
+               integers[i] = (rand() % 200) - 100;
+            }
+            writeBinary(TEST_DATASET("integer/FOR.integer"), integers);
+            writeBinary(TEST_DATASET("integer/FOR.bitmap"), bitmap);
+            integers.clear();
+         }
+      }
+      // SEQUENCE
+      {
+         vector<INTEGER> integers;
+         {
+            // row ids with a stride of 3 and a few outliers that end up as patches
+            integers = vector<INTEGER>(FLAGS_tuple_count);
+            for ( uint32_t i = 0; i < FLAGS_tuple_count; i++ ) {
+               integers[i] = rand() % 1000 == 0 ? rand() : 1000 + 3 * static_cast<INTEGER>(i);
+            }
+            writeBinary(TEST_DATASET("integer/SEQUENCE.integer"), integers);
+            writeBinary(TEST_DATASET("integer/SEQUENCE.bitmap"), bitmap);
+            integers.clear();
+         }
+      }
+      // SPARSE
+      {
+         vector<INTEGER> integers;
+         {
+            // 90% null rows, whose slots hold garbage
+            integers = vector<INTEGER>(FLAGS_tuple_count);
+            for ( uint32_t i = 0; i < FLAGS_tuple_count; i++ ) {
+               integers[i] = rand();
+               if ( rand() % 10 ) {
+                  bitmap[i] = 0;
+               } else {
+                  integers[i] = rand() % 1000;
+               }
+            }
+            writeBinary(TEST_DATASET("integer/SPARSE.integer"), integers);
+            writeBinary(TEST_DATASET("integer/SPARSE.bitmap"), bitmap);
+            integers.clear();
+            bitmap = vector<BITMAP>(FLAGS_tuple_count, 1);
+         }
+      }
+      // RLE with NULLs: null rows keep the value of their run, some runs are all null
+      {
+         vector<INTEGER> integers;
+         {
+            INTEGER value = 0;
+            bool null_run = false;
+            for ( uint32_t i = 0; i < FLAGS_tuple_count; i++ ) {
+               if ( rand() % 16 == 0 ) {
+                  value = rand() % 100 - 50;
+                  null_run = rand() % 8 == 0;
+               }
+               integers.push_back(value);
+               if ( null_run || rand() % 5 == 0 ) {
+                  bitmap[i] = 0;
+               }
+            }
+            writeBinary(TEST_DATASET("integer/RLE_NULLS.integer"), integers);
+            writeBinary(TEST_DATASET("integer/RLE_NULLS.bitmap"), bitmap);
+            integers.clear();
+            bitmap = vector<BITMAP>(FLAGS_tuple_count, 1);
+         }
+      }
       // -------------------------------------------------------------------------------------
       // Double
       {
@@ -323,6 +696,62 @@ int main(int argc, char **argv)
             doubles.clear();
          }
       }
+      // ALP
+      {
+         vector<DOUBLE> doubles;
+         {
+            // prices with two decimals and a few values that need patches
+            doubles = vector<DOUBLE>(FLAGS_tuple_count);
+            for ( uint32_t i = 0; i < FLAGS_tuple_count; i++ ) {
+               if ( rand() % 100 > 98 ) {
+                  doubles[i] = static_cast<DOUBLE>(rand()) / RAND_MAX;
+               } else {
+                  doubles[i] = (rand() % 1000000) / 100.0;
+               }
+            }
+            writeBinary(TEST_DATASET("double/ALP.double"), doubles);
+            writeBinary(TEST_DATASET("double/ALP.bitmap"), bitmap);
+            doubles.clear();
+         }
+      }
+      // XOR
+      {
+         vector<DOUBLE> doubles;
+         {
+            // slowly drifting sensor readings that repeat for a while
+            doubles = vector<DOUBLE>(FLAGS_tuple_count);
+            DOUBLE reading = 20.0;
+            for ( uint32_t i = 0; i < FLAGS_tuple_count; i++ ) {
+               if ( rand() % 4 == 0 ) {
+                  reading += static_cast<DOUBLE>(rand() % 2001 - 1000) / 3e5;
+               }
+               doubles[i] = reading;
+            }
+            writeBinary(TEST_DATASET("double/XOR.double"), doubles);
+            writeBinary(TEST_DATASET("double/XOR.bitmap"), bitmap);
+            doubles.clear();
+         }
+      }
+      // SPARSE
+      {
+         vector<DOUBLE> doubles;
+         {
+            // 85% null rows, whose slots hold garbage
+            doubles = vector<DOUBLE>(FLAGS_tuple_count);
+            for ( uint32_t i = 0; i < FLAGS_tuple_count; i++ ) {
+               if ( rand() % 20 < 17 ) {
+                  doubles[i] = static_cast<DOUBLE>(rand()) / RAND_MAX;
+                  bitmap[i] = 0;
+               } else {
+                  doubles[i] = (rand() % 100000) / 100.0;
+               }
+            }
+            writeBinary(TEST_DATASET("double/SPARSE.double"), doubles);
+            writeBinary(TEST_DATASET("double/SPARSE.bitmap"), bitmap);
+            doubles.clear();
+            bitmap = vector<BITMAP>(FLAGS_tuple_count, 1);
+         }
+      }
       // String
       // -------------------------------------------------------------------------------------
       const u32 TZT_MIN_INPUT = 200 * 1024;
@@ -351,6 +780,17 @@ int main(int argc, char **argv)
          writeBinary(TEST_DATASET("string/COMPRESSED_DICTIONARY.bitmap"), bitmap);
          strings.clear();
       }
+      // Front-coded dictionary
+      {
+         // URL-like values sharing long prefixes
+         for ( u64 i = 0; i < FLAGS_tuple_count; i++ ) {
+            strings.push_back("https://www.example.com/catalog/" + std::to_string(rand() % 4096) + "/item/" +
+                              std::to_string(rand() % 8));
+         }
+         writeBinary(TEST_DATASET("string/FRONT_CODED_DICTIONARY.string"), strings);
+         writeBinary(TEST_DATASET("string/FRONT_CODED_DICTIONARY.bitmap"), bitmap);
+         strings.clear();
+      }
    }
    return 0;
 }
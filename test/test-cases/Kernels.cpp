@@ -0,0 +1,261 @@
+// -------------------------------------------------------------------------------------
+#include "common/CpuDispatch.hpp"
+#include "common/Kernels.hpp"
+#include "common/SIMD.hpp"
+#include "extern/RoaringBitmap.hpp"
+// -------------------------------------------------------------------------------------
+#include "gtest/gtest.h"
+// -------------------------------------------------------------------------------------
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <random>
+// -------------------------------------------------------------------------------------
+using namespace btrblocks;
+// -------------------------------------------------------------------------------------
+namespace {
+// -------------------------------------------------------------------------------------
+// None of them is a multiple of the vector widths, so every kernel runs its tail
+const std::vector<u32> tuple_counts = {1, 3, 7, 13, 17, 31, 63, 65, 129, 1003, 4099};
+// -------------------------------------------------------------------------------------
+enum class Validity { ALL_NULL, ALL_SET, MIXED };
+const std::vector<Validity> validities = {Validity::ALL_NULL, Validity::ALL_SET, Validity::MIXED};
+// -------------------------------------------------------------------------------------
+// What a kernel may do with dest past the values it returns
+enum class Tail { UNTOUCHED, UNTOUCHED_BUT_AVX2, ANY };
+// -------------------------------------------------------------------------------------
+std::vector<BITMAP> makeNullmap(u32 tuple_count, Validity validity, std::mt19937& gen)
+{
+   std::vector<BITMAP> nullmap(tuple_count + SIMD_EXTRA_BYTES);
+   for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+      switch ( validity ) {
+         case Validity::ALL_NULL:
+            nullmap[row_i] = 0;
+            break;
+         case Validity::ALL_SET:
+            nullmap[row_i] = 1;
+            break;
+         case Validity::MIXED:
+            nullmap[row_i] = gen() % 2;
+            break;
+      }
+   }
+   return nullmap;
+}
+// -------------------------------------------------------------------------------------
+// kernel(dest) returns how many values it wrote. Each supported level has to
+// write exactly the bytes of the scalar kernel.
+template <typename T, typename Kernel>
+void expectSameOnAllLevels(u32 tuple_count, Tail tail, Kernel kernel)
+{
+   const SimdLevel initial_level = CpuDispatch::level();
+   std::vector<T> expected;
+   for ( auto level : {SimdLevel::SCALAR, SimdLevel::AVX2, SimdLevel::AVX512} ) {
+      if ( level > CpuDispatch::supported() ) {
+         break;
+      }
+      SCOPED_TRACE(CpuDispatch::toString(level) + ", " + std::to_string(tuple_count) + " tuples");
+      ASSERT_EQ(CpuDispatch::force(level), level);
+      std::vector<T> dest(tuple_count + SIMD_EXTRA_ELEMENTS(T));
+      std::memset(dest.data(), 0xAB, dest.size() * sizeof(T));
+      const u32 count = kernel(dest.data());
+      ASSERT_LE(count, tuple_count);
+      // -------------------------------------------------------------------------------------
+      std::vector<T> sentinel(1);
+      std::memset(sentinel.data(), 0xAB, sizeof(T));
+      if ( tail == Tail::UNTOUCHED || (tail == Tail::UNTOUCHED_BUT_AVX2 && level != SimdLevel::AVX2) ) {
+         for ( u32 i = count; i < dest.size(); i++ ) {
+            ASSERT_EQ(std::memcmp(&dest[i], sentinel.data(), sizeof(T)), 0) << "written past the end at " << i;
+         }
+      }
+      dest.resize(count);
+      if ( level == SimdLevel::SCALAR ) {
+         expected = std::move(dest);
+      } else {
+         ASSERT_EQ(dest.size(), expected.size());
+         ASSERT_EQ(std::memcmp(dest.data(), expected.data(), count * sizeof(T)), 0);
+      }
+   }
+   CpuDispatch::force(initial_level);
+}
+// -------------------------------------------------------------------------------------
+template <typename T>
+void checkGather(u32 dictionary_count)
+{
+   std::mt19937 gen(42);
+   std::vector<T> dictionary(dictionary_count);
+   for ( auto& value : dictionary ) {
+      value = static_cast<T>(gen()) << (sizeof(T) * 4) ^ gen();
+   }
+   for ( u32 tuple_count : tuple_counts ) {
+      std::vector<INTEGER> codes(tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+      for ( u32 i = 0; i < tuple_count; i++ ) {
+         codes[i] = gen() % dictionary_count;
+      }
+      expectSameOnAllLevels<T>(tuple_count, Tail::UNTOUCHED, [&](T* dest) {
+         Kernels::gather(dest, dictionary.data(), dictionary_count, codes.data(), tuple_count);
+         return tuple_count;
+      });
+   }
+}
+// -------------------------------------------------------------------------------------
+// Single rows, runs shorter than a vector and runs over several vectors
+template <typename V>
+void makeRuns(u32 tuple_count, std::mt19937& gen, std::vector<V>& values, std::vector<INTEGER>& counts)
+{
+   for ( u32 row_i = 0; row_i < tuple_count; ) {
+      u32 count = std::min<u32>(tuple_count - row_i, gen() % 3 == 0 ? 1 + gen() % 100 : 1 + gen() % 4);
+      values.push_back(static_cast<V>(gen()));
+      counts.push_back(count);
+      row_i += count;
+   }
+}
+// -------------------------------------------------------------------------------------
+template <typename T>
+void checkExpandRuns()
+{
+   std::mt19937 gen(42);
+   for ( u32 tuple_count : tuple_counts ) {
+      std::vector<T> values;
+      std::vector<INTEGER> counts;
+      makeRuns(tuple_count, gen, values, counts);
+      // AVX2 finishes each run with a full store
+      expectSameOnAllLevels<T>(tuple_count, Tail::UNTOUCHED_BUT_AVX2, [&](T* dest) {
+         Kernels::expandRuns(dest, values.data(), counts.data(), values.size());
+         return tuple_count;
+      });
+   }
+}
+// -------------------------------------------------------------------------------------
+// INTEGER runs into SMALLINT/TINYINT columns, values out of the narrow range wrap
+template <typename NarrowType>
+void checkExpandRunsNarrow()
+{
+   std::mt19937 gen(42);
+   for ( u32 tuple_count : tuple_counts ) {
+      std::vector<INTEGER> values;
+      std::vector<INTEGER> counts;
+      makeRuns(tuple_count, gen, values, counts);
+      expectSameOnAllLevels<NarrowType>(tuple_count, Tail::UNTOUCHED, [&](NarrowType* dest) {
+         Kernels::expandRunsNarrow(dest, values.data(), counts.data(), values.size());
+         return tuple_count;
+      });
+   }
+}
+// -------------------------------------------------------------------------------------
+template <typename T>
+void checkSelectAndExpandSet()
+{
+   std::mt19937 gen(42);
+   for ( u32 tuple_count : tuple_counts ) {
+      for ( auto validity_type : validities ) {
+         SCOPED_TRACE("validity " + std::to_string(static_cast<int>(validity_type)));
+         auto nullmap = makeNullmap(tuple_count, validity_type, gen);
+         std::vector<T> src(tuple_count + SIMD_EXTRA_ELEMENTS(T));
+         for ( auto& value : src ) {
+            value = static_cast<T>(gen());
+         }
+         // The scalar kernel writes the next slot for every row
+         expectSameOnAllLevels<T>(tuple_count, Tail::ANY, [&](T* dest) {
+            return Kernels::selectSet(dest, src.data(), nullmap.data(), tuple_count);
+         });
+         // -------------------------------------------------------------------------------------
+         std::vector<VALIDITY> validity(bitmap::PackedBitmap::wordCount(tuple_count));
+         bitmap::PackedBitmap::pack(validity.data(), nullmap.data(), tuple_count);
+         expectSameOnAllLevels<T>(tuple_count, Tail::UNTOUCHED, [&](T* dest) {
+            Kernels::expandSet(dest, src.data(), validity.data(), tuple_count);
+            return tuple_count;
+         });
+         // Set bits past the last row do not change anything
+         std::vector<T> expected(tuple_count);
+         Kernels::expandSet(expected.data(), src.data(), validity.data(), tuple_count);
+         if ( tuple_count % 64 != 0 ) {
+            validity.back() |= ~VALIDITY{0} << (tuple_count % 64);
+         }
+         expectSameOnAllLevels<T>(tuple_count, Tail::UNTOUCHED, [&](T* dest) {
+            Kernels::expandSet(dest, src.data(), validity.data(), tuple_count);
+            EXPECT_EQ(std::memcmp(dest, expected.data(), tuple_count * sizeof(T)), 0);
+            return tuple_count;
+         });
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+template <typename T>
+void checkAlp()
+{
+   std::mt19937 gen(42);
+   // (10^exponent, 10^-factor, 10^factor)
+   const std::vector<std::array<T, 3>> parameters = {{1, 1, 1}, {100, 1, 1}, {1000, T(0.1), 10}};
+   for ( u32 tuple_count : tuple_counts ) {
+      // Two-digit decimals, with values that fail the round trip in between
+      std::vector<T> src(tuple_count + SIMD_EXTRA_ELEMENTS(T));
+      for ( u32 i = 0; i < tuple_count; i++ ) {
+         switch ( gen() % 16 ) {
+            case 0:
+               src[i] = std::numeric_limits<T>::quiet_NaN();
+               break;
+            case 1:
+               src[i] = T(-0.0);
+               break;
+            case 2:
+               src[i] = T(1e30);
+               break;
+            case 3:
+               src[i] = static_cast<T>(gen()) / static_cast<T>(gen() | 1);
+               break;
+            default:
+               src[i] = static_cast<T>(static_cast<INTEGER>(gen() % 200000) - 100000) / T(100);
+         }
+      }
+      for ( auto& powers : parameters ) {
+         const T exponent_power = powers[0], factor_fraction = powers[1], factor_power = powers[2];
+         std::vector<INTEGER> digits(tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+         std::vector<INTEGER> exceptions(tuple_count + SIMD_EXTRA_ELEMENTS(INTEGER));
+         expectSameOnAllLevels<INTEGER>(tuple_count, Tail::UNTOUCHED, [&](INTEGER* dest) {
+            Kernels::alpEncode(dest, exceptions.data(), src.data(), tuple_count, exponent_power, factor_fraction, factor_power);
+            return tuple_count;
+         });
+         expectSameOnAllLevels<INTEGER>(tuple_count, Tail::ANY, [&](INTEGER* dest) {
+            return Kernels::alpEncode(digits.data(), dest, src.data(), tuple_count, exponent_power, factor_fraction, factor_power);
+         });
+         expectSameOnAllLevels<T>(tuple_count, Tail::UNTOUCHED, [&](T* dest) {
+            Kernels::alpDecode(dest, digits.data(), tuple_count, factor_power, exponent_power);
+            return tuple_count;
+         });
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+}  // namespace
+// -------------------------------------------------------------------------------------
+TEST(Kernels, Gather)
+{
+   checkGather<u32>(100);
+   checkGather<u64>(100);
+   // Past the L2 cache the gathers are batched with prefetching
+   checkGather<u32>(Kernels::largeDictionaryBytes() / sizeof(u32) + 1);
+   checkGather<u64>(Kernels::largeDictionaryBytes() / sizeof(u64) + 1);
+}
+// -------------------------------------------------------------------------------------
+TEST(Kernels, ExpandRuns)
+{
+   checkExpandRuns<u32>();
+   checkExpandRuns<u64>();
+   checkExpandRunsNarrow<SMALLINT>();
+   checkExpandRunsNarrow<TINYINT>();
+}
+// -------------------------------------------------------------------------------------
+TEST(Kernels, SelectAndExpandSet)
+{
+   checkSelectAndExpandSet<u32>();
+   checkSelectAndExpandSet<u64>();
+}
+// -------------------------------------------------------------------------------------
+TEST(Kernels, Alp)
+{
+   checkAlp<DOUBLE>();
+   checkAlp<FLOAT>();
+}
+// -------------------------------------------------------------------------------------
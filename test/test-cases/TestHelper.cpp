@@ -1,6 +1,51 @@
 #include "TestHelper.hpp"
+#include "common/Hash.hpp"
+#include "common/Utils.hpp"
+#include "compression/BtrReader.hpp"
+#include "storage/StringArrayViewer.hpp"
+#include "storage/StringPointerArrayViewer.hpp"
 // -------------------------------------------------------------------------------------
-
+#include <filesystem>
+// -------------------------------------------------------------------------------------
+namespace {
+// values(value_i) of the row's dictionary entry, run or plain value equals expected(row_i)
+template<typename Values, typename Expected>
+void CheckEncodedRows(const EncodedColumn &encoded, const vector<BITMAP> &nullmap, Values values, Expected expected)
+{
+   u32 run_i = 0;
+   u32 run_end = encoded.encoding == ColumnEncoding::RUNS && encoded.value_count > 0 ? encoded.run_lengths[0] : 0;
+   for ( u32 row_i = 0; row_i < encoded.tuple_count; row_i++ ) {
+      u32 value_i = row_i;
+      if ( encoded.encoding == ColumnEncoding::RUNS ) {
+         while ( run_end <= row_i ) {
+            ASSERT_LT(++run_i, encoded.value_count) << "row " << row_i;
+            run_end += encoded.run_lengths[run_i];
+         }
+         value_i = run_i;
+      }
+      if ( !nullmap[row_i] ) {
+         continue;
+      }
+      if ( encoded.encoding == ColumnEncoding::DICTIONARY ) {
+         value_i = encoded.codes[row_i];
+      }
+      ASSERT_LT(value_i, encoded.value_count) << "row " << row_i;
+      ASSERT_EQ(values(value_i), expected(row_i)) << "row " << row_i;
+   }
+   if ( encoded.encoding == ColumnEncoding::RUNS ) {
+      ASSERT_EQ(run_i + 1, encoded.value_count);
+      ASSERT_EQ(run_end, encoded.tuple_count);
+   }
+}
+// -------------------------------------------------------------------------------------
+template<typename T>
+void CheckEncodedRows(const EncodedColumn &encoded, const vector<BITMAP> &nullmap, const vector<u8> &decompressed)
+{
+   auto values = encoded.valuesAs<T>();
+   auto expected = reinterpret_cast<const T *>(decompressed.data());
+   CheckEncodedRows(encoded, nullmap, [&](u32 i) { return values[i]; }, [&](u32 i) { return expected[i]; });
+}
+}  // namespace
 // -------------------------------------------------------------------------------------
 void TestHelper::CheckRelationCompression(Relation &relation, RelationCompressor &compressor, const vector<u8> expected_compression_schemes)
 {
@@ -27,5 +72,115 @@ void TestHelper::CheckRelationCompression(Relation &relation, RelationCompressor
    }
 }
 // -------------------------------------------------------------------------------------
-
+vector<Range> TestHelper::GetPartRanges(const Relation &relation)
+{
+   OverrideConfig block_size(BtrBlocksConfig::get().block_size, PART_BLOCK_SIZE);
+   return relation.getRanges(btrblocks::SplitStrategy::SEQUENTIAL, 999999);
+}
+// -------------------------------------------------------------------------------------
+vector<char> TestHelper::WriteColumnPart(ColumnPart &part)
+{
+   const auto path = (std::filesystem::temp_directory_path() / "btrblocks_test_part").string();
+   part.writeToDisk(path);
+   vector<char> data;
+   Utils::readFileToMemory(path, data);
+   std::filesystem::remove(path);
+   return data;
+}
+// -------------------------------------------------------------------------------------
+void TestHelper::CheckColumnPart(const Relation &relation, vector<char> &part)
+{
+   auto ranges = GetPartRanges(relation);
+   BtrReader reader(part.data());
+   ASSERT_EQ(reader.getChunkCount(), ranges.size());
+   for ( u32 chunk_i = 0; chunk_i < ranges.size(); chunk_i++ ) {
+      auto input_chunk = relation.getInputChunk(ranges[chunk_i], chunk_i, 0);
+      vector<u8> decompressed;
+      bool requires_copy = reader.readColumn(decompressed, chunk_i);
+      ASSERT_TRUE(input_chunk.compareContents(decompressed.data(), reader.getBitmap(chunk_i)->writeBITMAP(),
+                                              input_chunk.tuple_count, requires_copy)) << "chunk " << chunk_i;
+   }
+}
+// -------------------------------------------------------------------------------------
+void TestHelper::CheckColumnHashes(vector<char> &part, u8 scheme)
+{
+   BtrReader reader(part.data());
+   vector<u8> decompressed;
+   vector<u64> hashes;
+   for ( u32 chunk_i = 0; chunk_i < reader.getChunkCount(); chunk_i++ ) {
+      ASSERT_EQ(reader.getChunkMetadata(chunk_i)->compression_type, scheme) << "chunk " << chunk_i;
+      const u32 tuple_count = reader.getTupleCount(chunk_i);
+      bool requires_copy = reader.readColumn(decompressed, chunk_i);
+      vector<u64> expected(tuple_count);
+      switch ( reader.getColumnType()) {
+         case ColumnType::INTEGER:
+            Hash::hashColumn(expected.data(), reinterpret_cast<const INTEGER *>(decompressed.data()), tuple_count);
+            break;
+         case ColumnType::BIGINT:
+            Hash::hashColumn(expected.data(), reinterpret_cast<const BIGINT *>(decompressed.data()), tuple_count);
+            break;
+         case ColumnType::DOUBLE:
+            Hash::hashColumn(expected.data(), reinterpret_cast<const DOUBLE *>(decompressed.data()), tuple_count);
+            break;
+         case ColumnType::FLOAT:
+            Hash::hashColumn(expected.data(), reinterpret_cast<const FLOAT *>(decompressed.data()), tuple_count);
+            break;
+         case ColumnType::STRING:
+            for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+               expected[row_i] = requires_copy ? Hash::hashValue(StringPointerArrayViewer(decompressed.data())(row_i))
+                                               : Hash::hashValue(StringArrayViewer(decompressed.data())(row_i));
+            }
+            break;
+         default:
+            FAIL() << "type " << ConvertTypeToString(reader.getColumnType());
+      }
+      reader.hashColumn(hashes, chunk_i);
+      auto nullmap = reader.getBitmap(chunk_i)->writeBITMAP();
+      for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+         if ( nullmap[row_i] ) {
+            ASSERT_EQ(hashes[row_i], expected[row_i]) << "chunk " << chunk_i << ", row " << row_i;
+         }
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+void TestHelper::CheckColumnEncoded(vector<char> &part, ColumnEncoding encoding, bool global_codes)
+{
+   BtrReader reader(part.data());
+   vector<u8> decompressed;
+   EncodedColumn encoded;
+   for ( u32 chunk_i = 0; chunk_i < reader.getChunkCount(); chunk_i++ ) {
+      SCOPED_TRACE("chunk " + std::to_string(chunk_i));
+      bool requires_copy = reader.readColumn(decompressed, chunk_i);
+      reader.readColumnEncoded(encoded, chunk_i);
+      ASSERT_EQ(encoded.encoding, encoding);
+      ASSERT_EQ(encoded.global_codes, global_codes);
+      ASSERT_EQ(encoded.tuple_count, reader.getTupleCount(chunk_i));
+      auto nullmap = reader.getBitmap(chunk_i)->writeBITMAP();
+      switch ( reader.getColumnType()) {
+         case ColumnType::INTEGER:
+            CheckEncodedRows<INTEGER>(encoded, nullmap, decompressed);
+            break;
+         case ColumnType::BIGINT:
+            CheckEncodedRows<BIGINT>(encoded, nullmap, decompressed);
+            break;
+         case ColumnType::DOUBLE:
+            CheckEncodedRows<DOUBLE>(encoded, nullmap, decompressed);
+            break;
+         case ColumnType::FLOAT:
+            CheckEncodedRows<FLOAT>(encoded, nullmap, decompressed);
+            break;
+         case ColumnType::STRING: {
+            auto value = [&](const vector<u8> &data, bool pointers, u32 i) {
+               return pointers ? StringPointerArrayViewer(data.data())(i) : StringArrayViewer(data.data())(i);
+            };
+            CheckEncodedRows(encoded, nullmap, [&](u32 i) { return value(encoded.values, encoded.requires_copy, i); },
+                             [&](u32 i) { return value(decompressed, requires_copy, i); });
+            break;
+         }
+         default:
+            FAIL() << "type " << ConvertTypeToString(reader.getColumnType());
+      }
+   }
+}
 // -------------------------------------------------------------------------------------
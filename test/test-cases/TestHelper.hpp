@@ -1,7 +1,10 @@
 #pragma once
 #include "btrblocks.hpp"
 #include "storage/Relation.hpp"
+#include "compression/BtrReader.hpp"
 #include "compression/Datablock.hpp"
+#include "scheme/GlobalDictionary.hpp"
+#include "scheme/string/FsstTable.hpp"
 // -------------------------------------------------------------------------------------
 #include "gtest/gtest.h"
 // -------------------------------------------------------------------------------------
@@ -9,7 +12,28 @@ using namespace btrblocks;
 // -------------------------------------------------------------------------------------
 class TestHelper {
 public:
+   // Rows per chunk of the parts written by WriteColumnPart, the test datasets
+   // end up as several chunks and a shorter last one
+   static constexpr u32 PART_BLOCK_SIZE = 16 * 1024;
+   // -------------------------------------------------------------------------------------
    static void CheckRelationCompression(Relation &relation, RelationCompressor &compressor, const vector<u8> expected_compression_schemes = {});
+   // -------------------------------------------------------------------------------------
+   // The chunks of the first column of relation in a part
+   static vector<Range> GetPartRanges(const Relation &relation);
+   // Compresses the chunks of the first column of relation with scheme_type
+   // and part_encoding into one ColumnPart that stores its data, writes it like
+   // csvtobtr and returns the file contents for a BtrReader
+   template<typename T>
+   static vector<char> WriteColumnPart(const Relation &relation, T scheme_type, const PartEncoding &part_encoding = {});
+   static vector<char> WriteColumnPart(ColumnPart &part);
+   // Every chunk of the part read back with readColumn equals the input chunk
+   static void CheckColumnPart(const Relation &relation, vector<char> &part);
+   // Every chunk of the part was compressed with scheme and hashColumn equals
+   // Hash::hashColumn over the readColumn output on the non-NULL rows
+   static void CheckColumnHashes(vector<char> &part, u8 scheme);
+   // Every chunk of the part comes out of readColumnEncoded with encoding and
+   // global_codes, and its values map back to the readColumn output row by row
+   static void CheckColumnEncoded(vector<char> &part, ColumnEncoding encoding, bool global_codes = false);
 };
 // -------------------------------------------------------------------------------------
 template<typename T>
@@ -26,12 +50,55 @@ inline IntegerSchemeType& EnforceScheme<IntegerSchemeType>::getSchemeRef() {
    return BtrBlocksConfig::get().integers.override_scheme;
 }
 template <>
+inline Integer64SchemeType& EnforceScheme<Integer64SchemeType>::getSchemeRef() {
+   return BtrBlocksConfig::get().bigints.override_scheme;
+}
+template <>
 inline DoubleSchemeType& EnforceScheme<DoubleSchemeType>::getSchemeRef() {
    return BtrBlocksConfig::get().doubles.override_scheme;
 }
 template <>
+inline FloatSchemeType& EnforceScheme<FloatSchemeType>::getSchemeRef() {
+   return BtrBlocksConfig::get().floats.override_scheme;
+}
+template <>
 inline StringSchemeType& EnforceScheme<StringSchemeType>::getSchemeRef() {
    return BtrBlocksConfig::get().strings.override_scheme;
 }
 // ------------------------------------------------------------------------------
-//
+// Sets a config field for the current scope, the old value comes back even
+// when an assertion returns early
+template<typename T>
+struct OverrideConfig {
+   OverrideConfig(T &field, T value) : field(field), saved(field) { field = value; }
+   ~OverrideConfig() { field = saved; }
+   OverrideConfig(const OverrideConfig &) = delete;
+   OverrideConfig &operator=(const OverrideConfig &) = delete;
+
+   T &field;
+   const T saved;
+};
+// The field alone decides the type, the value is converted
+template<typename T, typename V>
+OverrideConfig(T &, V) -> OverrideConfig<T>;
+// ------------------------------------------------------------------------------
+template<typename T>
+vector<char> TestHelper::WriteColumnPart(const Relation &relation, T scheme_type, const PartEncoding &part_encoding)
+{
+   auto ranges = GetPartRanges(relation);
+   ColumnPart part;
+   if ( part_encoding.fsst_table != nullptr ) {
+      part.fsst_table = part_encoding.fsst_table->exported();
+   }
+   if ( part_encoding.global_dictionary != nullptr ) {
+      part.global_dictionary = part_encoding.global_dictionary->exported();
+   }
+   for ( u32 chunk_i = 0; chunk_i < ranges.size(); chunk_i++ ) {
+      // The override only holds for a single compression
+      EnforceScheme<T> enforcer(scheme_type);
+      part.addCompressedChunk(
+          Datablock::compress(relation.getInputChunk(ranges[chunk_i], chunk_i, 0), part_encoding));
+   }
+   return WriteColumnPart(part);
+}
+// ------------------------------------------------------------------------------
@@ -2,18 +2,38 @@
 #include "TestHelper.hpp"
 // -------------------------------------------------------------------------------------
 #include "btrblocks.hpp"
+#include "common/Decimal.hpp"
+#include "common/Temporal.hpp"
 #include "storage/Relation.hpp"
 #include "compression/Datablock.hpp"
 // -------------------------------------------------------------------------------------
 #include "gtest/gtest.h"
 // -------------------------------------------------------------------------------------
+#include "scheme/GlobalDictionary.hpp"
+#include "scheme/SchemeConfig.hpp"
 #include "scheme/SchemePool.hpp"
+#include "scheme/double/Alp.hpp"
+#include "scheme/double/DynamicDictionary.hpp"
+#include "scheme/integer/Sequence.hpp"
+#include "scheme/string/FrontCodedDictionary.hpp"
+#include "scheme/string/DynamicDictionary.hpp"
+#include "scheme/string/FsstTable.hpp"
+#include "scheme/templated/Alp.hpp"
+#include "scheme/templated/Patches.hpp"
+#include "compression/BtrReader.hpp"
+#include "storage/StringArrayViewer.hpp"
+// -------------------------------------------------------------------------------------
+#include <algorithm>
+#include <numeric>
+#include <random>
 // -------------------------------------------------------------------------------------
 using namespace btrblocks;
 // -------------------------------------------------------------------------------------
 TEST(V2, Begin) {
    BtrBlocksConfig::get().integers.schemes = defaultIntegerSchemes();
+   BtrBlocksConfig::get().bigints.schemes = defaultInteger64Schemes();
    BtrBlocksConfig::get().doubles.schemes = defaultDoubleSchemes();
+   BtrBlocksConfig::get().floats.schemes = defaultFloatSchemes();
    BtrBlocksConfig::get().strings.schemes = defaultStringSchemes();
    SchemePool::refresh();
 }
@@ -27,6 +47,69 @@ TEST(V2, StringCompressedDictionary)
    TestHelper::CheckRelationCompression(relation, datablockV2, {CB(StringSchemeType::DICT)});
 }
 // -------------------------------------------------------------------------------------
+TEST(V2, StringFrontCodedDictionary)
+{
+   EnforceScheme<StringSchemeType> enforcer(StringSchemeType::DICT_FRONT_CODED);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("string/FRONT_CODED_DICTIONARY.string"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2,
+                                        {CB(StringSchemeType::DICT_FRONT_CODED)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, StringFrontCodedLookup)
+{
+   // Sorted distinct values with shared prefixes of every length, they span
+   // several restart blocks and end in a partial one
+   vector<string> values = {"", "a", "aa", "aaa", "aab", "ab", "b", "ba", "bab", "zzz"};
+   for ( u32 i = 0; i < 75; i++ ) {
+      values.push_back("key_" + std::to_string(i % 7) + "_" + std::to_string(i));
+   }
+   std::sort(values.begin(), values.end());
+   values.erase(std::unique(values.begin(), values.end()), values.end());
+   const u32 restart_interval = SchemeConfig::get().strings.front_coding_restart_interval;
+   ASSERT_NE(values.size() % restart_interval, 0);
+   // Every value twice in StringArrayViewer layout
+   const u32 tuple_count = 2 * values.size();
+   vector<u8> input(sizeof(StringArrayViewer::Slot) * (tuple_count + 1));
+   for ( u32 row_i = 0; row_i <= tuple_count; row_i++ ) {
+      reinterpret_cast<StringArrayViewer::Slot *>(input.data())[row_i].offset = input.size();
+      if ( row_i < tuple_count ) {
+         const string &value = values[(row_i * 7) % values.size()];
+         input.insert(input.end(), value.begin(), value.end());
+      }
+   }
+   StringArrayViewer viewer(input.data());
+   vector<BITMAP> nullmap(tuple_count, 1);
+   auto stats = StringStats::generateStats(viewer, nullmap.data(), tuple_count, input.size());
+   vector<u8> compressed(input.size() * 2 + 4096);
+   strings::FrontCodedDictionary().compress(viewer, nullmap.data(), compressed.data(), stats);
+   ASSERT_EQ(reinterpret_cast<const strings::FrontCodedDictionaryStructure *>(compressed.data())->num_codes,
+             values.size());
+   // -------------------------------------------------------------------------------------
+   u8 buffer[MAX_STR_LENGTH];
+   for ( u32 code = 0; code < values.size(); code++ ) {
+      u32 length = strings::FrontCodedDictionary::lookup(compressed.data(), code, buffer);
+      ASSERT_EQ(string(reinterpret_cast<const char *>(buffer), length), values[code]) << "code " << code;
+   }
+   // -------------------------------------------------------------------------------------
+   // The values themselves and probes before, after and between them
+   vector<string> probes = {"", "\x7f", "\xff\xff", "0", "key_", "key_3_", "key_9"};
+   for ( const auto &value : values ) {
+      probes.push_back(value);
+      probes.push_back(value + "0");
+      probes.push_back(value + "\xff");
+      if ( !value.empty() ) {
+         probes.push_back(value.substr(0, value.size() - 1));
+         probes.push_back(value.substr(0, value.size() - 1) + static_cast<char>(value.back() + 1));
+      }
+   }
+   for ( const auto &probe : probes ) {
+      const u32 expected = std::lower_bound(values.begin(), values.end(), probe) - values.begin();
+      ASSERT_EQ(strings::FrontCodedDictionary::lowerBound(compressed.data(), probe), expected) << "probe " << probe;
+   }
+}
+// -------------------------------------------------------------------------------------
 TEST(V2, IntegerRLE)
 {
    EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::RLE);
@@ -36,6 +119,478 @@ TEST(V2, IntegerRLE)
    TestHelper::CheckRelationCompression(relation, datablockV2, {CB(IntegerSchemeType::RLE)});
 }
 // -------------------------------------------------------------------------------------
+TEST(V2, IntegerRunsWithNulls)
+{
+   Relation relation;
+   relation.addColumn(TEST_DATASET("integer/RLE_NULLS.integer"));
+   auto ranges = TestHelper::GetPartRanges(relation);
+   auto pred = [](INTEGER value) { return value >= 0; };
+   // RLE hands out its runs, DICT is collapsed into runs
+   for ( auto scheme_type : {IntegerSchemeType::RLE, IntegerSchemeType::DICT} ) {
+      auto part = TestHelper::WriteColumnPart(relation, scheme_type);
+      BtrReader reader(part.data());
+      RunEncodedColumn<INTEGER> runs;
+      std::vector<runs::RowRange> row_ranges;
+      for ( u32 chunk_i = 0; chunk_i < ranges.size(); chunk_i++ ) {
+         auto input_chunk = relation.getInputChunk(ranges[chunk_i], chunk_i, 0);
+         auto values = reinterpret_cast<const INTEGER *>(input_chunk.data.get());
+         const u32 tuple_count = input_chunk.tuple_count;
+         reader.readColumnRuns(runs, chunk_i);
+         ASSERT_EQ(runs.tuple_count, tuple_count);
+         auto nullmap = reader.getBitmap(chunk_i);
+         // -------------------------------------------------------------------------------------
+         u64 expected_count = 0, expected_matches = 0;
+         s64 expected_sum = 0;
+         INTEGER expected_min = std::numeric_limits<INTEGER>::max();
+         INTEGER expected_max = std::numeric_limits<INTEGER>::lowest();
+         std::vector<BITMAP> expected_filter(tuple_count, 0);
+         for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+            if ( !input_chunk.isSet(row_i) ) {
+               continue;
+            }
+            expected_count++;
+            expected_sum += values[row_i];
+            expected_min = std::min(expected_min, values[row_i]);
+            expected_max = std::max(expected_max, values[row_i]);
+            if ( pred(values[row_i]) ) {
+               expected_matches++;
+               expected_filter[row_i] = 1;
+            }
+         }
+         ASSERT_LT(expected_count, tuple_count);
+         ASSERT_EQ(runs::count(runs, nullmap), expected_count);
+         ASSERT_EQ(runs::count(runs, nullmap, pred), expected_matches);
+         ASSERT_EQ(runs::sum(runs, nullmap), expected_sum);
+         ASSERT_EQ(runs::min(runs, nullmap), expected_min);
+         ASSERT_EQ(runs::max(runs, nullmap), expected_max);
+         // -------------------------------------------------------------------------------------
+         std::vector<BITMAP> filtered(tuple_count, 2);
+         ASSERT_EQ(runs::filter(runs, nullmap, pred, filtered.data()), expected_matches);
+         ASSERT_EQ(filtered, expected_filter);
+         std::fill(filtered.begin(), filtered.end(), 0);
+         runs::filter(runs, nullmap, pred, row_ranges);
+         for ( auto &range : row_ranges ) {
+            ASSERT_LT(range.begin, range.end);
+            std::fill(filtered.begin() + range.begin, filtered.begin() + range.end, 1);
+         }
+         ASSERT_EQ(filtered, expected_filter);
+         // Ranges are maximal
+         for ( u32 range_i = 1; range_i < row_ranges.size(); range_i++ ) {
+            ASSERT_LT(row_ranges[range_i - 1].end, row_ranges[range_i].begin);
+         }
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, IntegerDelta)
+{
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::DELTA);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("integer/DELTA.integer"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(IntegerSchemeType::DELTA)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, IntegerFOR)
+{
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::FOR);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("integer/FOR.integer"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(IntegerSchemeType::FOR)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, IntegerSequence)
+{
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::SEQUENCE);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("integer/SEQUENCE.integer"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(IntegerSchemeType::SEQUENCE)});
+}
+// -------------------------------------------------------------------------------------
+// Compresses the line base + stride * row with exceptions at the given rows and
+// checks valueAt and filterRange against a scan for many ranges
+static void CheckSequenceAccess(INTEGER base, INTEGER stride, u32 tuple_count, const vector<u32> &exception_rows)
+{
+   vector<INTEGER> src(tuple_count);
+   for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+      src[row_i] = static_cast<INTEGER>(static_cast<u32>(base) + static_cast<u32>(stride) * row_i);
+   }
+   for ( u32 i = 0; i < exception_rows.size(); i++ ) {
+      const u32 row = exception_rows[i];
+      src[row] = (i % 3 == 0) ? std::numeric_limits<INTEGER>::max()
+                              : (i % 3 == 1) ? std::numeric_limits<INTEGER>::min() : (src[row] ^ 1);
+   }
+   auto stats = SInteger32Stats::generateStats(src.data(), nullptr, tuple_count);
+   stats.sequence_base = base;
+   stats.sequence_stride = stride;
+   vector<u8> compressed(sizeof(integers::SequenceStructure) + tuple_count * (sizeof(u32) + sizeof(INTEGER)));
+   integers::Sequence().compress(src.data(), nullptr, compressed.data(), stats, 1);
+   ASSERT_EQ(reinterpret_cast<const integers::SequenceStructure *>(compressed.data())->exceptions_count,
+             exception_rows.size());
+   for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+      ASSERT_EQ(integers::Sequence::valueAt(compressed.data(), row_i), src[row_i]) << "row " << row_i;
+   }
+   // Bounds on and next to the line, the exceptions and the ends of the domain
+   vector<INTEGER> bounds = {std::numeric_limits<INTEGER>::min(), std::numeric_limits<INTEGER>::max(), 0};
+   for ( u32 row_i : {0u, 1u, tuple_count / 3, tuple_count / 2, tuple_count - 2, tuple_count - 1} ) {
+      for ( s64 delta : {-1, 0, 1} ) {
+         bounds.push_back(static_cast<INTEGER>(std::clamp<s64>(s64(src[row_i]) + delta,
+                                                              std::numeric_limits<INTEGER>::min(),
+                                                              std::numeric_limits<INTEGER>::max())));
+      }
+   }
+   vector<BITMAP> result(tuple_count);
+   for ( INTEGER min : bounds ) {
+      for ( INTEGER max : bounds ) {
+         u32 matches = integers::Sequence::filterRange(compressed.data(), tuple_count, min, max, result.data());
+         u32 expected_matches = 0;
+         for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+            const bool expected = src[row_i] >= min && src[row_i] <= max;
+            expected_matches += expected;
+            ASSERT_EQ(result[row_i], expected) << "[" << min << ", " << max << "] row " << row_i;
+         }
+         ASSERT_EQ(matches, expected_matches) << "[" << min << ", " << max << "]";
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, IntegerSequenceAccess)
+{
+   const u32 n = 1000;
+   for ( const vector<u32> &exception_rows : {vector<u32>{}, vector<u32>{0, n / 2, n - 1}} ) {
+      CheckSequenceAccess(10, 3, n, exception_rows);
+      CheckSequenceAccess(1000, -7, n, exception_rows);
+      CheckSequenceAccess(42, 0, n, exception_rows);
+      // The line wraps around the INTEGER domain
+      CheckSequenceAccess(std::numeric_limits<INTEGER>::max() - 100, 1, n, exception_rows);
+      CheckSequenceAccess(std::numeric_limits<INTEGER>::min() + 50, -3, n, exception_rows);
+      CheckSequenceAccess(1, std::numeric_limits<INTEGER>::max() / 256, n, exception_rows);
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, IntegerSparse)
+{
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::SPARSE);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("integer/SPARSE.integer"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(IntegerSchemeType::SPARSE)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, BigintFOR)
+{
+   EnforceScheme<Integer64SchemeType> enforcer(Integer64SchemeType::FOR);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("bigint/FOR.bigint"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(Integer64SchemeType::FOR)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, BigintFORWide)
+{
+   EnforceScheme<Integer64SchemeType> enforcer(Integer64SchemeType::FOR);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("bigint/FOR_WIDE.bigint"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(Integer64SchemeType::FOR)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, BigintDelta)
+{
+   EnforceScheme<Integer64SchemeType> enforcer(Integer64SchemeType::DELTA);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("bigint/DELTA.bigint"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(Integer64SchemeType::DELTA)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, BigintRLE)
+{
+   EnforceScheme<Integer64SchemeType> enforcer(Integer64SchemeType::RLE);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("bigint/RLE.bigint"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(Integer64SchemeType::RLE)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, BigintSparse)
+{
+   EnforceScheme<Integer64SchemeType> enforcer(Integer64SchemeType::SPARSE);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("bigint/SPARSE.bigint"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(Integer64SchemeType::SPARSE)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, BigintDynamicDict)
+{
+   EnforceScheme<Integer64SchemeType> enforcer(Integer64SchemeType::DICT);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("bigint/DICTIONARY.bigint"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(Integer64SchemeType::DICT)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, SmallintFOR)
+{
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::FOR);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("smallint/FOR.smallint"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(IntegerSchemeType::FOR)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, SmallintRLE)
+{
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::RLE);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("smallint/RLE.smallint"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(IntegerSchemeType::RLE)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, SmallintDynamicDictWithNulls)
+{
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::DICT);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("smallint/DICTIONARY_NULLS.smallint"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(IntegerSchemeType::DICT)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, TinyintDynamicDict)
+{
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::DICT);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("tinyint/DICTIONARY.tinyint"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(IntegerSchemeType::DICT)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, TinyintRLEWithNulls)
+{
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::RLE);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("tinyint/RLE_NULLS.tinyint"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(IntegerSchemeType::RLE)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, TimestampDeltaOfDelta)
+{
+   EnforceScheme<Integer64SchemeType> enforcer(Integer64SchemeType::DELTA_OF_DELTA);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("timestamp/DELTA_OF_DELTA.timestamp"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(Integer64SchemeType::DELTA_OF_DELTA)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, DateDelta)
+{
+   EnforceScheme<IntegerSchemeType> enforcer(IntegerSchemeType::DELTA);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("date/DELTA.date"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(IntegerSchemeType::DELTA)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, TemporalParseAndFormat)
+{
+   ASSERT_EQ(Temporal::parseDate("1970-01-01"), 0);
+   ASSERT_EQ(Temporal::parseDate("1969-12-31"), -1);
+   ASSERT_EQ(Temporal::parseDate("2000-03-01") - Temporal::parseDate("2000-02-28"), 2);
+   ASSERT_EQ(Temporal::parseDate("1900-03-01") - Temporal::parseDate("1900-02-28"), 1);
+   ASSERT_EQ(Temporal::parseDate("2024-2-9"), Temporal::parseDate("2024-02-09"));
+   ASSERT_EQ(Temporal::parseTimestamp("1970-01-01"), 0);
+   ASSERT_EQ(Temporal::parseTimestamp("1970-01-02 00:00:01"), Temporal::MICROS_PER_DAY + Temporal::MICROS_PER_SECOND);
+   ASSERT_EQ(Temporal::parseTimestamp("1970-01-01T00:00:00.5"), Temporal::MICROS_PER_SECOND / 2);
+   // Digits below microseconds are cut off
+   ASSERT_EQ(Temporal::parseTimestamp("1970-01-01 00:00:00.0000019"), 1);
+   ASSERT_EQ(Temporal::parseTimestamp("1969-12-31 23:59:59.999999"), -1);
+   // Days past the end of the month, leap years included
+   for ( const char *date : {"2023-02-29", "1900-02-29", "2024-02-30", "2024-04-31", "2024-13-01", "2024-00-10",
+                             "2024-01-00", "2024-01-32"} ) {
+      ASSERT_THROW(Temporal::parseDate(date), Generic_Exception) << date;
+   }
+   ASSERT_EQ(Temporal::formatDate(Temporal::parseDate("2024-02-29")), "2024-02-29");
+   ASSERT_EQ(Temporal::formatDate(Temporal::parseDate("2000-02-29")), "2000-02-29");
+   // Anything that is not a digit where one is expected
+   for ( const char *date : {"", "2024", "2024-01", "2024-01-", " 2024-01-01", "+2024-01-01", "2024-+1-01", "2024- 1-01",
+                             "2024-01-0a", "2024-01-01x", "2024/01/01", "2024-001-01"} ) {
+      ASSERT_THROW(Temporal::parseDate(date), Generic_Exception) << date;
+   }
+   for ( const char *timestamp : {"2024-01-01 1:00:00", "2024-01-01 01:+1:00", "2024-01-01 01:00: 1",
+                                  "2024-01-01 24:00:00", "2024-01-01 00:60:00", "2024-01-01 00:00:00.",
+                                  "2024-01-01 00:00:00.1x", "2024-01-01x00:00:00", "2024-01-01 "} ) {
+      ASSERT_THROW(Temporal::parseTimestamp(timestamp), Generic_Exception) << timestamp;
+   }
+   // Round trips, before and after the epoch
+   for ( const char *date : {"1970-01-01", "1969-12-31", "1600-02-29", "2024-12-31", "9999-12-31"} ) {
+      ASSERT_EQ(Temporal::formatDate(Temporal::parseDate(date)), date);
+   }
+   for ( const char *timestamp : {"1970-01-01 00:00:00.000000", "1969-12-31 23:59:59.999999",
+                                  "2024-02-29 12:34:56.789012", "1900-01-01 00:00:00.000001"} ) {
+      ASSERT_EQ(Temporal::formatTimestamp(Temporal::parseTimestamp(timestamp)), timestamp);
+   }
+   for ( DATE days = -800000; days <= 800000; days += 997 ) {
+      ASSERT_EQ(Temporal::parseDate(Temporal::formatDate(days)), days);
+   }
+}
+// -------------------------------------------------------------------------------------
+// Every chunk of the part has the min/max of its non-null values as zone map
+template<typename T>
+static void CheckZoneMaps(const Relation &relation, vector<char> &part)
+{
+   auto ranges = TestHelper::GetPartRanges(relation);
+   BtrReader reader(part.data());
+   ASSERT_EQ(reader.getChunkCount(), ranges.size());
+   for ( u32 chunk_i = 0; chunk_i < ranges.size(); chunk_i++ ) {
+      auto input_chunk = relation.getInputChunk(ranges[chunk_i], chunk_i, 0);
+      auto values = reinterpret_cast<const T *>(input_chunk.data.get());
+      s64 expected_min = std::numeric_limits<s64>::max(), expected_max = std::numeric_limits<s64>::min();
+      for ( u32 row_i = 0; row_i < input_chunk.tuple_count; row_i++ ) {
+         if ( input_chunk.isSet(row_i) ) {
+            expected_min = std::min<s64>(expected_min, values[row_i]);
+            expected_max = std::max<s64>(expected_max, values[row_i]);
+         }
+      }
+      auto zone_map = reader.getZoneMap(chunk_i);
+      ASSERT_NE(zone_map, nullptr);
+      ASSERT_EQ(zone_map->min, expected_min) << "chunk " << chunk_i;
+      ASSERT_EQ(zone_map->max, expected_max) << "chunk " << chunk_i;
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, TemporalZoneMap)
+{
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("timestamp/DELTA_OF_DELTA.timestamp"));
+      auto part = TestHelper::WriteColumnPart(relation, Integer64SchemeType::DELTA_OF_DELTA);
+      CheckZoneMaps<TIMESTAMP>(relation, part);
+      TestHelper::CheckColumnPart(relation, part);
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("date/DELTA.date"));
+      auto part = TestHelper::WriteColumnPart(relation, IntegerSchemeType::DELTA);
+      CheckZoneMaps<DATE>(relation, part);
+      TestHelper::CheckColumnPart(relation, part);
+   }
+   {
+      // Other types have none
+      Relation relation;
+      relation.addColumn(TEST_DATASET("bigint/FOR.bigint"));
+      auto part = TestHelper::WriteColumnPart(relation, Integer64SchemeType::FOR);
+      BtrReader reader(part.data());
+      ASSERT_EQ(reader.getZoneMap(0), nullptr);
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, DecimalFOR)
+{
+   EnforceScheme<Integer64SchemeType> enforcer(Integer64SchemeType::FOR);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("decimal/FOR.decimal"), 2);
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(Integer64SchemeType::FOR)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, DecimalParseAndFormat)
+{
+   u8 precision = 0, scale = 0;
+   ASSERT_TRUE(Decimal::parseType("decimal(12,2)", precision, scale));
+   ASSERT_EQ(precision, 12);
+   ASSERT_EQ(scale, 2);
+   ASSERT_TRUE(Decimal::parseType("decimal(5)", precision, scale));
+   ASSERT_EQ(precision, 5);
+   ASSERT_EQ(scale, 0);
+   ASSERT_TRUE(Decimal::parseType("decimal(18,18)", precision, scale));
+   ASSERT_FALSE(Decimal::parseType("integer", precision, scale));
+   ASSERT_FALSE(Decimal::parseType("double", precision, scale));
+   for ( const char *type : {"decimal(0,0)", "decimal(19,2)", "decimal(3,4)", "decimal(12,2)x", "decimal(12,", "decimal()"} ) {
+      ASSERT_THROW(Decimal::parseType(type, precision, scale), Generic_Exception) << type;
+   }
+   // -------------------------------------------------------------------------------------
+   ASSERT_EQ(Decimal::parse("12.34", 5, 2), 1234);
+   ASSERT_EQ(Decimal::parse("-12.34", 5, 2), -1234);
+   ASSERT_EQ(Decimal::parse("+1.5", 5, 2), 150);
+   ASSERT_EQ(Decimal::parse("-0.05", 5, 2), -5);
+   ASSERT_EQ(Decimal::parse("42", 5, 2), 4200);
+   ASSERT_EQ(Decimal::parse("7.", 5, 2), 700);
+   ASSERT_EQ(Decimal::parse(".5", 5, 2), 50);
+   // Fewer fractional digits than the scale are padded
+   ASSERT_EQ(Decimal::parse("1.2", 6, 3), 1200);
+   ASSERT_EQ(Decimal::parse("-1.2", 6, 3), -1200);
+   // Trailing zeros beyond the scale do not round anything
+   ASSERT_EQ(Decimal::parse("1.2300", 5, 2), 123);
+   ASSERT_EQ(Decimal::parse("999.99", 5, 2), 99999);
+   ASSERT_EQ(Decimal::parse("-999999999999999999", 18, 0), -999999999999999999ll);
+   ASSERT_THROW(Decimal::parse("1.234", 5, 2), Generic_Exception);
+   ASSERT_THROW(Decimal::parse("1.2301", 5, 2), Generic_Exception);
+   // Over precision, with and without the padding of the fraction
+   for ( const char *str : {"1000.00", "1000", "-1000.5", "99999.9"} ) {
+      ASSERT_THROW(Decimal::parse(str, 5, 2), Generic_Exception) << str;
+   }
+   ASSERT_THROW(Decimal::parse("1000000000000000000", 18, 0), Generic_Exception);
+   for ( const char *str : {"", "-", "+", ".", "1.2.3", "abc", "1e5", " 1", "1 ", "--1", "1,5"} ) {
+      ASSERT_THROW(Decimal::parse(str, 5, 2), Generic_Exception) << str;
+   }
+   // -------------------------------------------------------------------------------------
+   ASSERT_EQ(Decimal::format(1234, 2), "12.34");
+   ASSERT_EQ(Decimal::format(-5, 2), "-0.05");
+   ASSERT_EQ(Decimal::format(0, 2), "0.00");
+   ASSERT_EQ(Decimal::format(42, 0), "42");
+   ASSERT_EQ(Decimal::format(std::numeric_limits<DECIMAL>::min(), 2), "-92233720368547758.08");
+   for ( const char *str : {"0.00", "12.34", "-12.34", "-0.01", "999.99", "-999.99"} ) {
+      ASSERT_EQ(Decimal::format(Decimal::parse(str, 5, 2), 2), str);
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, DecimalReadAsDoubles)
+{
+   const vector<string> sources = {"0", "0.01", "-0.01", "12.34", "-12.34", "1.5", "0.1", "0.3", "123456789.99",
+                                   "-999999999999.99", "2.675", "1.005", "33.33", "-7"};
+   constexpr u8 precision = 15, scale = 3;
+   const u32 tuple_count = 20000;
+   auto data = makeBytesArray(tuple_count * sizeof(DECIMAL));
+   auto nullmap = std::unique_ptr<BITMAP[]>(new BITMAP[tuple_count]);
+   auto values = reinterpret_cast<DECIMAL *>(data.get());
+   for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+      values[row_i] = Decimal::parse(sources[row_i % sources.size()], precision, scale);
+      nullmap[row_i] = row_i % 7 != 3;
+   }
+   InputChunk input_chunk(std::move(data), std::move(nullmap), ColumnType::DECIMAL, tuple_count, tuple_count * sizeof(DECIMAL));
+   input_chunk.decimal_scale = scale;
+   for ( auto scheme_type : {Integer64SchemeType::FOR, Integer64SchemeType::DICT, Integer64SchemeType::UNCOMPRESSED} ) {
+      ColumnPart part;
+      {
+         EnforceScheme<Integer64SchemeType> enforcer(scheme_type);
+         part.addCompressedChunk(Datablock::compress(input_chunk));
+      }
+      auto file = TestHelper::WriteColumnPart(part);
+      BtrReader reader(file.data());
+      ASSERT_EQ(reader.getDecimalScale(), scale);
+      vector<DOUBLE> output;
+      reader.readColumnAsDoubles(output, 0);
+      for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+         if ( input_chunk.isSet(row_i) ) {
+            // The correctly rounded double of the source string
+            ASSERT_EQ(output[row_i], std::stod(sources[row_i % sources.size()])) << row_i;
+         }
+      }
+   }
+   // Other types are not decimal
+   Relation relation;
+   relation.addColumn(TEST_DATASET("bigint/FOR.bigint"));
+   auto file = TestHelper::WriteColumnPart(relation, Integer64SchemeType::FOR);
+   BtrReader reader(file.data());
+   vector<DOUBLE> output;
+   ASSERT_THROW(reader.readColumnAsDoubles(output, 0), Generic_Exception);
+}
+// -------------------------------------------------------------------------------------
 TEST(V2, DoubleRLE)
 {
    EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::RLE);
@@ -63,6 +618,93 @@ TEST(V2, DoubleDecimal)
    TestHelper::CheckRelationCompression(relation, datablockV2, {CB(DoubleSchemeType::PSEUDODECIMAL)});
 }
 // -------------------------------------------------------------------------------------
+TEST(V2, DoubleAlp)
+{
+   EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::ALP);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("double/ALP.double"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(DoubleSchemeType::ALP)});
+}
+// -------------------------------------------------------------------------------------
+// Vectors of large one-decimal values and of small five-decimal values, no
+// single (exponent, factor) pair encodes both without patching a whole vector
+TEST(V2, DoubleAlpPerVector)
+{
+   const u32 tuple_count = 10 * ALP_VECTOR_SIZE + 100;
+   vector<DOUBLE> values(tuple_count);
+   for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+      const u32 vector_i = row_i / ALP_VECTOR_SIZE;
+      values[row_i] = vector_i % 3 == 1 ? (row_i % 5000) / 1e5 : 1e8 + (row_i % 5000) / 10.0;
+   }
+   auto stats = DoubleStats::generateStats(values.data(), nullptr, tuple_count);
+   doubles::Alp scheme;
+   vector<u8> compressed(tuple_count * sizeof(DOUBLE) * 2 + 4096);
+   scheme.compress(values.data(), nullptr, compressed.data(), stats, 3);
+   const auto &col_struct = *reinterpret_cast<const AlpStructure *>(compressed.data());
+   ASSERT_EQ(col_struct.exceptions_count, 0u);
+   for ( u32 vector_i = 0; vector_i < AlpStructure::vectorCount(tuple_count); vector_i++ ) {
+      ASSERT_EQ(col_struct.parameters()[vector_i].exponent - col_struct.parameters()[vector_i].factor, vector_i % 3 == 1 ? 5 : 1) << vector_i;
+   }
+   vector<DOUBLE> decompressed(tuple_count + SIMD_EXTRA_ELEMENTS(DOUBLE));
+   scheme.decompress(decompressed.data(), nullptr, compressed.data(), tuple_count, 0);
+   ASSERT_EQ(std::memcmp(decompressed.data(), values.data(), tuple_count * sizeof(DOUBLE)), 0);
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, DoubleSparse)
+{
+   EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::SPARSE);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("double/SPARSE.double"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(DoubleSchemeType::SPARSE)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, DoubleXor)
+{
+   EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::XOR);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("double/XOR.double"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(DoubleSchemeType::XOR)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, FloatAlp)
+{
+   EnforceScheme<FloatSchemeType> enforcer(FloatSchemeType::ALP);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("float/ALP.float"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(FloatSchemeType::ALP)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, FloatRLE)
+{
+   EnforceScheme<FloatSchemeType> enforcer(FloatSchemeType::RLE);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("float/RLE.float"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(FloatSchemeType::RLE)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, FloatOneValue)
+{
+   EnforceScheme<FloatSchemeType> enforcer(FloatSchemeType::ONE_VALUE);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("float/ONE_VALUE.float"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(FloatSchemeType::ONE_VALUE)});
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, FloatDynamicDict)
+{
+   EnforceScheme<FloatSchemeType> enforcer(FloatSchemeType::DICT);
+   Relation relation;
+   relation.addColumn(TEST_DATASET("float/DICTIONARY.float"));
+   Datablock datablockV2(relation);
+   TestHelper::CheckRelationCompression(relation, datablockV2, {CB(FloatSchemeType::DICT)});
+}
+// -------------------------------------------------------------------------------------
 TEST(V2, DoubleDyanmicDict)
 {
    EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::DICT);
@@ -72,6 +714,453 @@ TEST(V2, DoubleDyanmicDict)
    TestHelper::CheckRelationCompression(relation, datablockV2, {CB(DoubleSchemeType::DICT)});
 }
 // -------------------------------------------------------------------------------------
+TEST(V2, DoubleGlobalDictionary)
+{
+   Relation relation;
+   relation.addColumn(TEST_DATASET("double/DICTIONARY_8.double"));
+   auto global_dictionary = GlobalDictionary::build(relation.columns[0], 4096);
+   ASSERT_FALSE(global_dictionary.empty());
+   {
+      // Relation blocks have no part and decode without the dictionary
+      EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::DICT);
+      Datablock datablockV2(relation);
+      TestHelper::CheckRelationCompression(relation, datablockV2, {CB(DoubleSchemeType::DICT)});
+   }
+   // -------------------------------------------------------------------------------------
+   auto ranges = relation.getRanges(btrblocks::SplitStrategy::SEQUENTIAL, 999999);
+   auto input_chunk = relation.getInputChunk(ranges[0], 0, 0);
+   std::vector<u8> compressed;
+   {
+      EnforceScheme<DoubleSchemeType> enforcer(DoubleSchemeType::DICT);
+      compressed = Datablock::compress(input_chunk, {nullptr, &global_dictionary});
+   }
+   auto meta = reinterpret_cast<const ColumnChunkMeta *>(compressed.data());
+   ASSERT_EQ(meta->compression_type, CB(DoubleSchemeType::DICT));
+   ASSERT_TRUE(doubles::DynamicDictionary().usesGlobalDictionary(meta->data));
+   std::vector<u8> decompressed(input_chunk.size + SIMD_EXTRA_BYTES);
+   BitmapWrapper *bitmap = nullptr;
+   ASSERT_THROW(Datablock::decompress(compressed.data(), &bitmap, decompressed.data()), Generic_Exception);
+   delete bitmap;
+   Datablock::decompress(compressed.data(), &bitmap, decompressed.data(),
+                         {nullptr, global_dictionary.exported().data()});
+   ASSERT_TRUE(input_chunk.compareContents(decompressed.data(), bitmap->writeBITMAP(), input_chunk.tuple_count,
+                                           false));
+   delete bitmap;
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, DoubleGlobalDictionaryPart)
+{
+   Relation relation;
+   relation.addColumn(TEST_DATASET("double/DICTIONARY_8.double"));
+   auto global_dictionary = GlobalDictionary::build(relation.columns[0], 4096);
+   ASSERT_FALSE(global_dictionary.empty());
+   auto part = TestHelper::WriteColumnPart(relation, DoubleSchemeType::DICT, {nullptr, &global_dictionary});
+   BtrReader reader(part.data());
+   ASSERT_EQ(reader.getPartFsstTable(), nullptr);
+   ASSERT_NE(reader.getPartGlobalDictionary(), nullptr);
+   TestHelper::CheckColumnPart(relation, part);
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, StringSharedFsstTablePart)
+{
+   Relation relation;
+   relation.addColumn(TEST_DATASET("string/COMPRESSED_DICTIONARY.string"));
+   strings::SharedFsstTable fsst_table;
+   fsst_table.train(relation.columns[0]);
+   ASSERT_FALSE(fsst_table.exported().empty());
+   for ( auto scheme_type : {StringSchemeType::DICT, StringSchemeType::FSST} ) {
+      auto part = TestHelper::WriteColumnPart(relation, scheme_type, {&fsst_table, nullptr});
+      BtrReader reader(part.data());
+      ASSERT_NE(reader.getPartFsstTable(), nullptr);
+      ASSERT_EQ(reader.getPartGlobalDictionary(), nullptr);
+      TestHelper::CheckColumnPart(relation, part);
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, ColumnPartBaselineFormat)
+{
+   Relation relation;
+   relation.addColumn(TEST_DATASET("string/DICTIONARY_8.string"));
+   auto ranges = TestHelper::GetPartRanges(relation);
+   ASSERT_GT(ranges.size(), 1);
+   // Parts written before the extension: metadata | offsets | chunks aligned by 16
+   vector<char> baseline(sizeof(u32) * (1 + ranges.size()));
+   reinterpret_cast<u32 *>(baseline.data())[0] = ranges.size();
+   ColumnPart part;
+   for ( u32 chunk_i = 0; chunk_i < ranges.size(); chunk_i++ ) {
+      auto chunk = Datablock::compress(relation.getInputChunk(ranges[chunk_i], chunk_i, 0));
+      baseline.resize((baseline.size() + 15) / 16 * 16);
+      reinterpret_cast<u32 *>(baseline.data())[1 + chunk_i] = baseline.size();
+      baseline.insert(baseline.end(), chunk.begin(), chunk.end());
+      part.addCompressedChunk(std::move(chunk));
+   }
+   BtrReader reader(baseline.data());
+   ASSERT_EQ(reader.getPartMetadata()->extension(), nullptr);
+   ASSERT_EQ(reader.getPartFsstTable(), nullptr);
+   ASSERT_EQ(reader.getPartGlobalDictionary(), nullptr);
+   TestHelper::CheckColumnPart(relation, baseline);
+   // Without part data, parts are still written in that layout
+   ASSERT_EQ(TestHelper::WriteColumnPart(part), baseline);
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, DoubleLargeDictionaryPenalty)
+{
+   Relation relation;
+   relation.addColumn(TEST_DATASET("double/DICTIONARY_8.double"));
+   auto& column = relation.columns[0].doubles();
+   const u32 tuple_count = std::min<u64>(column.size(), BtrBlocksConfig::get().block_size);
+   auto stats = DoubleStats::generateStats(column.data, nullptr, tuple_count);
+   doubles::DynamicDictionary scheme;
+   auto &cfg = SchemeConfig::get();
+   const double ratio = scheme.expectedCompressionRatio(stats, 3);
+   double penalized_ratio;
+   {
+      // The same dictionary counts as large once it exceeds the footprint limit
+      OverrideConfig large_dictionary_bytes(cfg.large_dictionary_bytes, 0);
+      penalized_ratio = scheme.expectedCompressionRatio(stats, 3);
+   }
+   EXPECT_DOUBLE_EQ(penalized_ratio, ratio * (100 - cfg.large_dictionary_penalty_pct) / 100.0);
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, PackedValidity)
+{
+   Relation relation;
+   relation.addColumn(TEST_DATASET("integer/SPARSE.integer"));
+   auto ranges = relation.getRanges(btrblocks::SplitStrategy::SEQUENTIAL, 999999);
+   auto input_chunk = relation.getInputChunk(ranges[0], 0, 0);
+   const u32 tuple_count = input_chunk.tuple_count;
+   const u32 word_count = bitmap::PackedBitmap::wordCount(tuple_count);
+   // Same chunk with bit-packed validity
+   auto validity = std::unique_ptr<VALIDITY[]>(new VALIDITY[word_count]);
+   bitmap::PackedBitmap::pack(validity.get(), input_chunk.nullmap.get(), tuple_count);
+   auto data = std::unique_ptr<u8[]>(new u8[input_chunk.size]);
+   std::memcpy(data.get(), input_chunk.data.get(), input_chunk.size);
+   InputChunk packed_chunk(std::move(data), std::move(validity), input_chunk.type, tuple_count,
+                           input_chunk.size);
+   // -------------------------------------------------------------------------------------
+   for ( auto chunk : {&input_chunk, &packed_chunk} ) {
+      auto compressed = Datablock::compress(*chunk);
+      BitmapWrapper *bitmap = nullptr;
+      std::vector<u8> decompressed(chunk->size + SIMD_EXTRA_BYTES);
+      Datablock::decompress(compressed.data(), &bitmap, decompressed.data());
+      std::vector<VALIDITY> decompressed_validity(word_count);
+      bitmap->writeValidity(decompressed_validity.data());
+      ASSERT_EQ(std::memcmp(decompressed_validity.data(), packed_chunk.validity.get(),
+                            word_count * sizeof(VALIDITY)), 0);
+      // Same words without a BitmapWrapper
+      auto meta = reinterpret_cast<const ColumnChunkMeta *>(compressed.data());
+      std::fill(decompressed_validity.begin(), decompressed_validity.end(), 0);
+      bitmap::RoaringBitmap::decompress(decompressed_validity.data(), meta->data + meta->nullmap_offset,
+                                        meta->nullmap_type, tuple_count);
+      ASSERT_EQ(std::memcmp(decompressed_validity.data(), packed_chunk.validity.get(),
+                            word_count * sizeof(VALIDITY)), 0);
+      ASSERT_TRUE(chunk->compareContents(decompressed.data(), bitmap->writeBITMAP(), tuple_count,
+                                         false));
+      delete bitmap;
+   }
+}
+// -------------------------------------------------------------------------------------
+// Serialized bitmaps with array, bitset and run containers, and the plain list
+// of positions, decoded in place
+TEST(V2, RoaringView)
+{
+   const u32 tuple_count = 4 * 65536 + 1000;
+   std::mt19937 gen(42);
+   auto make = [&](auto keep) {
+      vector<u32> positions;
+      for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+         if ( keep(row_i) ) {
+            positions.push_back(row_i);
+         }
+      }
+      return positions;
+   };
+   vector<vector<u32>> position_sets = {
+      {},
+      {0, 63, 64, 65536, tuple_count - 1},
+      make([&](u32) { return gen() % 100 == 0; }),
+      make([&](u32) { return gen() % 2 == 0; }),
+      make([&](u32 row_i) { return row_i % 1000 < 300; }),
+      // Run containers without the offset header
+      make([&](u32 row_i) { return row_i < 70000; }),
+      // Container 0 array, 1 bitset, 2 runs, 3 runs over the container border, 4 full
+      make([&](u32 row_i) {
+         switch ( row_i / 65536 ) {
+            case 0: return gen() % 50 == 0;
+            case 1: return gen() % 3 == 0;
+            case 2: return row_i % 4096 < 2048;
+            default: return row_i >= 3 * 65536 - 100;
+         }
+      }),
+   };
+   for ( auto &expected : position_sets ) {
+      SCOPED_TRACE(std::to_string(expected.size()) + " positions");
+      Roaring roaring;
+      roaring.addMany(expected.size(), expected.data());
+      roaring.runOptimize();
+      vector<u8> serialized(roaring.getSizeInBytes(false));
+      roaring.write(reinterpret_cast<char *>(serialized.data()), false);
+      const bitmap::RoaringView view(serialized.data());
+      ASSERT_EQ(view.cardinality(), expected.size());
+      auto positions = Patches::positions(view, 0);
+      ASSERT_TRUE(std::equal(expected.begin(), expected.end(), positions));
+      // -------------------------------------------------------------------------------------
+      vector<INTEGER> values(expected.size()), patched(tuple_count, -1);
+      std::iota(values.begin(), values.end(), 0);
+      Patches::apply(patched.data(), view, values.data());
+      for ( u32 k = 0; k < expected.size(); k++ ) {
+         ASSERT_EQ(patched[expected[k]], static_cast<INTEGER>(k));
+         patched[expected[k]] = -1;
+      }
+      ASSERT_EQ(std::count(patched.begin(), patched.end(), -1), tuple_count);
+      // -------------------------------------------------------------------------------------
+      // As nullmap, regular or flipped depending on the density
+      vector<BITMAP> nullmap(tuple_count, 0);
+      for ( auto position : expected ) {
+         nullmap[position] = 1;
+      }
+      for ( u32 count : {tuple_count, tuple_count - 37, 65536u} ) {
+         vector<VALIDITY> validity(bitmap::PackedBitmap::wordCount(count));
+         bitmap::PackedBitmap::pack(validity.data(), nullmap.data(), count);
+         vector<u8> compressed(count * 5 + 4096);
+         auto [size, type] = bitmap::RoaringBitmap::compress(validity.data(), compressed.data(), count);
+         vector<VALIDITY> decompressed(validity.size(), 0xAB);
+         bitmap::RoaringBitmap::decompress(decompressed.data(), compressed.data(), type, count);
+         ASSERT_EQ(decompressed, validity) << count;
+         BitmapWrapper wrapper(compressed.data(), type, count);
+         ASSERT_EQ(wrapper.cardinality(), bitmap::PackedBitmap::countOnes(validity.data(), count));
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+// Whatever the scheme, a value hashes like Hash::hashValue of its decompressed value.
+// Chunks with a single distinct value always end up as ONE_VALUE.
+TEST(V2, HashColumn)
+{
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("integer/ONE_VALUE.integer"));
+      auto part = TestHelper::WriteColumnPart(relation, IntegerSchemeType::ONE_VALUE);
+      TestHelper::CheckColumnHashes(part, CB(IntegerSchemeType::ONE_VALUE));
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("integer/RLE_NULLS.integer"));
+      for ( auto scheme_type : {IntegerSchemeType::UNCOMPRESSED, IntegerSchemeType::DICT, IntegerSchemeType::RLE} ) {
+         auto part = TestHelper::WriteColumnPart(relation, scheme_type);
+         TestHelper::CheckColumnHashes(part, CB(scheme_type));
+      }
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("bigint/DICTIONARY.bigint"));
+      for ( auto scheme_type : {Integer64SchemeType::UNCOMPRESSED, Integer64SchemeType::DICT,
+                                Integer64SchemeType::RLE} ) {
+         auto part = TestHelper::WriteColumnPart(relation, scheme_type);
+         TestHelper::CheckColumnHashes(part, CB(scheme_type));
+      }
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("double/ONE_VALUE.double"));
+      auto part = TestHelper::WriteColumnPart(relation, DoubleSchemeType::ONE_VALUE);
+      TestHelper::CheckColumnHashes(part, CB(DoubleSchemeType::ONE_VALUE));
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("double/DICTIONARY_8.double"));
+      for ( auto scheme_type : {DoubleSchemeType::UNCOMPRESSED, DoubleSchemeType::DICT, DoubleSchemeType::RLE} ) {
+         auto part = TestHelper::WriteColumnPart(relation, scheme_type);
+         TestHelper::CheckColumnHashes(part, CB(scheme_type));
+      }
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("float/ONE_VALUE.float"));
+      auto part = TestHelper::WriteColumnPart(relation, FloatSchemeType::ONE_VALUE);
+      TestHelper::CheckColumnHashes(part, CB(FloatSchemeType::ONE_VALUE));
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("float/DICTIONARY.float"));
+      for ( auto scheme_type : {FloatSchemeType::UNCOMPRESSED, FloatSchemeType::DICT, FloatSchemeType::RLE} ) {
+         auto part = TestHelper::WriteColumnPart(relation, scheme_type);
+         TestHelper::CheckColumnHashes(part, CB(scheme_type));
+      }
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("string/ONE_VALUE.string"));
+      auto part = TestHelper::WriteColumnPart(relation, StringSchemeType::ONE_VALUE);
+      TestHelper::CheckColumnHashes(part, CB(StringSchemeType::ONE_VALUE));
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("string/DICTIONARY_8.string"));
+      for ( auto scheme_type : {StringSchemeType::UNCOMPRESSED, StringSchemeType::DICT} ) {
+         auto part = TestHelper::WriteColumnPart(relation, scheme_type);
+         TestHelper::CheckColumnHashes(part, CB(scheme_type));
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
+// DICT chunks of a part with a GlobalDictionary hash the entries of the part
+TEST(V2, HashColumnGlobalDictionary)
+{
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("double/DICTIONARY_8.double"));
+      auto global_dictionary = GlobalDictionary::build(relation.columns[0], 4096);
+      ASSERT_FALSE(global_dictionary.empty());
+         auto part = TestHelper::WriteColumnPart(relation, DoubleSchemeType::DICT, {nullptr, &global_dictionary});
+      TestHelper::CheckColumnHashes(part, CB(DoubleSchemeType::DICT));
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("string/DICTIONARY_8.string"));
+      auto global_dictionary = GlobalDictionary::build(relation.columns[0], 4096);
+      ASSERT_FALSE(global_dictionary.empty());
+         auto part = TestHelper::WriteColumnPart(relation, StringSchemeType::DICT, {nullptr, &global_dictionary});
+      TestHelper::CheckColumnHashes(part, CB(StringSchemeType::DICT));
+   }
+}
+// -------------------------------------------------------------------------------------
+TEST(V2, ReadColumnEncoded)
+{
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("integer/RLE_NULLS.integer"));
+      auto part = TestHelper::WriteColumnPart(relation, IntegerSchemeType::DICT);
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::DICTIONARY);
+      part = TestHelper::WriteColumnPart(relation, IntegerSchemeType::RLE);
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::RUNS);
+      part = TestHelper::WriteColumnPart(relation, IntegerSchemeType::UNCOMPRESSED);
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::PLAIN);
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("bigint/DICTIONARY.bigint"));
+      auto part = TestHelper::WriteColumnPart(relation, Integer64SchemeType::DICT);
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::DICTIONARY);
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("double/DICTIONARY_8.double"));
+      auto part = TestHelper::WriteColumnPart(relation, DoubleSchemeType::DICT);
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::DICTIONARY);
+      part = TestHelper::WriteColumnPart(relation, DoubleSchemeType::RLE);
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::RUNS);
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("float/DICTIONARY.float"));
+      auto part = TestHelper::WriteColumnPart(relation, FloatSchemeType::DICT);
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::DICTIONARY);
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("string/DICTIONARY_8.string"));
+      auto part = TestHelper::WriteColumnPart(relation, StringSchemeType::DICT);
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::DICTIONARY);
+      part = TestHelper::WriteColumnPart(relation, StringSchemeType::UNCOMPRESSED);
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::PLAIN);
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("string/FRONT_CODED_DICTIONARY.string"));
+      auto part = TestHelper::WriteColumnPart(relation, StringSchemeType::DICT_FRONT_CODED);
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::DICTIONARY);
+   }
+}
+// -------------------------------------------------------------------------------------
+// The codes of every chunk index the entries of the part's GlobalDictionary
+TEST(V2, ReadColumnEncodedGlobalDictionary)
+{
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("double/DICTIONARY_8.double"));
+      auto global_dictionary = GlobalDictionary::build(relation.columns[0], 4096);
+      ASSERT_FALSE(global_dictionary.empty());
+         auto part = TestHelper::WriteColumnPart(relation, DoubleSchemeType::DICT, {nullptr, &global_dictionary});
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::DICTIONARY, true);
+   }
+   {
+      Relation relation;
+      relation.addColumn(TEST_DATASET("string/DICTIONARY_8.string"));
+      auto global_dictionary = GlobalDictionary::build(relation.columns[0], 4096);
+      ASSERT_FALSE(global_dictionary.empty());
+         auto part = TestHelper::WriteColumnPart(relation, StringSchemeType::DICT, {nullptr, &global_dictionary});
+      TestHelper::CheckColumnEncoded(part, ColumnEncoding::DICTIONARY, true);
+   }
+}
+// -------------------------------------------------------------------------------------
+// DICT chunks hand out single entries through a DictionaryEntryReader, its
+// direct-mapped cache only exists with FSST
+TEST(V2, StringReadStrings)
+{
+   Relation relation;
+   relation.addColumn(TEST_DATASET("string/DICTIONARY_16.string"));
+   auto ranges = TestHelper::GetPartRanges(relation);
+   ASSERT_GE(ranges.size(), 2u);
+   auto &cfg = SchemeConfig::get().strings;
+   std::mt19937 gen(42);
+   for ( bool fsst : {false, true} ) {
+      SCOPED_TRACE(fsst ? "fsst" : "no fsst");
+      vector<char> part;
+      {
+         OverrideConfig allow_fsst(cfg.dict_allow_fsst, fsst);
+         OverrideConfig force_fsst(cfg.dict_force_fsst, fsst);
+         part = TestHelper::WriteColumnPart(relation, StringSchemeType::DICT);
+      }
+      BtrReader reader(part.data());
+      // -------------------------------------------------------------------------------------
+      // Input strings of the first two chunks, all rows out of order and two
+      // rows whose codes share a cache slot
+      std::vector<std::vector<std::string>> expected(2);
+      std::vector<std::vector<u32>> shuffled(2), colliding(2);
+      EncodedColumn encoded;
+      for ( u32 chunk_i = 0; chunk_i < 2; chunk_i++ ) {
+         auto meta = reader.getChunkMetadata(chunk_i);
+         ASSERT_EQ(meta->compression_type, CB(StringSchemeType::DICT));
+         auto &col_struct = *reinterpret_cast<const strings::DynamicDictionaryStructure *>(meta->data);
+         ASSERT_EQ(col_struct.useFsst(), fsst);
+         ASSERT_GT(col_struct.num_codes, strings::DictionaryEntryReader::CACHE_SIZE);
+         auto input_chunk = relation.getInputChunk(ranges[chunk_i], chunk_i, 0);
+         StringArrayViewer viewer(input_chunk.data.get());
+         reader.readColumnEncoded(encoded, chunk_i);
+         std::vector<u32> code_rows(col_struct.num_codes, input_chunk.tuple_count);
+         for ( u32 row_i = 0; row_i < input_chunk.tuple_count; row_i++ ) {
+            // NULL rows come back empty
+            expected[chunk_i].emplace_back(input_chunk.isSet(row_i) ? std::string(viewer(row_i)) : std::string());
+            shuffled[chunk_i].push_back(row_i);
+            code_rows[encoded.codes[row_i]] = row_i;
+         }
+         std::shuffle(shuffled[chunk_i].begin(), shuffled[chunk_i].end(), gen);
+         const u32 row_a = code_rows[0], row_b = code_rows[strings::DictionaryEntryReader::CACHE_SIZE];
+         ASSERT_LT(row_a, input_chunk.tuple_count);
+         ASSERT_LT(row_b, input_chunk.tuple_count);
+         colliding[chunk_i] = {row_a, row_b, row_a, row_b, row_b, row_a};
+      }
+      // -------------------------------------------------------------------------------------
+      std::vector<std::string> output;
+      auto check = [&](u32 chunk_i, const std::vector<u32> &rows) {
+         reader.readStrings(output, chunk_i, rows.data(), rows.size());
+         ASSERT_EQ(output.size(), rows.size());
+         for ( u32 i = 0; i < rows.size(); i++ ) {
+            ASSERT_EQ(output[i], expected[chunk_i][rows[i]]) << "chunk " << chunk_i << ", row " << rows[i];
+         }
+      };
+      // Switch chunks, then read the same chunk again with the cached codes and entries
+      check(0, shuffled[0]);
+      check(1, shuffled[1]);
+      check(0, colliding[0]);
+      check(0, shuffled[0]);
+      check(0, colliding[0]);
+      check(1, colliding[1]);
+      check(1, shuffled[1]);
+   }
+}
+// -------------------------------------------------------------------------------------
 // TEST(V2, IntegerFrequency)
 // {
 //    FLAGS_force_integer_scheme = CB(IntegerSchemeType::FREQUENCY);
@@ -92,6 +1181,46 @@ TEST(V2, DoubleFrequency)
    TestHelper::CheckRelationCompression(relation, datablockV2, {CB(DoubleSchemeType::FREQUENCY)});
 }
 // -------------------------------------------------------------------------------------
+// Exceptions on the first and the last row and in a tail shorter than a vector
+TEST(V2, DoubleExceptionEdges)
+{
+   for ( auto scheme_type : {DoubleSchemeType::FREQUENCY, DoubleSchemeType::PSEUDODECIMAL} ) {
+      for ( u32 tuple_count : {1003u, 4099u, 65533u} ) {
+         SCOPED_TRACE(std::to_string(CI(scheme_type)) + ", " + std::to_string(tuple_count) + " tuples");
+         ASSERT_NE(tuple_count % 8, 0u);
+         const u32 tail_begin = tuple_count - tuple_count % 8;
+         auto data = std::unique_ptr<u8[]>(new u8[tuple_count * sizeof(DOUBLE)]);
+         auto doubles = reinterpret_cast<DOUBLE *>(data.get());
+         for ( u32 row_i = 0; row_i < tuple_count; row_i++ ) {
+            const bool exception = row_i == 0 || row_i >= tail_begin || row_i % 97 == 0;
+            if ( scheme_type == DoubleSchemeType::FREQUENCY ) {
+               doubles[row_i] = exception ? row_i + 0.5 : 12.5;
+            } else {
+               // Thirds have no exact decimal representation
+               doubles[row_i] = exception ? row_i + 1.0 / 3 : (row_i % 100000) / 100.0;
+            }
+         }
+         auto bitmap = std::unique_ptr<BITMAP[]>(new BITMAP[tuple_count]);
+         std::fill_n(bitmap.get(), tuple_count, 1);
+         InputChunk input_chunk(std::move(data), std::move(bitmap), ColumnType::DOUBLE, tuple_count,
+                                tuple_count * sizeof(DOUBLE));
+         // -------------------------------------------------------------------------------------
+         std::vector<u8> compressed;
+         {
+            EnforceScheme<DoubleSchemeType> enforcer(scheme_type);
+            compressed = Datablock::compress(input_chunk);
+         }
+         auto meta = reinterpret_cast<const ColumnChunkMeta *>(compressed.data());
+         ASSERT_EQ(meta->compression_type, CB(scheme_type));
+         std::vector<u8> decompressed(input_chunk.size + SIMD_EXTRA_BYTES);
+         BitmapWrapper *nullmap = nullptr;
+         Datablock::decompress(compressed.data(), &nullmap, decompressed.data());
+         ASSERT_TRUE(input_chunk.compareContents(decompressed.data(), nullmap->writeBITMAP(), tuple_count, false));
+         delete nullmap;
+      }
+   }
+}
+// -------------------------------------------------------------------------------------
 TEST(V2, End)
 {
    SchemePool::refresh();
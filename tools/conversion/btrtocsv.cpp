@@ -19,6 +19,8 @@
 #include "btrfiles.hpp"
 // ------------------------------------------------------------------------------
 // Btr internal includes
+#include "common/Decimal.hpp"
+#include "common/Temporal.hpp"
 #include "common/Utils.hpp"
 #include "scheme/SchemePool.hpp"
 #include "cache/ThreadCache.hpp"
@@ -37,6 +39,7 @@ using namespace btrblocks;
 void outputChunk(std::ofstream &csvstream, u32 tuple_count,
                  const std::vector<std::pair<u32, u32>> &counters,
                  const std::vector<std::vector<u8>> &decompressed_columns,
+                 const std::vector<std::vector<VALIDITY>> &validities,
                  std::vector<std::vector<BtrReader>> &readers,
                  const std::vector<u32>& requires_copy) {
     const std::string field_separator = "|";
@@ -45,18 +48,8 @@ void outputChunk(std::ofstream &csvstream, u32 tuple_count,
     for (size_t row = 0; row < tuple_count; row++) {
         for (size_t col = 0; col < decompressed_columns.size(); col++) {
             BtrReader &reader = readers[col][counters[col].first];
-            BitmapWrapper *nullmap = reader.getBitmap(counters[col].second-1);
 
-            bool is_null;
-            if (nullmap->type() == BitmapType::ALLZEROS) {
-                is_null = true;
-            } else if (nullmap->type() == BitmapType::ALLONES) {
-                is_null = false;
-            } else {
-                is_null = !(nullmap->get_bitset()->test(row));
-            }
-
-            if (!is_null) {
+            if (bitmap::PackedBitmap::test(validities[col].data(), row)) {
                 switch (reader.getColumnType()) {
                     case ColumnType::INTEGER: {
                         auto int_array = reinterpret_cast<const INTEGER *>(decompressed_columns[col].data());
@@ -68,6 +61,41 @@ void outputChunk(std::ofstream &csvstream, u32 tuple_count,
                         csvstream << double_array[row];
                         break;
                     }
+                    case ColumnType::BIGINT: {
+                        auto bigint_array = reinterpret_cast<const BIGINT *>(decompressed_columns[col].data());
+                        csvstream << bigint_array[row];
+                        break;
+                    }
+                    case ColumnType::SMALLINT: {
+                        auto smallint_array = reinterpret_cast<const SMALLINT *>(decompressed_columns[col].data());
+                        csvstream << smallint_array[row];
+                        break;
+                    }
+                    case ColumnType::TINYINT: {
+                        auto tinyint_array = reinterpret_cast<const TINYINT *>(decompressed_columns[col].data());
+                        csvstream << CI(tinyint_array[row]);
+                        break;
+                    }
+                    case ColumnType::TIMESTAMP: {
+                        auto timestamp_array = reinterpret_cast<const TIMESTAMP *>(decompressed_columns[col].data());
+                        csvstream << Temporal::formatTimestamp(timestamp_array[row]);
+                        break;
+                    }
+                    case ColumnType::DECIMAL: {
+                        auto decimal_array = reinterpret_cast<const DECIMAL *>(decompressed_columns[col].data());
+                        csvstream << Decimal::format(decimal_array[row], reader.getDecimalScale());
+                        break;
+                    }
+                    case ColumnType::DATE: {
+                        auto date_array = reinterpret_cast<const DATE *>(decompressed_columns[col].data());
+                        csvstream << Temporal::formatDate(date_array[row]);
+                        break;
+                    }
+                    case ColumnType::FLOAT: {
+                        auto float_array = reinterpret_cast<const FLOAT *>(decompressed_columns[col].data());
+                        csvstream << float_array[row];
+                        break;
+                    }
                     case ColumnType::STRING: {
                         std::string data;
                         if (requires_copy[col]) {
@@ -147,6 +175,7 @@ int main(int argc, char **argv)
          * vector solves the contention problem.
          */
         std::vector<u32> requires_copy(file_metadata->num_columns);
+        std::vector<std::vector<VALIDITY>> validities(file_metadata->num_columns);
         u32 tuple_count = 0;
         tbb::parallel_for(u32(0), file_metadata->num_columns, [&](u32 column_i) {
             u32 part_i = counters[column_i].first;
@@ -163,8 +192,10 @@ int main(int argc, char **argv)
                 tuple_count = reader.getTupleCount(part_chunk_i);
             }
             requires_copy[column_i] = reader.readColumn(outputs[column_i], part_chunk_i);
+            validities[column_i].resize(bitmap::PackedBitmap::wordCount(reader.getTupleCount(part_chunk_i)));
+            reader.readValidity(validities[column_i].data(), part_chunk_i);
             counters[column_i].second++;
         });
-        outputChunk(csvstream, tuple_count, counters, outputs, readers, requires_copy);
+        outputChunk(csvstream, tuple_count, counters, outputs, validities, readers, requires_copy);
     }
 }
@@ -1,7 +1,13 @@
 import sys
 import yaml
+from datetime import datetime
+from decimal import Decimal
 
-valid_types = ["integer", "smallint", "double", "float", "string"]
+valid_types = ["integer", "smallint", "tinyint", "timestamp", "date", "decimal", "double", "float", "string"]
+
+# "decimal(p,s)" -> "decimal"
+def base_type(column):
+    return column["type"].split("(")[0]
 
 def fix_format(lines, columns):
     for i in range(len(lines)):
@@ -22,6 +28,19 @@ def fix_format(lines, columns):
             elif columns[idx]["type"] == "integer":
                 if fields[idx] == "":
                     fields[idx] = "null"
+            elif base_type(columns[idx]) == "decimal":
+                if fields[idx] == "":
+                    fields[idx] = "null"
+                elif fields[idx] != "null":
+                    # btrtocsv prints exactly scale fraction digits
+                    fields[idx] = str(Decimal(fields[idx]).normalize())
+            elif columns[idx]["type"] == "timestamp":
+                if fields[idx] == "":
+                    fields[idx] = "null"
+                elif fields[idx] != "null":
+                    # btrtocsv always prints microseconds
+                    t = datetime.fromisoformat(fields[idx])
+                    fields[idx] = t.strftime("%Y-%m-%d %H:%M:%S.%f")
 
         lines[i] = "|".join(fields)
 
@@ -37,7 +56,7 @@ def strip_original_lines(original_lines, columns):
         stripped_line = ""
         first = True
         for part, column in zip(parts, columns):
-            if column["type"] not in valid_types:
+            if base_type(column) not in valid_types:
                 continue
             if first:
                 stripped_line = part
@@ -75,7 +94,7 @@ def main():
     strip_original_lines(original_lines, columns)
 
     # The columns we ignore do not exist in the csv anymore after converting back from btr
-    btr_columns = [c for c in columns if c["type"] in valid_types]
+    btr_columns = [c for c in columns if base_type(c) in valid_types]
 
     # Format lines
     print("Formatting btr lines")
@@ -23,6 +23,9 @@
 #include "scheme/SchemePool.hpp"
 #include "compression/Datablock.hpp"
 #include "compression/BtrReader.hpp"
+#include "scheme/GlobalDictionary.hpp"
+#include "scheme/SchemeConfig.hpp"
+#include "scheme/string/FsstTable.hpp"
 #include "cache/ThreadCache.hpp"
 // ------------------------------------------------------------------------------
 // Btrfiles include
@@ -105,12 +108,26 @@ int main(int argc, char **argv)
         typefilter = ColumnType::UNDEFINED;
     } else if (FLAGS_typefilter == "integer") {
         typefilter = ColumnType::INTEGER;
+    } else if (FLAGS_typefilter == "bigint") {
+        typefilter = ColumnType::BIGINT;
+    } else if (FLAGS_typefilter == "smallint") {
+        typefilter = ColumnType::SMALLINT;
+    } else if (FLAGS_typefilter == "tinyint") {
+        typefilter = ColumnType::TINYINT;
+    } else if (FLAGS_typefilter == "timestamp") {
+        typefilter = ColumnType::TIMESTAMP;
+    } else if (FLAGS_typefilter == "date") {
+        typefilter = ColumnType::DATE;
+    } else if (FLAGS_typefilter == "decimal") {
+        typefilter = ColumnType::DECIMAL;
     } else if (FLAGS_typefilter == "double") {
         typefilter = ColumnType::DOUBLE;
+    } else if (FLAGS_typefilter == "float") {
+        typefilter = ColumnType::FLOAT;
     } else if (FLAGS_typefilter == "string") {
         typefilter = ColumnType::STRING;
     } else {
-        throw std::runtime_error("typefilter must be one of [integer, double, string]");
+        throw std::runtime_error("typefilter must be one of [integer, bigint, smallint, tinyint, timestamp, date, decimal, double, float, string]");
     }
 
     if (typefilter != ColumnType::UNDEFINED) {
@@ -157,21 +174,35 @@ int main(int argc, char **argv)
         std::vector<InputChunk> input_chunks;
         std::string path_prefix = FLAGS_btr + "/" + "column" + std::to_string(column_i) + "_part";
         ColumnPart part;
+        // String chunks of the column share one FSST table, stored once per part
+        strings::SharedFsstTable fsst_table;
+        fsst_table.train(relation.columns[column_i]);
+        // Low-cardinality columns share one dictionary, stored once per part
+        auto global_dictionary = GlobalDictionary::build(
+            relation.columns[column_i], SchemeConfig::get().global_dictionary_max_unique);
+        PartEncoding part_encoding{&fsst_table, &global_dictionary};
+        // Every part stores both, so canAdd accounts for them from the first chunk on
+        auto start_part = [&]() {
+            part.fsst_table = fsst_table.exported();
+            part.global_dictionary = global_dictionary.exported();
+        };
+        start_part();
         for (SIZE chunk_i = 0; chunk_i < ranges.size(); chunk_i++) {
             if (FLAGS_chunk != -1 && FLAGS_chunk != chunk_i) {
                 continue;
             }
 
             auto input_chunk = relation.getInputChunk(ranges[chunk_i], chunk_i, column_i);
-            std::vector<u8> data = Datablock::compress(input_chunk);
+            std::vector<u8> data = Datablock::compress(input_chunk, part_encoding);
             sizes_uncompressed[column_i] += input_chunk.size;
 
-            if (!part.canAdd(data.size())) {
+            if (!part.canAdd(data.size()) && !part.chunks.empty()) {
                 std::string filename = path_prefix + std::to_string(part_counters[column_i]);
                 sizes_compressed[column_i] += part.writeToDisk(filename);
                 part_counters[column_i]++;
                 verify_or_die(filename, input_chunks);
                 input_chunks.clear();
+                start_part();
             }
 
             input_chunks.push_back(std::move(input_chunk));
@@ -125,12 +125,26 @@ int main(int argc, char **argv) {
         typefilter = ColumnType::UNDEFINED;
     } else if (FLAGS_typefilter == "integer") {
         typefilter = ColumnType::INTEGER;
+    } else if (FLAGS_typefilter == "bigint") {
+        typefilter = ColumnType::BIGINT;
+    } else if (FLAGS_typefilter == "smallint") {
+        typefilter = ColumnType::SMALLINT;
+    } else if (FLAGS_typefilter == "tinyint") {
+        typefilter = ColumnType::TINYINT;
+    } else if (FLAGS_typefilter == "timestamp") {
+        typefilter = ColumnType::TIMESTAMP;
+    } else if (FLAGS_typefilter == "date") {
+        typefilter = ColumnType::DATE;
+    } else if (FLAGS_typefilter == "decimal") {
+        typefilter = ColumnType::DECIMAL;
     } else if (FLAGS_typefilter == "double") {
         typefilter = ColumnType::DOUBLE;
+    } else if (FLAGS_typefilter == "float") {
+        typefilter = ColumnType::FLOAT;
     } else if (FLAGS_typefilter == "string") {
         typefilter = ColumnType::STRING;
     } else {
-        throw std::runtime_error("filter_type must be one of [integer, double, string]");
+        throw std::runtime_error("filter_type must be one of [integer, bigint, smallint, tinyint, timestamp, date, decimal, double, float, string]");
     }
 
     std::vector<u32> columns;
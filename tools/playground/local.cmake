@@ -43,12 +43,6 @@ add_executable(double_benchmarking ${BTR_PLAYGROUND_DIR}/double_benchmarking.cpp
 target_include_directories(double_benchmarking PRIVATE ${BTR_INCLUDE_DIR} ${GDOUBLE_INCLUDE_DIR})
 target_link_libraries(double_benchmarking gdouble btrblocks)
 
-# Pseudodecimal
-add_executable(pseudodecimal_benchmark ${BTR_PLAYGROUND_DIR}/pseudodecimal_benchmark.cpp)
-target_include_directories(pseudodecimal_benchmark PRIVATE ${BTR_INCLUDE_DIR})
-target_link_libraries(pseudodecimal_benchmark btrblocks gflags fsst pthread spdlog)
-configure_file(${BTR_PLAYGROUND_DIR}/pbi-double-columns.txt pbi-double-columns.txt COPYONLY)
-
 # Sampling Algorithm
 add_executable(sampling_algorithms ${BTR_PLAYGROUND_DIR}/sampling_algorithms.cpp)
 target_include_directories(sampling_algorithms PRIVATE ${BTR_INCLUDE_DIR})